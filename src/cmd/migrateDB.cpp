@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/// Should be run from a folder with constants.xml and a folder named
+/// "persistence" consisting of the persistence, with the node stopped.
+/// Rewrites the persistence into STORAGE_FORMAT_VERSION, from format 1 or from
+/// before formats were recorded. Can be run again if it was interrupted.
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <leveldb/write_batch.h>
+
+#include "common/Constants.h"
+#include "depends/libDatabase/LevelDB.h"
+#include "libPersistence/BlockStorage.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+#define SUCCESS 0
+#define ERROR_MIGRATION -1
+
+namespace {
+
+// DBs whose records are keyed by block number or index
+const vector<string> BLOCKNUM_KEYED_DBS = {
+    "dsBlocks",       "txBlocks",   "dsCommittee",     "blockLinks",
+    "shardStructure", "stateDelta", "diagnosticNodes", "diagnosticCoinb"};
+// DBs whose records are keyed by hash. The state DB also holds aux records
+// keyed by the hash bytes and a trailing byte, which are left as they are.
+const vector<string> HASH_KEYED_DBS = {"microBlocks", "VCBlocks",
+                                       "fallbackBlocks", "txBodies",
+                                       "txBodiesTmp", "state"};
+const unsigned int MIGRATION_BATCH_SIZE = 10000;
+
+bool IsDecimalKey(const leveldb::Slice& key) {
+  return !key.empty() &&
+         all_of(key.data(), key.data() + key.size(),
+                [](char c) { return c >= '0' && c <= '9'; });
+}
+
+/// Returns true and sets newKey if key is in the old format.
+using KeyConverter = function<bool(const leveldb::Slice&, string&)>;
+
+/// Moves the records whose key is accepted by convert to the key it returns.
+/// Converted keys must not be accepted again, so that records already moved
+/// by an interrupted run are left alone.
+bool MigrateKeys(LevelDB& db, const KeyConverter& convert) {
+  uint64_t count = 0;
+  leveldb::WriteBatch batch;
+  unsigned int batchSize = 0;
+
+  unique_ptr<leveldb::Iterator> it(
+      db.GetDB()->NewIterator(LevelDB::ScanReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    string newKey;
+    if (!convert(it->key(), newKey)) {
+      continue;
+    }
+
+    batch.Delete(it->key());
+    batch.Put(newKey, it->value());
+    count++;
+
+    if (++batchSize == MIGRATION_BATCH_SIZE) {
+      if (!db.GetDB()->Write(leveldb::WriteOptions(), &batch).ok()) {
+        return false;
+      }
+      batch.Clear();
+      batchSize = 0;
+    }
+  }
+
+  if (!it->status().ok() ||
+      !db.GetDB()->Write(leveldb::WriteOptions(), &batch).ok()) {
+    return false;
+  }
+
+  cout << "Migrated " << count << " records in " << db.GetDBName() << endl;
+  return true;
+}
+
+/// Decimal keys to toBlockNumKey keys, which start with a zero byte.
+bool ConvertBlockNumKey(const leveldb::Slice& key, string& newKey) {
+  if (!IsDecimalKey(key)) {
+    return false;
+  }
+
+  try {
+    newKey = toBlockNumKey(stoull(key.ToString()));
+  } catch (...) {
+    cout << "Skipping key " << key.ToString() << endl;
+    return false;
+  }
+  return true;
+}
+
+/// Hex hash keys to the 32 bytes of the hash.
+bool ConvertHashKey(const leveldb::Slice& key, string& newKey) {
+  if (!isHexHashKey(key)) {
+    return false;
+  }
+
+  const dev::h256 hash(key.ToString());
+  newKey.assign((const char*)hash.data(), hash.size);
+  return true;
+}
+
+bool MigrateDBs(const vector<string>& dbNames, const KeyConverter& convert) {
+  for (const auto& dbName : dbNames) {
+    // Not every kind of node has every DB
+    if (!boost::filesystem::exists(STORAGE_PATH + PERSISTENCE_PATH + "/" +
+                                   dbName)) {
+      continue;
+    }
+
+    LevelDB db(dbName);
+    if (!db.GetDB() || !MigrateKeys(db, convert)) {
+      cout << "Failed to migrate " << dbName << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main() {
+  INIT_STDOUT_LOGGER();
+
+  LevelDB metadataDB("metadata");
+  if (!metadataDB.GetDB()) {
+    cout << "Failed to open the persistence" << endl;
+    return ERROR_MIGRATION;
+  }
+
+  const string formatKey = to_string((int)MetaType::STORAGEFORMAT);
+  const string version = to_string(STORAGE_FORMAT_VERSION);
+  const string currentVersion = metadataDB.Lookup(formatKey);
+  if (currentVersion == version) {
+    cout << "Persistence is already in storage format " << version << endl;
+    return SUCCESS;
+  }
+  if (currentVersion.empty()) {
+    if (!MigrateDBs(BLOCKNUM_KEYED_DBS, ConvertBlockNumKey)) {
+      return ERROR_MIGRATION;
+    }
+  } else if (currentVersion != "1") {
+    cout << "Unknown storage format " << currentVersion << endl;
+    return ERROR_MIGRATION;
+  }
+
+  if (!MigrateDBs(HASH_KEYED_DBS, ConvertHashKey)) {
+    return ERROR_MIGRATION;
+  }
+
+  if (metadataDB.Insert(formatKey, bytes(version.begin(), version.end())) !=
+      0) {
+    cout << "Failed to record the storage format" << endl;
+    return ERROR_MIGRATION;
+  }
+
+  cout << "Persistence migrated to storage format " << version << endl;
+  return SUCCESS;
+}
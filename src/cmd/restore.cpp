@@ -73,8 +73,7 @@ bool RollBackDSComm(const BlockLink& lastBlockLink,
   return true;
 }
 
-bool PutStateDeltaInLocalPersistence(uint32_t lastBlockNum,
-                                     const list<TxBlockSharedPtr>& blocks) {
+bool PutStateDeltaInLocalPersistence(uint32_t lastBlockNum) {
   if ((lastBlockNum + 1) %
           (INCRDB_DSNUMS_WITH_STATEDELTAS * NUM_FINAL_BLOCK_PER_POW) ==
       0) {
@@ -96,6 +95,18 @@ bool PutStateDeltaInLocalPersistence(uint32_t lastBlockNum,
     LOG_GENERAL(INFO, "Will try recreating state from txnblks: "
                           << lower_bound_txnblk << " - " << upper_bound_txnblk);
 
+    // Only the Tx blocks whose state roots are checked are read
+    std::list<TxBlockSharedPtr> rangeBlocks;
+    if (!BlockStorage::GetBlockStorage().GetTxBlockRange(
+            lower_bound_txnblk, upper_bound_txnblk, rangeBlocks) ||
+        rangeBlocks.size() != upper_bound_txnblk - lower_bound_txnblk + 1) {
+      LOG_GENERAL(WARNING, "Missing TxBlocks " << lower_bound_txnblk << " - "
+                                               << upper_bound_txnblk);
+      return false;
+    }
+    const std::vector<TxBlockSharedPtr> stateBlocks(rangeBlocks.begin(),
+                                                    rangeBlocks.end());
+
     // clear all the state deltas from disk.
     if (!BlockStorage::GetBlockStorage().ResetDB(BlockStorage::STATE_DELTA)) {
       LOG_GENERAL(WARNING, "BlockStorage::ResetDB failed");
@@ -141,7 +152,7 @@ bool PutStateDeltaInLocalPersistence(uint32_t lastBlockNum,
               }
 
               if (AccountStore::GetInstance().GetStateRootHash() !=
-                  (*std::next(blocks.begin(), j))
+                  stateBlocks.at(j - lower_bound_txnblk)
                       ->GetHeader()
                       .GetStateRootHash()) {
                 LOG_GENERAL(
@@ -385,7 +396,7 @@ int main(int argc, char* argv[]) {
   if ((latestDSIndex == latestDSIndexPruned)) {
     ret.RetrieveTxBlocks(false);
   } else {
-    PutStateDeltaInLocalPersistence(latestTxBlockNumPruned, txblocks);
+    PutStateDeltaInLocalPersistence(latestTxBlockNumPruned);
   }
   auto dsCommittee_rolled_back = dsComm;
   if (!RollBackDSComm(mediator.m_blocklinkchain.GetLatestBlockLink(),
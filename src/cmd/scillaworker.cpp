@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <signal.h>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <boost/program_options.hpp>
+
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+#include "libUtils/SWInfo.h"
+#include "libUtils/ScillaWorker.h"
+
+#define SUCCESS 0
+#define ERROR_IN_COMMAND_LINE -1
+#define ERROR_UNHANDLED_EXCEPTION -2
+#define ERROR_UNEXPECTED -3
+
+namespace po = boost::program_options;
+using namespace std;
+
+void description() {
+  cout << endl << "Description:\n";
+  cout << "\tServes scilla interpreter requests from zilliqa nodes running "
+          "with ENABLE_SCILLA_WORKER, until SIGINT or SIGTERM."
+       << endl;
+}
+
+int main(int argc, const char* argv[]) {
+  try {
+    string socketPath;
+    string workDir;
+    po::options_description desc("Options");
+
+    desc.add_options()("help,h", "Print help messages")(
+        "socket,s", po::value<string>(&socketPath)->default_value(
+                        SCILLA_WORKER_SOCKET),
+        "Unix domain socket to listen on")(
+        "work-dir,w",
+        po::value<string>(&workDir)->default_value("scilla_worker"),
+        "Directory for the interpreter inputs and outputs");
+
+    po::variables_map vm;
+    try {
+      po::store(po::parse_command_line(argc, argv, desc), vm);
+
+      /** --help option
+       */
+      if (vm.count("help")) {
+        SWInfo::LogBrandBugReport();
+        description();
+        cout << desc << endl;
+        return SUCCESS;
+      }
+      po::notify(vm);
+    } catch (boost::program_options::error& e) {
+      SWInfo::LogBrandBugReport();
+      cerr << "ERROR: " << e.what() << endl << endl;
+      return ERROR_IN_COMMAND_LINE;
+    }
+
+    INIT_STDOUT_LOGGER();
+
+    // Block the stop signals in every thread so that only sigwait gets them
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    ScillaWorker worker(socketPath, workDir);
+    if (!worker.Listen()) {
+      return ERROR_UNEXPECTED;
+    }
+
+    thread runner([&worker]() { worker.Run(); });
+    int sig = 0;
+    sigwait(&stopSignals, &sig);
+    LOG_GENERAL(INFO, "Received signal " << sig << ", stopping");
+    worker.Stop();
+    runner.join();
+  } catch (exception& e) {
+    cerr << "Unhandled Exception reached the top of main: " << e.what()
+         << ", application will now exit" << endl;
+    return ERROR_UNHANDLED_EXCEPTION;
+  }
+  return SUCCESS;
+}
@@ -143,6 +143,20 @@ const unsigned int POW_PACKET_SENDERS{
 const unsigned int TX_SHARING_CLUSTER_SIZE{
     ReadConstantNumeric("TX_SHARING_CLUSTER_SIZE", "node.data_sharing.")};
 
+// Database constants
+const unsigned int LEVELDB_MAX_OPEN_FILES{
+    ReadConstantNumeric("LEVELDB_MAX_OPEN_FILES", "node.database.")};
+const unsigned int LEVELDB_BLOCK_CACHE_SIZE_IN_MB{
+    ReadConstantNumeric("LEVELDB_BLOCK_CACHE_SIZE_IN_MB", "node.database.")};
+const unsigned int LEVELDB_BLOOM_FILTER_BITS_PER_KEY{
+    ReadConstantNumeric("LEVELDB_BLOOM_FILTER_BITS_PER_KEY", "node.database.")};
+const bool LEVELDB_COMPRESSION{
+    ReadConstantString("LEVELDB_COMPRESSION", "node.database.") == "true"};
+const unsigned int LEVELDB_WRITE_BUFFER_SIZE_IN_MB{
+    ReadConstantNumeric("LEVELDB_WRITE_BUFFER_SIZE_IN_MB", "node.database.")};
+const unsigned int LEVELDB_BATCH_WRITE_BUFFER_SIZE_IN_MB{ReadConstantNumeric(
+    "LEVELDB_BATCH_WRITE_BUFFER_SIZE_IN_MB", "node.database.")};
+
 // Dispatcher constants
 const string TXN_PATH{ReadConstantString("TXN_PATH", "node.dispatcher.")};
 const bool USE_REMOTE_TXN_CREATOR{
@@ -340,12 +354,20 @@ const unsigned int BLACKLIST_NUM_TO_POP{
     ReadConstantNumeric("BLACKLIST_NUM_TO_POP", "node.p2pcomm.")};
 const unsigned int MAX_PEER_CONNECTION{
     ReadConstantNumeric("MAX_PEER_CONNECTION", "node.p2pcomm.")};
+const bool ENABLE_CONNECTION_POOL{
+    ReadConstantString("ENABLE_CONNECTION_POOL", "node.p2pcomm.") == "true"};
+const unsigned int MAX_SEND_BUFFER_IN_BYTES{
+    ReadConstantNumeric("MAX_SEND_BUFFER_IN_BYTES", "node.p2pcomm.")};
+const unsigned int IDLE_CONNECTION_TIMEOUT_IN_SECONDS{
+    ReadConstantNumeric("IDLE_CONNECTION_TIMEOUT_IN_SECONDS", "node.p2pcomm.")};
 
 // PoW constants
 const bool CUDA_GPU_MINE{ReadConstantString("CUDA_GPU_MINE", "node.pow.") ==
                          "true"};
 const bool FULL_DATASET_MINE{
     ReadConstantString("FULL_DATASET_MINE", "node.pow.") == "true"};
+const unsigned int CPU_MINING_THREADS{
+    ReadConstantNumeric("CPU_MINING_THREADS", "node.pow.")};
 const bool OPENCL_GPU_MINE{ReadConstantString("OPENCL_GPU_MINE", "node.pow.") ==
                            "true"};
 const bool REMOTE_MINE{ReadConstantString("REMOTE_MINE", "node.pow.") ==
@@ -420,6 +442,14 @@ const unsigned int RESUME_BLACKLIST_DELAY_IN_SECONDS{
     ReadConstantNumeric("RESUME_BLACKLIST_DELAY_IN_SECONDS", "node.recovery.")};
 const unsigned int INCRDB_DSNUMS_WITH_STATEDELTAS{
     ReadConstantNumeric("INCRDB_DSNUMS_WITH_STATEDELTAS", "node.recovery.")};
+const unsigned int STATE_SYNC_CHUNK_NUM_ACCOUNTS{
+    ReadConstantNumeric("STATE_SYNC_CHUNK_NUM_ACCOUNTS", "node.recovery.")};
+const unsigned int STATE_SYNC_NUM_RANGES{
+    ReadConstantNumeric("STATE_SYNC_NUM_RANGES", "node.recovery.")};
+const unsigned int STATE_SYNC_PARALLEL_REQUESTS{
+    ReadConstantNumeric("STATE_SYNC_PARALLEL_REQUESTS", "node.recovery.")};
+const unsigned int STATE_SYNC_CHUNK_TIMEOUT_IN_SECONDS{ReadConstantNumeric(
+    "STATE_SYNC_CHUNK_TIMEOUT_IN_SECONDS", "node.recovery.")};
 
 // Smart contract constants
 const bool ENABLE_SC{ReadConstantString("ENABLE_SC", "node.smart_contract.") ==
@@ -460,6 +490,13 @@ const string INPUT_CODE{
 const bool ENABLE_SCILLA_MULTI_VERSION{
     ReadConstantString("ENABLE_SCILLA_MULTI_VERSION", "node.smart_contract.") ==
     "true"};
+const bool ENABLE_SCILLA_WORKER{
+    ReadConstantString("ENABLE_SCILLA_WORKER", "node.smart_contract.") ==
+    "true"};
+const string SCILLA_WORKER_SOCKET{
+    ReadConstantString("SCILLA_WORKER_SOCKET", "node.smart_contract.")};
+const unsigned int CONTRACT_CODE_CACHE_SIZE{
+    ReadConstantNumeric("CONTRACT_CODE_CACHE_SIZE", "node.smart_contract.")};
 
 // Test constants
 const bool ENABLE_CHECK_PERFORMANCE_LOG{
@@ -516,6 +553,13 @@ const unsigned int REPOPULATE_STATE_PER_N_DS{
 const unsigned int REPOPULATE_STATE_IN_DS{std::min(
     ReadConstantNumeric("REPOPULATE_STATE_IN_DS", "node.transactions."),
     REPOPULATE_STATE_PER_N_DS - 1)};
+const bool ENABLE_PARALLEL_PAYMENTS{
+    ReadConstantString("ENABLE_PARALLEL_PAYMENTS", "node.transactions.") ==
+    "true"};
+const unsigned int PAYMENT_BATCH_SIZE{
+    ReadConstantNumeric("PAYMENT_BATCH_SIZE", "node.transactions.")};
+const unsigned int ACCOUNT_CACHE_SIZE{
+    ReadConstantNumeric("ACCOUNT_CACHE_SIZE", "node.transactions.")};
 
 // Viewchange constants
 const unsigned int POST_VIEWCHANGE_BUFFER{
@@ -79,6 +79,7 @@ enum MetaType : unsigned char {
   WAKEUPFORUPGRADE,
   LATEST_EPOCH_STATES_UPDATED,  // [deprecated soon]
   EPOCHFIN,
+  STORAGEFORMAT,
 };
 
 // Sync Type
@@ -170,6 +171,14 @@ extern const unsigned int NUM_OF_TREEBASED_CHILD_CLUSTERS;
 extern const unsigned int POW_PACKET_SENDERS;
 extern const unsigned int TX_SHARING_CLUSTER_SIZE;
 
+// Database constants
+extern const unsigned int LEVELDB_MAX_OPEN_FILES;
+extern const unsigned int LEVELDB_BLOCK_CACHE_SIZE_IN_MB;
+extern const unsigned int LEVELDB_BLOOM_FILTER_BITS_PER_KEY;
+extern const bool LEVELDB_COMPRESSION;
+extern const unsigned int LEVELDB_WRITE_BUFFER_SIZE_IN_MB;
+extern const unsigned int LEVELDB_BATCH_WRITE_BUFFER_SIZE_IN_MB;
+
 // Dispatcher constants
 extern const bool USE_REMOTE_TXN_CREATOR;
 extern const std::string TXN_PATH;
@@ -280,10 +289,14 @@ extern const unsigned int MAX_READ_WATERMARK_IN_BYTES;
 extern const unsigned int CONNECTION_TIMEOUT_IN_SECONDS;
 extern const unsigned int BLACKLIST_NUM_TO_POP;
 extern const unsigned int MAX_PEER_CONNECTION;
+extern const bool ENABLE_CONNECTION_POOL;
+extern const unsigned int MAX_SEND_BUFFER_IN_BYTES;
+extern const unsigned int IDLE_CONNECTION_TIMEOUT_IN_SECONDS;
 
 // PoW constants
 extern const bool CUDA_GPU_MINE;
 extern const bool FULL_DATASET_MINE;
+extern const unsigned int CPU_MINING_THREADS;
 extern const bool OPENCL_GPU_MINE;
 extern const bool REMOTE_MINE;
 extern const std::string MINING_PROXY_URL;
@@ -321,6 +334,10 @@ extern const bool RECOVERY_TRIM_INCOMPLETED_BLOCK;
 extern const bool REJOIN_NODE_NOT_IN_NETWORK;
 extern const unsigned int RESUME_BLACKLIST_DELAY_IN_SECONDS;
 extern const unsigned int INCRDB_DSNUMS_WITH_STATEDELTAS;
+extern const unsigned int STATE_SYNC_CHUNK_NUM_ACCOUNTS;
+extern const unsigned int STATE_SYNC_NUM_RANGES;
+extern const unsigned int STATE_SYNC_PARALLEL_REQUESTS;
+extern const unsigned int STATE_SYNC_CHUNK_TIMEOUT_IN_SECONDS;
 
 // Smart contract constants
 extern const bool ENABLE_SC;
@@ -337,6 +354,9 @@ extern const std::string INPUT_MESSAGE_JSON;
 extern const std::string OUTPUT_JSON;
 extern const std::string INPUT_CODE;
 extern const bool ENABLE_SCILLA_MULTI_VERSION;
+extern const bool ENABLE_SCILLA_WORKER;
+extern const std::string SCILLA_WORKER_SOCKET;
+extern const unsigned int CONTRACT_CODE_CACHE_SIZE;
 
 // Test constants
 extern const bool ENABLE_CHECK_PERFORMANCE_LOG;
@@ -367,6 +387,9 @@ extern const unsigned int ACCOUNT_IO_BATCH_SIZE;
 extern const bool ENABLE_REPOPULATE;
 extern const unsigned int REPOPULATE_STATE_PER_N_DS;
 extern const unsigned int REPOPULATE_STATE_IN_DS;
+extern const bool ENABLE_PARALLEL_PAYMENTS;
+extern const unsigned int PAYMENT_BATCH_SIZE;
+extern const unsigned int ACCOUNT_CACHE_SIZE;
 
 // Viewchange constants
 extern const unsigned int POST_VIEWCHANGE_BUFFER;
@@ -90,7 +90,9 @@ enum LookupInstructionType : unsigned char {
   VCGETLATESTDSTXBLOCK = 0x1B,
   FORWARDTXN = 0x1C,
   GETGUARDNODENETWORKINFOUPDATE = 0x1D,
-  SETHISTORICALDB = 0x1E
+  SETHISTORICALDB = 0x1E,
+  GETSTATECHUNKFROMSEED = 0x1F,
+  SETSTATECHUNKFROMSEED = 0x20
 };
 
 enum TxSharingMode : unsigned char {
@@ -101,4 +103,60 @@ enum TxSharingMode : unsigned char {
   SEND_AND_FORWARD = 0x04
 };
 
+/// Classes of messages for the incoming and outgoing dispatchers, from the
+/// highest priority down.
+enum MessagePriority : unsigned char {
+  PRIORITY_CONSENSUS = 0x00,
+  PRIORITY_BLOCK = 0x01,
+  PRIORITY_TXN = 0x02,
+  PRIORITY_SYNC = 0x03,
+  NUM_MESSAGE_PRIORITIES = 0x04
+};
+
+/// Names of the message classes, for logging.
+const char* const MESSAGE_PRIORITY_NAMES[NUM_MESSAGE_PRIORITIES] = {
+    "Consensus", "Block", "Txn", "Sync"};
+
+/// Jobs each message class may take in a round of the dispatchers.
+const unsigned int MESSAGE_PRIORITY_WEIGHTS[NUM_MESSAGE_PRIORITIES] = {8, 4, 2,
+                                                                       1};
+
+/// Returns the class of a message of type and instruction. Transactions and
+/// PoW submissions share the bulk class; lookup and unknown messages are
+/// served last.
+inline MessagePriority GetMessagePriority(unsigned char type,
+                                          unsigned char instruction) {
+  switch (type) {
+    case MessageType::DIRECTORY:
+      switch (instruction) {
+        case DSInstructionType::DSBLOCKCONSENSUS:
+        case DSInstructionType::FINALBLOCKCONSENSUS:
+        case DSInstructionType::VIEWCHANGECONSENSUS:
+          return PRIORITY_CONSENSUS;
+        case DSInstructionType::POWSUBMISSION:
+        case DSInstructionType::POWPACKETSUBMISSION:
+          return PRIORITY_TXN;
+        default:
+          return PRIORITY_BLOCK;
+      }
+    case MessageType::NODE:
+      switch (instruction) {
+        case NodeInstructionType::MICROBLOCKCONSENSUS:
+        case NodeInstructionType::FALLBACKCONSENSUS:
+          return PRIORITY_CONSENSUS;
+        case NodeInstructionType::SUBMITTRANSACTION:
+        case NodeInstructionType::FORWARDTXNPACKET:
+        case NodeInstructionType::PROPOSEGASPRICE:
+          return PRIORITY_TXN;
+        default:
+          return PRIORITY_BLOCK;
+      }
+    case MessageType::LOOKUP:
+      return (instruction == LookupInstructionType::FORWARDTXN) ? PRIORITY_TXN
+                                                                : PRIORITY_SYNC;
+    default:
+      return PRIORITY_SYNC;
+  }
+}
+
 #endif  // ZILLIQA_SRC_COMMON_MESSAGES_H_
@@ -18,6 +18,8 @@
 #include <string>
 
 #include <boost/filesystem.hpp>
+#include <leveldb/cache.h>
+#include <leveldb/filter_policy.h>
 
 #include "LevelDB.h"
 #include "common/Constants.h"
@@ -28,10 +30,70 @@
 using namespace std;
 
 
-LevelDB::LevelDB(const string& dbName, const string& path, const string& subdirectory)
+namespace
+{
+    const size_t BYTES_PER_MB = 1024 * 1024;
+
+    // The cache and filter policy are never freed, as databases owned by
+    // other statics may still be open while statics are destroyed
+
+    leveldb::Cache* GetSharedBlockCache()
+    {
+        static leveldb::Cache* cache =
+            leveldb::NewLRUCache(LEVELDB_BLOCK_CACHE_SIZE_IN_MB * BYTES_PER_MB);
+        return cache;
+    }
+
+    const leveldb::FilterPolicy* GetBloomFilterPolicy()
+    {
+        if (LEVELDB_BLOOM_FILTER_BITS_PER_KEY == 0)
+        {
+            return nullptr;
+        }
+        static const leveldb::FilterPolicy* policy =
+            leveldb::NewBloomFilterPolicy(LEVELDB_BLOOM_FILTER_BITS_PER_KEY);
+        return policy;
+    }
+}
+
+leveldb::Options LevelDB::GetOptions() const
+{
+    leveldb::Options options;
+    options.max_open_files = LEVELDB_MAX_OPEN_FILES;
+    options.create_if_missing = true;
+    options.block_cache = GetSharedBlockCache();
+    options.compression = LEVELDB_COMPRESSION ? leveldb::kSnappyCompression
+                                              : leveldb::kNoCompression;
+    options.write_buffer_size = LEVELDB_WRITE_BUFFER_SIZE_IN_MB * BYTES_PER_MB;
+
+    switch (m_profile)
+    {
+        case LevelDBProfile::DEFAULT:
+            break;
+        case LevelDBProfile::POINT_LOOKUP:
+            options.filter_policy = GetBloomFilterPolicy();
+            break;
+        case LevelDBProfile::BATCH_WRITE:
+            options.filter_policy = GetBloomFilterPolicy();
+            options.write_buffer_size = LEVELDB_BATCH_WRITE_BUFFER_SIZE_IN_MB * BYTES_PER_MB;
+            break;
+    }
+
+    return options;
+}
+
+leveldb::ReadOptions LevelDB::ScanReadOptions()
+{
+    leveldb::ReadOptions options;
+    options.fill_cache = false;
+    return options;
+}
+
+LevelDB::LevelDB(const string& dbName, const string& path, const string& subdirectory, LevelDBProfile profile)
 {
     this->m_subdirectory = subdirectory;
     this->m_dbName = dbName;
+    this->m_profile = profile;
     this->m_db = NULL;
 
     if(!(boost::filesystem::exists(path)))
@@ -40,9 +102,7 @@ LevelDB::LevelDB(const string& dbName, const string& path, const string& subdire
         return;
     }
 
-    leveldb::Options options;
-    options.max_open_files = 256;
-    options.create_if_missing = true;
+    leveldb::Options options = GetOptions();
 
     leveldb::DB* db;
     leveldb::Status status;
@@ -72,14 +132,13 @@ LevelDB::LevelDB(const string& dbName, const string& path, const string& subdire
     m_db.reset(db);
 }
 
-LevelDB::LevelDB(const std::string & dbName, const std::string& subdirectory, bool diagnostic)
+LevelDB::LevelDB(const std::string & dbName, const std::string& subdirectory, bool diagnostic, LevelDBProfile profile)
 {
     this->m_subdirectory = subdirectory;
     this->m_dbName = dbName;
+    this->m_profile = profile;
 
-    leveldb::Options options;
-    options.max_open_files = 256;
-    options.create_if_missing = true;
+    leveldb::Options options = GetOptions();
 
     leveldb::DB* db;
     leveldb::Status status;
@@ -104,12 +163,101 @@ LevelDB::LevelDB(const std::string & dbName, const std::string& subdirectory, bo
     m_db.reset(db);
 }
 
-leveldb::Slice toSlice(boost::multiprecision::uint256_t num)
+string toBlockNumKey(const boost::multiprecision::uint256_t & blockNum)
+{
+    string key(BLOCKNUM_KEY_SIZE, '\0');
+    uint64_t num = blockNum.convert_to<uint64_t>();
+    for (int i = BLOCKNUM_KEY_SIZE - 1; i >= 0; i--)
+    {
+        key[i] = (char)(num & 0xFF);
+        num >>= 8;
+    }
+    return key;
+}
+
+bool fromBlockNumKey(const leveldb::Slice & key, uint64_t & blockNum)
 {
-    dev::FixedHash<32> h;
-    dev::bytesRef ref(h.data(), 32);
-    dev::toBigEndian(num, ref);
-    return (leveldb::Slice)h.ref();
+    if (key.size() != BLOCKNUM_KEY_SIZE)
+    {
+        return false;
+    }
+
+    blockNum = 0;
+    for (size_t i = 0; i < BLOCKNUM_KEY_SIZE; i++)
+    {
+        blockNum = (blockNum << 8) | (unsigned char)key.data()[i];
+    }
+    return true;
+}
+
+bool isHexHashKey(const leveldb::Slice & key)
+{
+    if (key.size() != dev::h256::size * 2)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < key.size(); i++)
+    {
+        const char c = key.data()[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LevelDB::SetHashKeyFormat(HashKeyFormat format)
+{
+    m_hashKeyFormat = format;
+}
+
+void LevelDB::DetectHashKeyFormat()
+{
+    if (!m_db)
+    {
+        return;
+    }
+
+    unique_ptr<leveldb::Iterator> it(m_db->NewIterator(ScanReadOptions()));
+    it->SeekToFirst();
+    if (it->Valid() && isHexHashKey(it->key()))
+    {
+        LOG_GENERAL(INFO, m_dbName << " is keyed by hashes in hex");
+        m_hashKeyFormat = HashKeyFormat::HEX;
+    }
+}
+
+leveldb::Slice LevelDB::HashKey(const dev::h256 & hash, string & buffer) const
+{
+    if (m_hashKeyFormat == HashKeyFormat::HEX)
+    {
+        buffer = hash.hex();
+        return leveldb::Slice(buffer);
+    }
+
+    return leveldb::Slice((char const*)hash.data(), dev::h256::size);
+}
+
+bool LevelDB::FromHashKey(const leveldb::Slice & key, dev::h256 & hash) const
+{
+    if (m_hashKeyFormat == HashKeyFormat::HEX)
+    {
+        if (!isHexHashKey(key))
+        {
+            return false;
+        }
+        hash = dev::h256(key.ToString());
+        return true;
+    }
+
+    if (key.size() != dev::h256::size)
+    {
+        return false;
+    }
+    hash = dev::h256(dev::bytesConstRef((const unsigned char*)key.data(), key.size()));
+    return true;
 }
 
 string LevelDB::GetDBName()
@@ -140,7 +288,7 @@ string LevelDB::Lookup(const std::string & key) const
 string LevelDB::Lookup(const boost::multiprecision::uint256_t & blockNum) const
 {
     string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), blockNum.convert_to<string>(), &value);
+    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), toBlockNumKey(blockNum), &value);
 
     if (!s.ok())
     {
@@ -154,7 +302,7 @@ string LevelDB::Lookup(const boost::multiprecision::uint256_t & blockNum) const
 string LevelDB::Lookup(const boost::multiprecision::uint256_t & blockNum, bool &found) const
 {
     string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), blockNum.convert_to<string>(), &value);
+    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), toBlockNumKey(blockNum), &value);
 
     if (!s.ok())
     {
@@ -167,8 +315,8 @@ string LevelDB::Lookup(const boost::multiprecision::uint256_t & blockNum, bool &
 
 string LevelDB::Lookup(const dev::h256 & key) const
 {
-    string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), leveldb::Slice(key.hex()), &value);
+    string value, buffer;
+    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), HashKey(key, buffer), &value);
     if (!s.ok())
     {
         // TODO
@@ -181,7 +329,7 @@ string LevelDB::Lookup(const dev::h256 & key) const
 string LevelDB::Lookup(const dev::bytesConstRef & key) const
 {
     string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), ldb::Slice((char const*)key.data(), 32),
+    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), ldb::Slice((char const*)key.data(), key.size()),
                                   &value);
     if (!s.ok())
     {
@@ -206,7 +354,7 @@ int LevelDB::Insert(const boost::multiprecision::uint256_t & blockNum,
                     const vector<unsigned char> & body)
 {
     leveldb::Status s = m_db->Put(leveldb::WriteOptions(),
-                                  leveldb::Slice(blockNum.convert_to<string>()),
+                                  leveldb::Slice(toBlockNumKey(blockNum)),
                                   leveldb::Slice(vector_ref<const unsigned char>(&body[0],
                                                                                  body.size())));
 
@@ -222,7 +370,7 @@ int LevelDB::Insert(const boost::multiprecision::uint256_t & blockNum,
                     const std::string & body)
 {
     leveldb::Status s = m_db->Put(leveldb::WriteOptions(),
-                                  leveldb::Slice(blockNum.convert_to<string>()),
+                                  leveldb::Slice(toBlockNumKey(blockNum)),
                                   leveldb::Slice(body.c_str(), body.size()));
 
     if (!s.ok())
@@ -251,8 +399,8 @@ int LevelDB::Insert(const leveldb::Slice & key, dev::bytesConstRef value)
 
 int LevelDB::Insert(const dev::h256 & key, const string & value)
 {
-    leveldb::Status s = m_db->Put(leveldb::WriteOptions(),
-                                  ldb::Slice((char const*)key.data(), key.size),
+    string buffer;
+    leveldb::Status s = m_db->Put(leveldb::WriteOptions(), HashKey(key, buffer),
                                   ldb::Slice(value.data(), value.size()));
     if (!s.ok())
     {
@@ -264,7 +412,8 @@ int LevelDB::Insert(const dev::h256 & key, const string & value)
 
 int LevelDB::Insert(const dev::h256 & key, const vector<unsigned char> & body)
 {
-    leveldb::Status s = m_db->Put(leveldb::WriteOptions(), leveldb::Slice(key.hex()),
+    string buffer;
+    leveldb::Status s = m_db->Put(leveldb::WriteOptions(), HashKey(key, buffer),
                                   leveldb::Slice(vector_ref<const unsigned char>(&body[0],
                                                                                  body.size())));
     if (!s.ok())
@@ -290,12 +439,13 @@ int LevelDB::BatchInsert(std::unordered_map<dev::h256, std::pair<std::string, un
                          std::unordered_map<dev::h256, std::pair<dev::bytes, bool>> & m_aux)
 {
     ldb::WriteBatch batch;
+    string buffer;
 
     for (const auto & i: m_main)
     {
         if (i.second.second)
         {
-            batch.Put(leveldb::Slice(i.first.hex()),
+            batch.Put(HashKey(i.first, buffer),
                       leveldb::Slice(i.second.first.data(), i.second.first.size()));
         }
     }
@@ -362,7 +512,8 @@ bool LevelDB::Exists(const std::string & key) const
 
 int LevelDB::DeleteKey(const dev::h256 & key)
 {
-    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), ldb::Slice(key.hex()));
+    string buffer;
+    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), HashKey(key, buffer));
     if (!s.ok())
     {
         return -1;
@@ -373,7 +524,7 @@ int LevelDB::DeleteKey(const dev::h256 & key)
 
 int LevelDB::DeleteKey(const boost::multiprecision::uint256_t & blockNum)
 {
-    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), ldb::Slice(blockNum.convert_to<string>()));
+    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), ldb::Slice(toBlockNumKey(blockNum)));
     if (!s.ok())
     {
         return -1;
@@ -421,9 +572,7 @@ bool LevelDB::RefreshDB()
 {
     m_db.reset();
 
-    leveldb::Options options;
-    options.max_open_files = 256;
-    options.create_if_missing = true;
+    leveldb::Options options = GetOptions();
 
     leveldb::DB* db;
 
@@ -465,9 +614,7 @@ bool LevelDB::ResetDBForNormalNode()
     {
         boost::filesystem::remove_all(STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName);
 
-        leveldb::Options options;
-        options.max_open_files = 256;
-        options.create_if_missing = true;
+        leveldb::Options options = GetOptions();
 
         leveldb::DB* db;
 
@@ -509,9 +656,7 @@ bool LevelDB::ResetDBForLookupNode()
     {
         boost::filesystem::remove_all(STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName);
 
-        leveldb::Options options;
-        options.max_open_files = 256;
-        options.create_if_missing = true;
+        leveldb::Options options = GetOptions();
 
         leveldb::DB* db;
 
@@ -30,7 +30,42 @@
 #include "depends/common/FixedHash.h"
 //#include "libUtils/Logger.h"
 
-leveldb::Slice toSlice(boost::multiprecision::uint256_t num);
+/// Size of the keys of block number keyed records.
+const size_t BLOCKNUM_KEY_SIZE = 8;
+
+/// Returns the key of a block number keyed record: the number in fixed width
+/// big-endian, so that records are iterated in ascending block number order
+/// and a range of blocks can be read with a single seek.
+std::string toBlockNumKey(const boost::multiprecision::uint256_t & blockNum);
+
+/// Recovers the block number from a key made by toBlockNumKey.
+bool fromBlockNumKey(const leveldb::Slice & key, uint64_t & blockNum);
+
+/// Returns true if key is a hash in hex, the way hash keyed records were keyed
+/// before storage format 2.
+bool isHexHashKey(const leveldb::Slice & key);
+
+/// How the records keyed by dev::h256 are keyed on disk.
+enum class HashKeyFormat : unsigned char
+{
+    /// The 32 bytes of the hash
+    BINARY,
+    /// The hash in hex, as in databases written before storage format 2
+    HEX
+};
+
+/// Tuning profiles for the ways databases are accessed. All databases share
+/// one block cache; the profile decides the rest of the leveldb options.
+enum class LevelDBProfile : unsigned char
+{
+    /// Small or mostly iterated databases
+    DEFAULT,
+    /// Random reads by key, many of them for missing keys: adds a bloom filter
+    POINT_LOOKUP,
+    /// Random reads by key, written in large batches: adds a bloom filter and
+    /// a larger write buffer
+    BATCH_WRITE
+};
 
 /// Utility class for providing database-type storage.
 class LevelDB
@@ -39,13 +74,22 @@ class LevelDB
 
     std::string m_subdirectory;
 
+    LevelDBProfile m_profile;
+
+    HashKeyFormat m_hashKeyFormat{HashKeyFormat::BINARY};
+
     std::shared_ptr<leveldb::DB> m_db;
 
+    /// Returns the options to open the database with, according to m_profile.
+    leveldb::Options GetOptions() const;
+
 public:
 
     /// Constructor.
-    explicit LevelDB(const std::string & dbName, const std::string& subdirectory = "", bool diagnostic = false);
-    explicit LevelDB(const std::string& dbName, const std::string& path, const std::string& subdirectory = "");
+    explicit LevelDB(const std::string & dbName, const std::string& subdirectory = "", bool diagnostic = false,
+                     LevelDBProfile profile = LevelDBProfile::DEFAULT);
+    explicit LevelDB(const std::string& dbName, const std::string& path, const std::string& subdirectory = "",
+                     LevelDBProfile profile = LevelDBProfile::DEFAULT);
     /// Destructor.
     ~LevelDB() = default;
 
@@ -55,6 +99,25 @@ public:
     /// Returns the DB Name
     std::string GetDBName();
 
+    /// Returns the read options for scans over much of a database, which
+    /// should not evict the blocks of point lookups from the shared cache.
+    static leveldb::ReadOptions ScanReadOptions();
+
+    /// Sets how the records keyed by dev::h256 are keyed on disk.
+    void SetHashKeyFormat(HashKeyFormat format);
+
+    /// Switches to HashKeyFormat::HEX if the first record is keyed by a hash in
+    /// hex, for databases that come from elsewhere (e.g. historical databases)
+    /// and may predate storage format 2.
+    void DetectHashKeyFormat();
+
+    /// Returns the key of the record of hash. Binary keys point into hash;
+    /// hex keys are written into buffer.
+    leveldb::Slice HashKey(const dev::h256 & hash, std::string & buffer) const;
+
+    /// Recovers the hash from a key made by HashKey.
+    bool FromHashKey(const leveldb::Slice & key, dev::h256 & hash) const;
+
     /// Returns the value at the specified key.
     std::string Lookup(const std::string & key) const;
 
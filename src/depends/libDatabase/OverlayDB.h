@@ -33,7 +33,7 @@ namespace dev
 	class OverlayDB: public MemoryDB
 	{
 	public:
-		explicit OverlayDB(const std::string & dbName): m_levelDB(dbName) {}
+		explicit OverlayDB(const std::string & dbName): m_levelDB(dbName, "", false, LevelDBProfile::BATCH_WRITE) {}
 		~OverlayDB() = default;
 
 		void ResetDB();
@@ -19,7 +19,15 @@
 #ifndef __TRIEDB_H__
 #define __TRIEDB_H__
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "depends/common/Exceptions.h"
 #include "depends/common/SHA3.h"
@@ -145,6 +153,15 @@ namespace dev
         void remove(bytes const& _key) { remove(&_key); }
         void remove(bytesConstRef _key);
 
+        /// Applies a batch of updates: a non-empty value inserts, an empty one removes.
+        /// The nodes on the touched paths are decoded into memory once, all updates are
+        /// applied there, and each resulting node is encoded and hashed once, instead of
+        /// rehashing every node on the path for every key. Gives the same root as
+        /// applying the updates one by one; sorted keys keep the touched paths local.
+        /// With _threads > 1 the subtrees under a root branch are rebuilt and hashed
+        /// concurrently.
+        void update(std::vector<std::pair<bytesConstRef, bytesConstRef>> const& _updates, unsigned _threads = 1);
+
         bool contains(bytes const& _key) const { return contains(&_key); }
         bool contains(bytesConstRef _key) const { return !at(_key).empty(); }
 
@@ -274,6 +291,45 @@ namespace dev
         DB* db() { return m_db; }
 
     private:
+        /// A node being rebuilt by update(). Subtrees that no update reaches stay Ref,
+        /// holding the RLP item (hash or inline node) they were referenced by.
+        struct BatchNode
+        {
+            enum Kind { Leaf, Extension, Branch, Ref };
+
+            Kind kind;
+            bytes key;      // nibbles, for Leaf and Extension
+            bytes value;    // for Leaf, and the value slot of Branch
+            bytes ref;      // for Ref
+            std::unique_ptr<BatchNode> child;                       // for Extension
+            std::array<std::unique_ptr<BatchNode>, 16> children;    // for Branch
+
+            explicit BatchNode(Kind _kind): kind(_kind) {}
+        };
+        using BatchNodePtr = std::unique_ptr<BatchNode>;
+        /// DB writes made off the calling thread, for it to apply after: the DB is not
+        /// safe for concurrent writes.
+        struct BatchWrites
+        {
+            std::vector<h256> killed;
+            std::vector<std::pair<h256, bytes>> inserted;
+        };
+
+        static BatchNodePtr batchLeaf(bytes _key, bytes _value);
+        static BatchNodePtr batchExtension(bytes _key, BatchNodePtr _child);
+        static BatchNodePtr batchRef(RLP const& _item);
+        BatchNodePtr batchDecode(RLP const& _n) const;
+        void batchExpand(BatchNodePtr& _n, BatchWrites* _writes);
+        void batchApply(BatchNodePtr& _n, bytes const& _key, unsigned _offset, bytesConstRef _value, BatchWrites* _writes);
+        void batchInsert(BatchNodePtr& _n, bytes const& _key, unsigned _offset, bytesConstRef _value, BatchWrites* _writes);
+        void batchRemove(BatchNodePtr& _n, bytes const& _key, unsigned _offset, BatchWrites* _writes);
+        void batchNormalize(BatchNodePtr& _n, BatchWrites* _writes);
+        bytes batchEncode(BatchNode const& _n, BatchWrites* _writes);
+        void batchStreamChild(RLPStream& _s, BatchNodePtr const& _n, BatchWrites* _writes);
+        void batchUpdateParallel(BatchNodePtr& _root, std::vector<std::pair<bytes, bytesConstRef>> const& _updates, unsigned _threads);
+        bytes batchEncodeParallel(BatchNode const& _n, unsigned _threads);
+        static void batchForEachChild(unsigned _threads, std::function<void(unsigned)> const& _f);
+
         RLPStream& streamNode(RLPStream& _s, bytes const& _b);
 
         std::string atAux(RLP const& _here, NibbleSlice _key) const;
@@ -386,6 +442,17 @@ namespace dev
         }
         void remove(KeyType _k) { Generic::remove(bytesConstRef((byte const*)&_k, sizeof(KeyType))); }
 
+        /// Applies the updates together, an empty value removing the key. See
+        /// GenericTrieDB::update.
+        void update(std::map<KeyType, bytes> const& _updates, unsigned _threads = 1)
+        {
+            std::vector<std::pair<bytesConstRef, bytesConstRef>> updates;
+            updates.reserve(_updates.size());
+            for (auto const& u: _updates)
+                updates.emplace_back(bytesConstRef((byte const*)&u.first, sizeof(KeyType)), bytesConstRef(&u.second));
+            Generic::update(updates, _threads);
+        }
+
         class iterator: public Generic::iterator
         {
         public:
@@ -868,6 +935,413 @@ namespace dev
         m_root = forceInsertNode(&b);
     }
 
+    template <class DB> void GenericTrieDB<DB>::update(std::vector<std::pair<bytesConstRef, bytesConstRef>> const& _updates, unsigned _threads)
+    {
+        if (_updates.empty())
+            return;
+
+        std::string rootValue = node(m_root);
+
+        if(rootValue.size() == 0)
+        {
+            LOG_GENERAL(FATAL,
+                        "assertion failed (" << __FILE__ << ":" << __LINE__ << ": "
+                                             << __FUNCTION__ << ")");
+        }
+
+        // The root is always looked up via its hash, whatever its size.
+        BatchNodePtr root = batchDecode(RLP(rootValue));
+        forceKillNode(m_root);
+
+        std::vector<std::pair<bytes, bytesConstRef>> updates;
+        updates.reserve(_updates.size());
+        for (auto const& u: _updates)
+        {
+            bytes key(u.first.size() * 2);
+            for (unsigned i = 0; i < key.size(); ++i)
+                key[i] = nibble(u.first, i);
+            updates.emplace_back(std::move(key), u.second);
+        }
+
+        if (_threads > 1 && root && root->kind == BatchNode::Branch)
+            batchUpdateParallel(root, updates, _threads);
+        else
+            for (auto const& u: updates)
+                batchApply(root, u.first, 0, u.second, nullptr);
+
+        bytes b;
+        if (!root)
+            b = RLPNull;
+        else if (_threads > 1 && root->kind == BatchNode::Branch)
+            b = batchEncodeParallel(*root, _threads);
+        else
+            b = batchEncode(*root, nullptr);
+        m_root = forceInsertNode(&b);
+    }
+
+    template <class DB> typename GenericTrieDB<DB>::BatchNodePtr GenericTrieDB<DB>::batchLeaf(bytes _key, bytes _value)
+    {
+        BatchNodePtr ret(new BatchNode(BatchNode::Leaf));
+        ret->key = std::move(_key);
+        ret->value = std::move(_value);
+        return ret;
+    }
+
+    template <class DB> typename GenericTrieDB<DB>::BatchNodePtr GenericTrieDB<DB>::batchExtension(bytes _key, BatchNodePtr _child)
+    {
+        BatchNodePtr ret(new BatchNode(BatchNode::Extension));
+        ret->key = std::move(_key);
+        ret->child = std::move(_child);
+        return ret;
+    }
+
+    template <class DB> typename GenericTrieDB<DB>::BatchNodePtr GenericTrieDB<DB>::batchRef(RLP const& _item)
+    {
+        if (_item.isEmpty())
+            return nullptr;
+        BatchNodePtr ret(new BatchNode(BatchNode::Ref));
+        ret->ref = _item.data().toBytes();
+        return ret;
+    }
+
+    template <class DB> typename GenericTrieDB<DB>::BatchNodePtr GenericTrieDB<DB>::batchDecode(RLP const& _n) const
+    {
+        if (_n.isEmpty() || _n.isNull())
+            return nullptr;
+
+        unsigned itemCount = _n.itemCount();
+
+        if(!_n.isList() || (itemCount != 2 && itemCount != 17))
+        {
+            LOG_GENERAL(FATAL,
+                        "assertion failed (" << __FILE__ << ":" << __LINE__ << ": "
+                                             << __FUNCTION__ << ")");
+        }
+
+        if (itemCount == 2)
+        {
+            NibbleSlice k = keyOf(_n);
+            bytes key(k.size());
+            for (unsigned i = 0; i < k.size(); ++i)
+                key[i] = k[i];
+
+            if (isLeaf(_n))
+                return batchLeaf(std::move(key), _n[1].toBytes());
+            return batchExtension(std::move(key), batchRef(_n[1]));
+        }
+
+        BatchNodePtr ret(new BatchNode(BatchNode::Branch));
+        for (unsigned i = 0; i < 16; ++i)
+            ret->children[i] = batchRef(_n[i]);
+        ret->value = _n[16].toBytes();
+        return ret;
+    }
+
+    template <class DB> void GenericTrieDB<DB>::batchExpand(BatchNodePtr& _n, BatchWrites* _writes)
+    {
+        if (!_n || _n->kind != BatchNode::Ref)
+            return;
+
+        RLP item(_n->ref);
+        if (item.isList())
+        {
+            _n = batchDecode(item);
+            return;
+        }
+
+        // A hashed node is replaced by whatever it is rebuilt into.
+        h256 h = item.toHash<h256>();
+        std::string s = node(h);
+
+        if(s.empty())
+        {
+            LOG_GENERAL(FATAL,
+                        "assertion failed (" << __FILE__ << ":" << __LINE__ << ": "
+                                             << __FUNCTION__ << ")");
+        }
+
+        if (_writes)
+            _writes->killed.push_back(h);
+        else
+            forceKillNode(h);
+        _n = batchDecode(RLP(s));
+    }
+
+    template <class DB> void GenericTrieDB<DB>::batchApply(BatchNodePtr& _n, bytes const& _key, unsigned _offset, bytesConstRef _value, BatchWrites* _writes)
+    {
+        if (_value.empty())
+            batchRemove(_n, _key, _offset, _writes);
+        else
+            batchInsert(_n, _key, _offset, _value, _writes);
+    }
+
+    template <class DB> void GenericTrieDB<DB>::batchInsert(BatchNodePtr& _n, bytes const& _key, unsigned _offset, bytesConstRef _value, BatchWrites* _writes)
+    {
+        batchExpand(_n, _writes);
+
+        if (!_n)
+        {
+            _n = batchLeaf(bytes(_key.begin() + _offset, _key.end()), _value.toBytes());
+            return;
+        }
+
+        if (_n->kind == BatchNode::Branch)
+        {
+            if (_offset == _key.size())
+                _n->value = _value.toBytes();
+            else
+                batchInsert(_n->children[_key[_offset]], _key, _offset + 1, _value, _writes);
+            return;
+        }
+
+        // Leaf or extension: length of the shared start of its key and ours.
+        bytes const& k = _n->key;
+        unsigned shared = 0;
+        while (shared < k.size() && _offset + shared < _key.size() && k[shared] == _key[_offset + shared])
+            ++shared;
+
+        if (shared == k.size())
+        {
+            if (_n->kind == BatchNode::Leaf)
+            {
+                if (_offset + shared == _key.size())
+                {
+                    _n->value = _value.toBytes();
+                    return;
+                }
+            }
+            else
+            {
+                batchInsert(_n->child, _key, _offset + shared, _value, _writes);
+                return;
+            }
+        }
+
+        // Split at the first differing nibble: a branch, under an extension for the
+        // shared part if there is one.
+        BatchNodePtr branch(new BatchNode(BatchNode::Branch));
+        BatchNodePtr old = std::move(_n);
+        bytes prefix(old->key.begin(), old->key.begin() + shared);
+        if (shared == old->key.size())
+            branch->value = std::move(old->value);  // a leaf ending here
+        else
+        {
+            byte i = old->key[shared];
+            bytes rest(old->key.begin() + shared + 1, old->key.end());
+            if (old->kind == BatchNode::Leaf)
+                branch->children[i] = batchLeaf(std::move(rest), std::move(old->value));
+            else if (rest.empty())
+                branch->children[i] = std::move(old->child);
+            else
+                branch->children[i] = batchExtension(std::move(rest), std::move(old->child));
+        }
+        batchInsert(branch, _key, _offset + shared, _value, _writes);
+
+        _n = prefix.empty() ? std::move(branch) : batchExtension(std::move(prefix), std::move(branch));
+    }
+
+    template <class DB> void GenericTrieDB<DB>::batchRemove(BatchNodePtr& _n, bytes const& _key, unsigned _offset, BatchWrites* _writes)
+    {
+        batchExpand(_n, _writes);
+
+        if (!_n)
+            return;
+
+        if (_n->kind == BatchNode::Branch)
+        {
+            if (_offset == _key.size())
+                _n->value.clear();
+            else
+                batchRemove(_n->children[_key[_offset]], _key, _offset + 1, _writes);
+            batchNormalize(_n, _writes);
+            return;
+        }
+
+        bytes const& k = _n->key;
+        if (_key.size() - _offset < k.size() || !std::equal(k.begin(), k.end(), _key.begin() + _offset))
+            return;     // not found
+
+        if (_n->kind == BatchNode::Leaf)
+        {
+            if (_offset + k.size() == _key.size())
+                _n.reset();
+            return;
+        }
+
+        batchRemove(_n->child, _key, _offset + k.size(), _writes);
+        batchNormalize(_n, _writes);
+    }
+
+    template <class DB> void GenericTrieDB<DB>::batchNormalize(BatchNodePtr& _n, BatchWrites* _writes)
+    {
+        if (_n->kind == BatchNode::Extension)
+        {
+            if (!_n->child)
+            {
+                _n.reset();
+                return;
+            }
+
+            // An extension can only lead to a branch; join it with anything else.
+            batchExpand(_n->child, _writes);
+            if (_n->child->kind == BatchNode::Branch)
+                return;
+
+            BatchNodePtr child = std::move(_n->child);
+            bytes key = std::move(_n->key);
+            key.insert(key.end(), child->key.begin(), child->key.end());
+            if (child->kind == BatchNode::Leaf)
+                _n = batchLeaf(std::move(key), std::move(child->value));
+            else
+                _n = batchExtension(std::move(key), std::move(child->child));
+            return;
+        }
+
+        if (_n->kind != BatchNode::Branch)
+            return;
+
+        unsigned used = 16;
+        unsigned count = 0;
+        for (unsigned i = 0; i < 16; ++i)
+            if (_n->children[i])
+            {
+                used = i;
+                ++count;
+            }
+
+        if (count > 1 || (count == 1 && !_n->value.empty()))
+            return;
+
+        if (count == 0)
+        {
+            // Only the value (if any) is left.
+            if (_n->value.empty())
+                _n.reset();
+            else
+                _n = batchLeaf(bytes(), std::move(_n->value));
+            return;
+        }
+
+        // A branch with a single child becomes an extension of it, joined with the
+        // child if that is not a branch.
+        BatchNodePtr ext = batchExtension(bytes(1, (byte)used), std::move(_n->children[used]));
+        _n = std::move(ext);
+        batchNormalize(_n, _writes);
+    }
+
+    template <class DB> bytes GenericTrieDB<DB>::batchEncode(BatchNode const& _n, BatchWrites* _writes)
+    {
+        switch (_n.kind)
+        {
+        case BatchNode::Leaf:
+            return rlpList(hexPrefixEncode(_n.key, true), _n.value);
+        case BatchNode::Extension:
+        {
+            RLPStream s(2);
+            s << hexPrefixEncode(_n.key, false);
+            batchStreamChild(s, _n.child, _writes);
+            return s.out();
+        }
+        case BatchNode::Branch:
+        {
+            RLPStream r(17);
+            for (unsigned i = 0; i < 16; ++i)
+                batchStreamChild(r, _n.children[i], _writes);
+            r << _n.value;
+            return r.out();
+        }
+        case BatchNode::Ref:
+            break;
+        }
+        return _n.ref;
+    }
+
+    template <class DB> void GenericTrieDB<DB>::batchUpdateParallel(BatchNodePtr& _root, std::vector<std::pair<bytes, bytesConstRef>> const& _updates, unsigned _threads)
+    {
+        // The updates under each child of the root branch touch a subtree of their own,
+        // so the children are rebuilt concurrently and the root is normalised after.
+        std::array<std::vector<size_t>, 16> children;
+        for (size_t i = 0; i < _updates.size(); ++i)
+        {
+            bytes const& key = _updates[i].first;
+            if (key.empty())
+                _root->value = _updates[i].second.toBytes();
+            else
+                children[key[0]].push_back(i);
+        }
+
+        std::array<BatchWrites, 16> writes;
+        batchForEachChild(_threads, [&](unsigned c)
+        {
+            for (size_t i: children[c])
+                batchApply(_root->children[c], _updates[i].first, 1, _updates[i].second, &writes[c]);
+        });
+
+        for (auto const& w: writes)
+            for (auto const& h: w.killed)
+                forceKillNode(h);
+        batchNormalize(_root, nullptr);
+    }
+
+    template <class DB> bytes GenericTrieDB<DB>::batchEncodeParallel(BatchNode const& _n, unsigned _threads)
+    {
+        std::array<RLPStream, 16> items;
+        std::array<BatchWrites, 16> writes;
+        batchForEachChild(_threads, [&](unsigned c)
+        {
+            batchStreamChild(items[c], _n.children[c], &writes[c]);
+        });
+
+        RLPStream r(17);
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            for (auto const& n: writes[i].inserted)
+                forceInsertNode(n.first, &n.second);
+            r.appendRaw(items[i].out());
+        }
+        r << _n.value;
+        return r.out();
+    }
+
+    template <class DB> void GenericTrieDB<DB>::batchForEachChild(unsigned _threads, std::function<void(unsigned)> const& _f)
+    {
+        std::atomic<unsigned> next{0};
+        auto work = [&]()
+        {
+            for (unsigned c = next++; c < 16; c = next++)
+                _f(c);
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < std::min(_threads, 16u); ++t)
+            workers.emplace_back(work);
+        work();
+        for (auto& w: workers)
+            w.join();
+    }
+
+    template <class DB> void GenericTrieDB<DB>::batchStreamChild(RLPStream& _s, BatchNodePtr const& _n, BatchWrites* _writes)
+    {
+        if (!_n)
+            _s << "";
+        else if (_n->kind == BatchNode::Ref)
+            _s.appendRaw(_n->ref);
+        else if (!_writes)
+            streamNode(_s, batchEncode(*_n, nullptr));
+        else
+        {
+            bytes b = batchEncode(*_n, _writes);
+            if (b.size() < 32)
+                _s.appendRaw(b);
+            else
+            {
+                h256 h = sha3(b);
+                _s.append(h);
+                _writes->inserted.emplace_back(h, std::move(b));
+            }
+        }
+    }
+
     template <class DB> std::string GenericTrieDB<DB>::at(bytesConstRef _key) const
     {
         return atAux(RLP(node(m_root)), _key);
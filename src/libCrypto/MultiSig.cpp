@@ -15,6 +15,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "MultiSig.h"
 #include "Sha2.h"
 #include "libUtils/Logger.h"
@@ -448,6 +450,12 @@ void Challenge::Set(const CommitPoint& aggregatedCommit,
     return;
   }
 
+  shared_ptr<const EC_POINT> pubkeyPoint = aggregatedPubkey.GetPoint();
+  if (pubkeyPoint == nullptr) {
+    LOG_GENERAL(WARNING, "Invalid aggregated public key");
+    return;
+  }
+
   // Compute the challenge c = H(r, kpub, m)
 
   SHA2<HashType::HASH_VARIANT_256> sha2;
@@ -486,7 +494,7 @@ void Challenge::Set(const CommitPoint& aggregatedCommit,
   fill(buf.begin(), buf.end(), 0x00);
 
   // Convert the public key to octets
-  if (EC_POINT_point2oct(curve.m_group.get(), aggregatedPubkey.m_P.get(),
+  if (EC_POINT_point2oct(curve.m_group.get(), pubkeyPoint.get(),
                          POINT_CONVERSION_COMPRESSED, buf.data(),
                          Schnorr::PUBKEY_COMPRESSED_SIZE_BYTES,
                          NULL) != Schnorr::PUBKEY_COMPRESSED_SIZE_BYTES) {
@@ -673,23 +681,149 @@ shared_ptr<PubKey> MultiSig::AggregatePubKeys(const vector<PubKey>& pubkeys) {
     return nullptr;
   }
 
-  shared_ptr<PubKey> aggregatedPubkey(new PubKey(pubkeys.at(0)));
-  if (aggregatedPubkey == nullptr) {
+  unique_ptr<EC_POINT, void (*)(EC_POINT*)> aggregatedPoint(
+      EC_POINT_new(curve.m_group.get()), EC_POINT_clear_free);
+  if (aggregatedPoint == nullptr) {
     LOG_GENERAL(WARNING, "Memory allocation failure");
     // throw exception();
     return nullptr;
   }
 
-  for (unsigned int i = 1; i < pubkeys.size(); i++) {
-    if (EC_POINT_add(curve.m_group.get(), aggregatedPubkey->m_P.get(),
-                     aggregatedPubkey->m_P.get(), pubkeys.at(i).m_P.get(),
-                     NULL) == 0) {
+  for (const auto& pubkey : pubkeys) {
+    shared_ptr<const EC_POINT> point = pubkey.GetPoint();
+    if ((point == nullptr) ||
+        (EC_POINT_add(curve.m_group.get(), aggregatedPoint.get(),
+                      aggregatedPoint.get(), point.get(), NULL) == 0)) {
       LOG_GENERAL(WARNING, "Pubkey aggregation failed");
       return nullptr;
     }
   }
 
-  return aggregatedPubkey;
+  return make_shared<PubKey>(aggregatedPoint.get());
+}
+
+/// Adds to sum the points of the keys whose bit in the bitmap is selected.
+static bool AddKeyPoints(const Curve& curve, const vector<PubKey>& keys,
+                         const vector<bool>& bitmap, bool selected,
+                         EC_POINT* sum) {
+  for (unsigned int i = 0; i < keys.size(); i++) {
+    if (bitmap.at(i) != selected) {
+      continue;
+    }
+    shared_ptr<const EC_POINT> point = keys.at(i).GetPoint();
+    if ((point == nullptr) ||
+        (EC_POINT_add(curve.m_group.get(), sum, sum, point.get(), NULL) ==
+         0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+shared_ptr<const EC_POINT> MultiSig::GetCommitteeAggregate(
+    const vector<PubKey>& committee) {
+  bytes serialized;
+  serialized.reserve(committee.size() * PUB_KEY_SIZE);
+  for (const auto& pubkey : committee) {
+    serialized.insert(serialized.end(), pubkey.GetBytes().begin(),
+                      pubkey.GetBytes().end());
+  }
+  SHA2<HashType::HASH_VARIANT_256> sha2;
+  sha2.Update(serialized);
+  const bytes committeeHash = sha2.Finalize();
+
+  auto findCommittee = [this, &committeeHash]() {
+    return find_if(m_committeeKeys.begin(), m_committeeKeys.end(),
+                   [&committeeHash](const auto& entry) {
+                     return entry.first == committeeHash;
+                   });
+  };
+
+  {
+    lock_guard<mutex> g(m_mutexCommitteeKeys);
+    auto it = findCommittee();
+    if (it != m_committeeKeys.end()) {
+      m_committeeKeys.splice(m_committeeKeys.begin(), m_committeeKeys, it);
+      return it->second;
+    }
+  }
+
+  // Summed outside the lock so that lookups for other committees proceed
+  const Curve& curve = Schnorr::GetInstance().GetCurve();
+  shared_ptr<EC_POINT> committeePoint(EC_POINT_new(curve.m_group.get()),
+                                      EC_POINT_clear_free);
+  if (committeePoint == nullptr) {
+    LOG_GENERAL(WARNING, "Memory allocation failure");
+    return nullptr;
+  }
+  if (!AddKeyPoints(curve, committee, vector<bool>(committee.size(), true),
+                    true, committeePoint.get())) {
+    LOG_GENERAL(WARNING, "Committee key aggregation failed");
+    return nullptr;
+  }
+
+  lock_guard<mutex> g(m_mutexCommitteeKeys);
+  auto it = findCommittee();
+  if (it != m_committeeKeys.end()) {
+    m_committeeKeys.splice(m_committeeKeys.begin(), m_committeeKeys, it);
+    return it->second;
+  }
+  m_committeeKeys.emplace_front(committeeHash, committeePoint);
+  if (m_committeeKeys.size() > COMMITTEE_KEY_CACHE_SIZE) {
+    m_committeeKeys.pop_back();
+  }
+  return committeePoint;
+}
+
+shared_ptr<PubKey> MultiSig::AggregateCommitteeKeys(
+    const vector<PubKey>& committee, const vector<bool>& bitmap) {
+  if (committee.size() != bitmap.size()) {
+    LOG_GENERAL(WARNING, "Committee size " << committee.size()
+                                           << " != bitmap size "
+                                           << bitmap.size());
+    return nullptr;
+  }
+
+  const size_t signers = count(bitmap.begin(), bitmap.end(), true);
+  if (signers == 0) {
+    LOG_GENERAL(WARNING, "Empty list of public keys");
+    return nullptr;
+  }
+
+  const Curve& curve = Schnorr::GetInstance().GetCurve();
+  unique_ptr<EC_POINT, void (*)(EC_POINT*)> aggregatedPoint(
+      EC_POINT_new(curve.m_group.get()), EC_POINT_clear_free);
+  if (aggregatedPoint == nullptr) {
+    LOG_GENERAL(WARNING, "Memory allocation failure");
+    return nullptr;
+  }
+
+  // Starting from the whole committee only pays off when fewer members are
+  // left out than signed
+  shared_ptr<const EC_POINT> committeePoint;
+  if (signers > committee.size() - signers) {
+    committeePoint = GetCommitteeAggregate(committee);
+  }
+
+  bool aggregated = false;
+  if (committeePoint == nullptr) {
+    aggregated = AddKeyPoints(curve, committee, bitmap, true,
+                              aggregatedPoint.get());
+  } else {
+    aggregated =
+        AddKeyPoints(curve, committee, bitmap, false, aggregatedPoint.get()) &&
+        (EC_POINT_invert(curve.m_group.get(), aggregatedPoint.get(), NULL) !=
+         0) &&
+        (EC_POINT_add(curve.m_group.get(), aggregatedPoint.get(),
+                      aggregatedPoint.get(), committeePoint.get(),
+                      NULL) != 0);
+  }
+  if (!aggregated) {
+    LOG_GENERAL(WARNING, "Pubkey aggregation failed");
+    return nullptr;
+  }
+
+  return make_shared<PubKey>(aggregatedPoint.get());
 }
 
 shared_ptr<CommitPoint> MultiSig::AggregateCommits(
@@ -808,6 +942,12 @@ bool MultiSig::VerifyResponse(const Response& response,
       return false;
     }
 
+    shared_ptr<const EC_POINT> pubkeyPoint = pubkey.GetPoint();
+    if (pubkeyPoint == nullptr) {
+      LOG_GENERAL(WARNING, "Invalid public key");
+      return false;
+    }
+
     const Curve& curve = Schnorr::GetInstance().GetCurve();
 
     // The algorithm to check whether the commit point generated from its
@@ -831,9 +971,9 @@ bool MultiSig::VerifyResponse(const Response& response,
       }
 
       // 2. Compute Q = sG + r*kpub
-      err =
-          (EC_POINT_mul(curve.m_group.get(), Q.get(), response.m_r.get(),
-                        pubkey.m_P.get(), challenge.m_c.get(), ctx.get()) == 0);
+      err = (EC_POINT_mul(curve.m_group.get(), Q.get(), response.m_r.get(),
+                          pubkeyPoint.get(), challenge.m_c.get(),
+                          ctx.get()) == 0);
       if (err) {
         LOG_GENERAL(WARNING, "Commit regenerate failed");
         return false;
@@ -886,10 +1026,6 @@ bool MultiSig::MultiSigVerify(const bytes& message, const Signature& toverify,
 bool MultiSig::MultiSigVerify(const bytes& message, unsigned int offset,
                               unsigned int size, const Signature& toverify,
                               const PubKey& pubkey) {
-  // This mutex is to prevent multi-threaded issues with the use of openssl
-  // functions
-  lock_guard<mutex> g(m_mutexMultiSigVerify);
-
   // Initial checks
   if (message.size() == 0) {
     LOG_GENERAL(WARNING, "Empty message");
@@ -901,6 +1037,12 @@ bool MultiSig::MultiSigVerify(const bytes& message, unsigned int offset,
     return false;
   }
 
+  shared_ptr<const EC_POINT> pubkeyPoint = pubkey.GetPoint();
+  if (pubkeyPoint == nullptr) {
+    LOG_GENERAL(WARNING, "Invalid public key");
+    return false;
+  }
+
   try {
     // Main verification procedure
 
@@ -962,9 +1104,9 @@ bool MultiSig::MultiSigVerify(const bytes& message, unsigned int offset,
       }
 
       // 2. Compute Q = sG + r*kpub
-      err2 =
-          (EC_POINT_mul(curve.m_group.get(), Q.get(), toverify.m_s.get(),
-                        pubkey.m_P.get(), toverify.m_r.get(), ctx.get()) == 0);
+      err2 = (EC_POINT_mul(curve.m_group.get(), Q.get(), toverify.m_s.get(),
+                           pubkeyPoint.get(), toverify.m_r.get(),
+                           ctx.get()) == 0);
       err = err || err2;
       if (err2) {
         LOG_GENERAL(WARNING, "Commit regenerate failed");
@@ -998,7 +1140,7 @@ bool MultiSig::MultiSigVerify(const bytes& message, unsigned int offset,
       fill(buf.begin(), buf.end(), 0x00);
 
       // 4.2 Convert the public key to octets
-      err2 = (EC_POINT_point2oct(curve.m_group.get(), pubkey.m_P.get(),
+      err2 = (EC_POINT_point2oct(curve.m_group.get(), pubkeyPoint.get(),
                                  POINT_CONVERSION_COMPRESSED, buf.data(),
                                  Schnorr::PUBKEY_COMPRESSED_SIZE_BYTES, NULL) !=
               Schnorr::PUBKEY_COMPRESSED_SIZE_BYTES);
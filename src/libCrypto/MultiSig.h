@@ -18,7 +18,10 @@
 #ifndef ZILLIQA_SRC_LIBCRYPTO_MULTISIG_H_
 #define ZILLIQA_SRC_LIBCRYPTO_MULTISIG_H_
 
+#include <list>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "Schnorr.h"
@@ -260,7 +263,18 @@ class MultiSig {
   MultiSig(MultiSig const&) = delete;
   void operator=(MultiSig const&) = delete;
 
-  std::mutex m_mutexMultiSigVerify;
+  /// Full-committee aggregates of the most recently seen committees, keyed
+  /// by the hash of their keys and ordered from most recently used.
+  std::list<std::pair<bytes, std::shared_ptr<const EC_POINT>>>
+      m_committeeKeys;
+  std::mutex m_mutexCommitteeKeys;
+
+  /// Number of committees kept in m_committeeKeys. A DS node verifies
+  /// microblocks from every shard in the epoch plus its own committee.
+  static const unsigned int COMMITTEE_KEY_CACHE_SIZE = 16;
+
+  std::shared_ptr<const EC_POINT> GetCommitteeAggregate(
+      const std::vector<PubKey>& committee);
 
  public:
   /// Returns a MultiSig instance.
@@ -270,6 +284,12 @@ class MultiSig {
   static std::shared_ptr<PubKey> AggregatePubKeys(
       const std::vector<PubKey>& pubkeys);
 
+  /// Aggregates the keys of the committee members whose bit is set in the
+  /// bitmap. When most members signed, the result is derived from a cached
+  /// aggregate of the whole committee by subtracting the non-signers.
+  std::shared_ptr<PubKey> AggregateCommitteeKeys(
+      const std::vector<PubKey>& committee, const std::vector<bool>& bitmap);
+
   /// Aggregates the received commitments for the multisignature aggregator.
   static std::shared_ptr<CommitPoint> AggregateCommits(
       const std::vector<CommitPoint>& commitPoints);
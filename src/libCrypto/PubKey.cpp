@@ -19,6 +19,8 @@
 #include <openssl/ec.h>
 #include <openssl/err.h>
 
+#include <algorithm>
+
 #include "Schnorr.h"
 #include "libUtils/Logger.h"
 
@@ -28,32 +30,9 @@ using namespace std;
 // Construction
 // ============================================================================
 
-bool PubKey::constructPreChecks() {
-  if (m_P == nullptr) {
-    LOG_GENERAL(WARNING, "Memory allocation failure");
-    return false;
-  }
-
-  return true;
-}
-
-PubKey::PubKey()
-    : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()),
-          EC_POINT_clear_free) {
-  if (!constructPreChecks()) {
-    LOG_GENERAL(FATAL, "constructPreChecks failed");
-    return;
-  }
-}
-
-PubKey::PubKey(const PrivKey& privkey)
-    : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()),
-          EC_POINT_clear_free) {
-  if (!constructPreChecks()) {
-    LOG_GENERAL(FATAL, "constructPreChecks failed");
-    return;
-  }
+PubKey::PubKey() {}
 
+PubKey::PubKey(const PrivKey& privkey) {
   const Curve& curve = Schnorr::GetInstance().GetCurve();
 
   if (BN_is_zero(privkey.m_d.get()) ||
@@ -63,48 +42,98 @@ PubKey::PubKey(const PrivKey& privkey)
                 "generation failed");
     return;
   }
-  if (EC_POINT_mul(curve.m_group.get(), m_P.get(), privkey.m_d.get(), NULL,
-                   NULL, NULL) == 0) {
-    LOG_GENERAL(WARNING, "Public key generation failed");
+
+  unique_ptr<EC_POINT, void (*)(EC_POINT*)> point(
+      EC_POINT_new(curve.m_group.get()), EC_POINT_clear_free);
+  if (point == nullptr) {
+    LOG_GENERAL(FATAL, "Memory allocation failure");
     return;
   }
-}
 
-PubKey::PubKey(const bytes& src, unsigned int offset)
-    : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()),
-          EC_POINT_clear_free) {
-  if (!constructPreChecks()) {
-    LOG_GENERAL(FATAL, "constructPreChecks failed");
+  if (EC_POINT_mul(curve.m_group.get(), point.get(), privkey.m_d.get(), NULL,
+                   NULL, NULL) == 0) {
+    LOG_GENERAL(WARNING, "Public key generation failed");
     return;
   }
 
+  SetPoint(point.get());
+}
+
+PubKey::PubKey(const bytes& src, unsigned int offset) {
   if (Deserialize(src, offset) != 0) {
     LOG_GENERAL(WARNING, "We failed to init PubKey from stream");
   }
 }
 
+PubKey::PubKey(const EC_POINT* point) { SetPoint(point); }
+
 PubKey::PubKey(const PubKey& src)
-    : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()),
-          EC_POINT_clear_free) {
-  if (!constructPreChecks()) {
-    LOG_GENERAL(FATAL, "constructPreChecks failed");
+    : m_data(src.m_data), m_point(atomic_load(&src.m_point)) {}
+
+PubKey::~PubKey() {}
+
+void PubKey::SetPoint(const EC_POINT* point) {
+  const Curve& curve = Schnorr::GetInstance().GetCurve();
+
+  shared_ptr<EC_POINT> copy(EC_POINT_dup(point, curve.m_group.get()),
+                            EC_POINT_clear_free);
+  if (copy == nullptr) {
+    LOG_GENERAL(FATAL, "Memory allocation failure");
     return;
   }
 
-  if (!EC_POINT_copy(m_P.get(), src.m_P.get())) {
-    LOG_GENERAL(WARNING, "PubKey copy failed");
+  m_data.fill(0x00);
+  // The point at infinity is encoded as a single zero byte
+  if (!EC_POINT_is_at_infinity(curve.m_group.get(), point) &&
+      EC_POINT_point2oct(curve.m_group.get(), point,
+                         POINT_CONVERSION_COMPRESSED, m_data.data(),
+                         m_data.size(), NULL) != m_data.size()) {
+    LOG_GENERAL(WARNING, "Pubkey octet conversion failed");
+    m_data.fill(0x00);
     return;
   }
+
+  atomic_store(&m_point, shared_ptr<const EC_POINT>(move(copy)));
 }
 
-PubKey::~PubKey() {}
+shared_ptr<const EC_POINT> PubKey::GetPoint() const {
+  shared_ptr<const EC_POINT> point = atomic_load(&m_point);
+  if (point != nullptr) {
+    return point;
+  }
+
+  const Curve& curve = Schnorr::GetInstance().GetCurve();
+
+  shared_ptr<EC_POINT> decoded(EC_POINT_new(curve.m_group.get()),
+                               EC_POINT_clear_free);
+  unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
+  if ((decoded == nullptr) || (ctx == nullptr)) {
+    LOG_GENERAL(FATAL, "Memory allocation failure");
+    return nullptr;
+  }
+
+  // All zeros is the point at infinity, whose encoding is a single zero byte
+  const size_t size = (m_data[0] == 0x00) ? 1 : m_data.size();
+  if (EC_POINT_oct2point(curve.m_group.get(), decoded.get(), m_data.data(),
+                         size, ctx.get()) == 0) {
+    LOG_GENERAL(WARNING, "Pubkey is not a point on the curve");
+    return nullptr;
+  }
+
+  point = move(decoded);
+  atomic_store(&m_point, point);
+  return point;
+}
 
 // ============================================================================
 // Serialization
 // ============================================================================
 
 unsigned int PubKey::Serialize(bytes& dst, unsigned int offset) const {
-  ECPOINTSerialize::SetNumber(dst, offset, PUB_KEY_SIZE, m_P);
+  if (offset + PUB_KEY_SIZE > dst.size()) {
+    dst.resize(offset + PUB_KEY_SIZE);
+  }
+  copy(m_data.begin(), m_data.end(), dst.begin() + offset);
   return PUB_KEY_SIZE;
 }
 
@@ -126,72 +155,39 @@ PubKey PubKey::GetPubKeyFromString(const string& key) {
 }
 
 int PubKey::Deserialize(const bytes& src, unsigned int offset) {
-  shared_ptr<EC_POINT> result =
-      ECPOINTSerialize::GetNumber(src, offset, PUB_KEY_SIZE);
-
-  if (result == nullptr) {
-    LOG_GENERAL(WARNING, "ECPOINTSerialize::GetNumber failed");
+  // Check for offset overflow
+  if ((offset + PUB_KEY_SIZE) < PUB_KEY_SIZE ||
+      offset + PUB_KEY_SIZE > src.size()) {
+    LOG_GENERAL(WARNING, "Can't get PubKey. offset = " << offset
+                                                       << " src = "
+                                                       << src.size());
     return -1;
   }
 
-  if (!EC_POINT_copy(m_P.get(), result.get())) {
-    LOG_GENERAL(WARNING, "PubKey copy failed");
+  // Only the form is checked here; whether the point is on the curve is
+  // checked when it is first decoded
+  const auto begin = src.begin() + offset;
+  const auto end = begin + PUB_KEY_SIZE;
+  if ((*begin != 0x02) && (*begin != 0x03) &&
+      any_of(begin, end, [](unsigned char c) { return c != 0x00; })) {
+    LOG_GENERAL(WARNING, "Pubkey is not a compressed point");
     return -1;
   }
 
+  copy(begin, end, m_data.begin());
+  atomic_store(&m_point, shared_ptr<const EC_POINT>());
+
   return 0;
 }
 
 // ============================================================================
-// Assignment and Comparison
+// Assignment
 // ============================================================================
 
 PubKey& PubKey::operator=(const PubKey& src) {
-  if (!EC_POINT_copy(m_P.get(), src.m_P.get())) {
-    LOG_GENERAL(WARNING, "PubKey copy failed");
+  if (this != &src) {
+    m_data = src.m_data;
+    atomic_store(&m_point, atomic_load(&src.m_point));
   }
   return *this;
 }
-
-bool PubKey::comparePreChecks(const PubKey& r, shared_ptr<BIGNUM>& lhs_bnvalue,
-                              shared_ptr<BIGNUM>& rhs_bnvalue) const {
-  unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
-  if (ctx == nullptr) {
-    LOG_GENERAL(FATAL, "Memory allocation failure");
-    return false;
-  }
-
-  lhs_bnvalue.reset(
-      EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(),
-                        m_P.get(), POINT_CONVERSION_COMPRESSED, NULL,
-                        ctx.get()),
-      BN_clear_free);
-  rhs_bnvalue.reset(
-      EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(),
-                        r.m_P.get(), POINT_CONVERSION_COMPRESSED, NULL,
-                        ctx.get()),
-      BN_clear_free);
-
-  if ((lhs_bnvalue == nullptr) || (rhs_bnvalue == nullptr)) {
-    LOG_GENERAL(FATAL, "Memory allocation failure");
-    return false;
-  }
-
-  return true;
-}
-
-bool PubKey::operator<(const PubKey& r) const {
-  shared_ptr<BIGNUM> lhs_bnvalue, rhs_bnvalue;
-  return comparePreChecks(r, lhs_bnvalue, rhs_bnvalue) &&
-         BN_cmp(lhs_bnvalue.get(), rhs_bnvalue.get()) == -1;
-}
-
-bool PubKey::operator>(const PubKey& r) const { return r < *this; }
-
-bool PubKey::operator==(const PubKey& r) const {
-  shared_ptr<BIGNUM> lhs_bnvalue, rhs_bnvalue;
-  return comparePreChecks(r, lhs_bnvalue, rhs_bnvalue) &&
-         BN_cmp(lhs_bnvalue.get(), rhs_bnvalue.get()) == 0;
-}
-
-bool PubKey::operator!=(const PubKey& r) const { return !(*this == r); }
\ No newline at end of file
@@ -30,13 +30,42 @@
 #include "generate_dsa_nonce.h"
 #endif
 
+#include <algorithm>
 #include <array>
+#include <thread>
 
 #include "Schnorr.h"
 #include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
 
 using namespace std;
 
+namespace {
+/// Per-thread OpenSSL scratch space. Each thread that signs or verifies owns
+/// its BN_CTX and temporaries, so the curve group is the only shared state
+/// and it is only ever read.
+struct ThreadContext {
+  unique_ptr<BN_CTX, void (*)(BN_CTX*)> m_ctx;
+  unique_ptr<BIGNUM, void (*)(BIGNUM*)> m_challenge;
+  unique_ptr<EC_POINT, void (*)(EC_POINT*)> m_commit;
+
+  explicit ThreadContext(const Curve& curve)
+      : m_ctx(BN_CTX_new(), BN_CTX_free),
+        m_challenge(BN_new(), BN_clear_free),
+        m_commit(EC_POINT_new(curve.m_group.get()), EC_POINT_clear_free) {}
+
+  bool IsValid() const {
+    return (m_ctx != nullptr) && (m_challenge != nullptr) &&
+           (m_commit != nullptr);
+  }
+};
+
+ThreadContext& GetThreadContext(const Curve& curve) {
+  thread_local ThreadContext context(curve);
+  return context;
+}
+}  // namespace
+
 Curve::Curve()
     : m_group(EC_GROUP_new_by_curve_name(NID_secp256k1), EC_GROUP_clear_free),
       m_order(BN_new(), BN_clear_free) {
@@ -52,11 +81,19 @@ Curve::Curve()
   if (!EC_GROUP_get_order(m_group.get(), m_order.get(), NULL)) {
     LOG_GENERAL(FATAL, "Recover curve order failed");
   }
+  // Precompute multiples of the base point for the sG term in Verify. Sign's
+  // kG has a secret scalar and goes through OpenSSL's constant time ladder,
+  // which does not use the table. The table is read-only after this point
+  // and is shared by all threads.
+  if (!EC_GROUP_precompute_mult(m_group.get(), NULL)) {
+    LOG_GENERAL(WARNING, "Base point precomputation failed");
+  }
 }
 
 Curve::~Curve() {}
 
-Schnorr::Schnorr() {}
+Schnorr::Schnorr()
+    : m_verifyPoolSize(max(thread::hardware_concurrency(), 1u)) {}
 
 Schnorr::~Schnorr() {}
 
@@ -90,10 +127,6 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
                    Signature& result) {
   // LOG_MARKER();
 
-  // This mutex is to prevent multi-threaded issues with the use of openssl
-  // functions
-  lock_guard<mutex> g(m_mutexSchnorr);
-
   // Initial checks
 
   if (message.size() == 0) {
@@ -106,6 +139,12 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
     return false;
   }
 
+  shared_ptr<const EC_POINT> pubkeyPoint = pubkey.GetPoint();
+  if (pubkeyPoint == nullptr) {
+    LOG_GENERAL(WARNING, "Invalid public key");
+    return false;
+  }
+
   // Main signing procedure
 
   // The algorithm takes the following steps:
@@ -123,12 +162,15 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
   bool err = false;  // detect error
   int res = 1;       // result to return
 
+  // The nonce and its commitment are secret, so they are not taken from the
+  // reusable thread context
   unique_ptr<BIGNUM, void (*)(BIGNUM*)> k(BN_new(), BN_clear_free);
   unique_ptr<EC_POINT, void (*)(EC_POINT*)> Q(
       EC_POINT_new(m_curve.m_group.get()), EC_POINT_clear_free);
-  unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
+  ThreadContext& context = GetThreadContext(m_curve);
+  BN_CTX* ctx = context.m_ctx.get();
 
-  if ((k != nullptr) && (ctx != nullptr) && (Q != nullptr)) {
+  if ((k != nullptr) && context.IsValid() && (Q != nullptr)) {
     do {
       err = false;
 
@@ -137,7 +179,7 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
         err = (BN_generate_dsa_nonce(
                    k.get(), m_curve.m_order.get(), privkey.m_d.get(),
                    static_cast<const unsigned char*>(message.data()),
-                   message.size(), ctx.get()) == 0);
+                   message.size(), ctx) == 0);
 
         // err =
         // (BN_rand(k.get(), BN_num_bits(m_curve.m_order.get()), -1, 0) == 0);
@@ -149,7 +191,7 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
 
       // 2. Compute the commitment Q = kG, where G is the base point
       err = (EC_POINT_mul(m_curve.m_group.get(), Q.get(), k.get(), NULL, NULL,
-                          NULL) == 0);
+                          ctx) == 0);
       if (err) {
         LOG_GENERAL(WARNING, "Commit generation failed");
         return false;
@@ -161,7 +203,7 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
       err = (EC_POINT_point2oct(m_curve.m_group.get(), Q.get(),
                                 POINT_CONVERSION_COMPRESSED, buf.data(),
                                 PUBKEY_COMPRESSED_SIZE_BYTES,
-                                NULL) != PUBKEY_COMPRESSED_SIZE_BYTES);
+                                ctx) != PUBKEY_COMPRESSED_SIZE_BYTES);
       if (err) {
         LOG_GENERAL(WARNING, "Commit octet conversion failed");
         return false;
@@ -174,10 +216,10 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
       fill(buf.begin(), buf.end(), 0x00);
 
       // Convert the public key to octets
-      err = (EC_POINT_point2oct(m_curve.m_group.get(), pubkey.m_P.get(),
+      err = (EC_POINT_point2oct(m_curve.m_group.get(), pubkeyPoint.get(),
                                 POINT_CONVERSION_COMPRESSED, buf.data(),
                                 PUBKEY_COMPRESSED_SIZE_BYTES,
-                                NULL) != PUBKEY_COMPRESSED_SIZE_BYTES);
+                                ctx) != PUBKEY_COMPRESSED_SIZE_BYTES);
       if (err) {
         LOG_GENERAL(WARNING, "Pubkey octet conversion failed");
         return false;
@@ -199,7 +241,7 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
       }
 
       err = (BN_nnmod(result.m_r.get(), result.m_r.get(), m_curve.m_order.get(),
-                      NULL) == 0);
+                      ctx) == 0);
       if (err) {
         LOG_GENERAL(WARNING, "BIGNUM NNmod failed");
         return false;
@@ -208,7 +250,7 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
       // 4. Compute s = k - r*krpiv
       // 4.1 r*kpriv
       err = (BN_mod_mul(result.m_s.get(), result.m_r.get(), privkey.m_d.get(),
-                        m_curve.m_order.get(), ctx.get()) == 0);
+                        m_curve.m_order.get(), ctx) == 0);
       if (err) {
         LOG_GENERAL(WARNING, "Response mod mul failed");
         return false;
@@ -216,7 +258,7 @@ bool Schnorr::Sign(const bytes& message, unsigned int offset, unsigned int size,
 
       // 4.2 k-r*kpriv
       err = (BN_mod_sub(result.m_s.get(), k.get(), result.m_s.get(),
-                        m_curve.m_order.get(), ctx.get()) == 0);
+                        m_curve.m_order.get(), ctx) == 0);
       if (err) {
         LOG_GENERAL(WARNING, "BIGNUM mod sub failed");
         return false;
@@ -250,10 +292,6 @@ bool Schnorr::Verify(const bytes& message, unsigned int offset,
                      const PubKey& pubkey) {
   // LOG_MARKER();
 
-  // This mutex is to prevent multi-threaded issues with the use of openssl
-  // functions
-  lock_guard<mutex> g(m_mutexSchnorr);
-
   // Initial checks
 
   if (message.size() == 0) {
@@ -266,6 +304,12 @@ bool Schnorr::Verify(const bytes& message, unsigned int offset,
     return false;
   }
 
+  shared_ptr<const EC_POINT> pubkeyPoint = pubkey.GetPoint();
+  if (pubkeyPoint == nullptr) {
+    LOG_GENERAL(WARNING, "Invalid public key");
+    return false;
+  }
+
   try {
     // Main verification procedure
 
@@ -284,13 +328,12 @@ bool Schnorr::Verify(const bytes& message, unsigned int offset,
     bool err2 = false;
 
     // Regenerate the commitmment part of the signature
-    unique_ptr<BIGNUM, void (*)(BIGNUM*)> challenge_built(BN_new(),
-                                                          BN_clear_free);
-    unique_ptr<EC_POINT, void (*)(EC_POINT*)> Q(
-        EC_POINT_new(m_curve.m_group.get()), EC_POINT_clear_free);
-    unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
+    ThreadContext& context = GetThreadContext(m_curve);
+    BIGNUM* challenge_built = context.m_challenge.get();
+    EC_POINT* Q = context.m_commit.get();
+    BN_CTX* ctx = context.m_ctx.get();
 
-    if ((challenge_built != nullptr) && (ctx != nullptr) && (Q != nullptr)) {
+    if (context.IsValid()) {
       // 1. Check if r,s is in [1, ..., order-1]
       err2 = (BN_is_zero(toverify.m_r.get()) ||
               BN_is_negative(toverify.m_r.get()) ||
@@ -311,9 +354,8 @@ bool Schnorr::Verify(const bytes& message, unsigned int offset,
       }
 
       // 2. Compute Q = sG + r*kpub
-      err2 =
-          (EC_POINT_mul(m_curve.m_group.get(), Q.get(), toverify.m_s.get(),
-                        pubkey.m_P.get(), toverify.m_r.get(), ctx.get()) == 0);
+      err2 = (EC_POINT_mul(m_curve.m_group.get(), Q, toverify.m_s.get(),
+                           pubkeyPoint.get(), toverify.m_r.get(), ctx) == 0);
       err = err || err2;
       if (err2) {
         LOG_GENERAL(WARNING, "Commit regenerate failed");
@@ -321,7 +363,7 @@ bool Schnorr::Verify(const bytes& message, unsigned int offset,
       }
 
       // 3. If Q = O (the neutral point), return 0;
-      err2 = (EC_POINT_is_at_infinity(m_curve.m_group.get(), Q.get()));
+      err2 = (EC_POINT_is_at_infinity(m_curve.m_group.get(), Q));
       err = err || err2;
       if (err2) {
         LOG_GENERAL(WARNING, "Commit at infinity");
@@ -330,10 +372,10 @@ bool Schnorr::Verify(const bytes& message, unsigned int offset,
 
       // 4. r' = H(Q, kpub, m)
       // 4.1 Convert the committment to octets first
-      err2 = (EC_POINT_point2oct(m_curve.m_group.get(), Q.get(),
+      err2 = (EC_POINT_point2oct(m_curve.m_group.get(), Q,
                                  POINT_CONVERSION_COMPRESSED, buf.data(),
                                  PUBKEY_COMPRESSED_SIZE_BYTES,
-                                 NULL) != PUBKEY_COMPRESSED_SIZE_BYTES);
+                                 ctx) != PUBKEY_COMPRESSED_SIZE_BYTES);
       err = err || err2;
       if (err2) {
         LOG_GENERAL(WARNING, "Commit octet conversion failed");
@@ -347,10 +389,10 @@ bool Schnorr::Verify(const bytes& message, unsigned int offset,
       fill(buf.begin(), buf.end(), 0x00);
 
       // 4.2 Convert the public key to octets
-      err2 = (EC_POINT_point2oct(m_curve.m_group.get(), pubkey.m_P.get(),
+      err2 = (EC_POINT_point2oct(m_curve.m_group.get(), pubkeyPoint.get(),
                                  POINT_CONVERSION_COMPRESSED, buf.data(),
                                  PUBKEY_COMPRESSED_SIZE_BYTES,
-                                 NULL) != PUBKEY_COMPRESSED_SIZE_BYTES);
+                                 ctx) != PUBKEY_COMPRESSED_SIZE_BYTES);
       err = err || err2;
       if (err2) {
         LOG_GENERAL(WARNING, "Pubkey octet conversion failed");
@@ -365,16 +407,15 @@ bool Schnorr::Verify(const bytes& message, unsigned int offset,
       bytes digest = sha2.Finalize();
 
       // 5. return r' == r
-      err2 = (BN_bin2bn(digest.data(), digest.size(), challenge_built.get()) ==
-              NULL);
+      err2 = (BN_bin2bn(digest.data(), digest.size(), challenge_built) == NULL);
       err = err || err2;
       if (err2) {
         LOG_GENERAL(WARNING, "Challenge bin2bn conversion failed");
         return false;
       }
 
-      err2 = (BN_nnmod(challenge_built.get(), challenge_built.get(),
-                       m_curve.m_order.get(), NULL) == 0);
+      err2 = (BN_nnmod(challenge_built, challenge_built, m_curve.m_order.get(),
+                       ctx) == 0);
       err = err || err2;
       if (err2) {
         LOG_GENERAL(WARNING, "Challenge rebuild mod failed");
@@ -387,13 +428,46 @@ bool Schnorr::Verify(const bytes& message, unsigned int offset,
       // throw exception();
       return false;
     }
-    return (!err) && (BN_cmp(challenge_built.get(), toverify.m_r.get()) == 0);
+    return (!err) && (BN_cmp(challenge_built, toverify.m_r.get()) == 0);
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Error with Schnorr::Verify." << ' ' << e.what());
     return false;
   }
 }
 
+bool Schnorr::VerifyBatch(const vector<VerifyItem>& items,
+                          vector<bool>& results) {
+  // vector<bool> packs bits, so workers write to a byte vector instead
+  vector<unsigned char> verified(items.size(), 0);
+
+  auto verifyRange = [this, &items, &verified](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      const VerifyItem& item = items.at(i);
+      verified.at(i) = Verify(*item.message, item.offset, item.size,
+                              *item.signature, *item.pubkey);
+    }
+  };
+
+  const size_t numJobs =
+      min<size_t>(m_verifyPoolSize, items.size() / VERIFY_BATCH_MIN_PER_JOB);
+
+  if (numJobs <= 1) {
+    verifyRange(0, items.size());
+  } else {
+    call_once(m_verifyPoolFlag, [this]() {
+      m_verifyPool =
+          make_unique<ThreadPool>(m_verifyPoolSize, "SchnorrVerifyBatch");
+    });
+
+    const size_t chunkSize = (items.size() + numJobs - 1) / numJobs;
+    m_verifyPool->ParallelFor(0, items.size(), chunkSize, verifyRange);
+  }
+
+  results.assign(verified.begin(), verified.end());
+  return all_of(verified.begin(), verified.end(),
+                [](unsigned char v) { return v != 0; });
+}
+
 void Schnorr::PrintPoint(const EC_POINT* point) {
   LOG_MARKER();
 
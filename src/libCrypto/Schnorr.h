@@ -22,6 +22,7 @@
 #include <openssl/ec.h>
 
 #include <array>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -111,16 +112,20 @@ class PrivKey : public Serializable {
   bool operator==(const PrivKey& r) const;
 };
 
-/// Stores information on an EC-Schnorr public key.
+/// Stores information on an EC-Schnorr public key. The key is held as the
+/// compressed encoding of its point, so copies, comparisons and hashing are
+/// plain byte operations. The point itself is decoded when a curve operation
+/// first needs it, and copies made after that share the decoded point.
 class PubKey : public Serializable {
-  bool constructPreChecks();
-  bool comparePreChecks(const PubKey& r, std::shared_ptr<BIGNUM>& lhs_bnvalue,
-                        std::shared_ptr<BIGNUM>& rhs_bnvalue) const;
+  /// The compressed point, all zeros for the point at infinity.
+  std::array<unsigned char, PUB_KEY_SIZE> m_data{};
 
- public:
-  /// The point on the curve.
-  std::shared_ptr<EC_POINT> m_P;
+  /// The decoded point, set on first use.
+  mutable std::shared_ptr<const EC_POINT> m_point;
+
+  void SetPoint(const EC_POINT* point);
 
+ public:
   /// Default constructor for an uninitialized key.
   PubKey();
 
@@ -130,6 +135,9 @@ class PubKey : public Serializable {
   /// Constructor for loading existing key from a byte stream.
   PubKey(const bytes& src, unsigned int offset);
 
+  /// Constructor for the key of the specified point.
+  explicit PubKey(const EC_POINT* point);
+
   /// Copy constructor.
   PubKey(const PubKey&);
 
@@ -145,20 +153,29 @@ class PubKey : public Serializable {
   /// Implements the Deserialize function inherited from Serializable.
   int Deserialize(const bytes& src, unsigned int offset);
 
+  /// Returns the point on the curve, or nullptr if the key does not encode
+  /// one.
+  std::shared_ptr<const EC_POINT> GetPoint() const;
+
+  /// Returns the compressed encoding of the point.
+  const std::array<unsigned char, PUB_KEY_SIZE>& GetBytes() const {
+    return m_data;
+  }
+
   /// Assignment operator.
   PubKey& operator=(const PubKey& src);
 
   /// Less-than comparison operator (for sorting keys in lookup table).
-  bool operator<(const PubKey& r) const;
+  bool operator<(const PubKey& r) const { return m_data < r.m_data; }
 
   /// Greater-than comparison operator.
-  bool operator>(const PubKey& r) const;
+  bool operator>(const PubKey& r) const { return r < *this; }
 
   /// Equality operator.
-  bool operator==(const PubKey& r) const;
+  bool operator==(const PubKey& r) const { return m_data == r.m_data; }
 
   /// Inequality operator.
-  bool operator!=(const PubKey& r) const;
+  bool operator!=(const PubKey& r) const { return !(*this == r); }
 
   /// Utility std::string conversion function for public key info.
   explicit operator std::string() const {
@@ -175,12 +192,10 @@ namespace std {
 template <>
 struct hash<PubKey> {
   size_t operator()(PubKey const& pubKey) const noexcept {
-    std::size_t seed = 0;
-    std::string pubKeyStr;
-    if (!DataConversion::SerializableToHexStr(pubKey, pubKeyStr)) {
-      return seed;
-    }
-    boost::hash_combine(seed, pubKeyStr);
+    // The bytes after the prefix are the x coordinate, which is already
+    // uniformly distributed
+    size_t seed;
+    std::memcpy(&seed, pubKey.GetBytes().data() + 1, sizeof(seed));
     return seed;
   }
 };
@@ -253,10 +268,17 @@ inline std::ostream& operator<<(std::ostream& os, const Signature& s) {
   return os;
 }
 
+class ThreadPool;
+
 /// Implements the Elliptic Curve Based Schnorr Signature algorithm.
 class Schnorr {
   Curve m_curve;
 
+  /// Workers used by VerifyBatch, created on first use.
+  std::unique_ptr<ThreadPool> m_verifyPool;
+  std::once_flag m_verifyPoolFlag;
+  unsigned int m_verifyPoolSize;
+
   Schnorr();
   ~Schnorr();
 
@@ -270,6 +292,21 @@ class Schnorr {
   /// for y. Hence a total of 33 bytes.
   static const unsigned int PUBKEY_COMPRESSED_SIZE_BYTES = 33;
 
+  /// Minimum number of signatures handed to a single VerifyBatch worker.
+  static const unsigned int VERIFY_BATCH_MIN_PER_JOB = 16;
+
+  /// Describes one (message, signature, public key) triple for VerifyBatch.
+  /// The referenced objects must outlive the call.
+  struct VerifyItem {
+    const bytes* message;
+    unsigned int offset;
+    unsigned int size;
+    const Signature* signature;
+    const PubKey* pubkey;
+  };
+
+  /// Guards key generation and point printing. Sign and Verify do not take it;
+  /// they use a per-thread OpenSSL context instead.
   std::mutex m_mutexSchnorr;
 
   /// Returns the singleton Schnorr instance.
@@ -299,6 +336,12 @@ class Schnorr {
   bool Verify(const bytes& message, unsigned int offset, unsigned int size,
               const Signature& toverify, const PubKey& pubkey);
 
+  /// Checks all the signatures in the batch, spreading the work over the
+  /// verification worker pool. results[i] is set to the outcome for items[i].
+  /// Returns true only if every signature in the batch is valid.
+  bool VerifyBatch(const std::vector<VerifyItem>& items,
+                   std::vector<bool>& results);
+
   /// Utility function for printing EC_POINT coordinates.
   void PrintPoint(const EC_POINT* point);
 };
@@ -15,6 +15,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <thread>
+
 #include <leveldb/db.h>
 
 #include "AccountStore.h"
@@ -29,7 +32,13 @@ using namespace dev;
 using namespace boost::multiprecision;
 using namespace Contract;
 
-AccountStore::AccountStore() {
+namespace {
+/// Below this many txns a payment batch is executed by the calling thread
+const size_t PAYMENT_BATCH_MIN_PARALLEL = 64;
+}  // namespace
+
+AccountStore::AccountStore()
+    : m_paymentPoolSize(max(thread::hardware_concurrency(), 1u)) {
   m_accountStoreTemp = make_unique<AccountStoreTemp>(*this);
 }
 
@@ -235,6 +244,7 @@ bool AccountStore::MoveUpdatesToDisk(bool repopulate) {
       return false;
     }
     lock_guard<mutex> g(m_mutexTrie);
+    ApplyPendingUpdates();
     m_state.db()->commit();
     if (!MoveRootToDisk(m_state.root())) {
       LOG_GENERAL(WARNING, "MoveRootToDisk failed " << m_state.root().hex());
@@ -248,6 +258,7 @@ bool AccountStore::MoveUpdatesToDisk(bool repopulate) {
   }
 
   m_addressToAccount->clear();
+  LogAccountCacheHitRate();
 
   return true;
 }
@@ -260,6 +271,7 @@ bool AccountStore::RepopulateStateTrie() {
 
   {
     lock_guard<mutex> g(m_mutexTrie);
+    ApplyPendingUpdates();
     for (const auto& i : m_state) {
       counter++;
 
@@ -353,6 +365,8 @@ void AccountStore::DiscardUnsavedUpdates() {
   try {
     {
       lock_guard<mutex> g(m_mutexTrie);
+      m_pendingUpdates.clear();
+      m_accountCache.Clear();
       m_state.db()->rollback();
       m_state.setRoot(m_prevRoot);
     }
@@ -393,6 +407,8 @@ bool AccountStore::RetrieveFromDisk() {
     h256 root(rootBytes);
     LOG_GENERAL(INFO, "StateRootHash:" << root.hex());
     lock_guard<mutex> g(m_mutexTrie);
+    m_pendingUpdates.clear();
+    m_accountCache.Clear();
     m_state.setRoot(root);
   } catch (const boost::exception& e) {
     LOG_GENERAL(WARNING, "Error with AccountStore::RetrieveFromDisk. "
@@ -402,6 +418,163 @@ bool AccountStore::RetrieveFromDisk() {
   return true;
 }
 
+bool AccountStore::SerializeStateChunk(const StateHash& root,
+                                       const Address& start,
+                                       const Address& end,
+                                       unsigned int maxAccounts, bytes& dst,
+                                       Address& next, bool& stale) {
+  LOG_MARKER();
+
+  shared_lock<shared_timed_mutex> lock(m_mutexPrimary);
+
+  map<Address, Account> accounts;
+  next = end;
+  stale = false;
+
+  try {
+    // A separate view, so that older roots can be served while m_state moves
+    // on. The trie nodes of a root are never deleted from the database.
+    const SpecificTrieDB<GenericTrieDB<OverlayDB>, Address> stateTrie(
+        &m_db, root, Verification::Skip);
+
+    for (auto it = stateTrie.lower_bound(start); it != stateTrie.end(); ++it) {
+      const Address address((*it).first);
+      if (end != Address() && !(address < end)) {
+        break;
+      }
+      if (accounts.size() >= maxAccounts) {
+        next = address;
+        break;
+      }
+
+      const bytesConstRef rawAccountBase = (*it).second;
+      Account account;
+      if (!account.DeserializeBase(
+              bytes(rawAccountBase.begin(), rawAccountBase.end()), 0)) {
+        LOG_GENERAL(WARNING, "Account::DeserializeBase failed");
+        return false;
+      }
+
+      if (account.isContract()) {
+        // Contract code and storage are only kept for the latest state
+        lock_guard<mutex> g(m_mutexTrie);
+        ApplyPendingUpdates();
+        if (m_state.at(address) != rawAccountBase.toString()) {
+          LOG_GENERAL(WARNING, "Contract " << address.hex()
+                                           << " has changed since state root "
+                                           << root.hex());
+          stale = true;
+          return false;
+        }
+        account.SetAddress(address);
+      }
+
+      accounts.emplace(address, account);
+    }
+  } catch (const boost::exception& e) {
+    LOG_GENERAL(WARNING, "State root " << root.hex() << " not available. "
+                                       << boost::diagnostic_information(e));
+    stale = true;
+    return false;
+  }
+
+  LOG_GENERAL(INFO, "Accounts in chunk from " << start.hex() << ": "
+                                              << accounts.size());
+
+  return MessengerAccountStoreBase::SetAccountStore(dst, 0, accounts);
+}
+
+bool AccountStore::GetStateRangeDigest(const StateHash& root,
+                                       const Address& start,
+                                       const Address& end, h256& digest) {
+  LOG_MARKER();
+
+  shared_lock<shared_timed_mutex> lock(m_mutexPrimary);
+
+  SHA2<HashType::HASH_VARIANT_256> sha2;
+
+  try {
+    const SpecificTrieDB<GenericTrieDB<OverlayDB>, Address> stateTrie(
+        &m_db, root, Verification::Skip);
+
+    for (auto it = stateTrie.lower_bound(start); it != stateTrie.end(); ++it) {
+      const Address address((*it).first);
+      if (end != Address() && !(address < end)) {
+        break;
+      }
+      const bytesConstRef rawAccountBase = (*it).second;
+      sha2.Update(address.asBytes());
+      sha2.Update(bytes(rawAccountBase.begin(), rawAccountBase.end()));
+    }
+  } catch (const boost::exception& e) {
+    LOG_GENERAL(WARNING, "State root " << root.hex() << " not available. "
+                                       << boost::diagnostic_information(e));
+    return false;
+  }
+
+  digest = h256(sha2.Finalize());
+  return true;
+}
+
+bool AccountStore::RemoveStateRange(const Address& start, const Address& end) {
+  LOG_MARKER();
+
+  vector<Address> addresses;
+  {
+    lock_guard<mutex> g(m_mutexTrie);
+    ApplyPendingUpdates();
+    for (auto it = m_state.lower_bound(start); it != m_state.end(); ++it) {
+      const Address address((*it).first);
+      if (end != Address() && !(address < end)) {
+        break;
+      }
+      addresses.emplace_back(address);
+    }
+  }
+
+  {
+    unique_lock<shared_timed_mutex> g(m_mutexPrimary);
+    for (const auto& address : addresses) {
+      RemoveAccount(address);
+      RemoveFromTrie(address);
+    }
+  }
+
+  LOG_GENERAL(INFO, "Accounts removed from " << start.hex() << ": "
+                                             << addresses.size());
+
+  return MoveUpdatesToDisk();
+}
+
+bool AccountStore::AddStateChunk(const bytes& src, unsigned int offset,
+                                 const Address& start, const Address& next) {
+  LOG_MARKER();
+
+  map<Address, Account> accounts;
+  if (!MessengerAccountStoreBase::GetAccountStore(src, offset, accounts)) {
+    LOG_GENERAL(WARNING, "Messenger::GetAccountStore failed.");
+    return false;
+  }
+
+  for (const auto& entry : accounts) {
+    if (entry.first < start ||
+        (next != Address() && !(entry.first < next))) {
+      LOG_GENERAL(WARNING, "Account " << entry.first.hex()
+                                      << " is outside of the chunk");
+      return false;
+    }
+  }
+
+  {
+    unique_lock<shared_timed_mutex> g(m_mutexPrimary);
+    for (const auto& entry : accounts) {
+      AddAccountDuringDeserialization(entry.first, entry.second, Account());
+    }
+  }
+
+  return MoveUpdatesToDisk();
+}
+
 Account* AccountStore::GetAccountTemp(const Address& address) {
   return m_accountStoreTemp->GetAccount(address);
 }
@@ -435,6 +608,140 @@ bool AccountStore::UpdateCoinbaseTemp(const Address& rewardee,
   // Should the nonce increase ??
 }
 
+void AccountStore::ExecutePaymentsTemp(const vector<Transaction>& txns,
+                                       const vector<unsigned char>& eligible,
+                                       PaymentBatch& batch) {
+  const size_t numTxns = txns.size();
+  batch.applied.assign(numTxns, 0);
+  batch.touched.assign(numTxns, {});
+  batch.receipts.resize(numTxns);
+
+  // Txns sharing a sender or recipient end up in the same group
+  unordered_map<Address, size_t> addrIndex;
+  vector<size_t> parent;
+  auto find = [&parent](size_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  auto index = [&addrIndex, &parent](const Address& addr) {
+    auto it = addrIndex.emplace(addr, parent.size());
+    if (it.second) {
+      parent.emplace_back(parent.size());
+    }
+    return it.first->second;
+  };
+
+  vector<pair<Address, Address>> txnAddrs(numTxns);
+  for (size_t i = 0; i < numTxns; i++) {
+    if (!eligible.at(i)) {
+      continue;
+    }
+    txnAddrs[i] = {txns[i].GetSenderAddr(), txns[i].GetToAddr()};
+    const size_t from = find(index(txnAddrs[i].first));
+    const size_t to = find(index(txnAddrs[i].second));
+    parent[to] = from;
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
+  unique_lock<mutex> g2(m_mutexDelta, defer_lock);
+  lock(g, g2);
+
+  // Take the accounts the batch can touch from where AccountStoreTemp would
+  // get them, without adding them to the state delta yet
+  map<Address, Account> snapshot;
+  const auto& tempAccounts = m_accountStoreTemp->GetAddressToAccount();
+  for (const auto& entry : addrIndex) {
+    auto it = tempAccounts->find(entry.first);
+    const Account* account =
+        (it != tempAccounts->end()) ? &it->second : GetAccount(entry.first);
+    if (account != nullptr) {
+      snapshot.emplace(entry.first, *account);
+    }
+  }
+
+  map<size_t, vector<size_t>> groups;
+  for (size_t i = 0; i < numTxns; i++) {
+    if (eligible.at(i)) {
+      groups[find(addrIndex.at(txnAddrs[i].first))].emplace_back(i);
+    }
+  }
+
+  auto runGroup = [&txns, &txnAddrs, &snapshot,
+                   &batch](const vector<size_t>& group) {
+    AccountStorePayment store(snapshot);
+    for (const auto& i : group) {
+      batch.applied[i] = store.UpdateAccounts(txns[i], batch.receipts[i]);
+
+      const Address& from = txnAddrs[i].first;
+      const Address& to = txnAddrs[i].second;
+      const Account* account = store.GetTouchedAccount(from);
+      if (account != nullptr) {
+        batch.touched[i].emplace_back(from, *account);
+      }
+      account = store.GetTouchedAccount(to);
+      if (account != nullptr && to != from) {
+        batch.touched[i].emplace_back(to, *account);
+      }
+    }
+  };
+
+  const size_t numJobs =
+      (numTxns < PAYMENT_BATCH_MIN_PARALLEL)
+          ? 1
+          : min<size_t>(m_paymentPoolSize, groups.size());
+
+  if (numJobs <= 1) {
+    for (const auto& group : groups) {
+      runGroup(group.second);
+    }
+    return;
+  }
+
+  call_once(m_paymentPoolFlag, [this]() {
+    m_paymentPool = make_unique<ThreadPool>(m_paymentPoolSize, "Payments");
+  });
+
+  // Spread the groups so that every job has about the same number of txns
+  vector<vector<const vector<size_t>*>> jobs(numJobs);
+  vector<size_t> jobSizes(numJobs, 0);
+  for (const auto& group : groups) {
+    const size_t job =
+        min_element(jobSizes.begin(), jobSizes.end()) - jobSizes.begin();
+    jobs[job].emplace_back(&group.second);
+    jobSizes[job] += group.second.size();
+  }
+
+  auto runJob = [&runGroup](const vector<const vector<size_t>*>& job) {
+    for (const auto& group : job) {
+      runGroup(*group);
+    }
+  };
+
+  m_paymentPool->ParallelFor(0, numJobs, 1, [&runJob, &jobs](size_t begin,
+                                                             size_t end) {
+    for (size_t job = begin; job < end; job++) {
+      runJob(jobs[job]);
+    }
+  });
+}
+
+void AccountStore::CommitPaymentsTemp(const PaymentBatch& batch,
+                                      size_t count) {
+  unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
+  unique_lock<mutex> g2(m_mutexDelta, defer_lock);
+  lock(g, g2);
+
+  const auto& tempAccounts = m_accountStoreTemp->GetAddressToAccount();
+  for (size_t i = 0; i < count && i < batch.touched.size(); i++) {
+    for (const auto& entry : batch.touched[i]) {
+      (*tempAccounts)[entry.first] = entry.second;
+    }
+  }
+}
+
 uint128_t AccountStore::GetNonceTemp(const Address& address) {
   lock_guard<mutex> g(m_mutexDelta);
 
@@ -20,9 +20,11 @@
 
 #include <json/json.h>
 #include <map>
+#include <mutex>
 #include <set>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "Account.h"
 #include "AccountStoreSC.h"
@@ -37,6 +39,7 @@
 #include "depends/libTrie/TrieDB.h"
 #include "libCrypto/Schnorr.h"
 #include "libData/AccountData/Transaction.h"
+#include "libUtils/ThreadPool.h"
 
 using StateHash = dev::h256;
 
@@ -63,6 +66,36 @@ class AccountStoreTemp : public AccountStoreSC<std::map<Address, Account>> {
   }
 };
 
+/// Private store of a group of payment txns executed by
+/// AccountStore::ExecutePaymentsTemp. As in AccountStoreTemp, an account is
+/// copied in when first accessed, here from a snapshot of the accounts the
+/// batch can touch.
+class AccountStorePayment
+    : public AccountStoreBase<std::map<Address, Account>> {
+  const std::map<Address, Account>& m_snapshot;
+
+ public:
+  AccountStorePayment(const std::map<Address, Account>& snapshot);
+
+  Account* GetAccount(const Address& address) override;
+
+  /// Returns the account if it has been accessed by a previous txn.
+  const Account* GetTouchedAccount(const Address& address) const;
+
+  /// Applies a payment txn the way AccountStoreSC::UpdateAccounts does.
+  bool UpdateAccounts(const Transaction& transaction,
+                      TransactionReceipt& receipt);
+};
+
+/// Outcome of a batch of payment txns run by AccountStore::ExecutePaymentsTemp
+struct PaymentBatch {
+  /// Not a vector<bool>, as the entries are written from several threads
+  std::vector<unsigned char> applied;
+  std::vector<TransactionReceipt> receipts;
+  /// The accounts each txn leaves in AccountStoreTemp
+  std::vector<std::vector<std::pair<Address, Account>>> touched;
+};
+
 // Singleton class for providing interface related Account System
 class AccountStore
     : public AccountStoreTrie<dev::OverlayDB,
@@ -86,6 +119,11 @@ class AccountStore
   /// buffer for the raw bytes of state delta serialized
   bytes m_stateDeltaSerialized;
 
+  /// Workers used by ExecutePaymentsTemp, created on first use.
+  std::unique_ptr<ThreadPool> m_paymentPool;
+  std::once_flag m_paymentPoolFlag;
+  unsigned int m_paymentPoolSize;
+
   AccountStore();
   ~AccountStore();
 
@@ -134,6 +172,33 @@ class AccountStore
   /// repopulate the in-memory data structures from persistent storage
   bool RetrieveFromDisk();
 
+  /// Serializes the accounts of the state at root from start up to but not
+  /// including end (a zero end stands for the end of the address space), at
+  /// most maxAccounts of them. next is set to where the following chunk of
+  /// the range starts, or to end once the range is covered. Only roots that
+  /// are still in the state database can be served. stale is set when the
+  /// chunk cannot be served for root any more, i.e. the root is not available
+  /// or a contract in the chunk has changed since.
+  bool SerializeStateChunk(const StateHash& root, const Address& start,
+                           const Address& end, unsigned int maxAccounts,
+                           bytes& dst, Address& next, bool& stale);
+
+  /// Computes a digest of the accounts of the state at root from start up to
+  /// but not including end, to check whether a range synced for an older root
+  /// still holds for a newer one.
+  bool GetStateRangeDigest(const StateHash& root, const Address& start,
+                           const Address& end, dev::h256& digest);
+
+  /// Removes the accounts from start up to but not including end, so that the
+  /// range can be synced again.
+  bool RemoveStateRange(const Address& start, const Address& end);
+
+  /// Adds the accounts of a chunk made by SerializeStateChunk for the range
+  /// from start up to next, and moves them to disk so that only one chunk is
+  /// held in memory at a time.
+  bool AddStateChunk(const bytes& src, unsigned int offset,
+                     const Address& start, const Address& next);
+
   Account* GetAccountTemp(const Address& address);
 
   /// update account states in AccountStoreTemp
@@ -142,6 +207,19 @@ class AccountStore
                           const Transaction& transaction,
                           TransactionReceipt& receipt);
 
+  /// Runs payment txns against AccountStoreTemp as UpdateAccountsTemp would
+  /// run them one after the other, without applying them yet. The txns are
+  /// split into groups that touch disjoint accounts, which are executed
+  /// concurrently. Only the txns flagged in eligible are run; the receipts in
+  /// batch are expected to be initialized by the caller.
+  void ExecutePaymentsTemp(const std::vector<Transaction>& txns,
+                           const std::vector<unsigned char>& eligible,
+                           PaymentBatch& batch);
+
+  /// Applies the effects of the first count txns of a batch to
+  /// AccountStoreTemp.
+  void CommitPaymentsTemp(const PaymentBatch& batch, size_t count);
+
   /// add account in AccountStoreTemp
   void AddAccountTemp(const Address& address, const Account& account) {
     m_accountStoreTemp->AddAccount(address, account);
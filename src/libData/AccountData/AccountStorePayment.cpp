@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AccountStore.h"
+
+using namespace std;
+using namespace boost::multiprecision;
+
+AccountStorePayment::AccountStorePayment(
+    const map<Address, Account>& snapshot)
+    : m_snapshot(snapshot) {}
+
+Account* AccountStorePayment::GetAccount(const Address& address) {
+  Account* account =
+      AccountStoreBase<map<Address, Account>>::GetAccount(address);
+  if (account != nullptr) {
+    return account;
+  }
+
+  auto it = m_snapshot.find(address);
+  if (it != m_snapshot.end()) {
+    return &(m_addressToAccount->emplace(address, it->second).first->second);
+  }
+
+  return nullptr;
+}
+
+const Account* AccountStorePayment::GetTouchedAccount(
+    const Address& address) const {
+  auto it = m_addressToAccount->find(address);
+  if (it != m_addressToAccount->end()) {
+    return &it->second;
+  }
+  return nullptr;
+}
+
+bool AccountStorePayment::UpdateAccounts(const Transaction& transaction,
+                                         TransactionReceipt& receipt) {
+  uint128_t gasDeposit;
+  if (!SafeMath<uint128_t>::mul(transaction.GetGasLimit(),
+                                transaction.GetGasPrice(), gasDeposit)) {
+    return false;
+  }
+
+  // Disallow normal transaction to contract account
+  Account* toAccount = GetAccount(transaction.GetToAddr());
+  if (toAccount != nullptr) {
+    if (toAccount->isContract()) {
+      LOG_GENERAL(WARNING, "Contract account won't accept normal txn");
+      return false;
+    }
+  }
+
+  return AccountStoreBase<map<Address, Account>>::UpdateAccounts(transaction,
+                                                                 receipt);
+}
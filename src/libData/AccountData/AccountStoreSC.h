@@ -84,6 +84,9 @@ class AccountStoreSC : public AccountStoreBase<MAP> {
   /// the depth of chain call while executing the current txn
   unsigned int m_curDepth{0};
 
+  /// interpreter inputs kept in memory when running with the scilla worker
+  Json::Value m_scillaInput;
+
   /// for contract execution timeout
   std::mutex m_MutexCVCallContract;
   std::condition_variable cv_callContract;
@@ -138,6 +141,28 @@ class AccountStoreSC : public AccountStoreBase<MAP> {
   /// updating m_root_w_version
   bool PrepareRootPathWVersion(const uint32_t& scilla_version);
 
+  enum INVOKE_TYPE { CHECKER, RUNNER_CREATE, RUNNER_CALL };
+  /// run the interpreter, either as a new process or through the scilla
+  /// worker; handle is set to the pid or the worker connection in use
+  bool InvokeInterpreter(INVOKE_TYPE invoke_type,
+                         std::string& interprinterPrint,
+                         const uint64_t& available_gas, int& handle);
+  /// interrupt the interpreter started by InvokeInterpreter
+  void AbortInterpreter(int handle);
+  /// get the request for the scilla worker
+  std::string GetWorkerRequestStr(INVOKE_TYPE invoke_type,
+                                  const std::string& root_w_version,
+                                  const uint64_t& available_gas);
+
+  /// get the scilla source of the contract, cached by code hash
+  std::string GetContractCodeStr(const Account& contract);
+  /// create SCILLA_FILES if needed and remove the previous output
+  void PrepareScillaFiles();
+  /// write the code and init json for the interpreter, skipping the files
+  /// already exported for the same contract
+  bool ExportCodeAndInit(const Account& contract, const Json::Value& init,
+                         bool reuseInit);
+
   /// generate input files for interpreter to deploy contract
   bool ExportCreateContractFiles(const Account& contract);
 
@@ -23,6 +23,7 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/JsonUtils.h"
 #include "libUtils/SafeMath.h"
+#include "libUtils/ScillaWorkerClient.h"
 #include "libUtils/SysCommand.h"
 
 // 5mb
@@ -186,53 +187,54 @@ bool AccountStoreSC<MAP>::UpdateAccounts(
       std::string checkerPrint;
 
       int pid = -1;
-      auto func1 = [this, &checkerPrint, &ret_checker, &pid,
-                    &receipt]() mutable -> void {
-        try {
-          if (!SysCommand::ExecuteCmd(
-                  SysCommand::WITH_OUTPUT_PID,
-                  GetContractCheckerCmdStr(m_root_w_version), checkerPrint,
-                  pid)) {
-            LOG_GENERAL(WARNING,
-                        "ExecuteCmd failed: "
-                            << GetContractCheckerCmdStr(m_root_w_version));
-            receipt.AddError(EXECUTE_CMD_FAILED);
+      // The checker output only depends on the code and interpreter version
+      const bool checkerCached =
+          Contract::ContractStorage::GetContractStorage()
+              .GetCachedCheckerOutput(toAccount->GetCodeHash(),
+                                      m_root_w_version, checkerPrint);
+      if (!checkerCached) {
+        auto func1 = [this, &checkerPrint, &ret_checker, &pid,
+                      &receipt]() mutable -> void {
+          try {
+            if (!InvokeInterpreter(CHECKER, checkerPrint, 0, pid)) {
+              receipt.AddError(EXECUTE_CMD_FAILED);
+              ret_checker = false;
+            }
+          } catch (const std::exception& e) {
+            LOG_GENERAL(WARNING, "Exception caught in InvokeInterpreter (1): "
+                                     << e.what());
             ret_checker = false;
           }
-        } catch (const std::exception& e) {
-          LOG_GENERAL(
-              WARNING,
-              "Exception caught in SysCommand::ExecuteCmd (1): " << e.what());
-          ret_checker = false;
-        }
 
-        cv_callContract.notify_all();
-      };
-      DetachedFunction(1, func1);
+          cv_callContract.notify_all();
+        };
+        DetachedFunction(1, func1);
 
-      {
-        std::unique_lock<std::mutex> lk(m_MutexCVCallContract);
-        cv_callContract.wait(lk);
-      }
+        {
+          std::unique_lock<std::mutex> lk(m_MutexCVCallContract);
+          cv_callContract.wait(lk);
+        }
 
-      if (m_txnProcessTimeout) {
-        LOG_GENERAL(
-            WARNING,
-            "Txn processing timeout! Interrupt current contract check, pid: "
-                << pid);
-        try {
-          if (pid >= 0) {
-            kill(pid, SIGKILL);
+        if (m_txnProcessTimeout) {
+          LOG_GENERAL(
+              WARNING,
+              "Txn processing timeout! Interrupt current contract check, pid: "
+                  << pid);
+          try {
+            AbortInterpreter(pid);
+          } catch (const std::exception& e) {
+            LOG_GENERAL(WARNING, "Exception caught in kill pid: " << e.what());
           }
-        } catch (const std::exception& e) {
-          LOG_GENERAL(WARNING, "Exception caught in kill pid: " << e.what());
+          receipt.AddError(EXECUTE_CMD_TIMEOUT);
+          ret_checker = false;
         }
-        receipt.AddError(EXECUTE_CMD_TIMEOUT);
-        ret_checker = false;
       }
 
       if (ret_checker && !ParseContractCheckerOutput(checkerPrint, receipt)) {
         ret_checker = false;
+      } else if (ret_checker && !checkerCached) {
+        Contract::ContractStorage::GetContractStorage().CacheCheckerOutput(
+            toAccount->GetCodeHash(), m_root_w_version, checkerPrint);
       }
 
       // Undergo scilla runner
@@ -245,20 +247,14 @@ bool AccountStoreSC<MAP>::UpdateAccounts(
         auto func2 = [this, &runnerPrint, &ret, &pid, gasRemained,
                       &receipt]() mutable -> void {
           try {
-            if (!SysCommand::ExecuteCmd(
-                    SysCommand::WITH_OUTPUT_PID,
-                    GetCreateContractCmdStr(m_root_w_version, gasRemained),
-                    runnerPrint, pid)) {
-              LOG_GENERAL(WARNING,
-                          "ExecuteCmd failed: " << GetCreateContractCmdStr(
-                              m_root_w_version, gasRemained));
+            if (!InvokeInterpreter(RUNNER_CREATE, runnerPrint, gasRemained,
+                                   pid)) {
               receipt.AddError(EXECUTE_CMD_FAILED);
               ret = false;
             }
           } catch (const std::exception& e) {
-            LOG_GENERAL(
-                WARNING,
-                "Exception caught in SysCommand::ExecuteCmd (2): " << e.what());
+            LOG_GENERAL(WARNING, "Exception caught in InvokeInterpreter (2): "
+                                     << e.what());
             ret = false;
           }
 
@@ -277,9 +273,7 @@ bool AccountStoreSC<MAP>::UpdateAccounts(
                         "Txn processing timeout! Interrupt current contract "
                         "deployment, pid: "
                             << pid);
-            if (pid >= 0) {
-              kill(pid, SIGKILL);
-            }
+            AbortInterpreter(pid);
 
             receipt.AddError(EXECUTE_CMD_TIMEOUT);
             ret = false;
@@ -436,12 +430,7 @@ bool AccountStoreSC<MAP>::UpdateAccounts(
       auto func = [this, &runnerPrint, &ret, &pid, gasRemained,
                    &receipt]() mutable -> void {
         try {
-          if (!SysCommand::ExecuteCmd(
-                  SysCommand::WITH_OUTPUT_PID,
-                  GetCallContractCmdStr(m_root_w_version, gasRemained),
-                  runnerPrint, pid)) {
-            LOG_GENERAL(WARNING, "ExecuteCmd failed: " << GetCallContractCmdStr(
-                                     m_root_w_version, gasRemained));
+          if (!InvokeInterpreter(RUNNER_CALL, runnerPrint, gasRemained, pid)) {
             receipt.AddError(EXECUTE_CMD_FAILED);
             ret = false;
           }
@@ -466,9 +455,7 @@ bool AccountStoreSC<MAP>::UpdateAccounts(
             "Txn processing timeout! Interrupt current contract call, pid: "
                 << pid);
         try {
-          if (pid >= 0) {
-            kill(pid, SIGKILL);
-          }
+          AbortInterpreter(pid);
         } catch (const std::exception& e) {
           LOG_GENERAL(WARNING, "Exception caught in kill pid: " << e.what());
         }
@@ -565,16 +552,81 @@ Json::Value AccountStoreSC<MAP>::GetBlockStateJson(
 }
 
 template <class MAP>
-bool AccountStoreSC<MAP>::ExportCreateContractFiles(const Account& contract) {
-  LOG_MARKER();
+std::string AccountStoreSC<MAP>::GetContractCodeStr(const Account& contract) {
+  std::string code;
+  if (!Contract::ContractStorage::GetContractStorage().GetCachedCode(
+          contract.GetCodeHash(), code)) {
+    code = DataConversion::CharArrayToString(contract.GetCode());
+    Contract::ContractStorage::GetContractStorage().CacheCode(
+        contract.GetCodeHash(), code);
+  }
+  return code;
+}
 
-  boost::filesystem::remove_all("./" + SCILLA_FILES);
-  boost::filesystem::create_directories("./" + SCILLA_FILES);
+template <class MAP>
+void AccountStoreSC<MAP>::PrepareScillaFiles() {
+  if (!(boost::filesystem::exists("./" + SCILLA_FILES))) {
+    boost::filesystem::create_directories("./" + SCILLA_FILES);
+  }
 
   if (!(boost::filesystem::exists("./" + SCILLA_LOG))) {
     boost::filesystem::create_directories("./" + SCILLA_LOG);
   }
 
+  // Never parse the output left by a previous invocation
+  boost::filesystem::remove(OUTPUT_JSON);
+}
+
+template <class MAP>
+bool AccountStoreSC<MAP>::ExportCodeAndInit(const Account& contract,
+                                            const Json::Value& init,
+                                            bool reuseInit) {
+  Contract::ContractStorage& cs =
+      Contract::ContractStorage::GetContractStorage();
+
+  Address exportedAddr;
+  dev::h256 exportedCodeHash;
+  cs.GetExportedContract(exportedAddr, exportedCodeHash);
+
+  const bool codeExported = exportedCodeHash == contract.GetCodeHash() &&
+                            boost::filesystem::exists(INPUT_CODE);
+  const bool initExported = reuseInit && codeExported &&
+                            exportedAddr == contract.GetAddress() &&
+                            boost::filesystem::exists(INIT_JSON);
+
+  if (codeExported && initExported) {
+    return true;
+  }
+
+  cs.SetExportedContract(Address(), dev::h256());
+
+  try {
+    if (!codeExported) {
+      // Scilla code
+      std::ofstream os(INPUT_CODE);
+      os << GetContractCodeStr(contract);
+      os.close();
+    }
+
+    // Initialize Json
+    JSONUtils::GetInstance().writeJsontoFile(INIT_JSON, init);
+  } catch (const std::exception& e) {
+    LOG_GENERAL(WARNING, "Exception caught: " << e.what());
+    return false;
+  }
+
+  cs.SetExportedContract(contract.GetAddress(), contract.GetCodeHash());
+  return true;
+}
+
+template <class MAP>
+bool AccountStoreSC<MAP>::ExportCreateContractFiles(const Account& contract) {
+  LOG_MARKER();
+
+  if (!ENABLE_SCILLA_WORKER) {
+    PrepareScillaFiles();
+  }
+
   std::pair<Json::Value, Json::Value> roots;
   uint32_t scilla_version;
   if (!contract.GetStorageJson(roots, true, scilla_version)) {
@@ -587,15 +639,21 @@ bool AccountStoreSC<MAP>::ExportCreateContractFiles(const Account& contract) {
     return false;
   }
 
-  try {
-    // Scilla code
-    std::ofstream os(INPUT_CODE);
-    os << DataConversion::CharArrayToString(contract.GetCode());
-    os.close();
+  if (ENABLE_SCILLA_WORKER) {
+    m_scillaInput = Json::Value(Json::objectValue);
+    m_scillaInput["code"] = GetContractCodeStr(contract);
+    m_scillaInput["code_hash"] = contract.GetCodeHash().hex();
+    m_scillaInput["init"] = roots.first;
+    m_scillaInput["blockchain"] = GetBlockStateJson(m_curBlockNum);
+    return true;
+  }
 
-    // Initialize Json
-    JSONUtils::GetInstance().writeJsontoFile(INIT_JSON, roots.first);
+  // The address of a failed deployment can be reused with other init data
+  if (!ExportCodeAndInit(contract, roots.first, false)) {
+    return false;
+  }
 
+  try {
     // Block Json
     JSONUtils::GetInstance().writeJsontoFile(INPUT_BLOCKCHAIN_JSON,
                                              GetBlockStateJson(m_curBlockNum));
@@ -612,11 +670,8 @@ bool AccountStoreSC<MAP>::ExportContractFiles(const Account& contract) {
   LOG_MARKER();
   std::chrono::system_clock::time_point tpStart;
 
-  boost::filesystem::remove_all("./" + SCILLA_FILES);
-  boost::filesystem::create_directories("./" + SCILLA_FILES);
-
-  if (!(boost::filesystem::exists("./" + SCILLA_LOG))) {
-    boost::filesystem::create_directories("./" + SCILLA_LOG);
+  if (!ENABLE_SCILLA_WORKER) {
+    PrepareScillaFiles();
   }
 
   if (ENABLE_CHECK_PERFORMANCE_LOG) {
@@ -635,15 +690,24 @@ bool AccountStoreSC<MAP>::ExportContractFiles(const Account& contract) {
     return false;
   }
 
-  try {
-    // Scilla code
-    std::ofstream os(INPUT_CODE);
-    os << DataConversion::CharArrayToString(contract.GetCode());
-    os.close();
+  if (ENABLE_SCILLA_WORKER) {
+    m_scillaInput = Json::Value(Json::objectValue);
+    m_scillaInput["code"] = GetContractCodeStr(contract);
+    m_scillaInput["code_hash"] = contract.GetCodeHash().hex();
+    m_scillaInput["init"] = roots.first;
+    m_scillaInput["state"] = roots.second;
+    m_scillaInput["blockchain"] = GetBlockStateJson(m_curBlockNum);
+    if (ENABLE_CHECK_PERFORMANCE_LOG) {
+      LOG_GENERAL(DEBUG, "LDB Read (microsec) = " << r_timer_end(tpStart));
+    }
+    return true;
+  }
 
-    // Initialize Json
-    JSONUtils::GetInstance().writeJsontoFile(INIT_JSON, roots.first);
+  if (!ExportCodeAndInit(contract, roots.first, true)) {
+    return false;
+  }
 
+  try {
     // State Json
     JSONUtils::GetInstance().writeJsontoFile(INPUT_STATE_JSON, roots.second);
 
@@ -685,7 +749,11 @@ bool AccountStoreSC<MAP>::ExportCallContractFiles(
         Account::GetAddressFromPublicKey(transaction.GetSenderPubKey()).hex();
     msgObj["_amount"] = transaction.GetAmount().convert_to<std::string>();
 
-    JSONUtils::GetInstance().writeJsontoFile(INPUT_MESSAGE_JSON, msgObj);
+    if (ENABLE_SCILLA_WORKER) {
+      m_scillaInput["message"] = msgObj;
+    } else {
+      JSONUtils::GetInstance().writeJsontoFile(INPUT_MESSAGE_JSON, msgObj);
+    }
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Exception caught: " << e.what());
     return false;
@@ -705,7 +773,12 @@ bool AccountStoreSC<MAP>::ExportCallContractFiles(
   }
 
   try {
-    JSONUtils::GetInstance().writeJsontoFile(INPUT_MESSAGE_JSON, contractData);
+    if (ENABLE_SCILLA_WORKER) {
+      m_scillaInput["message"] = contractData;
+    } else {
+      JSONUtils::GetInstance().writeJsontoFile(INPUT_MESSAGE_JSON,
+                                               contractData);
+    }
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Exception caught: " << e.what());
     return false;
@@ -768,6 +841,95 @@ std::string AccountStoreSC<MAP>::GetCallContractCmdStr(
   return cmdStr;
 }
 
+template <class MAP>
+std::string AccountStoreSC<MAP>::GetWorkerRequestStr(
+    INVOKE_TYPE invoke_type, const std::string& root_w_version,
+    const uint64_t& available_gas) {
+  Json::Value request = m_scillaInput;
+  Json::Value args(Json::arrayValue);
+
+  args.append("-libdir");
+  args.append(root_w_version + '/' + SCILLA_LIB);
+
+  switch (invoke_type) {
+    case CHECKER:
+      request["command"] = "check";
+      break;
+    case RUNNER_CREATE:
+      request["command"] = "run";
+      request.removeMember("state");
+      request.removeMember("message");
+      args.append("-gaslimit");
+      args.append(std::to_string(available_gas));
+      args.append("-jsonerrors");
+      break;
+    case RUNNER_CALL:
+      request["command"] = "run";
+      args.append("-gaslimit");
+      args.append(std::to_string(available_gas));
+      args.append("-disable-pp-json");
+      args.append("-disable-validate-json");
+      args.append("-jsonerrors");
+      break;
+  }
+
+  request["root"] = root_w_version;
+  request["args"] = args;
+
+  LOG_GENERAL(INFO, "Scilla worker request: " << request["command"].asString()
+                                              << " " << root_w_version);
+  return JSONUtils::GetInstance().convertJsontoStr(request);
+}
+
+template <class MAP>
+bool AccountStoreSC<MAP>::InvokeInterpreter(INVOKE_TYPE invoke_type,
+                                            std::string& interprinterPrint,
+                                            const uint64_t& available_gas,
+                                            int& handle) {
+  if (ENABLE_SCILLA_WORKER) {
+    if (!ScillaWorkerClient::GetInstance().Call(
+            GetWorkerRequestStr(invoke_type, m_root_w_version, available_gas),
+            interprinterPrint, handle)) {
+      LOG_GENERAL(WARNING, "Scilla worker call failed");
+      return false;
+    }
+    return true;
+  }
+
+  std::string cmdStr;
+  switch (invoke_type) {
+    case CHECKER:
+      cmdStr = GetContractCheckerCmdStr(m_root_w_version);
+      break;
+    case RUNNER_CREATE:
+      cmdStr = GetCreateContractCmdStr(m_root_w_version, available_gas);
+      break;
+    case RUNNER_CALL:
+      cmdStr = GetCallContractCmdStr(m_root_w_version, available_gas);
+      break;
+  }
+
+  if (!SysCommand::ExecuteCmd(SysCommand::WITH_OUTPUT_PID, cmdStr,
+                              interprinterPrint, handle)) {
+    LOG_GENERAL(WARNING, "ExecuteCmd failed: " << cmdStr);
+    return false;
+  }
+  return true;
+}
+
+template <class MAP>
+void AccountStoreSC<MAP>::AbortInterpreter(int handle) {
+  if (handle < 0) {
+    return;
+  }
+
+  if (ENABLE_SCILLA_WORKER) {
+    ScillaWorkerClient::Abort(handle);
+  } else {
+    kill(handle, SIGKILL);
+  }
+}
+
 template <class MAP>
 bool AccountStoreSC<MAP>::ParseContractCheckerOutput(
     const std::string& checkerPrint, TransactionReceipt& receipt) {
@@ -805,23 +967,33 @@ bool AccountStoreSC<MAP>::ParseCreateContractOutput(
     TransactionReceipt& receipt) {
   // LOG_MARKER();
 
-  std::ifstream in(OUTPUT_JSON, std::ios::binary);
   std::string outStr;
 
-  if (!in.is_open()) {
-    LOG_GENERAL(WARNING,
-                "Error opening output file or no output file generated");
-
-    // Check the printout
-    if (!runnerPrint.empty()) {
-      outStr = runnerPrint;
-    } else {
+  if (ENABLE_SCILLA_WORKER) {
+    // The worker returns the output json instead of writing it to file
+    if (runnerPrint.empty()) {
       receipt.AddError(NO_OUTPUT);
       return false;
     }
+    outStr = runnerPrint;
   } else {
-    outStr = {std::istreambuf_iterator<char>(in),
-              std::istreambuf_iterator<char>()};
+    std::ifstream in(OUTPUT_JSON, std::ios::binary);
+
+    if (!in.is_open()) {
+      LOG_GENERAL(WARNING,
+                  "Error opening output file or no output file generated");
+
+      // Check the printout
+      if (!runnerPrint.empty()) {
+        outStr = runnerPrint;
+      } else {
+        receipt.AddError(NO_OUTPUT);
+        return false;
+      }
+    } else {
+      outStr = {std::istreambuf_iterator<char>(in),
+                std::istreambuf_iterator<char>()};
+    }
   }
 
   LOG_GENERAL(
@@ -942,24 +1114,34 @@ bool AccountStoreSC<MAP>::ParseCallContractOutput(
   if (ENABLE_CHECK_PERFORMANCE_LOG) {
     tpStart = r_timer_start();
   }
-  std::ifstream in(OUTPUT_JSON, std::ios::binary);
   std::string outStr;
 
   try {
-    if (!in.is_open()) {
-      LOG_GENERAL(WARNING,
-                  "Error opening output file or no output file generated");
-
-      // Check the printout
-      if (!runnerPrint.empty()) {
-        outStr = runnerPrint;
-      } else {
+    if (ENABLE_SCILLA_WORKER) {
+      // The worker returns the output json instead of writing it to file
+      if (runnerPrint.empty()) {
         receipt.AddError(NO_OUTPUT);
         return false;
       }
+      outStr = runnerPrint;
     } else {
-      outStr = {std::istreambuf_iterator<char>(in),
-                std::istreambuf_iterator<char>()};
+      std::ifstream in(OUTPUT_JSON, std::ios::binary);
+
+      if (!in.is_open()) {
+        LOG_GENERAL(WARNING,
+                    "Error opening output file or no output file generated");
+
+        // Check the printout
+        if (!runnerPrint.empty()) {
+          outStr = runnerPrint;
+        } else {
+          receipt.AddError(NO_OUTPUT);
+          return false;
+        }
+      } else {
+        outStr = {std::istreambuf_iterator<char>(in),
+                  std::istreambuf_iterator<char>()};
+      }
     }
     LOG_GENERAL(
         INFO,
@@ -1240,12 +1422,7 @@ bool AccountStoreSC<MAP>::ParseCallContractJsonOutput(
   auto func = [this, &runnerPrint, &result, &pid, gasRemained,
                &receipt]() mutable -> void {
     try {
-      if (!SysCommand::ExecuteCmd(
-              SysCommand::WITH_OUTPUT_PID,
-              GetCallContractCmdStr(m_root_w_version, gasRemained), runnerPrint,
-              pid)) {
-        LOG_GENERAL(WARNING, "ExecuteCmd failed: " << GetCallContractCmdStr(
-                                 m_root_w_version, gasRemained));
+      if (!InvokeInterpreter(RUNNER_CALL, runnerPrint, gasRemained, pid)) {
         receipt.AddError(EXECUTE_CMD_FAILED);
         result = false;
       }
@@ -1273,9 +1450,7 @@ bool AccountStoreSC<MAP>::ParseCallContractJsonOutput(
                 "Txn processing timeout! Interrupt current contract call, pid: "
                     << pid);
     try {
-      if (pid >= 0) {
-        kill(pid, SIGKILL);
-      }
+      AbortInterpreter(pid);
     } catch (const std::exception& e) {
       LOG_GENERAL(WARNING,
                   "Exception caught when calling kill pid: " << e.what());
@@ -18,17 +18,40 @@
 #ifndef ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_ACCOUNTSTORETRIE_H_
 #define ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_ACCOUNTSTORETRIE_H_
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <thread>
+
 #include "AccountStoreSC.h"
 #include "depends/libDatabase/MemoryDB.h"
 #include "depends/libDatabase/OverlayDB.h"
+#include "libData/DataStructures/ShardedLRUCache.h"
 
 template <class DB, class MAP>
 class AccountStoreTrie : public AccountStoreSC<MAP> {
  protected:
   DB m_db;
-  dev::SpecificTrieDB<dev::GenericTrieDB<DB>, Address> m_state;
+  // mutable so that the pending updates can be applied by const readers
+  mutable dev::SpecificTrieDB<dev::GenericTrieDB<DB>, Address> m_state;
   dev::h256 m_prevRoot;
 
+  // account updates not yet applied to m_state, an empty value being a
+  // removal; applied together so that each touched node is hashed once
+  mutable std::map<Address, bytes> m_pendingUpdates;
+
+  // number of pending updates from which the subtrees of the state trie are
+  // hashed in parallel
+  static const unsigned int PARALLEL_HASH_MIN_UPDATES = 1000;
+
+  // accounts as decoded from m_state, kept across MoveUpdatesToDisk so that
+  // accounts used every epoch are not read from disk again; kept in step with
+  // m_state by the writes to it, and cleared when its root is reset
+  ShardedLRUCache<Address, std::shared_ptr<const Account>> m_accountCache;
+  std::atomic<uint64_t> m_accountCacheHits{0};
+  std::atomic<uint64_t> m_accountCacheMisses{0};
+  static const unsigned int ACCOUNT_CACHE_SHARDS = 16;
+
   // mutex for AccountStore DB related operations
   std::mutex m_mutexDB;
   mutable std::mutex m_mutexTrie;
@@ -38,6 +61,16 @@ class AccountStoreTrie : public AccountStoreSC<MAP> {
   bool UpdateStateTrie(const Address& address, const Account& account);
   bool RemoveFromTrie(const Address& address);
 
+  /// Applies m_pendingUpdates to m_state. Caller must hold m_mutexTrie.
+  void ApplyPendingUpdates() const;
+
+  /// Returns the account serialized by Account::SerializeBase, or nullptr.
+  static std::shared_ptr<const Account> DecodeAccount(
+      const Address& address, const bytes& rawAccountBase);
+
+  /// Logs and resets the hit rate of m_accountCache.
+  void LogAccountCacheHitRate();
+
  public:
   virtual void Init() override;
 
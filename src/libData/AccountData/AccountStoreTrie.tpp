@@ -21,7 +21,8 @@
 
 template <class DB, class MAP>
 AccountStoreTrie<DB, MAP>::AccountStoreTrie()
-    : m_db(std::is_same<DB, dev::OverlayDB>::value ? "state" : "") {
+    : m_db(std::is_same<DB, dev::OverlayDB>::value ? "state" : ""),
+      m_accountCache(ACCOUNT_CACHE_SIZE, ACCOUNT_CACHE_SHARDS) {
   std::lock_guard<std::mutex> g(m_mutexTrie);
   m_state = dev::SpecificTrieDB<dev::GenericTrieDB<DB>, Address>(&m_db);
 }
@@ -35,6 +36,8 @@ void AccountStoreTrie<DB, MAP>::Init() {
 template <class DB, class MAP>
 void AccountStoreTrie<DB, MAP>::InitTrie() {
   std::lock_guard<std::mutex> g(m_mutexTrie);
+  m_pendingUpdates.clear();
+  m_accountCache.Clear();
   m_state.init();
   m_prevRoot = m_state.root();
 }
@@ -43,6 +46,7 @@ template <class DB, class MAP>
 bool AccountStoreTrie<DB, MAP>::Serialize(bytes& dst,
                                           unsigned int offset) const {
   std::lock_guard<std::mutex> g(m_mutexTrie);
+  ApplyPendingUpdates();
   if (!MessengerAccountStoreTrie::SetAccountStoreTrie(
           dst, offset, m_state, this->m_addressToAccount)) {
     LOG_GENERAL(WARNING, "Messenger::SetAccountStoreTrie failed.");
@@ -62,21 +66,49 @@ Account* AccountStoreTrie<DB, MAP>::GetAccount(const Address& address) {
     return account;
   }
 
-  std::string rawAccountBase;
+  std::shared_ptr<const Account> decoded;
   {
     std::lock(m_mutexTrie, m_mutexDB);
     std::lock_guard<std::mutex> lock1(m_mutexTrie, std::adopt_lock);
     std::lock_guard<std::mutex> lock2(m_mutexDB, std::adopt_lock);
 
-    rawAccountBase = m_state.at(address);
+    if (m_accountCache.Get(address, decoded)) {
+      m_accountCacheHits++;
+    } else {
+      m_accountCacheMisses++;
+
+      auto it = m_pendingUpdates.find(address);
+      if (it != m_pendingUpdates.end()) {
+        if (!it->second.empty()) {
+          decoded = DecodeAccount(address, it->second);
+        }
+      } else {
+        const std::string rawAccountBase = m_state.at(address);
+        if (!rawAccountBase.empty()) {
+          decoded = DecodeAccount(
+              address, bytes(rawAccountBase.begin(), rawAccountBase.end()));
+        }
+      }
+
+      if (decoded != nullptr) {
+        m_accountCache.Put(address, decoded);
+      }
+    }
   }
-  if (rawAccountBase.empty()) {
+  if (decoded == nullptr) {
     return nullptr;
   }
 
-  account = new Account();
-  if (!account->DeserializeBase(
-          bytes(rawAccountBase.begin(), rawAccountBase.end()), 0)) {
+  auto it2 = this->m_addressToAccount->emplace(address, *decoded);
+
+  return &it2.first->second;
+}
+
+template <class DB, class MAP>
+std::shared_ptr<const Account> AccountStoreTrie<DB, MAP>::DecodeAccount(
+    const Address& address, const bytes& rawAccountBase) {
+  auto account = std::make_shared<Account>();
+  if (!account->DeserializeBase(rawAccountBase, 0)) {
     LOG_GENERAL(WARNING, "Account::DeserializeBase failed");
     return nullptr;
   }
@@ -85,9 +117,7 @@ Account* AccountStoreTrie<DB, MAP>::GetAccount(const Address& address) {
     account->SetAddress(address);
   }
 
-  auto it2 = this->m_addressToAccount->emplace(address, *account);
-
-  return &it2.first->second;
+  return account;
 }
 
 template <class DB, class MAP>
@@ -101,7 +131,15 @@ bool AccountStoreTrie<DB, MAP>::UpdateStateTrie(const Address& address,
   }
 
   std::lock_guard<std::mutex> g(m_mutexTrie);
-  m_state.insert(address, rawBytes);
+  // Decoded again rather than copied, so that the cache only holds what a
+  // read from m_state would give
+  auto decoded = DecodeAccount(address, rawBytes);
+  if (decoded != nullptr) {
+    m_accountCache.Put(address, decoded);
+  } else {
+    m_accountCache.Erase(address);
+  }
+  m_pendingUpdates[address] = std::move(rawBytes);
 
   return true;
 }
@@ -111,16 +149,44 @@ bool AccountStoreTrie<DB, MAP>::RemoveFromTrie(const Address& address) {
   // LOG_MARKER();
   std::lock_guard<std::mutex> g(m_mutexTrie);
 
-  m_state.remove(address);
+  m_pendingUpdates[address].clear();
+  m_accountCache.Erase(address);
 
   return true;
 }
 
+template <class DB, class MAP>
+void AccountStoreTrie<DB, MAP>::ApplyPendingUpdates() const {
+  if (m_pendingUpdates.empty()) {
+    return;
+  }
+
+  const unsigned int threads =
+      (m_pendingUpdates.size() < PARALLEL_HASH_MIN_UPDATES)
+          ? 1
+          : std::max(std::thread::hardware_concurrency(), 1u);
+  m_state.update(m_pendingUpdates, threads);
+  m_pendingUpdates.clear();
+}
+
+template <class DB, class MAP>
+void AccountStoreTrie<DB, MAP>::LogAccountCacheHitRate() {
+  const uint64_t hits = m_accountCacheHits.exchange(0);
+  const uint64_t misses = m_accountCacheMisses.exchange(0);
+  if (hits + misses > 0) {
+    LOG_GENERAL(INFO, "Account cache hits: " << hits << " misses: " << misses
+                                             << " hit rate: "
+                                             << hits * 100 / (hits + misses)
+                                             << "%");
+  }
+}
+
 template <class DB, class MAP>
 dev::h256 AccountStoreTrie<DB, MAP>::GetStateRootHash() const {
   LOG_MARKER();
 
   std::lock_guard<std::mutex> g(m_mutexTrie);
+  ApplyPendingUpdates();
 
   return m_state.root();
 }
@@ -143,8 +209,9 @@ bool AccountStoreTrie<DB, MAP>::UpdateStateTrieAll() {
       LOG_GENERAL(WARNING, "Messenger::SetAccountBase failed");
       return false;
     }
-    m_state.insert(entry.first, rawBytes);
+    m_pendingUpdates[entry.first] = std::move(rawBytes);
   }
+  ApplyPendingUpdates();
 
   return true;
 }
@@ -20,136 +20,264 @@
 
 #include <functional>
 #include <map>
+#include <set>
 #include <unordered_map>
+#include <vector>
 
 #include "Account.h"
 #include "Transaction.h"
 
-struct TxnPool {
-  struct PubKeyNonceHash {
-    std::size_t operator()(const std::pair<PubKey, uint128_t>& p) const {
-      std::size_t seed = 0;
-      boost::hash_combine(seed, std::string(p.first));
-      boost::hash_combine(seed, p.second.convert_to<std::string>());
+/// Pool of pending transactions.
+///
+/// Every transaction is stored once in the hash index; the nonce and ready
+/// indexes only refer to that single copy. Each sender has a nonce-ordered
+/// queue holding at most one transaction per nonce. Once the account nonces of
+/// the senders are provided through prepareReady, the queue heads that can be
+/// executed next are kept ordered by gas price, so that popReady is O(log n).
+class TxnPool {
+ public:
+  /// Returns the current (last used) nonce of an account.
+  using NonceGetter = std::function<uint128_t(const Address&)>;
 
-      return seed;
+ private:
+  struct Entry {
+    Transaction txn;
+    Address sender;
+  };
+
+  /// Highest gas price first, then lowest transaction hash.
+  struct GasOrder {
+    bool operator()(const Entry* l, const Entry* r) const {
+      if (l->txn.GetGasPrice() != r->txn.GetGasPrice()) {
+        return l->txn.GetGasPrice() > r->txn.GetGasPrice();
+      }
+      return l->txn.GetTranID() < r->txn.GetTranID();
     }
   };
 
-  std::unordered_map<TxnHash, Transaction> HashIndex;
-  std::map<uint128_t, std::map<TxnHash, Transaction>, std::greater<uint128_t>>
-      GasIndex;
-  std::unordered_map<std::pair<PubKey, uint64_t>, Transaction, PubKeyNonceHash>
-      NonceIndex;
+  struct SenderQueue {
+    std::map<uint64_t, Entry*> txns;
+    /// Head of txns if it is currently in m_readyIndex.
+    Entry* ready{nullptr};
+    /// Set while the account nonce of the sender is known.
+    bool nonceKnown{false};
+    uint128_t nonce{0};
+  };
+
+  using SenderIter = std::unordered_map<Address, SenderQueue>::iterator;
+
+  std::unordered_map<TxnHash, Entry> m_hashIndex;
+  std::unordered_map<Address, SenderQueue> m_nonceIndex;
+  std::set<Entry*, GasOrder> m_readyIndex;
+
+  void addEntry(const Transaction& t, const Address& sender) {
+    Entry& entry =
+        m_hashIndex.emplace(t.GetTranID(), Entry{t, sender}).first->second;
+
+    auto it = m_nonceIndex.emplace(sender, SenderQueue()).first;
+    it->second.txns.emplace(t.GetNonce(), &entry);
+    updateReady(it);
+  }
+
+  /// Removes the entry from every index but keeps its sender queue.
+  void dropEntry(Entry* entry, SenderQueue& queue) {
+    if (queue.ready == entry) {
+      m_readyIndex.erase(entry);
+      queue.ready = nullptr;
+    }
+    queue.txns.erase(entry->txn.GetNonce());
+    const TxnHash tranID = entry->txn.GetTranID();
+    m_hashIndex.erase(tranID);
+  }
+
+  /// Drops used nonces at the head of the queue, re-evaluates whether the new
+  /// head is executable, and releases the queue once it is empty.
+  void updateReady(SenderIter it) {
+    SenderQueue& queue = it->second;
+
+    if (queue.ready != nullptr) {
+      m_readyIndex.erase(queue.ready);
+      queue.ready = nullptr;
+    }
+
+    if (queue.nonceKnown) {
+      while (!queue.txns.empty() && queue.txns.begin()->first <= queue.nonce) {
+        dropEntry(queue.txns.begin()->second, queue);
+      }
+      if (!queue.txns.empty() &&
+          queue.txns.begin()->first == queue.nonce + 1) {
+        queue.ready = queue.txns.begin()->second;
+        m_readyIndex.insert(queue.ready);
+      }
+    }
+
+    if (queue.txns.empty()) {
+      m_nonceIndex.erase(it);
+    }
+  }
+
+ public:
+  TxnPool() = default;
+
+  TxnPool(const TxnPool& src) { *this = src; }
+
+  TxnPool(TxnPool&& src) = default;
+
+  /// Copies the transactions only; nonces must be supplied again through
+  /// prepareReady before the copy can serve popReady.
+  TxnPool& operator=(const TxnPool& src) {
+    if (this != &src) {
+      clear();
+      m_hashIndex.reserve(src.m_hashIndex.size());
+      for (const auto& kv : src.m_hashIndex) {
+        addEntry(kv.second.txn, kv.second.sender);
+      }
+    }
+    return *this;
+  }
+
+  TxnPool& operator=(TxnPool&& src) = default;
 
   void clear() {
-    HashIndex.clear();
-    GasIndex.clear();
-    NonceIndex.clear();
+    m_readyIndex.clear();
+    m_nonceIndex.clear();
+    m_hashIndex.clear();
   }
 
-  unsigned int size() { return HashIndex.size(); }
+  unsigned int size() const { return m_hashIndex.size(); }
 
-  bool exist(const TxnHash& th) {
-    return HashIndex.find(th) != HashIndex.end();
+  bool exist(const TxnHash& th) const {
+    return m_hashIndex.find(th) != m_hashIndex.end();
   }
 
-  bool get(const TxnHash& th, Transaction& t) {
-    if (!exist(th)) {
+  bool get(const TxnHash& th, Transaction& t) const {
+    auto it = m_hashIndex.find(th);
+    if (it == m_hashIndex.end()) {
       return false;
     }
-    t = HashIndex.at(th);
+    t = it->second.txn;
 
     return true;
   }
 
+  /// Adds a transaction. If the sender already has one with the same nonce,
+  /// the one with the higher gas price (or lower hash on a tie) is kept.
   bool insert(const Transaction& t) {
     if (exist(t.GetTranID())) {
       return false;
     }
 
-    auto searchNonce = NonceIndex.find({t.GetSenderPubKey(), t.GetNonce()});
-    if (searchNonce != NonceIndex.end()) {
-      if ((t.GetGasPrice() > searchNonce->second.GetGasPrice()) ||
-          (t.GetGasPrice() == searchNonce->second.GetGasPrice() &&
-           t.GetTranID() < searchNonce->second.GetTranID())) {
-        // erase from HashIdxTxns
-        auto searchHash = HashIndex.find(searchNonce->second.GetTranID());
-        if (searchHash != HashIndex.end()) {
-          HashIndex.erase(searchHash);
-        }
-        // erase from GasIdxTxns
-        auto searchGas = GasIndex.find(searchNonce->second.GetGasPrice());
-        if (searchGas != GasIndex.end()) {
-          auto searchGasHash =
-              searchGas->second.find(searchNonce->second.GetTranID());
-          if (searchGasHash != searchGas->second.end()) {
-            searchGas->second.erase(searchGasHash);
-          }
+    const Address sender = t.GetSenderAddr();
+
+    auto searchSender = m_nonceIndex.find(sender);
+    if (searchSender != m_nonceIndex.end()) {
+      auto searchNonce = searchSender->second.txns.find(t.GetNonce());
+      if (searchNonce != searchSender->second.txns.end()) {
+        const Transaction& existing = searchNonce->second->txn;
+        if ((t.GetGasPrice() > existing.GetGasPrice()) ||
+            (t.GetGasPrice() == existing.GetGasPrice() &&
+             t.GetTranID() < existing.GetTranID())) {
+          dropEntry(searchNonce->second, searchSender->second);
+          addEntry(t, sender);
         }
-        HashIndex[t.GetTranID()] = t;
-        GasIndex[t.GetGasPrice()][t.GetTranID()] = t;
-        searchNonce->second = t;
+        return true;
       }
-    } else {
-      HashIndex[t.GetTranID()] = t;
-      GasIndex[t.GetGasPrice()][t.GetTranID()] = t;
-      NonceIndex[{t.GetSenderPubKey(), t.GetNonce()}] = t;
     }
+
+    addEntry(t, sender);
     return true;
   }
 
-  void findSameNonceButHigherGas(Transaction& t) {
-    auto searchNonce = NonceIndex.find({t.GetSenderPubKey(), t.GetNonce()});
-    if (searchNonce != NonceIndex.end()) {
-      if (searchNonce->second.GetGasPrice() > t.GetGasPrice()) {
-        t = std::move(searchNonce->second);
-
-        // erase tx nonce map
-        NonceIndex.erase(searchNonce);
-        // erase tx gas map
-        GasIndex[t.GetGasPrice()].erase(t.GetTranID());
-        if (GasIndex[t.GetGasPrice()].empty()) {
-          GasIndex.erase(t.GetGasPrice());
-        }
-        // erase tx hash map
-        HashIndex.erase(t.GetTranID());
-      }
+  /// Records the current nonce of every sender in the pool and builds the set
+  /// of executable queue heads. Transactions with already used nonces are
+  /// dropped.
+  void prepareReady(const NonceGetter& getNonce) {
+    std::vector<SenderIter> senders;
+    senders.reserve(m_nonceIndex.size());
+    for (auto it = m_nonceIndex.begin(); it != m_nonceIndex.end(); it++) {
+      senders.emplace_back(it);
+    }
+    for (const auto& it : senders) {
+      it->second.nonceKnown = true;
+      it->second.nonce = getNonce(it->first);
+      updateReady(it);
     }
   }
 
-  bool findOne(Transaction& t) {
-    if (GasIndex.empty()) {
+  /// Removes the executable transaction with the highest gas price. Its sender
+  /// is not considered again until updateSender reports the sender's nonce.
+  bool popReady(Transaction& t) {
+    if (m_readyIndex.empty()) {
       return false;
     }
 
-    auto firstGas = GasIndex.begin();
-    auto firstHash = firstGas->second.begin();
+    Entry* entry = *m_readyIndex.begin();
+    auto it = m_nonceIndex.find(entry->sender);
+    it->second.nonceKnown = false;
+    t = entry->txn;
+    dropEntry(entry, it->second);
+    updateReady(it);
+    return true;
+  }
+
+  /// Sets the current nonce of the sender, e.g. after its transaction returned
+  /// by popReady has been applied, and re-evaluates its next transaction.
+  void updateSender(const Address& sender, const uint128_t& nonce) {
+    auto it = m_nonceIndex.find(sender);
+    if (it == m_nonceIndex.end()) {
+      return;
+    }
+    it->second.nonceKnown = true;
+    it->second.nonce = nonce;
+    updateReady(it);
+  }
 
-    if (firstHash != firstGas->second.end()) {
-      t = std::move(firstHash->second);
+  /// Puts back transactions returned by popReady that were not applied. The
+  /// nonces of their senders are looked up again first, since a nonce set by
+  /// updateSender ahead of applying a txn would drop them on insert.
+  void reinsert(const std::vector<Transaction>& txns,
+                const NonceGetter& getNonce) {
+    std::unordered_map<Address, uint128_t> nonces;
+    for (const auto& t : txns) {
+      nonces.emplace(t.GetSenderAddr(), 0);
+    }
+    for (auto& kv : nonces) {
+      kv.second = getNonce(kv.first);
+      updateSender(kv.first, kv.second);
+    }
+    for (const auto& t : txns) {
+      insert(t);
+    }
+    // Queues that were released before are new and need the nonce as well
+    for (const auto& kv : nonces) {
+      updateSender(kv.first, kv.second);
+    }
+  }
 
-      // erase tx gas map
-      firstGas->second.erase(firstHash);
-      if (firstGas->second.empty()) {
-        GasIndex.erase(firstGas);
+  /// Returns the transactions that are waiting for a lower nonce of their
+  /// sender to be used first. Only senders with a known nonce are considered.
+  std::vector<TxnHash> getNonceHighTxns() const {
+    std::vector<TxnHash> result;
+    for (const auto& kv : m_nonceIndex) {
+      const SenderQueue& queue = kv.second;
+      if (!queue.nonceKnown || queue.ready != nullptr) {
+        continue;
+      }
+      for (const auto& nonceEntry : queue.txns) {
+        result.emplace_back(nonceEntry.second->txn.GetTranID());
       }
-      // erase tx nonce map
-      NonceIndex.erase({t.GetSenderPubKey(), t.GetNonce()});
-      // erase tx hash m ap
-      HashIndex.erase(t.GetTranID());
-      return true;
     }
-    return false;
+    return result;
   }
+
+  friend std::ostream& operator<<(std::ostream& os, const TxnPool& t);
 };
 
 inline std::ostream& operator<<(std::ostream& os, const TxnPool& t) {
   os << "Txn in txnPool: " << std::endl;
-  for (const auto& entry : t.HashIndex) {
-    os << "TranID: " << entry.first.hex() << " Sender:"
-       << Account::GetAddressFromPublicKey(entry.second.GetSenderPubKey())
-       << " Nonce: " << entry.second.GetNonce() << std::endl;
+  for (const auto& entry : t.m_hashIndex) {
+    os << "TranID: " << entry.first.hex() << " Sender:" << entry.second.sender
+       << " Nonce: " << entry.second.txn.GetNonce() << std::endl;
   }
   return os;
 }
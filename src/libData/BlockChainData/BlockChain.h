@@ -18,6 +18,8 @@
 #ifndef ZILLIQA_SRC_LIBDATA_BLOCKCHAINDATA_BLOCKCHAIN_H_
 #define ZILLIQA_SRC_LIBDATA_BLOCKCHAINDATA_BLOCKCHAIN_H_
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 
 #include "libData/BlockData/Block/DSBlock.h"
@@ -26,10 +28,22 @@
 
 /// Transient storage for DS/Tx/ Blocks. The block should have function
 /// .GetHeader().GetBlockNum()
+/// Blocks are stored as shared immutable handles, so readers get them
+/// without copying. The last block is also published outside m_mutexBlocks
+/// and is read without taking it.
 template <class T>
 class BlockChain {
+ public:
+  typedef std::shared_ptr<const T> BlockPtr;
+
+ private:
   std::mutex m_mutexBlocks;
-  CircularArray<T> m_blocks;
+  CircularArray<BlockPtr> m_blocks;
+  /// Dummy block returned for block numbers not in the chain
+  const BlockPtr m_emptyBlock{std::make_shared<const T>()};
+  /// Read and replaced with std::atomic_load / std::atomic_store only
+  BlockPtr m_lastBlock;
+  std::atomic<uint64_t> m_lastBlockNum{INIT_BLOCK_NUMBER};
 
  protected:
   /// Constructor.
@@ -37,11 +51,19 @@ class BlockChain {
 
   ~BlockChain() {}
 
-  virtual T GetBlockFromPersistentStorage(const uint64_t& blockNum) = 0;
+  virtual BlockPtr GetBlockFromPersistentStorage(const uint64_t& blockNum) = 0;
 
  public:
   /// Reset
-  void Reset() { m_blocks.resize(BLOCKCHAIN_SIZE); }
+  void Reset() {
+    std::lock_guard<std::mutex> g(m_mutexBlocks);
+    m_blocks.resize(BLOCKCHAIN_SIZE);
+    for (uint64_t i = 0; i < m_blocks.capacity(); i++) {
+      m_blocks[i] = m_emptyBlock;
+    }
+    std::atomic_store(&m_lastBlock, m_emptyBlock);
+    m_lastBlockNum = INIT_BLOCK_NUMBER;
+  }
 
   /// Returns the number of blocks.
   uint64_t GetBlockCount() {
@@ -49,55 +71,67 @@ class BlockChain {
     return m_blocks.size();
   }
 
-  /// Returns the last stored block.
-  T GetLastBlock() {
-    std::lock_guard<std::mutex> g(m_mutexBlocks);
-    try {
-      return m_blocks.back();
-    } catch (...) {
-      return T();
-    }
-  }
+  /// Returns a handle to the last stored block without locking the chain.
+  BlockPtr GetLastBlockPtr() const { return std::atomic_load(&m_lastBlock); }
 
-  /// Returns the block at the specified block number.
-  T GetBlock(const uint64_t& blockNum) {
-    std::lock_guard<std::mutex> g(m_mutexBlocks);
+  /// Returns a copy of the last stored block.
+  T GetLastBlock() const { return *GetLastBlockPtr(); }
 
-    if (m_blocks.size() > 0 &&
-        (m_blocks.back().GetHeader().GetBlockNum() < blockNum)) {
-      LOG_GENERAL(WARNING,
-                  "BlockNum too high " << blockNum << " Dummy block used");
-      return T();
-    }
+  /// Returns the number of the last stored block without locking the chain.
+  uint64_t GetLastBlockNum() const { return m_lastBlockNum; }
 
-    else if (blockNum + m_blocks.capacity() < m_blocks.size()) {
-      return GetBlockFromPersistentStorage(blockNum);
-    }
+  /// Returns a handle to the block at the specified block number.
+  BlockPtr GetBlockPtr(const uint64_t& blockNum) {
+    {
+      std::lock_guard<std::mutex> g(m_mutexBlocks);
+
+      if (m_blocks.size() > 0 &&
+          (m_blocks.back()->GetHeader().GetBlockNum() < blockNum)) {
+        LOG_GENERAL(WARNING,
+                    "BlockNum too high " << blockNum << " Dummy block used");
+        return m_emptyBlock;
+      }
 
-    if (m_blocks[blockNum].GetHeader().GetBlockNum() != blockNum) {
-      LOG_GENERAL(WARNING,
-                  "BlockNum : " << blockNum << " != GetBlockNum() : "
-                                << m_blocks[blockNum].GetHeader().GetBlockNum()
-                                << ", a dummy block will be used and abnormal "
-                                   "behavior may happen!");
-      return T();
+      if (blockNum + m_blocks.capacity() >= m_blocks.size()) {
+        const BlockPtr& block = m_blocks[blockNum];
+        if (block->GetHeader().GetBlockNum() != blockNum) {
+          LOG_GENERAL(WARNING,
+                      "BlockNum : " << blockNum << " != GetBlockNum() : "
+                                    << block->GetHeader().GetBlockNum()
+                                    << ", a dummy block will be used and "
+                                       "abnormal behavior may happen!");
+          return m_emptyBlock;
+        }
+        return block;
+      }
     }
-    return m_blocks[blockNum];
+
+    // Overwritten in the chain, so no lock is needed to read it from disk
+    return GetBlockFromPersistentStorage(blockNum);
   }
+
+  /// Returns a copy of the block at the specified block number.
+  T GetBlock(const uint64_t& blockNum) { return *GetBlockPtr(blockNum); }
+
   /// Adds a block to the chain.
   int AddBlock(const T& block) {
-    uint64_t blockNumOfNewBlock = block.GetHeader().GetBlockNum();
+    return AddBlock(std::make_shared<const T>(block));
+  }
+
+  /// Adds a block to the chain, sharing the handle instead of copying it.
+  int AddBlock(const BlockPtr& block) {
+    uint64_t blockNumOfNewBlock = block->GetHeader().GetBlockNum();
 
     std::lock_guard<std::mutex> g(m_mutexBlocks);
 
     uint64_t blockNumOfExistingBlock =
-        m_blocks[blockNumOfNewBlock].GetHeader().GetBlockNum();
+        m_blocks[blockNumOfNewBlock]->GetHeader().GetBlockNum();
 
     if (blockNumOfExistingBlock < blockNumOfNewBlock ||
         INIT_BLOCK_NUMBER == blockNumOfExistingBlock) {
       if (m_blocks.size() > 0) {
         uint64_t blockNumOfLastBlock =
-            m_blocks.back().GetHeader().GetBlockNum();
+            m_blocks.back()->GetHeader().GetBlockNum();
         uint64_t blockNumMissed = blockNumOfNewBlock - blockNumOfLastBlock - 1;
         if (blockNumMissed > 0) {
           LOG_GENERAL(INFO,
@@ -108,6 +142,8 @@ class BlockChain {
         }
       }
       m_blocks.insert_new(blockNumOfNewBlock, block);
+      std::atomic_store(&m_lastBlock, block);
+      m_lastBlockNum = blockNumOfNewBlock;
     } else {
       LOG_GENERAL(WARNING, "Failed to add " << blockNumOfNewBlock << " "
                                             << blockNumOfExistingBlock);
@@ -120,33 +156,33 @@ class BlockChain {
 
 class DSBlockChain : public BlockChain<DSBlock> {
  public:
-  DSBlock GetBlockFromPersistentStorage(const uint64_t& blockNum) {
+  BlockPtr GetBlockFromPersistentStorage(const uint64_t& blockNum) {
     DSBlockSharedPtr block;
     if (!BlockStorage::GetBlockStorage().GetDSBlock(blockNum, block)) {
       LOG_GENERAL(WARNING, "BlockNum not in persistent storage "
                                << blockNum << " Dummy block used");
-      return DSBlock();
+      return std::make_shared<const DSBlock>();
     }
-    return *block;
+    return block;
   }
 };
 
 class TxBlockChain : public BlockChain<TxBlock> {
  public:
-  TxBlock GetBlockFromPersistentStorage(const uint64_t& blockNum) {
+  BlockPtr GetBlockFromPersistentStorage(const uint64_t& blockNum) {
     TxBlockSharedPtr block;
     if (!BlockStorage::GetBlockStorage().GetTxBlock(blockNum, block)) {
       LOG_GENERAL(WARNING, "BlockNum not in persistent storage "
                                << blockNum << " Dummy block used");
-      return TxBlock();
+      return std::make_shared<const TxBlock>();
     }
-    return *block;
+    return block;
   }
 };
 
 class VCBlockChain : public BlockChain<VCBlock> {
  public:
-  VCBlock GetBlockFromPersistentStorage([
+  BlockPtr GetBlockFromPersistentStorage([
       [gnu::unused]] const uint64_t& blockNum) {
     throw "vc block persistent storage not supported";
   }
@@ -154,7 +190,7 @@ class VCBlockChain : public BlockChain<VCBlock> {
 
 class FallbackBlockChain : public BlockChain<FallbackBlock> {
  public:
-  FallbackBlock GetBlockFromPersistentStorage([
+  BlockPtr GetBlockFromPersistentStorage([
       [gnu::unused]] const uint64_t& blockNum) {
     throw "fallback block persistent storage not supported";
   }
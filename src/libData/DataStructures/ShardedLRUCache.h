@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBDATA_DATASTRUCTURES_SHARDEDLRUCACHE_H_
+#define ZILLIQA_SRC_LIBDATA_DATASTRUCTURES_SHARDEDLRUCACHE_H_
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// Utility class - bounded least-recently-used cache, split into shards that
+/// are locked independently so that concurrent lookups of different keys
+/// rarely contend. Each shard holds up to capacity / numShards entries and
+/// evicts its own least recently used entry when full.
+template <class K, class V, class Hash = std::hash<K>>
+class ShardedLRUCache {
+  using Item = std::pair<K, V>;
+
+  struct Shard {
+    std::mutex m_mutex;
+    /// Most recently used first
+    std::list<Item> m_items;
+    std::unordered_map<K, typename std::list<Item>::iterator, Hash> m_index;
+  };
+
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  size_t m_shardCapacity;
+  Hash m_hash;
+
+  Shard& GetShard(const K& key) {
+    return *m_shards[m_hash(key) % m_shards.size()];
+  }
+
+ public:
+  /// Constructor.
+  ShardedLRUCache(size_t capacity, size_t numShards) {
+    if (numShards == 0) {
+      numShards = 1;
+    }
+    m_shardCapacity = (capacity + numShards - 1) / numShards;
+    for (size_t i = 0; i < numShards; i++) {
+      m_shards.emplace_back(new Shard());
+    }
+  }
+
+  ShardedLRUCache(const ShardedLRUCache&) = delete;
+  ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+
+  /// Copies the value of key into value and marks it as recently used.
+  bool Get(const K& key, V& value) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> g(shard.m_mutex);
+
+    auto it = shard.m_index.find(key);
+    if (it == shard.m_index.end()) {
+      return false;
+    }
+    shard.m_items.splice(shard.m_items.begin(), shard.m_items, it->second);
+    value = it->second->second;
+    return true;
+  }
+
+  /// Adds or replaces the value of key.
+  void Put(const K& key, const V& value) {
+    if (m_shardCapacity == 0) {
+      return;
+    }
+
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> g(shard.m_mutex);
+
+    auto it = shard.m_index.find(key);
+    if (it != shard.m_index.end()) {
+      it->second->second = value;
+      shard.m_items.splice(shard.m_items.begin(), shard.m_items, it->second);
+      return;
+    }
+
+    if (shard.m_items.size() >= m_shardCapacity) {
+      shard.m_index.erase(shard.m_items.back().first);
+      shard.m_items.pop_back();
+    }
+    shard.m_items.emplace_front(key, value);
+    shard.m_index.emplace(key, shard.m_items.begin());
+  }
+
+  /// Removes the entry of key, if any.
+  void Erase(const K& key) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> g(shard.m_mutex);
+
+    auto it = shard.m_index.find(key);
+    if (it == shard.m_index.end()) {
+      return;
+    }
+    shard.m_items.erase(it->second);
+    shard.m_index.erase(it);
+  }
+
+  /// Removes all entries.
+  void Clear() {
+    for (auto& shard : m_shards) {
+      std::lock_guard<std::mutex> g(shard->m_mutex);
+      shard->m_items.clear();
+      shard->m_index.clear();
+    }
+  }
+
+  /// Returns the number of entries across all shards.
+  size_t Size() {
+    size_t size = 0;
+    for (auto& shard : m_shards) {
+      std::lock_guard<std::mutex> g(shard->m_mutex);
+      size += shard->m_items.size();
+    }
+    return size;
+  }
+};
+
+#endif  // ZILLIQA_SRC_LIBDATA_DATASTRUCTURES_SHARDEDLRUCACHE_H_
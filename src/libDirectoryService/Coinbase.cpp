@@ -420,13 +420,12 @@ void DirectoryService::StoreCoinbaseInDiagnosticDB(
   if ((MAX_ENTRIES_FOR_DIAGNOSTIC_DATA > 0) &&  // If limit is 0, skip deletion
       (BlockStorage::GetBlockStorage().GetDiagnosticDataCoinbaseCount() >=
        MAX_ENTRIES_FOR_DIAGNOSTIC_DATA) &&  // Limit reached
-      (m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() >=
+      (m_mediator.m_dsBlockChain.GetLastBlockNum() >=
        MAX_ENTRIES_FOR_DIAGNOSTIC_DATA)) {  // DS Block number is not below
                                             // limit
 
-    const uint64_t oldBlockNum =
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() -
-        MAX_ENTRIES_FOR_DIAGNOSTIC_DATA;
+    const uint64_t oldBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum() -
+                                 MAX_ENTRIES_FOR_DIAGNOSTIC_DATA;
 
     canPutNewEntry =
         BlockStorage::GetBlockStorage().DeleteDiagnosticDataCoinbase(
@@ -443,7 +442,6 @@ void DirectoryService::StoreCoinbaseInDiagnosticDB(
 
   if (canPutNewEntry) {
     BlockStorage::GetBlockStorage().PutDiagnosticDataCoinbase(
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
-        entry);
+        m_mediator.m_dsBlockChain.GetLastBlockNum(), entry);
   }
 }
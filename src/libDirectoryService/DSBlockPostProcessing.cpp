@@ -428,9 +428,7 @@ void DirectoryService::StartFirstTxEpoch() {
     LOG_STATE(
         "[MIBLKSWAIT]["
         << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-        << "]["
-        << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-               1
+        << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
         << "] BEGIN");
 
     m_stopRecvNewMBSubmission = false;
@@ -458,10 +456,7 @@ void DirectoryService::StartFirstTxEpoch() {
         LOG_STATE("[MIBLKSWAIT]["
                   << setw(15) << left
                   << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["
-                  << m_mediator.m_txBlockChain.GetLastBlock()
-                             .GetHeader()
-                             .GetBlockNum() +
-                         1
+                  << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
                   << "] TIMEOUT: Didn't receive all Microblock.");
 
         m_stopRecvNewMBSubmission = true;
@@ -518,10 +513,7 @@ void DirectoryService::ProcessDSBlockConsensusWhenDone() {
     LOG_STATE(
         "[DSCON]["
         << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-        << "]["
-        << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-               1
-        << "] DONE");
+        << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1 << "] DONE");
   }
 
   {
@@ -538,8 +530,7 @@ void DirectoryService::ProcessDSBlockConsensusWhenDone() {
     m_pendingDSBlock->SetCoSignatures(*m_consensusObject);
 
     if (m_pendingDSBlock->GetHeader().GetBlockNum() >
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-            1) {
+        m_mediator.m_dsBlockChain.GetLastBlockNum() + 1) {
       LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
                 "We are missing some blocks. What to do here?");
     }
@@ -622,8 +613,7 @@ void DirectoryService::ProcessDSBlockConsensusWhenDone() {
   LOG_STATE(
       "[DSBLK]["
       << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-      << "]["
-      << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1
+      << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
       << "] AFTER SENDING DSBLOCK");
 
   ClearVCBlockVector();
@@ -916,8 +916,8 @@ bool DirectoryService::RunConsensusOnDSBlockWhenDSPrimary() {
       "[DSCON]["
       << std::setw(15) << std::left
       << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["
-      << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1
-      << "] BGIN, POWS = " << m_allPoWs.size());
+      << m_mediator.m_txBlockChain.GetLastBlockNum() + 1 << "] BGIN, POWS = "
+      << m_allPoWs.size());
 
   // Refer to Effective mordern C++. Item 32: Use init capture to move objects
   // into closures.
@@ -1097,10 +1097,8 @@ bool DirectoryService::RunConsensusOnDSBlockWhenDSBackup() {
   }
 
 #ifdef VC_TEST_VC_PRECHECK_1
-  uint64_t dsCurBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
-  uint64_t txCurBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t dsCurBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum();
+  uint64_t txCurBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
 
   // FIXME: Prechecking not working due at epoch 1 due to the way we have low
   // blocknum
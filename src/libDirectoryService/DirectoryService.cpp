@@ -83,8 +83,7 @@ void DirectoryService::StartSynchronization(bool clean) {
           m_mediator.m_blocklinkchain.GetLatestIndex() + 1);
       m_synchronizer.FetchLatestTxBlockSeed(
           m_mediator.m_lookup,
-          m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-              1);
+          m_mediator.m_txBlockChain.GetLastBlockNum() + 1);
       this_thread::sleep_for(chrono::seconds(NEW_NODE_SYNC_INTERVAL));
     }
   };
@@ -286,9 +285,7 @@ bool DirectoryService::ProcessSetPrimary(const bytes& message,
   }
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
-            "START OF EPOCH " << m_mediator.m_dsBlockChain.GetLastBlock()
-                                         .GetHeader()
-                                         .GetBlockNum() +
+            "START OF EPOCH " << m_mediator.m_dsBlockChain.GetLastBlockNum() +
                                      1);
 
   if (primary == m_mediator.m_selfPeer) {
@@ -355,7 +352,7 @@ bool DirectoryService::CheckWhetherDSBlockIsFresh(const uint64_t dsblock_num) {
   // uint128_t latest_block_num_in_blockchain =
   // m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
   uint64_t latest_block_num_in_blockchain =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+      m_mediator.m_dsBlockChain.GetLastBlockNum();
 
   if (dsblock_num < latest_block_num_in_blockchain + 1) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
@@ -647,8 +644,7 @@ void DirectoryService::StartNewDSEpochConsensus(bool fromFallback,
   cv_POWSubmission.notify_all();
 
   POW::GetInstance().EthashConfigureClient(
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1,
-      FULL_DATASET_MINE);
+      m_mediator.m_dsBlockChain.GetLastBlockNum() + 1, FULL_DATASET_MINE);
 
   if (m_mode == PRIMARY_DS) {
     // Notify lookup that it's time to do PoW
@@ -790,8 +786,7 @@ bool DirectoryService::UpdateDSGuardIdentity() {
   bytes updatedsguardidentitymessage = {MessageType::DIRECTORY,
                                         DSInstructionType::NEWDSGUARDIDENTITY};
 
-  uint64_t curDSEpochNo =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+  uint64_t curDSEpochNo = m_mediator.m_dsBlockChain.GetLastBlockNum() + 1;
 
   if (!Messenger::SetDSLookupNewDSGuardNetworkInfo(
           updatedsguardidentitymessage, MessageOffset::BODY, curDSEpochNo,
@@ -855,7 +850,7 @@ bool DirectoryService::ProcessNewDSGuardNetworkInfo(
   }
 
   uint64_t currentDSEpochNumber =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+      m_mediator.m_dsBlockChain.GetLastBlockNum() + 1;
   uint64_t loCurrentDSEpochNumber = currentDSEpochNumber - 1;
   uint64_t hiCurrentDSEpochNumber = currentDSEpochNumber + 1;
 
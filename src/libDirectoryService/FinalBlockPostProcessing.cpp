@@ -58,7 +58,9 @@ bool DirectoryService::StoreFinalBlockToDisk() {
     bytes body;
     m_mediator.m_node->m_microblock->Serialize(body, 0);
     if (!BlockStorage::GetBlockStorage().PutMicroBlock(
-            m_mediator.m_node->m_microblock->GetBlockHash(), body)) {
+            m_mediator.m_node->m_microblock->GetBlockHash(),
+            m_mediator.m_node->m_microblock->GetHeader().GetEpochNum(),
+            m_mediator.m_node->m_microblock->GetHeader().GetShardId(), body)) {
       LOG_GENERAL(WARNING, "Failed to put microblock in persistence");
       return false;
     }
@@ -88,8 +90,7 @@ bool DirectoryService::StoreFinalBlockToDisk() {
   bytes stateDelta;
   AccountStore::GetInstance().GetSerializedDelta(stateDelta);
   if (!BlockStorage::GetBlockStorage().PutStateDelta(
-          m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
-          stateDelta)) {
+          m_mediator.m_txBlockChain.GetLastBlockNum(), stateDelta)) {
     LOG_GENERAL(WARNING, "Failed to put statedelta in persistence");
     return false;
   }
@@ -110,8 +111,7 @@ bool DirectoryService::ComposeFinalBlockMessageForSender(
 
   finalblock_message = {MessageType::NODE, NodeInstructionType::FINALBLOCK};
 
-  const uint64_t dsBlockNumber =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  const uint64_t dsBlockNumber = m_mediator.m_dsBlockChain.GetLastBlockNum();
 
   bytes stateDelta;
   AccountStore::GetInstance().GetSerializedDelta(stateDelta);
@@ -146,10 +146,7 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
     LOG_STATE(
         "[FBCON]["
         << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-        << "]["
-        << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-               1
-        << "] DONE");
+        << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1 << "] DONE");
   }
 
   // Update the final block with the co-signatures from the consensus
@@ -182,11 +179,10 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
   if (isVacuousEpoch) {
     auto writeStateToDisk = [this]() -> void {
       if (!AccountStore::GetInstance().MoveUpdatesToDisk(
-              ENABLE_REPOPULATE && (m_mediator.m_dsBlockChain.GetLastBlock()
-                                            .GetHeader()
-                                            .GetBlockNum() %
-                                        REPOPULATE_STATE_PER_N_DS ==
-                                    REPOPULATE_STATE_IN_DS))) {
+              ENABLE_REPOPULATE &&
+              (m_mediator.m_dsBlockChain.GetLastBlockNum() %
+                   REPOPULATE_STATE_PER_N_DS ==
+               REPOPULATE_STATE_IN_DS))) {
         LOG_GENERAL(WARNING, "MoveUpdatesToDisk failed, what to do?");
         return;
       } else {
@@ -212,15 +208,11 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
         LOG_STATE("[FLBLK][" << setw(15) << left
                              << m_mediator.m_selfPeer.GetPrintableIPAddress()
                              << "]["
-                             << m_mediator.m_txBlockChain.GetLastBlock()
-                                        .GetHeader()
-                                        .GetBlockNum() +
-                                    1
+                             << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
                              << "] FINISH WRITE STATE TO DISK");
       }
       if (ENABLE_ACCOUNTS_POPULATING &&
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() <
-              PREGEN_ACCOUNT_TIMES) {
+          m_mediator.m_dsBlockChain.GetLastBlockNum() < PREGEN_ACCOUNT_TIMES) {
         m_mediator.m_node->PopulateAccounts();
       }
     };
@@ -249,8 +241,8 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
 
   // Acquire shard receivers cosigs from MicroBlocks
   unordered_map<uint32_t, BlockBase> t_microBlocks;
-  const auto& microBlocks = m_microBlocks
-      [m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum()];
+  const auto& microBlocks =
+      m_microBlocks[m_mediator.m_txBlockChain.GetLastBlockNum()];
   for (const auto& microBlock : microBlocks) {
     t_microBlocks.emplace(microBlock.GetHeader().GetShardId(), microBlock);
   }
@@ -270,8 +262,7 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
   LOG_STATE(
       "[FLBLK]["
       << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-      << "]["
-      << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1
+      << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
       << "] AFTER SENDING FLBLK");
 
   if (m_mediator.m_node->m_microblock != nullptr &&
@@ -308,9 +299,7 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
       LOG_STATE("[MIBLKSWAIT][" << setw(15) << left
                                 << m_mediator.m_selfPeer.GetPrintableIPAddress()
                                 << "]["
-                                << m_mediator.m_txBlockChain.GetLastBlock()
-                                           .GetHeader()
-                                           .GetBlockNum() +
+                                << m_mediator.m_txBlockChain.GetLastBlockNum() +
                                        1
                                 << "] BEGIN");
 
@@ -332,10 +321,7 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
         LOG_STATE("[MIBLKSWAIT]["
                   << setw(15) << left
                   << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["
-                  << m_mediator.m_txBlockChain.GetLastBlock()
-                             .GetHeader()
-                             .GetBlockNum() +
-                         1
+                  << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
                   << "] TIMEOUT: Didn't receive all Microblock.");
 
         m_stopRecvNewMBSubmission = true;
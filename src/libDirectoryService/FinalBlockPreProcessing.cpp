@@ -173,16 +173,16 @@ bool DirectoryService::ComposeFinalBlock() {
           allGasLimit, allGasUsed, allRewards, blockNum,
           {stateRoot, stateDeltaHash, mbInfoHash}, numTxs,
           m_mediator.m_selfKey.second,
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
-          version, committeeHash, prevHash),
+          m_mediator.m_dsBlockChain.GetLastBlockNum(), version, committeeHash,
+          prevHash),
       mbInfos, CoSignatures(m_mediator.m_DSCommittee->size())));
 
   LOG_STATE(
       "[STATS]["
       << std::setw(15) << std::left
       << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["
-      << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1
-      << "][" << m_finalBlock->GetHeader().GetNumTxs() << "] FINAL");
+      << m_mediator.m_txBlockChain.GetLastBlockNum() + 1 << "]["
+      << m_finalBlock->GetHeader().GetNumTxs() << "] FINAL");
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
             "Final block Composed: " << *m_finalBlock);
@@ -275,10 +275,7 @@ bool DirectoryService::RunConsensusOnFinalBlockWhenDSPrimary() {
     LOG_STATE(
         "[FBCON]["
         << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-        << "]["
-        << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-               1
-        << "] BGIN");
+        << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1 << "] BGIN");
   }
 
   auto announcementGeneratorFunc =
@@ -1016,10 +1013,8 @@ bool DirectoryService::RunConsensusOnFinalBlockWhenDSBackup() {
   }
 
 #ifdef VC_TEST_VC_PRECHECK_2
-  uint64_t dsCurBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
-  uint64_t txCurBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t dsCurBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum();
+  uint64_t txCurBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
 
   // FIXME: Prechecking not working due at epoch 1 due to the way we have low
   // blocknum
@@ -27,8 +27,7 @@ uint128_t DirectoryService::GetNewGasPrice() {
 
   uint64_t loBlockNum =
       m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetEpochNum();
-  uint64_t hiBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t hiBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
   uint64_t totalBlockNum = 0;
   uint64_t fullBlockNum = 0;
 
@@ -53,8 +52,7 @@ uint128_t DirectoryService::GetNewGasPrice() {
 }
 
 uint128_t DirectoryService::GetHistoricalMeanGasPrice() {
-  uint64_t curDSBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t curDSBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum();
   uint64_t lowDSBlockNum = (curDSBlockNum > MEAN_GAS_PRICE_DS_NUM)
                                ? (curDSBlockNum - MEAN_GAS_PRICE_DS_NUM)
                                : 0;
@@ -53,6 +53,7 @@ bool DirectoryService::VerifyMicroBlockCoSignature(const MicroBlock& microBlock,
 
   const vector<bool>& B2 = microBlock.GetB2();
   vector<PubKey> keys;
+  keys.reserve(B2.size());
   unsigned int index = 0;
   unsigned int count = 0;
 
@@ -65,8 +66,8 @@ bool DirectoryService::VerifyMicroBlockCoSignature(const MicroBlock& microBlock,
     }
 
     for (const auto& ds : *m_mediator.m_DSCommittee) {
+      keys.emplace_back(ds.first);
       if (B2.at(index)) {
-        keys.emplace_back(ds.first);
         count++;
       }
       index++;
@@ -81,10 +82,9 @@ bool DirectoryService::VerifyMicroBlockCoSignature(const MicroBlock& microBlock,
       return false;
     }
 
-    // Generate the aggregated key
     for (const auto& kv : shard) {
+      keys.emplace_back(std::get<SHARD_NODE_PUBKEY>(kv));
       if (B2.at(index)) {
-        keys.emplace_back(std::get<SHARD_NODE_PUBKEY>(kv));
         count++;
       }
       index++;
@@ -96,7 +96,9 @@ bool DirectoryService::VerifyMicroBlockCoSignature(const MicroBlock& microBlock,
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  // Generate the aggregated key
+  shared_ptr<PubKey> aggregatedKey =
+      MultiSig::GetInstance().AggregateCommitteeKeys(keys, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -113,8 +115,10 @@ bool DirectoryService::VerifyMicroBlockCoSignature(const MicroBlock& microBlock,
   if (!MultiSig::GetInstance().MultiSigVerify(
           message, 0, message.size(), microBlock.GetCS2(), *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    for (unsigned int i = 0; i < keys.size(); i++) {
+      if (B2.at(i)) {
+        LOG_GENERAL(WARNING, keys.at(i));
+      }
     }
     return false;
   }
@@ -309,8 +313,9 @@ bool DirectoryService::ProcessMicroblockSubmissionFromShardCore(
 
   bytes body;
   microBlock.Serialize(body, 0);
-  if (!BlockStorage::GetBlockStorage().PutMicroBlock(microBlock.GetBlockHash(),
-                                                     body)) {
+  if (!BlockStorage::GetBlockStorage().PutMicroBlock(
+          microBlock.GetBlockHash(), microBlock.GetHeader().GetEpochNum(),
+          microBlock.GetHeader().GetShardId(), body)) {
     LOG_GENERAL(WARNING, "Failed to put microblock in persistence");
     return false;
   }
@@ -656,7 +661,9 @@ bool DirectoryService::ProcessMissingMicroblockSubmission(
       bytes body;
       microBlocks[i].Serialize(body, 0);
       if (!BlockStorage::GetBlockStorage().PutMicroBlock(
-              microBlocks[i].GetBlockHash(), body)) {
+              microBlocks[i].GetBlockHash(),
+              microBlocks[i].GetHeader().GetEpochNum(),
+              microBlocks[i].GetHeader().GetShardId(), body)) {
         LOG_GENERAL(WARNING, "Failed to put microblock in persistence");
         return false;
       }
@@ -325,8 +325,8 @@ void DirectoryService::ProcessViewChangeConsensusWhenDone() {
 
     // Acquire shard receivers cosigs from MicroBlocks
     unordered_map<uint32_t, BlockBase> t_microBlocks;
-    const auto& microBlocks = m_microBlocks
-        [m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum()];
+    const auto& microBlocks =
+        m_microBlocks[m_mediator.m_txBlockChain.GetLastBlockNum()];
     for (const auto& microBlock : microBlocks) {
       t_microBlocks.emplace(microBlock.GetHeader().GetShardId(), microBlock);
     }
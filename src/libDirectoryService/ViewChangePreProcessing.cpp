@@ -257,10 +257,8 @@ void DirectoryService::RunConsensusOnViewChange() {
   SetLastKnownGoodState();
   SetState(VIEWCHANGE_CONSENSUS_PREP);
 
-  uint64_t dsCurBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
-  uint64_t txCurBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t dsCurBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum();
+  uint64_t txCurBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
 
   // Note: Special check as 0 and 1 have special usage when fetching ds block
   // and final block No need check for 1 as
@@ -422,8 +420,7 @@ bool DirectoryService::ComputeNewCandidateLeader(
     // To-do: Handle exceptions.
     m_pendingVCBlock.reset(new VCBlock(
         VCBlockHeader(
-            m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-                1,
+            m_mediator.m_dsBlockChain.GetLastBlockNum() + 1,
             m_mediator.m_currentEpochNum, m_viewChangestate,
             newLeaderNetworkInfo,
             m_mediator.m_DSCommittee->at(candidateLeaderIndex).first,
@@ -720,10 +717,8 @@ bytes DirectoryService::ComposeVCGetDSTxBlockMessage() {
   LOG_MARKER();
   bytes getDSTxBlockMessage = {MessageType::LOOKUP,
                                LookupInstructionType::VCGETLATESTDSTXBLOCK};
-  uint64_t dslowBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
-  uint64_t txlowBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+  uint64_t dslowBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum() + 1;
+  uint64_t txlowBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum() + 1;
   if (!Messenger::SetLookupGetDSTxBlockFromSeed(
           getDSTxBlockMessage, MessageOffset::BODY, dslowBlockNum, 0,
           txlowBlockNum, 0, m_mediator.m_selfPeer.m_listenPortHost)) {
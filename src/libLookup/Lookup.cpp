@@ -561,21 +561,25 @@ bytes Lookup::ComposeGetDSInfoMessage(bool initialDS) {
   return getDSNodesMessage;
 }
 
-bytes Lookup::ComposeGetStateMessage() {
+bytes Lookup::ComposeGetStateChunkMessage(const StateHash& stateRoot,
+                                          const Address& start,
+                                          const Address& end,
+                                          bool digestOnly) {
   LOG_MARKER();
 
-  bytes getStateMessage = {MessageType::LOOKUP,
-                           LookupInstructionType::GETSTATEFROMSEED};
+  bytes getStateChunkMessage = {MessageType::LOOKUP,
+                                LookupInstructionType::GETSTATECHUNKFROMSEED};
 
-  if (!Messenger::SetLookupGetStateFromSeed(
-          getStateMessage, MessageOffset::BODY,
-          m_mediator.m_selfPeer.m_listenPortHost)) {
+  if (!Messenger::SetLookupGetStateChunkFromSeed(
+          getStateChunkMessage, MessageOffset::BODY,
+          m_mediator.m_selfPeer.m_listenPortHost, stateRoot, start, end,
+          digestOnly)) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
-              "Messenger::SetLookupGetStateFromSeed failed.");
+              "Messenger::SetLookupGetStateChunkFromSeed failed.");
     return {};
   }
 
-  return getStateMessage;
+  return getStateChunkMessage;
 }
 
 bool Lookup::GetDSInfoFromSeedNodes() {
@@ -591,10 +595,178 @@ bool Lookup::GetDSInfoFromLookupNodes(bool initialDS) {
 }
 
 bool Lookup::GetStateFromSeedNodes() {
-  SendMessageToRandomSeedNode(ComposeGetStateMessage());
+  LOG_MARKER();
+
+  if (GetSeedNodes().empty()) {
+    LOG_GENERAL(WARNING, "Seed nodes are empty");
+    return false;
+  }
+
+  const auto lastTxBlock = m_mediator.m_txBlockChain.GetLastBlockPtr();
+  const uint64_t blockNum = lastTxBlock->GetHeader().GetBlockNum();
+  const StateHash stateRoot = lastTxBlock->GetHeader().GetStateRootHash();
+  const unsigned int numRanges =
+      max(min(STATE_SYNC_NUM_RANGES, (unsigned int)0x10000), 1u);
+
+  unsigned int syncId = 0;
+  {
+    lock_guard<mutex> g(m_mutexStateSync);
+
+    if (!m_stateSyncRanges.empty()) {
+      if (blockNum > m_stateSyncBlockNum) {
+        RepinStateSync(blockNum, stateRoot);
+        cv_stateSync.notify_all();
+      } else {
+        LOG_GENERAL(INFO, "Already syncing state " << m_stateSyncRoot.hex());
+      }
+      return true;
+    }
+
+    // Split the address space evenly on the first two bytes
+    m_stateSyncRanges.assign(numRanges, StateSyncRange());
+    for (unsigned int i = 1; i < numRanges; i++) {
+      const unsigned int prefix = i * 0x10000 / numRanges;
+      Address boundary;
+      boundary.asArray()[0] = prefix >> 8;
+      boundary.asArray()[1] = prefix & 0xff;
+      m_stateSyncRanges[i - 1].m_end = boundary;
+      m_stateSyncRanges[i].m_start = boundary;
+      m_stateSyncRanges[i].m_next = boundary;
+    }
+
+    m_stateSyncRoot = stateRoot;
+    m_stateSyncBlockNum = blockNum;
+    m_stateSyncStale = false;
+    syncId = ++m_stateSyncId;
+
+    AccountStore::GetInstance().Init();
+  }
+
+  LOG_GENERAL(INFO, "Syncing state " << stateRoot.hex() << " in " << numRanges
+                                     << " ranges");
+
+  auto func = [this, syncId]() -> void { StateSyncLoop(syncId); };
+  DetachedFunction(1, func);
   return true;
 }
 
+void Lookup::RepinStateSync(uint64_t blockNum, const StateHash& stateRoot) {
+  LOG_GENERAL(INFO, "State sync moves from " << m_stateSyncRoot.hex()
+                                             << " to " << stateRoot.hex()
+                                             << " of Tx block " << blockNum);
+
+  m_stateSyncRoot = stateRoot;
+  m_stateSyncBlockNum = blockNum;
+  m_stateSyncStale = false;
+
+  // Replies for the old root are ignored from now on
+  for (auto& range : m_stateSyncRanges) {
+    range.m_pending = false;
+    range.m_verify = range.m_done || range.m_next != range.m_start;
+  }
+}
+
+void Lookup::StateSyncLoop(unsigned int syncId) {
+  LOG_MARKER();
+
+  const VectorOfNode seedNodes = GetSeedNodes();
+
+  unique_lock<mutex> lock(m_mutexStateSync);
+  while (syncId == m_stateSyncId) {
+    const auto now = chrono::steady_clock::now();
+
+    if (m_stateSyncStale) {
+      const auto lastTxBlock = m_mediator.m_txBlockChain.GetLastBlockPtr();
+      if (lastTxBlock->GetHeader().GetBlockNum() > m_stateSyncBlockNum) {
+        RepinStateSync(lastTxBlock->GetHeader().GetBlockNum(),
+                       lastTxBlock->GetHeader().GetStateRootHash());
+      }
+    }
+
+    bool done = true;
+    unsigned int numPending = 0;
+    for (auto& range : m_stateSyncRanges) {
+      if (range.m_done && !range.m_verify) {
+        continue;
+      }
+      done = false;
+      if (range.m_pending &&
+          now - range.m_requestTime >=
+              chrono::seconds(STATE_SYNC_CHUNK_TIMEOUT_IN_SECONDS)) {
+        LOG_GENERAL(INFO, "Timed out waiting for state chunk at "
+                              << range.m_next.hex());
+        range.m_pending = false;
+      }
+      if (range.m_pending) {
+        numPending++;
+      }
+    }
+
+    if (done) {
+      const StateHash stateRoot =
+          AccountStore::GetInstance().GetStateRootHash();
+      if (stateRoot == m_stateSyncRoot) {
+        break;
+      }
+      LOG_GENERAL(WARNING, "State root mismatch after sync. Expected: "
+                               << m_stateSyncRoot.hex()
+                               << " Actual: " << stateRoot.hex());
+
+      // Every range is checked again, against the latest Tx block if it is
+      // newer, and only the ones that differ are fetched again
+      const auto lastTxBlock = m_mediator.m_txBlockChain.GetLastBlockPtr();
+      if (lastTxBlock->GetHeader().GetBlockNum() > m_stateSyncBlockNum) {
+        RepinStateSync(lastTxBlock->GetHeader().GetBlockNum(),
+                       lastTxBlock->GetHeader().GetStateRootHash());
+      } else {
+        RepinStateSync(m_stateSyncBlockNum, m_stateSyncRoot);
+      }
+      continue;
+    }
+
+    for (unsigned int i = 0; i < m_stateSyncRanges.size() &&
+                             numPending < STATE_SYNC_PARALLEL_REQUESTS;
+         i++) {
+      StateSyncRange& range = m_stateSyncRanges[i];
+      if ((range.m_done && !range.m_verify) || range.m_pending) {
+        continue;
+      }
+
+      // Ranges are spread over the seeds, and a retry goes to the next seed
+      const Peer& seed =
+          seedNodes[(i + range.m_attempts) % seedNodes.size()].second;
+      const auto resolved_ip = TryGettingResolvedIP(seed);
+      Blacklist::GetInstance().Exclude(resolved_ip);
+      P2PComm::GetInstance().SendMessage(
+          Peer(resolved_ip, seed.GetListenPortHost()),
+          range.m_verify
+              ? ComposeGetStateChunkMessage(m_stateSyncRoot, range.m_start,
+                                            range.FetchedEnd(), true)
+              : ComposeGetStateChunkMessage(m_stateSyncRoot, range.m_next,
+                                            range.m_end, false));
+
+      range.m_pending = true;
+      range.m_requestTime = now;
+      range.m_attempts++;
+      numPending++;
+    }
+
+    cv_stateSync.wait_for(lock, chrono::seconds(1));
+  }
+
+  if (syncId != m_stateSyncId) {
+    LOG_GENERAL(INFO, "State sync towards " << m_stateSyncRoot.hex()
+                                            << " has been replaced");
+    return;
+  }
+  m_stateSyncRanges.clear();
+  const StateHash stateRoot = m_stateSyncRoot;
+  lock.unlock();
+
+  LOG_GENERAL(INFO, "State " << stateRoot.hex() << " synced");
+  FinishSetStateFromSeed();
+}
+
 bytes Lookup::ComposeGetDSBlockMessage(uint64_t lowBlockNum,
                                        uint64_t highBlockNum) {
   LOG_MARKER();
@@ -995,8 +1167,7 @@ void Lookup::RetrieveDSBlocks(vector<DSBlock>& dsBlocks, uint64_t& lowBlockNum,
                               uint64_t& highBlockNum, bool partialRetrieve) {
   lock_guard<mutex> g(m_mediator.m_node->m_mutexDSBlock);
 
-  uint64_t curBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t curBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum();
 
   if (INIT_BLOCK_NUMBER == curBlockNum) {
     LOG_GENERAL(WARNING,
@@ -1087,6 +1258,82 @@ bool Lookup::ProcessGetStateFromSeed(const bytes& message, unsigned int offset,
   return true;
 }
 
+bool Lookup::ProcessGetStateChunkFromSeed(const bytes& message,
+                                          unsigned int offset,
+                                          const Peer& from) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING,
+                "Lookup::ProcessGetStateChunkFromSeed not expected to be "
+                "called from other than the LookUp node.");
+    return true;
+  }
+
+  LOG_MARKER();
+
+  uint32_t portNo = 0;
+  StateHash stateRoot;
+  Address start, end;
+  bool digestOnly = false;
+
+  if (!Messenger::GetLookupGetStateChunkFromSeed(
+          message, offset, portNo, stateRoot, start, end, digestOnly)) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "Messenger::GetLookupGetStateChunkFromSeed failed.");
+    return false;
+  }
+
+  if (end != Address() && !(start < end)) {
+    LOG_GENERAL(WARNING, "Invalid state range " << start.hex() << " - "
+                                                << end.hex());
+    return false;
+  }
+
+  bytes accountStoreBytes;
+  Address next = end;
+  dev::h256 digest;
+  bool stale = false;
+  if (digestOnly) {
+    stale = !AccountStore::GetInstance().GetStateRangeDigest(stateRoot, start,
+                                                             end, digest);
+  } else if (!AccountStore::GetInstance().SerializeStateChunk(
+                 stateRoot, start, end, STATE_SYNC_CHUNK_NUM_ACCOUNTS,
+                 accountStoreBytes, next, stale) &&
+             !stale) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "AccountStore::SerializeStateChunk failed.");
+    return false;
+  }
+
+  // Tell the requester which Tx block to fetch for a root it can move on to
+  uint64_t latestBlockNum = 0;
+  if (stale) {
+    latestBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
+    LOG_GENERAL(INFO, "State " << stateRoot.hex()
+                               << " is stale, latest Tx block is "
+                               << latestBlockNum);
+    accountStoreBytes.clear();
+    digest = dev::h256();
+    next = start;
+  }
+
+  Peer requestingNode(from.m_ipAddress, portNo);
+  bytes setStateChunkMessage = {MessageType::LOOKUP,
+                                LookupInstructionType::SETSTATECHUNKFROMSEED};
+
+  if (!Messenger::SetLookupSetStateChunkFromSeed(
+          setStateChunkMessage, MessageOffset::BODY, m_mediator.m_selfKey,
+          stateRoot, start, end, next, accountStoreBytes, digest, stale,
+          latestBlockNum)) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "Messenger::SetLookupSetStateChunkFromSeed failed.");
+    return false;
+  }
+
+  P2PComm::GetInstance().SendMessage(requestingNode, setStateChunkMessage);
+
+  return true;
+}
+
 // TODO: Refactor the code to remove the following assumption
 // lowBlockNum = 1 => Latest block number
 // lowBlockNum = 0 => lowBlockNum set to 1
@@ -1162,8 +1409,7 @@ void Lookup::RetrieveTxBlocks(vector<TxBlock>& txBlocks, uint64_t& lowBlockNum,
   }
 
   if (highBlockNum == 0) {
-    highBlockNum =
-        m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+    highBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
   }
 
   if (INIT_BLOCK_NUMBER == highBlockNum) {
@@ -1439,8 +1685,9 @@ bool Lookup::AddMicroBlockToStorage(const MicroBlock& microblock) {
 
   bytes body;
   microblock.Serialize(body, 0);
-  if (!BlockStorage::GetBlockStorage().PutMicroBlock(microblock.GetBlockHash(),
-                                                     body)) {
+  if (!BlockStorage::GetBlockStorage().PutMicroBlock(
+          microblock.GetBlockHash(), microblock.GetHeader().GetEpochNum(),
+          microblock.GetHeader().GetShardId(), body)) {
     LOG_GENERAL(WARNING, "Failed to put microblock in body");
     return false;
   }
@@ -1728,8 +1975,7 @@ bool Lookup::ProcessSetDSBlockFromSeed(const bytes& message,
     return false;
   }
 
-  uint64_t latestSynBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+  uint64_t latestSynBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum() + 1;
 
   if (latestSynBlockNum > highBlockNum) {
     // TODO: We should get blocks from n nodes.
@@ -1755,8 +2001,7 @@ bool Lookup::ProcessSetDSBlockFromSeed(const bytes& message,
       LOG_GENERAL(WARNING, "Initial DS comm size 0, it is unset")
       return true;
     }
-    uint64_t dsblocknumbefore =
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+    uint64_t dsblocknumbefore = m_mediator.m_dsBlockChain.GetLastBlockNum();
     uint64_t index_num = m_mediator.m_blocklinkchain.GetLatestIndex() + 1;
 
     DequeOfNode newDScomm;
@@ -1766,8 +2011,7 @@ bool Lookup::ProcessSetDSBlockFromSeed(const bytes& message,
       LOG_GENERAL(WARNING, "Could not verify all DS blocks");
     }
     m_mediator.m_blocklinkchain.SetBuiltDSComm(newDScomm);
-    uint64_t dsblocknumafter =
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+    uint64_t dsblocknumafter = m_mediator.m_dsBlockChain.GetLastBlockNum();
 
     LOG_GENERAL(INFO, "DS epoch before" << dsblocknumbefore + 1
                                         << " DS epoch now "
@@ -1854,8 +2098,7 @@ bool Lookup::ProcessSetTxBlockFromSeed(const bytes& message,
     return false;
   }
 
-  uint64_t latestSynBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+  uint64_t latestSynBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum() + 1;
 
   if (latestSynBlockNum > highBlockNum) {
     // TODO: We should get blocks from n nodes.
@@ -1949,8 +2192,7 @@ void Lookup::PrepareForStartPow() {
   if (!Messenger::SetLookupGetStartPoWFromSeed(
           getpowsubmission_message, MessageOffset::BODY,
           m_mediator.m_selfPeer.m_listenPortHost,
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
-          m_mediator.m_selfKey)) {
+          m_mediator.m_dsBlockChain.GetLastBlockNum(), m_mediator.m_selfKey)) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
               "Messenger::SetLookupGetStartPoWFromSeed failed.");
     return;
@@ -2027,8 +2269,7 @@ void Lookup::CommitTxBlocks(const vector<TxBlock>& txBlocks) {
     m_mediator.m_node->CommitMBnForwardedTransactionBuffer();
   }
 
-  m_mediator.m_currentEpochNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  m_mediator.m_currentEpochNum = m_mediator.m_txBlockChain.GetLastBlockNum();
   // To trigger m_isVacuousEpoch calculation
   m_mediator.IncreaseEpochNum();
 
@@ -2224,7 +2465,6 @@ bool Lookup::ProcessSetStateFromSeed(const bytes& message, unsigned int offset,
     return true;
   }
 
-  unique_lock<mutex> lock(m_mutexSetState);
   PubKey lookupPubKey;
   bytes accountStoreBytes;
   if (!Messenger::GetLookupSetStateFromSeed(message, offset, lookupPubKey,
@@ -2241,11 +2481,140 @@ bool Lookup::ProcessSetStateFromSeed(const bytes& message, unsigned int offset,
     return false;
   }
 
-  if (!AccountStore::GetInstance().Deserialize(accountStoreBytes, 0)) {
-    LOG_GENERAL(WARNING, "Deserialize AccountStore Failed");
+  {
+    lock_guard<mutex> g(m_mutexSetState);
+    if (!AccountStore::GetInstance().Deserialize(accountStoreBytes, 0)) {
+      LOG_GENERAL(WARNING, "Deserialize AccountStore Failed");
+      return false;
+    }
+  }
+
+  return FinishSetStateFromSeed();
+}
+
+bool Lookup::ProcessSetStateChunkFromSeed(const bytes& message,
+                                          unsigned int offset,
+                                          [[gnu::unused]] const Peer& from) {
+  LOG_MARKER();
+
+  if (AlreadyJoinedNetwork()) {
+    return true;
+  }
+
+  PubKey lookupPubKey;
+  StateHash stateRoot;
+  Address start, end, next;
+  bytes accountStoreBytes;
+  dev::h256 digest;
+  bool stale = false;
+  uint64_t latestBlockNum = 0;
+  if (!Messenger::GetLookupSetStateChunkFromSeed(
+          message, offset, lookupPubKey, stateRoot, start, end, next,
+          accountStoreBytes, digest, stale, latestBlockNum)) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "Messenger::GetLookupSetStateChunkFromSeed failed.");
+    return false;
+  }
+
+  if (!VerifySenderNode(GetSeedNodes(), lookupPubKey)) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "The message sender pubkey: "
+                  << lookupPubKey << " is not in my lookup node list.");
     return false;
   }
 
+  lock_guard<mutex> g(m_mutexStateSync);
+
+  if (stateRoot != m_stateSyncRoot) {
+    // Late reply to a request for a root that has been moved away from
+    LOG_GENERAL(INFO, "Ignoring state chunk at " << start.hex() << " for "
+                                                 << stateRoot.hex());
+    return true;
+  }
+
+  // A digest reply is for a range being checked, a chunk for one being
+  // fetched
+  const bool isDigest = (digest != dev::h256());
+  auto range = find_if(
+      m_stateSyncRanges.begin(), m_stateSyncRanges.end(),
+      [&start, &end](const StateSyncRange& r) {
+        return r.m_verify ? (r.m_start == start && r.FetchedEnd() == end)
+                          : (!r.m_done && r.m_next == start && r.m_end == end);
+      });
+
+  if (stale) {
+    LOG_GENERAL(INFO, "Seed cannot serve state "
+                          << stateRoot.hex()
+                          << " any more, its latest Tx block is "
+                          << latestBlockNum);
+    m_stateSyncStale = true;
+
+    // The sync only moves to the root of a Tx block verified here. The
+    // seed's block number is just a hint that there is a newer one to fetch.
+    // The range stays pending and is retried with the next seed on timeout.
+    const uint64_t lastBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
+    const auto now = chrono::steady_clock::now();
+    if (lastBlockNum <= m_stateSyncBlockNum && latestBlockNum > lastBlockNum &&
+        now - m_stateSyncBlockRequestTime >=
+            chrono::seconds(STATE_SYNC_CHUNK_TIMEOUT_IN_SECONDS)) {
+      m_stateSyncBlockRequestTime = now;
+      GetTxBlockFromSeedNodes(lastBlockNum + 1, 0);
+    }
+    cv_stateSync.notify_all();
+    return true;
+  }
+
+  if (range == m_stateSyncRanges.end() || range->m_verify != isDigest) {
+    // Late reply to a request that has been retried with another seed
+    LOG_GENERAL(INFO, "Ignoring state chunk at " << start.hex());
+    return true;
+  }
+
+  // On failure the range is requested again from the next seed
+  range->m_pending = false;
+  cv_stateSync.notify_all();
+
+  if (isDigest) {
+    dev::h256 localDigest;
+    if (!AccountStore::GetInstance().GetStateRangeDigest(
+            AccountStore::GetInstance().GetStateRootHash(), start, end,
+            localDigest)) {
+      LOG_GENERAL(WARNING, "Failed to check state range at " << start.hex());
+      return false;
+    }
+    range->m_verify = false;
+
+    if (localDigest != digest) {
+      LOG_GENERAL(INFO, "State range at " << start.hex()
+                                          << " has changed, fetching again");
+      range->m_next = range->m_start;
+      range->m_done = false;
+      if (!AccountStore::GetInstance().RemoveStateRange(start, end)) {
+        LOG_GENERAL(WARNING, "Failed to remove state range at "
+                                 << start.hex());
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const bool validNext =
+      (next == end) || (start < next && (end == Address() || next < end));
+  if (!validNext || !AccountStore::GetInstance().AddStateChunk(
+                        accountStoreBytes, 0, start, next)) {
+    LOG_GENERAL(WARNING, "Invalid state chunk at " << start.hex());
+    return false;
+  }
+
+  range->m_next = next;
+  range->m_done = (next == end);
+
+  return true;
+}
+
+bool Lookup::FinishSetStateFromSeed() {
+  unique_lock<mutex> lock(m_mutexSetState);
+
   if (!LOOKUP_NODE_MODE) {
     if (m_syncType == SyncType::NEW_SYNC ||
         m_syncType == SyncType::NORMAL_SYNC) {
@@ -2285,9 +2654,7 @@ bool Lookup::ProcessSetStateFromSeed(const bytes& message, unsigned int offset,
       if (!Messenger::SetLookupGetStartPoWFromSeed(
               getpowsubmission_message, MessageOffset::BODY,
               m_mediator.m_selfPeer.m_listenPortHost,
-              m_mediator.m_dsBlockChain.GetLastBlock()
-                  .GetHeader()
-                  .GetBlockNum(),
+              m_mediator.m_dsBlockChain.GetLastBlockNum(),
               m_mediator.m_selfKey)) {
         LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
                   "Messenger::SetLookupGetStartPoWFromSeed failed.");
@@ -2491,8 +2858,7 @@ bool Lookup::InitMining(uint32_t lookupIndex) {
     return false;
   }
 
-  uint64_t curDsBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t curDsBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum();
 
   m_mediator.UpdateDSBlockRand();
   auto dsBlockRand = m_mediator.m_dsBlockRand;
@@ -2507,8 +2873,7 @@ bool Lookup::InitMining(uint32_t lookupIndex) {
 
   m_mediator.m_node->SetState(Node::POW_SUBMISSION);
   POW::GetInstance().EthashConfigureClient(
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1,
-      FULL_DATASET_MINE);
+      m_mediator.m_dsBlockChain.GetLastBlockNum() + 1, FULL_DATASET_MINE);
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
             "Starting PoW for new ds block number " << curDsBlockNum + 1);
@@ -2523,16 +2888,14 @@ bool Lookup::InitMining(uint32_t lookupIndex) {
   //  return false;
   //}
 
-  uint64_t lastTxBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t lastTxBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
 
   unique_lock<mutex> lk(m_mutexCVJoined);
   cv_waitJoined.wait(lk);
 
   m_startedPoW = false;
 
-  if (m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() >
-      lastTxBlockNum) {
+  if (m_mediator.m_txBlockChain.GetLastBlockNum() > lastTxBlockNum) {
     if (GetSyncType() != SyncType::NO_SYNC) {
       LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
                 "Not yet connected to network");
@@ -2852,15 +3215,12 @@ bool Lookup::ProcessGetStartPoWFromSeed(const bytes& message,
     return false;
   }
 
-  if (blockNumber !=
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum()) {
+  if (blockNumber != m_mediator.m_dsBlockChain.GetLastBlockNum()) {
     LOG_EPOCH(
         WARNING, m_mediator.m_currentEpochNum,
         "DS block " << blockNumber
                     << " in GetStartPoWFromSeed not equal to current DS block "
-                    << m_mediator.m_dsBlockChain.GetLastBlock()
-                           .GetHeader()
-                           .GetBlockNum());
+                    << m_mediator.m_dsBlockChain.GetLastBlockNum());
     return false;
   }
 
@@ -3245,6 +3605,7 @@ bool Lookup::ToBlockMessage(unsigned char ins_byte) {
           ins_byte != LookupInstructionType::SETDSINFOFROMSEED &&
           ins_byte != LookupInstructionType::SETTXBLOCKFROMSEED &&
           ins_byte != LookupInstructionType::SETSTATEFROMSEED &&
+          ins_byte != LookupInstructionType::SETSTATECHUNKFROMSEED &&
           ins_byte != LookupInstructionType::SETLOOKUPOFFLINE &&
           ins_byte != LookupInstructionType::SETLOOKUPONLINE &&
           ins_byte != LookupInstructionType::SETSTATEDELTAFROMSEED &&
@@ -3419,8 +3780,7 @@ bool Lookup::ProcessSetDirectoryBlocksFromSeed(
 
   DequeOfNode newDScomm;
 
-  uint64_t dsblocknumbefore =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t dsblocknumbefore = m_mediator.m_dsBlockChain.GetLastBlockNum();
   LOG_GENERAL(INFO, "[DSINFOVERIF]"
                         << "Recvd " << dirBlocks.size() << " from lookup");
   {
@@ -3440,8 +3800,7 @@ bool Lookup::ProcessSetDirectoryBlocksFromSeed(
 
     m_mediator.m_blocklinkchain.SetBuiltDSComm(newDScomm);
   }
-  uint64_t dsblocknumafter =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t dsblocknumafter = m_mediator.m_dsBlockChain.GetLastBlockNum();
 
   if (dsblocknumafter > dsblocknumbefore) {
     if (m_syncType == SyncType::NO_SYNC &&
@@ -3572,7 +3931,9 @@ bool Lookup::Execute(const bytes& message, unsigned int offset,
       &Lookup::ProcessVCGetLatestDSTxBlockFromSeed,
       &Lookup::ProcessForwardTxn,
       &Lookup::ProcessGetDSGuardNetworkInfo,
-      &Lookup::ProcessSetHistoricalDB};
+      &Lookup::ProcessSetHistoricalDB,
+      &Lookup::ProcessGetStateChunkFromSeed,
+      &Lookup::ProcessSetStateChunkFromSeed};
 
   const unsigned char ins_byte = message.at(offset);
   const unsigned int ins_handlers_count =
@@ -3784,8 +4145,8 @@ void Lookup::SendTxnPacketToNodes(const uint32_t oldNumShards,
 
       result = Messenger::SetNodeForwardTxnBlock(
           msg, MessageOffset::BODY, m_mediator.m_currentEpochNum,
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(), i,
-          m_mediator.m_selfKey, GetTxnFromShardMap(i), mp[i]);
+          m_mediator.m_dsBlockChain.GetLastBlockNum(), i, m_mediator.m_selfKey,
+          GetTxnFromShardMap(i), mp[i]);
     }
 
     if (!result) {
@@ -131,13 +131,49 @@ class Lookup : public Executable {
   std::mutex m_mutexSetStateDeltasFromSeed;
   std::condition_variable cv_setStateDeltasFromSeed;
 
+  // Chunked state sync from seed. The address space is split into ranges
+  // that are fetched in parallel, each one chunk after the other.
+  struct StateSyncRange {
+    Address m_start;
+    /// Where the next chunk to fetch starts
+    Address m_next;
+    /// Zero for the last range
+    Address m_end;
+    bool m_done = false;
+    /// Set when the accounts fetched so far are for an older root, so that
+    /// they are checked against the current one before going on
+    bool m_verify = false;
+    bool m_pending = false;
+    std::chrono::steady_clock::time_point m_requestTime;
+    /// Requests sent so far, used to go to another seed on retries
+    unsigned int m_attempts = 0;
+
+    /// End of the accounts fetched so far
+    const Address& FetchedEnd() const { return m_done ? m_end : m_next; }
+  };
+  std::mutex m_mutexStateSync;
+  std::condition_variable cv_stateSync;
+  StateHash m_stateSyncRoot;
+  /// Tx block whose state root is m_stateSyncRoot. Both only ever come from
+  /// Tx blocks in m_txBlockChain, which have been verified here.
+  uint64_t m_stateSyncBlockNum = 0;
+  /// Set when a seed can no longer serve m_stateSyncRoot, so that the sync
+  /// moves on once a newer Tx block is in
+  bool m_stateSyncStale = false;
+  std::chrono::steady_clock::time_point m_stateSyncBlockRequestTime;
+  std::vector<StateSyncRange> m_stateSyncRanges;
+  /// Bumped when a sync towards a newer root replaces the current one
+  unsigned int m_stateSyncId = 0;
+
   // TxBlockBuffer
   std::vector<TxBlock> m_txBlockBuffer;
 
   std::shared_ptr<LookupServer> m_lookupServer;
 
   bytes ComposeGetDSInfoMessage(bool initialDS = false);
-  bytes ComposeGetStateMessage();
+  bytes ComposeGetStateChunkMessage(const StateHash& stateRoot,
+                                    const Address& start, const Address& end,
+                                    bool digestOnly);
 
   bytes ComposeGetDSBlockMessage(uint64_t lowBlockNum, uint64_t highBlockNum);
   bytes ComposeGetTxBlockMessage(uint64_t lowBlockNum, uint64_t highBlockNum);
@@ -229,6 +265,15 @@ class Lookup : public Executable {
   bool GetStateDeltasFromSeedNodes(uint64_t lowBlockNum, uint64_t highBlockNum);
 
   bool GetStateFromSeedNodes();
+  /// Requests the chunks of the state sync with the given id until all
+  /// ranges are in, then checks the resulting state root
+  void StateSyncLoop(unsigned int syncId);
+  /// Moves the ongoing state sync to the root of the given Tx block. The
+  /// ranges fetched so far are kept, to be checked against the new root.
+  /// Caller holds m_mutexStateSync.
+  void RepinStateSync(uint64_t blockNum, const StateHash& stateRoot);
+  /// Carries on with joining once the state has been received
+  bool FinishSetStateFromSeed();
   // UNUSED
   bool ProcessGetShardFromSeed([[gnu::unused]] const bytes& message,
                                [[gnu::unused]] unsigned int offset,
@@ -290,6 +335,8 @@ class Lookup : public Executable {
                                      const Peer& from);
   bool ProcessGetStateFromSeed(const bytes& message, unsigned int offset,
                                const Peer& from);
+  bool ProcessGetStateChunkFromSeed(const bytes& message, unsigned int offset,
+                                    const Peer& from);
   // UNUSED
   bool ProcessGetTxnsFromLookup([[gnu::unused]] const bytes& message,
                                 [[gnu::unused]] unsigned int offset,
@@ -331,6 +378,8 @@ class Lookup : public Executable {
                                      const Peer& from);
   bool ProcessSetStateFromSeed(const bytes& message, unsigned int offset,
                                const Peer& from);
+  bool ProcessSetStateChunkFromSeed(const bytes& message, unsigned int offset,
+                                    const Peer& from);
 
   bool ProcessSetLookupOffline(const bytes& message, unsigned int offset,
                                const Peer& from);
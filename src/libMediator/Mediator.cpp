@@ -179,8 +179,7 @@ bool Mediator::CheckWhetherBlockIsLatest(const uint64_t& dsblockNum,
                                          const uint64_t& epochNum) {
   LOG_MARKER();
 
-  uint64_t latestDSBlockNumInBlockchain =
-      m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t latestDSBlockNumInBlockchain = m_dsBlockChain.GetLastBlockNum();
 
   if (dsblockNum < (latestDSBlockNumInBlockchain + 1)) {
     LOG_EPOCH(WARNING, m_currentEpochNum,
@@ -245,6 +244,5 @@ bool Mediator::ToProcessTransaction() {
                TXN_SHARD_TARGET_DIFFICULTY &&
            m_dsBlockChain.GetLastBlock().GetHeader().GetDSDifficulty() >=
                TXN_DS_TARGET_DIFFICULTY) ||
-          m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() >=
-              TXN_DS_TARGET_NUM);
+          m_dsBlockChain.GetLastBlockNum() >= TXN_DS_TARGET_NUM);
 }
\ No newline at end of file
@@ -52,6 +52,21 @@ bool ProtobufByteArrayToSerializable(const ByteArray& byteArray,
   return serializable.Deserialize(tmp, 0) == 0;
 }
 
+bool ProtobufByteArrayToSerializable(const ByteArray& byteArray,
+                                     PubKey& pubKey) {
+  if (!ProtobufByteArrayToSerializable(byteArray,
+                                       static_cast<Serializable&>(pubKey))) {
+    return false;
+  }
+
+  // Decoded once here, so later verifications reuse the point
+  if (pubKey.GetPoint() == nullptr) {
+    LOG_GENERAL(WARNING, "PubKey is not a point on the curve");
+    return false;
+  }
+  return true;
+}
+
 // Temporary function for use by data blocks
 void SerializableToProtobufByteArray(const SerializableDataBlock& serializable,
                                      ByteArray& byteArray) {
@@ -5959,6 +5974,172 @@ bool Messenger::GetLookupSetStateFromSeed(const bytes& src,
   return true;
 }
 
+bool Messenger::SetLookupGetStateChunkFromSeed(
+    bytes& dst, const unsigned int offset, const uint32_t listenPort,
+    const StateHash& stateRoot, const Address& start, const Address& end,
+    const bool digestOnly) {
+  LOG_MARKER();
+
+  LookupGetStateChunkFromSeed result;
+
+  result.set_listenport(listenPort);
+  result.set_stateroot(stateRoot.data(), stateRoot.size);
+  result.set_startaddress(start.data(), start.size);
+  result.set_endaddress(end.data(), end.size);
+  if (digestOnly) {
+    result.set_digestonly(true);
+  }
+
+  if (!result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "LookupGetStateChunkFromSeed initialization failed");
+    return false;
+  }
+
+  return SerializeToArray(result, dst, offset);
+}
+
+bool Messenger::GetLookupGetStateChunkFromSeed(
+    const bytes& src, const unsigned int offset, uint32_t& listenPort,
+    StateHash& stateRoot, Address& start, Address& end, bool& digestOnly) {
+  LOG_MARKER();
+
+  if (offset >= src.size()) {
+    LOG_GENERAL(WARNING, "Invalid data and offset, data size "
+                             << src.size() << ", offset " << offset);
+    return false;
+  }
+
+  LookupGetStateChunkFromSeed result;
+  result.ParseFromArray(src.data() + offset, src.size() - offset);
+
+  if (!result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "LookupGetStateChunkFromSeed initialization failed");
+    return false;
+  }
+
+  listenPort = result.listenport();
+  digestOnly = result.has_digestonly() && result.digestonly();
+
+  return CopyWithSizeCheck(result.stateroot(), stateRoot.asArray()) &&
+         CopyWithSizeCheck(result.startaddress(), start.asArray()) &&
+         CopyWithSizeCheck(result.endaddress(), end.asArray());
+}
+
+bool Messenger::SetLookupSetStateChunkFromSeed(
+    bytes& dst, const unsigned int offset, const PairOfKey& lookupKey,
+    const StateHash& stateRoot, const Address& start, const Address& end,
+    const Address& next, const bytes& accountStoreBytes,
+    const dev::h256& digest, const bool stale,
+    const uint64_t latestBlockNum) {
+  LOG_MARKER();
+
+  LookupSetStateChunkFromSeed result;
+
+  LookupSetStateChunkFromSeed::Data* data = result.mutable_data();
+  data->set_stateroot(stateRoot.data(), stateRoot.size);
+  data->set_startaddress(start.data(), start.size);
+  data->set_endaddress(end.data(), end.size);
+  data->set_nextaddress(next.data(), next.size);
+  data->mutable_accountstore()->set_data(accountStoreBytes.data(),
+                                         accountStoreBytes.size());
+  if (digest != dev::h256()) {
+    data->set_digest(digest.data(), digest.size);
+  }
+  if (stale) {
+    data->set_stale(true);
+    data->set_latestblocknum(latestBlockNum);
+  }
+
+  if (!result.data().IsInitialized()) {
+    LOG_GENERAL(WARNING,
+                "LookupSetStateChunkFromSeed.Data initialization failed");
+    return false;
+  }
+
+  SerializableToProtobufByteArray(lookupKey.second, *result.mutable_pubkey());
+
+  bytes tmp(result.data().ByteSize());
+  result.data().SerializeToArray(tmp.data(), tmp.size());
+
+  Signature signature;
+  if (!Schnorr::GetInstance().Sign(tmp, lookupKey.first, lookupKey.second,
+                                   signature)) {
+    LOG_GENERAL(WARNING, "Failed to sign state chunk");
+    return false;
+  }
+
+  SerializableToProtobufByteArray(signature, *result.mutable_signature());
+
+  if (!result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "LookupSetStateChunkFromSeed initialization failed");
+    return false;
+  }
+
+  return SerializeToArray(result, dst, offset);
+}
+
+bool Messenger::GetLookupSetStateChunkFromSeed(
+    const bytes& src, const unsigned int offset, PubKey& lookupPubKey,
+    StateHash& stateRoot, Address& start, Address& end, Address& next,
+    bytes& accountStoreBytes, dev::h256& digest, bool& stale,
+    uint64_t& latestBlockNum) {
+  LOG_MARKER();
+
+  if (offset >= src.size()) {
+    LOG_GENERAL(WARNING, "Invalid data and offset, data size "
+                             << src.size() << ", offset " << offset);
+    return false;
+  }
+
+  LookupSetStateChunkFromSeed result;
+
+  google::protobuf::io::ArrayInputStream arrayIn(src.data() + offset,
+                                                 src.size() - offset);
+  google::protobuf::io::CodedInputStream codedIn(&arrayIn);
+  codedIn.SetTotalBytesLimit(MAX_READ_WATERMARK_IN_BYTES,
+                             MAX_READ_WATERMARK_IN_BYTES);
+
+  if (!result.ParseFromCodedStream(&codedIn) ||
+      !codedIn.ConsumedEntireMessage() || !result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "LookupSetStateChunkFromSeed initialization failed");
+    return false;
+  }
+
+  bytes tmp(result.data().ByteSize());
+  result.data().SerializeToArray(tmp.data(), tmp.size());
+
+  PROTOBUFBYTEARRAYTOSERIALIZABLE(result.pubkey(), lookupPubKey);
+  Signature signature;
+  PROTOBUFBYTEARRAYTOSERIALIZABLE(result.signature(), signature);
+
+  if (!Schnorr::GetInstance().Verify(tmp, signature, lookupPubKey)) {
+    LOG_GENERAL(WARNING, "Invalid signature in state chunk");
+    return false;
+  }
+
+  const LookupSetStateChunkFromSeed::Data& data = result.data();
+  if (!CopyWithSizeCheck(data.stateroot(), stateRoot.asArray()) ||
+      !CopyWithSizeCheck(data.startaddress(), start.asArray()) ||
+      !CopyWithSizeCheck(data.endaddress(), end.asArray()) ||
+      !CopyWithSizeCheck(data.nextaddress(), next.asArray())) {
+    return false;
+  }
+
+  accountStoreBytes.assign(data.accountstore().data().begin(),
+                           data.accountstore().data().end());
+
+  digest = dev::h256();
+  if (data.has_digest() &&
+      !CopyWithSizeCheck(data.digest(), digest.asArray())) {
+    return false;
+  }
+
+  stale = data.has_stale() && data.stale();
+  latestBlockNum = stale ? data.latestblocknum() : 0;
+
+  return true;
+}
+
 bool Messenger::SetLookupSetLookupOffline(bytes& dst, const unsigned int offset,
                                           const uint8_t msgType,
                                           const uint32_t listenPort,
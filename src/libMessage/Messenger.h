@@ -42,6 +42,10 @@ class ByteArray;
 bool ProtobufByteArrayToSerializable(const ZilliqaMessage::ByteArray& byteArray,
                                      Serializable& serializable);
 
+/// Also fails if the key does not decompress to a point on the curve.
+bool ProtobufByteArrayToSerializable(const ZilliqaMessage::ByteArray& byteArray,
+                                     PubKey& pubKey);
+
 class Messenger {
  public:
   template <class K, class V>
@@ -551,6 +555,27 @@ class Messenger {
                                         const unsigned int offset,
                                         PubKey& lookupPubKey,
                                         bytes& accountStoreBytes);
+  static bool SetLookupGetStateChunkFromSeed(
+      bytes& dst, const unsigned int offset, const uint32_t listenPort,
+      const StateHash& stateRoot, const Address& start, const Address& end,
+      const bool digestOnly);
+  static bool GetLookupGetStateChunkFromSeed(
+      const bytes& src, const unsigned int offset, uint32_t& listenPort,
+      StateHash& stateRoot, Address& start, Address& end, bool& digestOnly);
+  /// A zero digest is left out of the message, and latestBlockNum is only
+  /// sent with stale
+  static bool SetLookupSetStateChunkFromSeed(
+      bytes& dst, const unsigned int offset, const PairOfKey& lookupKey,
+      const StateHash& stateRoot, const Address& start, const Address& end,
+      const Address& next, const bytes& accountStoreBytes,
+      const dev::h256& digest, const bool stale,
+      const uint64_t latestBlockNum);
+  /// digest and latestBlockNum are zero when not in the message
+  static bool GetLookupSetStateChunkFromSeed(
+      const bytes& src, const unsigned int offset, PubKey& lookupPubKey,
+      StateHash& stateRoot, Address& start, Address& end, Address& next,
+      bytes& accountStoreBytes, dev::h256& digest, bool& stale,
+      uint64_t& latestBlockNum);
   static bool SetLookupSetLookupOffline(bytes& dst, const unsigned int offset,
                                         const uint8_t msgType,
                                         const uint32_t listenPort,
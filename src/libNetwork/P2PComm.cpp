@@ -29,6 +29,7 @@
 #include <signal.h>
 #include <stdint.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <cstring>
 #include <memory>
@@ -42,7 +43,6 @@
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/JoinableFunction.h"
 #include "libUtils/Logger.h"
-#include "libUtils/SafeMath.h"
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -80,7 +80,21 @@ static bool comparePairSecond(
   return a.second < b.second;
 }
 
-P2PComm::P2PComm() : m_sendQueue(SENDQUEUE_SIZE) {
+static vector<PriorityDispatcher<SendJob*>::Class> SendClasses() {
+  vector<PriorityDispatcher<SendJob*>::Class> classes;
+  for (unsigned int i = 0; i < NUM_MESSAGE_PRIORITIES; i++) {
+    classes.push_back({MESSAGE_PRIORITY_NAMES[i], MESSAGE_PRIORITY_WEIGHTS[i],
+                       SENDQUEUE_SIZE});
+  }
+  return classes;
+}
+
+P2PComm::P2PComm()
+    : m_sendDispatcher("SendDispatcher", SendClasses(), MAXMESSAGE,
+                       [](SendJob*& job) {
+                         job->DoSend();
+                         delete job;
+                       }) {
   auto func = [this]() -> void {
     bytes emptyHash;
 
@@ -114,8 +128,7 @@ P2PComm::P2PComm() : m_sendQueue(SENDQUEUE_SIZE) {
 }
 
 P2PComm::~P2PComm() {
-  SendJob* job = NULL;
-  while (m_sendQueue.pop(job)) {
+  for (auto job : m_sendDispatcher.Stop()) {
     delete job;
   }
 }
@@ -125,13 +138,12 @@ P2PComm& P2PComm::GetInstance() {
   return comm;
 }
 
-uint32_t SendJob::writeMsg(const void* buf, int cli_sock, const Peer& from,
-                           const uint32_t message_length) {
+uint32_t SendJob::writeMsg(struct iovec* iov, int iovcnt, int cli_sock,
+                           const Peer& from, const uint32_t message_length) {
   uint32_t written_length = 0;
 
   while (written_length < message_length) {
-    ssize_t n = write(cli_sock, (unsigned char*)buf + written_length,
-                      message_length - written_length);
+    ssize_t n = writev(cli_sock, iov, iovcnt);
 
     if (P2PComm::IsHostHavingNetworkIssue()) {
       LOG_GENERAL(WARNING, "[blacklist] Encountered "
@@ -158,6 +170,18 @@ uint32_t SendJob::writeMsg(const void* buf, int cli_sock, const Peer& from,
     }
 
     written_length += n;
+
+    // Skip over what has been written out
+    size_t skip = n;
+    while (iovcnt > 0 && skip >= iov->iov_len) {
+      skip -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if (iovcnt > 0) {
+      iov->iov_base = (unsigned char*)iov->iov_base + skip;
+      iov->iov_len -= skip;
+    }
   }
 
   if (written_length > 1000000) {
@@ -167,11 +191,11 @@ uint32_t SendJob::writeMsg(const void* buf, int cli_sock, const Peer& from,
   return written_length;
 }
 
-bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
+bool SendJob::SendMessageSocketCore(const Peer& peer, const MessagePtr& message,
                                     unsigned char start_byte,
                                     const bytes& msg_hash) {
   // LOG_MARKER();
-  LOG_PAYLOAD(DEBUG, "Sending to " << peer, message,
+  LOG_PAYLOAD(DEBUG, "Sending to " << peer, *message,
               Logger::MAX_BYTES_TO_DISPLAY);
 
   if (peer.m_ipAddress == 0 && peer.m_listenPortHost == 0) {
@@ -184,6 +208,62 @@ bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
     return true;
   }
 
+  // Transmission format:
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x11 - start byte
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
+  // <message>
+
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x22 - start byte (broadcast)
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
+  // <32-byte hash> <message>
+
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x33 - start byte (report)
+  // 0x00 0x00 0x00 0x01 - 4-byte length of message
+  // 0x00
+  uint32_t length = message->size();
+
+  if (start_byte == START_BYTE_BROADCAST) {
+    if (msg_hash.size() != HASH_LEN) {
+      LOG_GENERAL(WARNING, "Wrong message hash length.");
+      return true;
+    }
+    length += HASH_LEN;
+  }
+
+  // Header and hash are sent ahead of the message, which is never copied
+  bytes header = {(unsigned char)(MSG_VERSION & 0xFF),
+                  start_byte,
+                  (unsigned char)((length >> 24) & 0xFF),
+                  (unsigned char)((length >> 16) & 0xFF),
+                  (unsigned char)((length >> 8) & 0xFF),
+                  (unsigned char)(length & 0xFF)};
+  if (start_byte == START_BYTE_BROADCAST) {
+    header.insert(header.end(), msg_hash.begin(), msg_hash.end());
+  }
+
+  PeerConnectionPool& pool = P2PComm::GetInstance().m_connectionPool;
+  if (ENABLE_CONNECTION_POOL && pool.IsRunning()) {
+    // Broadcasts are gossiped on by other peers, so only direct messages are
+    // resent if the connection fails
+    if (!pool.Send(peer, header, message, start_byte != START_BYTE_BROADCAST)) {
+      LOG_GENERAL(WARNING, "Send failed. Code = "
+                               << errno << " Desc: " << std::strerror(errno)
+                               << ". IP address: " << peer);
+      if (P2PComm::IsHostHavingNetworkIssue()) {
+        LOG_GENERAL(WARNING, "[blacklist] Encountered "
+                                 << errno << " (" << std::strerror(errno)
+                                 << "). Adding " << peer.GetPrintableIPAddress()
+                                 << " to blacklist");
+        Blacklist::GetInstance().Add(peer.m_ipAddress);
+      }
+      return false;
+    }
+    return true;
+  }
+
   try {
     int cli_sock = socket(AF_INET, SOCK_STREAM, 0);
     unique_ptr<int, void (*)(int*)> cli_sock_closer(&cli_sock, close_socket);
@@ -220,50 +300,15 @@ bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
 
       return false;
     }
-    // Transmission format:
-    // 0x01 ~ 0xFF - version, defined in constant file
-    // 0x11 - start byte
-    // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
-    // <message>
-
-    // 0x01 ~ 0xFF - version, defined in constant file
-    // 0x22 - start byte (broadcast)
-    // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
-    // <32-byte hash> <message>
-
-    // 0x01 ~ 0xFF - version, defined in constant file
-    // 0x33 - start byte (report)
-    // 0x00 0x00 0x00 0x01 - 4-byte length of message
-    // 0x00
-    uint32_t length = message.size();
-
-    if (start_byte == START_BYTE_BROADCAST) {
-      length += HASH_LEN;
-    }
 
-    unsigned char buf[HDR_LEN] = {(unsigned char)(MSG_VERSION & 0xFF),
-                                  start_byte,
-                                  (unsigned char)((length >> 24) & 0xFF),
-                                  (unsigned char)((length >> 16) & 0xFF),
-                                  (unsigned char)((length >> 8) & 0xFF),
-                                  (unsigned char)(length & 0xFF)};
+    struct iovec iov[2] = {
+        {header.data(), header.size()},
+        {const_cast<unsigned char*>(message->data()), message->size()}};
+    const uint32_t total = header.size() + message->size();
 
-    if (HDR_LEN != writeMsg(buf, cli_sock, peer, HDR_LEN)) {
-      LOG_GENERAL(INFO, "DEBUG: not written_length == " << HDR_LEN);
+    if (total != writeMsg(iov, 2, cli_sock, peer, total)) {
+      LOG_GENERAL(INFO, "DEBUG: not written_length == " << total);
     }
-
-    if (start_byte != START_BYTE_BROADCAST) {
-      writeMsg(&message.at(0), cli_sock, peer, length);
-      return true;
-    }
-
-    if (HASH_LEN != writeMsg(&msg_hash.at(0), cli_sock, peer, HASH_LEN)) {
-      LOG_GENERAL(WARNING, "Wrong message hash length.");
-      return true;
-    }
-
-    length -= HASH_LEN;
-    writeMsg(&message.at(0), cli_sock, peer, length);
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Error with write socket." << ' ' << e.what());
     return false;
@@ -271,7 +316,7 @@ bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
   return true;
 }
 
-void SendJob::SendMessageCore(const Peer& peer, const bytes& message,
+void SendJob::SendMessageCore(const Peer& peer, const MessagePtr& message,
                               unsigned char startbyte, const bytes& hash) {
   uint32_t retry_counter = 0;
   while (!SendMessageSocketCore(peer, message, startbyte, hash)) {
@@ -352,12 +397,17 @@ void SendJobPeers<T>::DoSend() {
   }
 }
 
-void P2PComm::ProcessSendJob(SendJob* job) {
-  auto funcSendMsg = [job]() mutable -> void {
-    job->DoSend();
+void P2PComm::QueueSendJob(SendJob* job) {
+  const bytes& message = *job->m_message;
+  MessagePriority priority = PRIORITY_SYNC;
+  if (message.size() >= MessageOffset::BODY) {
+    priority = GetMessagePriority(message.at(MessageOffset::TYPE),
+                                  message.at(MessageOffset::INST));
+  }
+
+  if (!m_sendDispatcher.Push(priority, move(job))) {
     delete job;
-  };
-  m_SendPool.AddJob(funcSendMsg);
+  }
 }
 
 void P2PComm::ClearBroadcastHashAsync(const bytes& message_hash) {
@@ -491,107 +541,15 @@ void P2PComm::ClearPeerConnectionCount() {
   m_peerConnectionCount.clear();
 }
 
-void P2PComm::EventCallback(struct bufferevent* bev, short events,
-                            [[gnu::unused]] void* ctx) {
-  unique_ptr<struct bufferevent, decltype(&CloseAndFreeBufferEvent)>
-      socket_closer(bev, CloseAndFreeBufferEvent);
-
-  if (events & BEV_EVENT_ERROR) {
-    LOG_GENERAL(WARNING, "Error from bufferevent.");
-    return;
-  }
-
-  // Not all bytes read out
-  if (!(events & (BEV_EVENT_EOF | BEV_EVENT_ERROR))) {
-    LOG_GENERAL(WARNING, "Unknown error from bufferevent.");
-    return;
-  }
-
-  // Get the IP info
-  int fd = bufferevent_getfd(bev);
-  struct sockaddr_in cli_addr {};
-  socklen_t addr_size = sizeof(struct sockaddr_in);
-  getpeername(fd, (struct sockaddr*)&cli_addr, &addr_size);
-  Peer from(cli_addr.sin_addr.s_addr, cli_addr.sin_port);
-
-  // Get the data stored in buffer
-  struct evbuffer* input = bufferevent_get_input(bev);
-  if (input == NULL) {
-    LOG_GENERAL(WARNING, "bufferevent_get_input failure.");
-    return;
-  }
-  size_t len = evbuffer_get_length(input);
-  if (len == 0) {
-    LOG_GENERAL(WARNING, "evbuffer_get_length failure.");
-    return;
-  }
-  bytes message(len);
-  if (evbuffer_copyout(input, message.data(), len) !=
-      static_cast<ev_ssize_t>(len)) {
-    LOG_GENERAL(WARNING, "evbuffer_copyout failure.");
-    return;
-  }
-  if (evbuffer_drain(input, len) != 0) {
-    LOG_GENERAL(WARNING, "evbuffer_drain failure.");
-    return;
-  }
-
-  // Reception format:
-  // 0x01 ~ 0xFF - version, defined in constant file
-  // 0x11 - start byte
-  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
-  // <message>
-
-  // 0x01 ~ 0xFF - version, defined in constant file
-  // 0x22 - start byte (broadcast)
-  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
-  // <32-byte hash> <message>
-
-  // 0x01 ~ 0xFF - version, defined in constant file
-  // 0x33 - start byte (gossip)
-  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
-  // 0x01 ~ 0x04 - Gossip_Message_Type
-  // <4-byte Age> <message>
-
-  // 0x01 ~ 0xFF - version, defined in constant file
-  // 0x33 - start byte (report)
-  // 0x00 0x00 0x00 0x01 - 4-byte length of message
-  // 0x00
-
+/*static*/ void P2PComm::ProcessMessage(bytes& message, Peer from) {
   // Check for minimum message size
   if (message.size() <= HDR_LEN) {
     LOG_GENERAL(WARNING, "Empty message received.");
     return;
   }
 
-  const unsigned char version = message[0];
   const unsigned char startByte = message[1];
-
-  // Check for version requirement
-  if (version != (unsigned char)(MSG_VERSION & 0xFF)) {
-    LOG_GENERAL(WARNING, "Header version wrong, received ["
-                             << version - 0x00 << "] while expected ["
-                             << MSG_VERSION << "].");
-    return;
-  }
-
-  const uint32_t messageLength =
-      (message[2] << 24) + (message[3] << 16) + (message[4] << 8) + message[5];
-
-  {
-    // Check for length consistency
-    uint32_t res;
-
-    if (!SafeMath<uint32_t>::sub(message.size(), HDR_LEN, res)) {
-      LOG_GENERAL(WARNING, "Unexpected subtraction operation!");
-      return;
-    }
-
-    if (messageLength != res) {
-      LOG_GENERAL(WARNING, "Incorrect message length.");
-      return;
-    }
-  }
+  const uint32_t messageLength = message.size() - HDR_LEN;
 
   if (startByte == START_BYTE_BROADCAST) {
     LOG_PAYLOAD(INFO, "Incoming broadcast " << from, message,
@@ -645,24 +603,134 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
   }
 }
 
-void P2PComm::ReadCallback(struct bufferevent* bev, [[gnu::unused]] void* ctx) {
+static Peer GetRemotePeer(struct bufferevent* bev) {
+  int fd = bufferevent_getfd(bev);
+  struct sockaddr_in cli_addr {};
+  socklen_t addr_size = sizeof(struct sockaddr_in);
+  getpeername(fd, (struct sockaddr*)&cli_addr, &addr_size);
+  return Peer(cli_addr.sin_addr.s_addr, cli_addr.sin_port);
+}
+
+/*static*/ bool P2PComm::ProcessFrames(struct bufferevent* bev) {
+  // Reception format:
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x11 - start byte
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
+  // <message>
+
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x22 - start byte (broadcast)
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
+  // <32-byte hash> <message>
+
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x33 - start byte (gossip)
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
+  // 0x01 ~ 0x04 - Gossip_Message_Type
+  // <4-byte Age> <message>
+
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x33 - start byte (report)
+  // 0x00 0x00 0x00 0x01 - 4-byte length of message
+  // 0x00
+
+  // A connection carries one or more of these back to back, so each complete
+  // message is taken out of the buffer as soon as it has fully arrived
   struct evbuffer* input = bufferevent_get_input(bev);
+  if (input == NULL) {
+    LOG_GENERAL(WARNING, "bufferevent_get_input failure.");
+    return false;
+  }
+
+  const Peer from = GetRemotePeer(bev);
+
+  while (true) {
+    const size_t len = evbuffer_get_length(input);
+    if (len < HDR_LEN) {
+      return true;
+    }
+
+    unsigned char header[HDR_LEN];
+    if (evbuffer_copyout(input, header, HDR_LEN) !=
+        static_cast<ev_ssize_t>(HDR_LEN)) {
+      LOG_GENERAL(WARNING, "evbuffer_copyout failure.");
+      return false;
+    }
 
-  size_t len = evbuffer_get_length(input);
-  if (len >= MAX_READ_WATERMARK_IN_BYTES) {
-    // Get the IP info
-    int fd = bufferevent_getfd(bev);
-    struct sockaddr_in cli_addr {};
-    socklen_t addr_size = sizeof(struct sockaddr_in);
-    getpeername(fd, (struct sockaddr*)&cli_addr, &addr_size);
-    Peer from(cli_addr.sin_addr.s_addr, cli_addr.sin_port);
-    LOG_GENERAL(WARNING, "[blacklist] Encountered data of size: "
-                             << len << " being received."
-                             << " Adding sending node "
-                             << from.GetPrintableIPAddress()
-                             << " to blacklist");
-    Blacklist::GetInstance().Add(from.m_ipAddress);
-    bufferevent_free(bev);
+    // Check for version requirement
+    const unsigned char version = header[0];
+    if (version != (unsigned char)(MSG_VERSION & 0xFF)) {
+      LOG_GENERAL(WARNING, "Header version wrong, received ["
+                               << version - 0x00 << "] while expected ["
+                               << MSG_VERSION << "].");
+      return false;
+    }
+
+    const uint32_t messageLength =
+        (header[2] << 24) + (header[3] << 16) + (header[4] << 8) + header[5];
+    const uint64_t frameLength = (uint64_t)HDR_LEN + messageLength;
+
+    if (frameLength >= MAX_READ_WATERMARK_IN_BYTES) {
+      LOG_GENERAL(WARNING, "[blacklist] Encountered data of size: "
+                               << frameLength << " being received."
+                               << " Adding sending node "
+                               << from.GetPrintableIPAddress()
+                               << " to blacklist");
+      Blacklist::GetInstance().Add(from.m_ipAddress);
+      return false;
+    }
+
+    if (len < frameLength) {
+      return true;
+    }
+
+    bytes message(frameLength);
+    if (evbuffer_remove(input, message.data(), frameLength) !=
+        static_cast<ev_ssize_t>(frameLength)) {
+      LOG_GENERAL(WARNING, "evbuffer_remove failure.");
+      return false;
+    }
+
+    ProcessMessage(message, from);
+  }
+}
+
+void P2PComm::EventCallback(struct bufferevent* bev, short events,
+                            [[gnu::unused]] void* ctx) {
+  unique_ptr<struct bufferevent, decltype(&CloseAndFreeBufferEvent)>
+      socket_closer(bev, CloseAndFreeBufferEvent);
+
+  if (events & BEV_EVENT_ERROR) {
+    LOG_GENERAL(WARNING, "Error from bufferevent.");
+    return;
+  }
+
+  if (events & BEV_EVENT_TIMEOUT) {
+    LOG_GENERAL(INFO, "Closing idle connection from " << GetRemotePeer(bev));
+    return;
+  }
+
+  // Not all bytes read out
+  if (!(events & BEV_EVENT_EOF)) {
+    LOG_GENERAL(WARNING, "Unknown error from bufferevent.");
+    return;
+  }
+
+  // Pick up whatever arrived together with the EOF
+  if (!ProcessFrames(bev)) {
+    return;
+  }
+
+  const size_t len = evbuffer_get_length(bufferevent_get_input(bev));
+  if (len > 0) {
+    LOG_GENERAL(WARNING, "Incorrect message length. Dropping "
+                             << len << " bytes from " << GetRemotePeer(bev));
+  }
+}
+
+void P2PComm::ReadCallback(struct bufferevent* bev, [[gnu::unused]] void* ctx) {
+  if (!ProcessFrames(bev)) {
+    CloseAndFreeBufferEvent(bev);
   }
 }
 
@@ -721,6 +789,12 @@ void P2PComm::AcceptConnectionCallback([[gnu::unused]] evconnlistener* listener,
   bufferevent_setwatermark(bev, EV_READ, MIN_READ_WATERMARK_IN_BYTES,
                            MAX_READ_WATERMARK_IN_BYTES);
   bufferevent_setcb(bev, ReadCallback, NULL, EventCallback, NULL);
+
+  // Pooled connections stay open between messages; drop them if the sender
+  // has gone quiet for longer than it would keep them
+  struct timeval idleTimeout {};
+  idleTimeout.tv_sec = 2 * IDLE_CONNECTION_TIMEOUT_IN_SECONDS;
+  bufferevent_set_timeouts(bev, &idleTimeout, NULL);
   bufferevent_enable(bev, EV_READ | EV_WRITE);
 }
 
@@ -733,17 +807,12 @@ void P2PComm::StartMessagePump(uint32_t listen_port_host,
                                Dispatcher dispatcher) {
   LOG_MARKER();
 
-  // Launch the thread that reads messages from the send queue
-  auto funcCheckSendQueue = [this]() mutable -> void {
-    SendJob* job = NULL;
-    while (true) {
-      while (m_sendQueue.pop(job)) {
-        ProcessSendJob(job);
-      }
-      std::this_thread::sleep_for(std::chrono::microseconds(1));
-    }
-  };
-  DetachedFunction(1, funcCheckSendQueue);
+  // Must come before any event base is created, see PeerConnectionPool
+  if (ENABLE_CONNECTION_POOL && !m_connectionPool.Start()) {
+    LOG_GENERAL(WARNING,
+                "Failed to start connection pool, using one connection per "
+                "message");
+  }
 
   m_dispatcher = move(dispatcher);
 
@@ -791,13 +860,11 @@ void P2PComm::SendMessage(const vector<Peer>& peers, const bytes& message,
   dynamic_cast<SendJobPeers<vector<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = startByteType;
-  job->m_message = message;
+  job->m_message = make_shared<const bytes>(message);
   job->m_hash.clear();
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
+  QueueSendJob(job);
 }
 
 void P2PComm::SendMessage(const deque<Peer>& peers, const bytes& message,
@@ -813,13 +880,11 @@ void P2PComm::SendMessage(const deque<Peer>& peers, const bytes& message,
   dynamic_cast<SendJobPeers<deque<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = startByteType;
-  job->m_message = message;
+  job->m_message = make_shared<const bytes>(message);
   job->m_hash.clear();
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
+  QueueSendJob(job);
 }
 
 void P2PComm::SendMessage(const Peer& peer, const bytes& message,
@@ -831,13 +896,11 @@ void P2PComm::SendMessage(const Peer& peer, const bytes& message,
   dynamic_cast<SendJobPeer*>(job)->m_peer = peer;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = startByteType;
-  job->m_message = message;
+  job->m_message = make_shared<const bytes>(message);
   job->m_hash.clear();
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
+  QueueSendJob(job);
 }
 
 void P2PComm::SendBroadcastMessage(const vector<Peer>& peers,
@@ -856,15 +919,13 @@ void P2PComm::SendBroadcastMessage(const vector<Peer>& peers,
   dynamic_cast<SendJobPeers<vector<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = START_BYTE_BROADCAST;
-  job->m_message = message;
+  job->m_message = make_shared<const bytes>(message);
   job->m_hash = sha256.Finalize();
 
   bytes hashCopy(job->m_hash);
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
+  QueueSendJob(job);
 
   lock_guard<mutex> guard(m_broadcastHashesMutex);
   m_broadcastHashes.insert(hashCopy);
@@ -886,15 +947,13 @@ void P2PComm::SendBroadcastMessage(const deque<Peer>& peers,
   dynamic_cast<SendJobPeers<deque<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = START_BYTE_BROADCAST;
-  job->m_message = message;
+  job->m_message = make_shared<const bytes>(message);
   job->m_hash = sha256.Finalize();
 
   bytes hashCopy(job->m_hash);
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-  }
+  QueueSendJob(job);
 
   lock_guard<mutex> guard(m_broadcastHashesMutex);
   m_broadcastHashes.insert(hashCopy);
@@ -911,7 +970,8 @@ void P2PComm::SendMessageNoQueue(const Peer& peer, const bytes& message,
     return;
   }
 
-  SendJob::SendMessageCore(peer, message, startByteType, {});
+  SendJob::SendMessageCore(peer, make_shared<const bytes>(message),
+                           startByteType, {});
 }
 
 bool P2PComm::SpreadRumor(const bytes& message) {
@@ -19,40 +19,46 @@
 #define ZILLIQA_SRC_LIBNETWORK_P2PCOMM_H_
 
 #include <event2/util.h>
-#include <boost/lockfree/queue.hpp>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
 
 #include "Peer.h"
+#include "PeerConnectionPool.h"
 #include "RumorManager.h"
 #include "common/BaseType.h"
 #include "common/Constants.h"
 #include "libUtils/Logger.h"
-#include "libUtils/ThreadPool.h"
+#include "libUtils/PriorityDispatcher.h"
 
 struct evconnlistener;
+struct iovec;
 
 extern const unsigned char START_BYTE_NORMAL;
 extern const unsigned char START_BYTE_GOSSIP;
 
 class SendJob {
+ public:
+  /// Message body shared by every peer the job sends to
+  using MessagePtr = std::shared_ptr<const bytes>;
+
  protected:
-  static uint32_t writeMsg(const void* buf, int cli_sock, const Peer& from,
-                           const uint32_t message_length);
-  static bool SendMessageSocketCore(const Peer& peer, const bytes& message,
+  static uint32_t writeMsg(struct iovec* iov, int iovcnt, int cli_sock,
+                           const Peer& from, const uint32_t message_length);
+  static bool SendMessageSocketCore(const Peer& peer, const MessagePtr& message,
                                     unsigned char start_byte,
                                     const bytes& msg_hash);
 
  public:
   Peer m_selfPeer;
   unsigned char m_startbyte{};
-  bytes m_message;
+  MessagePtr m_message;
   bytes m_hash;
 
-  static void SendMessageCore(const Peer& peer, const bytes& message,
+  static void SendMessageCore(const Peer& peer, const MessagePtr& message,
                               unsigned char startbyte, const bytes& hash);
 
   virtual ~SendJob() {}
@@ -102,13 +108,18 @@ class P2PComm {
   static std::mutex m_mutexPeerConnectionCount;
   static std::map<uint128_t, uint16_t> m_peerConnectionCount;
 
-  ThreadPool m_SendPool{MAXMESSAGE, "SendPool"};
+  /// Outbound connections reused across SendJobs
+  PeerConnectionPool m_connectionPool;
+  friend class SendJob;
 
-  boost::lockfree::queue<SendJob*> m_sendQueue;
-  void ProcessSendJob(SendJob* job);
+  /// Hands send jobs to the senders, by message class
+  PriorityDispatcher<SendJob*> m_sendDispatcher;
+  void QueueSendJob(SendJob* job);
 
   static void ProcessBroadCastMsg(bytes& message, const Peer& from);
   static void ProcessGossipMsg(bytes& message, Peer& from);
+  static void ProcessMessage(bytes& message, Peer from);
+  static bool ProcessFrames(struct bufferevent* bev);
 
   static void EventCallback(struct bufferevent* bev, short events, void* ctx);
   static void ReadCallback(struct bufferevent* bev, void* ctx);
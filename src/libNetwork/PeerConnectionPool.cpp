@@ -0,0 +1,499 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PeerConnectionPool.h"
+
+#include <errno.h>
+#include <event2/buffer.h>
+#include <event2/bufferevent.h>
+#include <event2/event.h>
+#include <event2/thread.h>
+#include <event2/util.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <cstring>
+
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+PeerConnectionPool::Connection::~Connection() {
+  if (m_bev != nullptr) {
+    bufferevent_free(m_bev);
+  }
+}
+
+PeerConnectionPool::PeerConnectionPool() {}
+
+PeerConnectionPool::~PeerConnectionPool() {
+  if (m_loopThread.joinable()) {
+    // The loop is stopped from inside so that this works even if it has not
+    // started dispatching yet
+    m_stopping = true;
+    event_active(m_sweepEvent, EV_TIMEOUT, 0);
+    m_loopThread.join();
+  }
+
+  // Bufferevents have to go before their base
+  m_connections.clear();
+  if (m_sweepEvent != nullptr) {
+    event_free(m_sweepEvent);
+  }
+  if (m_base != nullptr) {
+    event_base_free(m_base);
+  }
+}
+
+bool PeerConnectionPool::Start() {
+  if (m_running) {
+    return true;
+  }
+
+  // Bufferevents are written to from the send threads while the loop thread
+  // flushes them
+  if (evthread_use_pthreads() != 0) {
+    LOG_GENERAL(WARNING, "evthread_use_pthreads failure.");
+    return false;
+  }
+
+  // Writes to a peer that reset the connection must fail with EPIPE rather
+  // than kill the process
+  signal(SIGPIPE, SIG_IGN);
+
+  m_base = event_base_new();
+  if (m_base == nullptr) {
+    LOG_GENERAL(WARNING, "event_base_new failure.");
+    return false;
+  }
+
+  // The sweep timer also keeps the loop alive while there are no connections
+  m_sweepEvent = event_new(m_base, -1, EV_PERSIST, SweepCallback, this);
+  struct timeval interval {};
+  interval.tv_sec = max(IDLE_CONNECTION_TIMEOUT_IN_SECONDS / 4, 1u);
+  if (m_sweepEvent == nullptr || event_add(m_sweepEvent, &interval) != 0) {
+    LOG_GENERAL(WARNING, "Failed to schedule idle connection sweep.");
+    return false;
+  }
+
+  m_loopThread = thread([this]() { event_base_dispatch(m_base); });
+
+  m_running = true;
+  return true;
+}
+
+PeerConnectionPool::ConnectionPtr PeerConnectionPool::Acquire(
+    const Peer& peer, bool& created) {
+  lock_guard<mutex> g(m_mutex);
+
+  // Connections are removed from the map as soon as they are closed
+  auto it = m_connections.find(peer);
+  if (it != m_connections.end()) {
+    it->second->m_users++;
+    created = false;
+    return it->second;
+  }
+
+  auto conn = make_shared<Connection>(this, peer);
+  conn->m_users = 1;
+  conn->m_lastUsed = chrono::steady_clock::now();
+  m_connections.emplace(peer, conn);
+  created = true;
+  return conn;
+}
+
+void PeerConnectionPool::Release(const ConnectionPtr& conn) {
+  lock_guard<mutex> g(m_mutex);
+  conn->m_users--;
+  conn->m_lastUsed = chrono::steady_clock::now();
+}
+
+bool PeerConnectionPool::Open(const ConnectionPtr& conn) {
+  const Peer& peer = conn->m_peer;
+
+  conn->m_bev = bufferevent_socket_new(
+      m_base, -1, BEV_OPT_CLOSE_ON_FREE | BEV_OPT_THREADSAFE);
+  if (conn->m_bev == nullptr) {
+    LOG_GENERAL(WARNING, "bufferevent_socket_new failure.");
+    ConnectionPtr detached;
+    {
+      lock_guard<mutex> g(m_mutex);
+      detached = DetachLocked(conn.get(), ENOMEM);
+    }
+    errno = ENOMEM;
+    return false;
+  }
+
+  bufferevent_setcb(conn->m_bev, ReadCallback, WriteCallback, EventCallback,
+                    conn.get());
+  bufferevent_setwatermark(conn->m_bev, EV_WRITE, MAX_SEND_BUFFER_IN_BYTES / 2,
+                           0);
+  bufferevent_enable(conn->m_bev, EV_READ | EV_WRITE);
+
+  struct sockaddr_in serv_addr {};
+  serv_addr.sin_family = AF_INET;
+  serv_addr.sin_addr.s_addr = peer.m_ipAddress.convert_to<unsigned long>();
+  serv_addr.sin_port = htons(peer.m_listenPortHost);
+
+  if (bufferevent_socket_connect(conn->m_bev, (struct sockaddr*)&serv_addr,
+                                 sizeof(serv_addr)) < 0) {
+    const int error = EVUTIL_SOCKET_ERROR();
+    LOG_GENERAL(WARNING, "Socket connect failed. Code = "
+                             << error << " Desc: " << std::strerror(error)
+                             << ". IP address: " << peer);
+    ConnectionPtr detached;
+    {
+      lock_guard<mutex> g(m_mutex);
+      detached = DetachLocked(conn.get(), error);
+    }
+    errno = error;
+    return false;
+  }
+
+  return true;
+}
+
+bool PeerConnectionPool::Send(const Peer& peer, const bytes& header,
+                              const shared_ptr<const bytes>& payload,
+                              bool requeue) {
+  if (!m_running) {
+    errno = ENOTCONN;
+    return false;
+  }
+
+  bool created = false;
+  ConnectionPtr conn = Acquire(peer, created);
+  if (created && !Open(conn)) {
+    const int error = errno;
+    Release(conn);
+    errno = error;
+    return false;
+  }
+
+  const size_t frameSize = header.size() + payload->size();
+
+  // Wait for the connection to come up and for room in its output buffer
+  int error = 0;
+  ConnectionPtr detached;
+  {
+    unique_lock<mutex> lock(m_mutex);
+    const bool ready = conn->m_cv.wait_for(
+        lock, chrono::seconds(CONNECTION_TIMEOUT_IN_SECONDS), [&conn]() {
+          return conn->m_state == CLOSED ||
+                 (conn->m_state == CONNECTED &&
+                  conn->m_pending < MAX_SEND_BUFFER_IN_BYTES);
+        });
+
+    if (!ready) {
+      if (conn->m_state == CONNECTING) {
+        LOG_GENERAL(WARNING, "Timed out connecting to " << peer);
+        detached = DetachLocked(conn.get(), EAGAIN);
+      } else {
+        LOG_GENERAL(WARNING, "Send buffer to " << peer << " is full ("
+                                               << conn->m_pending
+                                               << " bytes pending)");
+      }
+      error = EAGAIN;
+    } else if (conn->m_state == CLOSED) {
+      error = (conn->m_error != 0) ? conn->m_error : ECONNRESET;
+    } else {
+      conn->m_pending += frameSize;
+    }
+  }
+
+  if (error != 0) {
+    Release(conn);
+    errno = error;
+    return false;
+  }
+
+  // The whole frame goes in under one lock so that frames from concurrent
+  // senders do not interleave
+  bufferevent_lock(conn->m_bev);
+  const bool result =
+      Append(conn.get(), Frame{header, payload, frameSize, requeue}, true);
+  bufferevent_unlock(conn->m_bev);
+
+  if (!result) {
+    // A partial frame would corrupt the stream
+    LOG_GENERAL(WARNING, "bufferevent_write failure. IP address: " << peer);
+    lock_guard<mutex> g(m_mutex);
+    detached = DetachLocked(conn.get(), ENOMEM);
+  }
+
+  Release(conn);
+  if (!result) {
+    errno = ENOMEM;
+  }
+  return result;
+}
+
+bool PeerConnectionPool::Append(Connection* conn, Frame&& frame,
+                                bool reserved) {
+  // The payload stays alive until libevent has written it out and calls
+  // ReleasePayload
+  struct evbuffer* output = bufferevent_get_output(conn->m_bev);
+  if (evbuffer_add(output, frame.m_header.data(), frame.m_header.size()) !=
+      0) {
+    return false;
+  }
+  if (!frame.m_payload->empty()) {
+    auto ref = new shared_ptr<const bytes>(frame.m_payload);
+    if (evbuffer_add_reference(output, frame.m_payload->data(),
+                               frame.m_payload->size(), ReleasePayload,
+                               ref) != 0) {
+      delete ref;
+      return false;
+    }
+  }
+
+  if (!frame.m_requeue) {
+    frame.m_header.clear();
+    frame.m_payload.reset();
+  }
+
+  lock_guard<mutex> g(m_mutex);
+  if (!reserved) {
+    conn->m_pending += frame.m_size;
+  }
+  conn->m_queued += frame.m_size;
+  conn->m_frames.emplace_back(move(frame));
+  return true;
+}
+
+void PeerConnectionPool::PopWrittenLocked(Connection* conn, size_t pending) {
+  if (pending >= conn->m_queued) {
+    return;
+  }
+
+  // Whatever has left the output buffer was taken from the oldest frames
+  size_t written = conn->m_queued - pending;
+  while (!conn->m_frames.empty() && conn->m_frames.front().m_size <= written) {
+    written -= conn->m_frames.front().m_size;
+    conn->m_queued -= conn->m_frames.front().m_size;
+    conn->m_frames.pop_front();
+  }
+}
+
+void PeerConnectionPool::Requeue(const Peer& peer, deque<Frame>& frames) {
+  size_t bytesDropped = 0;
+  for (const auto& frame : frames) {
+    bytesDropped += frame.m_size;
+  }
+
+  bool created = false;
+  ConnectionPtr conn = Acquire(peer, created);
+  if (created && !Open(conn)) {
+    Release(conn);
+    LOG_GENERAL(WARNING, "Dropped " << frames.size() << " frames ("
+                                    << bytesDropped << " bytes) to " << peer
+                                    << " that could not be requeued");
+    return;
+  }
+
+  // A requeued frame is not requeued again if this connection fails too
+  unsigned int requeued = 0;
+  bufferevent_lock(conn->m_bev);
+  for (auto& frame : frames) {
+    const size_t frameSize = frame.m_size;
+    frame.m_requeue = false;
+    if (!Append(conn.get(), move(frame), false)) {
+      break;
+    }
+    bytesDropped -= frameSize;
+    requeued++;
+  }
+  bufferevent_unlock(conn->m_bev);
+
+  LOG_GENERAL(INFO, "Requeued " << requeued << " frames to " << peer);
+
+  ConnectionPtr detached;
+  if (requeued < frames.size()) {
+    LOG_GENERAL(WARNING, "Dropped " << frames.size() - requeued << " frames ("
+                                    << bytesDropped << " bytes) to " << peer
+                                    << " that could not be requeued");
+    lock_guard<mutex> g(m_mutex);
+    detached = DetachLocked(conn.get(), ENOMEM);
+  }
+
+  Release(conn);
+}
+
+PeerConnectionPool::ConnectionPtr PeerConnectionPool::DetachLocked(
+    Connection* conn, int error) {
+  ConnectionPtr detached;
+
+  if (conn->m_state != CLOSED) {
+    conn->m_state = CLOSED;
+    conn->m_error = error;
+  }
+
+  auto it = m_connections.find(conn->m_peer);
+  if (it != m_connections.end() && it->second.get() == conn) {
+    detached = move(it->second);
+    m_connections.erase(it);
+  }
+
+  conn->m_cv.notify_all();
+  return detached;
+}
+
+void PeerConnectionPool::ReleasePayload([[gnu::unused]] const void* data,
+                                        [[gnu::unused]] size_t len,
+                                        void* ctx) {
+  delete static_cast<shared_ptr<const bytes>*>(ctx);
+}
+
+void PeerConnectionPool::ReadCallback(struct bufferevent* bev,
+                                      [[gnu::unused]] void* ctx) {
+  // Peers do not reply on our outbound connections; reading is only enabled
+  // to notice when they close
+  struct evbuffer* input = bufferevent_get_input(bev);
+  evbuffer_drain(input, evbuffer_get_length(input));
+}
+
+void PeerConnectionPool::WriteCallback(struct bufferevent* bev, void* ctx) {
+  auto conn = static_cast<Connection*>(ctx);
+  const size_t pending = evbuffer_get_length(bufferevent_get_output(bev));
+
+  lock_guard<mutex> g(conn->m_pool->m_mutex);
+  conn->m_pending = pending;
+  PopWrittenLocked(conn, pending);
+  conn->m_cv.notify_all();
+}
+
+void PeerConnectionPool::EventCallback(struct bufferevent* bev, short events,
+                                       void* ctx) {
+  auto conn = static_cast<Connection*>(ctx);
+  auto pool = conn->m_pool;
+
+  if (events & BEV_EVENT_CONNECTED) {
+    int one = 1;
+    setsockopt(bufferevent_getfd(bev), IPPROTO_TCP, TCP_NODELAY, &one,
+               sizeof(one));
+
+    lock_guard<mutex> g(conn->m_pool->m_mutex);
+    conn->m_state = CONNECTED;
+    conn->m_cv.notify_all();
+    return;
+  }
+
+  int error = ECONNRESET;
+  if (events & BEV_EVENT_ERROR) {
+    error = EVUTIL_SOCKET_ERROR();
+    LOG_GENERAL(WARNING, "Connection to " << conn->m_peer
+                                          << " failed. Code = " << error
+                                          << " Desc: " << std::strerror(error));
+  } else {
+    LOG_GENERAL(INFO, "Connection closed by " << conn->m_peer);
+  }
+
+  bufferevent_disable(bev, EV_READ | EV_WRITE);
+  const size_t pending = evbuffer_get_length(bufferevent_get_output(bev));
+
+  // The connection may be freed when detached goes out of scope, so conn
+  // must not be touched after this
+  const Peer peer = conn->m_peer;
+  deque<Frame> unsent;
+  ConnectionPtr detached;
+  {
+    lock_guard<mutex> g(pool->m_mutex);
+    PopWrittenLocked(conn, pending);
+    unsent.swap(conn->m_frames);
+    conn->m_queued = 0;
+    detached = pool->DetachLocked(conn, error);
+  }
+
+  if (unsent.empty()) {
+    return;
+  }
+
+  // Frames the peer may have got in part are sent again in full, as the
+  // partial frame is dropped with the connection on its side
+  deque<Frame> requeue;
+  size_t bytesDropped = 0;
+  unsigned int framesDropped = 0;
+  for (auto& frame : unsent) {
+    if (frame.m_requeue && !pool->m_stopping) {
+      requeue.emplace_back(move(frame));
+    } else {
+      bytesDropped += frame.m_size;
+      framesDropped++;
+    }
+  }
+
+  LOG_GENERAL(WARNING, "Connection to " << peer << " lost with "
+                                        << unsent.size()
+                                        << " frames unsent. Dropped "
+                                        << framesDropped << " frames ("
+                                        << bytesDropped << " bytes)");
+
+  if (!requeue.empty()) {
+    pool->Requeue(peer, requeue);
+  }
+}
+
+void PeerConnectionPool::SweepCallback([[gnu::unused]] int fd,
+                                       [[gnu::unused]] short events,
+                                       void* ctx) {
+  auto pool = static_cast<PeerConnectionPool*>(ctx);
+  if (pool->m_stopping) {
+    event_base_loopbreak(pool->m_base);
+    return;
+  }
+
+  const auto cutoff = chrono::steady_clock::now() -
+                      chrono::seconds(IDLE_CONNECTION_TIMEOUT_IN_SECONDS);
+  auto isIdle = [&cutoff](const ConnectionPtr& conn) {
+    return conn->m_users == 0 && conn->m_state == CONNECTED &&
+           conn->m_pending == 0 && conn->m_lastUsed < cutoff;
+  };
+
+  vector<ConnectionPtr> candidates;
+  {
+    lock_guard<mutex> g(pool->m_mutex);
+    for (const auto& entry : pool->m_connections) {
+      if (isIdle(entry.second)) {
+        candidates.emplace_back(entry.second);
+      }
+    }
+  }
+
+  // Freed after m_mutex and the bufferevent locks are released
+  vector<ConnectionPtr> idle;
+  for (const auto& conn : candidates) {
+    // A connection is only idle once its output buffer has been flushed.
+    // The bufferevent lock is taken before m_mutex, as in the callbacks.
+    bufferevent_lock(conn->m_bev);
+    const size_t pending =
+        evbuffer_get_length(bufferevent_get_output(conn->m_bev));
+    {
+      lock_guard<mutex> g(pool->m_mutex);
+      if (pending == 0 && isIdle(conn)) {
+        idle.emplace_back(pool->DetachLocked(conn.get(), 0));
+      }
+    }
+    bufferevent_unlock(conn->m_bev);
+  }
+  candidates.clear();
+
+  if (!idle.empty()) {
+    LOG_GENERAL(INFO, "Closing " << idle.size() << " idle connections");
+  }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBNETWORK_PEERCONNECTIONPOOL_H_
+#define ZILLIQA_SRC_LIBNETWORK_PEERCONNECTIONPOOL_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Peer.h"
+
+struct bufferevent;
+struct event;
+struct event_base;
+
+/// Keeps one persistent outbound connection per peer, driven by its own
+/// libevent loop.
+///
+/// Each message is appended to the connection's output buffer as one complete
+/// frame (the same header + payload that P2PComm sends), so messages from
+/// concurrent senders never interleave and the receiver splits them out of
+/// the stream using the length in the header. The payload is referenced, not
+/// copied, so the same message queued to many peers is held in memory once.
+/// Senders block while the connection has more than MAX_SEND_BUFFER_IN_BYTES
+/// queued, and connections left idle for IDLE_CONNECTION_TIMEOUT_IN_SECONDS
+/// with nothing left to write are closed.
+///
+/// Frames are tracked until they have been written to the socket. When a
+/// connection fails, the frames it had not written are counted in the log,
+/// and those queued with requeue set are sent once more on a new connection.
+///
+/// Lock order: libevent's per-connection lock may be held while taking
+/// m_mutex (inside callbacks), never the other way round.
+class PeerConnectionPool {
+ public:
+  PeerConnectionPool();
+  ~PeerConnectionPool();
+
+  /// Starts the event loop thread. Send fails until this succeeds.
+  bool Start();
+
+  bool IsRunning() const { return m_running; }
+
+  /// Queues a frame made of header followed by payload for the peer,
+  /// connecting first if needed. Returns false with errno set to the socket
+  /// error if the connection could not be established, or to EAGAIN if
+  /// connecting or waiting for buffer space took longer than
+  /// CONNECTION_TIMEOUT_IN_SECONDS. With requeue set, the frame is sent again
+  /// on a new connection if this one fails before writing all of it.
+  bool Send(const Peer& peer, const bytes& header,
+            const std::shared_ptr<const bytes>& payload, bool requeue);
+
+ private:
+  enum State : unsigned char { CONNECTING, CONNECTED, CLOSED };
+
+  /// A frame in a connection's output buffer. The header and payload are
+  /// only kept for frames that may be requeued.
+  struct Frame {
+    bytes m_header;
+    std::shared_ptr<const bytes> m_payload;
+    size_t m_size{0};
+    bool m_requeue{false};
+  };
+
+  struct Connection {
+    PeerConnectionPool* m_pool;
+    Peer m_peer;
+    struct bufferevent* m_bev{nullptr};
+    State m_state{CONNECTING};
+    int m_error{0};
+    unsigned int m_users{0};
+    size_t m_pending{0};
+    /// Frames not yet fully written, oldest first, and their total size
+    std::deque<Frame> m_frames;
+    size_t m_queued{0};
+    std::chrono::steady_clock::time_point m_lastUsed;
+    std::condition_variable m_cv;
+
+    Connection(PeerConnectionPool* pool, const Peer& peer)
+        : m_pool(pool), m_peer(peer) {}
+    ~Connection();
+  };
+
+  using ConnectionPtr = std::shared_ptr<Connection>;
+
+  std::mutex m_mutex;
+  std::map<Peer, ConnectionPtr> m_connections;
+
+  struct event_base* m_base{nullptr};
+  struct event* m_sweepEvent{nullptr};
+  std::thread m_loopThread;
+  std::atomic<bool> m_running{false};
+  std::atomic<bool> m_stopping{false};
+
+  ConnectionPtr Acquire(const Peer& peer, bool& created);
+  void Release(const ConnectionPtr& conn);
+  bool Open(const ConnectionPtr& conn);
+
+  /// Appends the frame to the connection's output buffer. Must be called with
+  /// the bufferevent lock held, and not with m_mutex held.
+  bool Append(Connection* conn, Frame&& frame, bool reserved);
+
+  /// Drops the frames already written out, given the number of bytes still
+  /// in the output buffer. Must be called with m_mutex held.
+  static void PopWrittenLocked(Connection* conn, size_t pending);
+
+  /// Sends the frames on a new connection to the peer, from the loop thread.
+  void Requeue(const Peer& peer, std::deque<Frame>& frames);
+
+  /// Marks the connection closed and removes it from the pool. Must be
+  /// called with m_mutex held; the returned pointer has to be released after
+  /// m_mutex is unlocked, as it may free the bufferevent.
+  ConnectionPtr DetachLocked(Connection* conn, int error);
+
+  static void ReleasePayload(const void* data, size_t len, void* ctx);
+  static void ReadCallback(struct bufferevent* bev, void* ctx);
+  static void WriteCallback(struct bufferevent* bev, void* ctx);
+  static void EventCallback(struct bufferevent* bev, short events, void* ctx);
+  static void SweepCallback(int fd, short events, void* ctx);
+};
+
+#endif  // ZILLIQA_SRC_LIBNETWORK_PEERCONNECTIONPOOL_H_
@@ -130,11 +130,11 @@ bool Node::VerifyDSBlockCoSignature(const DSBlock& dsblock) {
     return false;
   }
 
-  // Generate the aggregated key
   vector<PubKey> keys;
+  keys.reserve(B2.size());
   for (auto const& kv : *m_mediator.m_DSCommittee) {
+    keys.emplace_back(kv.first);
     if (B2.at(index)) {
-      keys.emplace_back(kv.first);
       count++;
     }
     index++;
@@ -145,7 +145,9 @@ bool Node::VerifyDSBlockCoSignature(const DSBlock& dsblock) {
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  // Generate the aggregated key
+  shared_ptr<PubKey> aggregatedKey =
+      MultiSig::GetInstance().AggregateCommitteeKeys(keys, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -162,8 +164,10 @@ bool Node::VerifyDSBlockCoSignature(const DSBlock& dsblock) {
   if (!MultiSig::GetInstance().MultiSigVerify(
           message, 0, message.size(), dsblock.GetCS2(), *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    for (unsigned int i = 0; i < keys.size(); i++) {
+      if (B2.at(i)) {
+        LOG_GENERAL(WARNING, keys.at(i));
+      }
     }
     return false;
   }
@@ -298,9 +302,7 @@ void Node::StartFirstTxEpoch() {
     LOG_STATE(
         "[SHSTU]["
         << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-        << "]["
-        << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-               1
+        << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
         << "] RECVD SHARDING STRUCTURE");
 
     LOG_STATE("[IDENT][" << std::setw(15) << std::left
@@ -437,8 +439,7 @@ bool Node::ProcessVCDSBlocksMessage(const bytes& message,
     LOG_GENERAL(WARNING,
                 "ProcessVCDSBlocksMessage CheckWhetherBlockIsLatest failed");
     if (dsblock.GetHeader().GetBlockNum() >
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-            1) {
+        m_mediator.m_dsBlockChain.GetLastBlockNum() + 1) {
       if (LOOKUP_NODE_MODE && ARCHIVAL_LOOKUP) {
         m_mediator.m_lookup->RejoinAsNewLookup();
       }
@@ -523,11 +524,10 @@ bool Node::ProcessVCDSBlocksMessage(const bytes& message,
   LOG_STATE(
       "[DSBLK]["
       << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-      << "]["
-      << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1
+      << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
       << "] RECVD DSBLOCK -> DS Diff = "
-      << to_string(dsblock.GetHeader().GetDSDifficulty())
-      << " Diff = " << to_string(dsblock.GetHeader().GetDifficulty()));
+      << to_string(dsblock.GetHeader().GetDSDifficulty()) << " Diff = "
+      << to_string(dsblock.GetHeader().GetDifficulty()));
 
   if (LOOKUP_NODE_MODE) {
     LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
@@ -685,13 +685,12 @@ bool Node::ProcessVCDSBlocksMessage(const bytes& message,
          0) &&  // If limit is 0, skip deletion
         (BlockStorage::GetBlockStorage().GetDiagnosticDataNodesCount() >=
          MAX_ENTRIES_FOR_DIAGNOSTIC_DATA) &&  // Limit reached
-        (m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() >=
+        (m_mediator.m_dsBlockChain.GetLastBlockNum() >=
          MAX_ENTRIES_FOR_DIAGNOSTIC_DATA)) {  // DS Block number is not below
                                               // limit
 
-      const uint64_t oldBlockNum =
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() -
-          MAX_ENTRIES_FOR_DIAGNOSTIC_DATA;
+      const uint64_t oldBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum() -
+                                   MAX_ENTRIES_FOR_DIAGNOSTIC_DATA;
 
       canPutNewEntry =
           BlockStorage::GetBlockStorage().DeleteDiagnosticDataNodes(
@@ -709,7 +708,7 @@ bool Node::ProcessVCDSBlocksMessage(const bytes& message,
 
     if (canPutNewEntry) {
       BlockStorage::GetBlockStorage().PutDiagnosticDataNodes(
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
+          m_mediator.m_dsBlockChain.GetLastBlockNum(),
           m_mediator.m_ds->m_shards, *m_mediator.m_DSCommittee);
     }
   }
@@ -72,12 +72,11 @@ bool Node::VerifyFallbackBlockCoSignature(const FallbackBlock& fallbackblock) {
     return false;
   }
 
-  // Generate the aggregated key
   vector<PubKey> keys;
-
+  keys.reserve(B2.size());
   for (auto const& shardNode : m_mediator.m_ds->m_shards[shard_id]) {
+    keys.emplace_back(std::get<SHARD_NODE_PUBKEY>(shardNode));
     if (B2.at(index)) {
-      keys.emplace_back(std::get<SHARD_NODE_PUBKEY>(shardNode));
       count++;
     }
     index++;
@@ -88,7 +87,9 @@ bool Node::VerifyFallbackBlockCoSignature(const FallbackBlock& fallbackblock) {
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  // Generate the aggregated key
+  shared_ptr<PubKey> aggregatedKey =
+      MultiSig::GetInstance().AggregateCommitteeKeys(keys, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -105,8 +106,10 @@ bool Node::VerifyFallbackBlockCoSignature(const FallbackBlock& fallbackblock) {
   if (!MultiSig::GetInstance().MultiSigVerify(
           message, 0, message.size(), fallbackblock.GetCS2(), *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed. Pubkeys");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    for (unsigned int i = 0; i < keys.size(); i++) {
+      if (B2.at(i)) {
+        LOG_GENERAL(WARNING, keys.at(i));
+      }
     }
     return false;
   }
@@ -302,10 +305,7 @@ bool Node::ProcessFallbackBlock(const bytes& message, unsigned int cur_offset,
       LOG_STATE("[FLBLK][" << setw(15) << left
                            << m_mediator.m_selfPeer.GetPrintableIPAddress()
                            << "]["
-                           << m_mediator.m_txBlockChain.GetLastBlock()
-                                      .GetHeader()
-                                      .GetBlockNum() +
-                                  1
+                           << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
                            << "] FINISH WRITE STATE TO DISK");
     };
     DetachedFunction(1, writeStateToDisk);
@@ -207,10 +207,7 @@ void Node::ProcessFallbackConsensusWhenDone() {
       LOG_STATE("[FLBLK][" << setw(15) << left
                            << m_mediator.m_selfPeer.GetPrintableIPAddress()
                            << "]["
-                           << m_mediator.m_txBlockChain.GetLastBlock()
-                                      .GetHeader()
-                                      .GetBlockNum() +
-                                  1
+                           << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
                            << "] FINISH WRITE STATE TO DISK");
     };
     DetachedFunction(1, writeStateToDisk);
@@ -418,8 +418,7 @@ bool Node::ComposeFallbackBlock() {
   // To-do: Handle exceptions.
   m_pendingFallbackBlock.reset(new FallbackBlock(
       FallbackBlockHeader(
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-              1,
+          m_mediator.m_dsBlockChain.GetLastBlockNum() + 1,
           m_mediator.m_currentEpochNum, m_fallbackState,
           {AccountStore::GetInstance().GetStateRootHash()}, m_consensusLeaderID,
           leaderNetworkInfo, m_myShardMembers->at(m_consensusLeaderID).first,
@@ -79,8 +79,7 @@ bool Node::StoreFinalBlock(const TxBlock& txBlock) {
       "[FINBK]["
       << std::setw(15) << std::left
       << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["
-      << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1
-      << "] RECV");
+      << m_mediator.m_txBlockChain.GetLastBlockNum() + 1 << "] RECV");
 
   return true;
 }
@@ -217,11 +216,11 @@ bool Node::VerifyFinalBlockCoSignature(const TxBlock& txblock) {
     return false;
   }
 
-  // Generate the aggregated key
   vector<PubKey> keys;
+  keys.reserve(B2.size());
   for (auto const& kv : *m_mediator.m_DSCommittee) {
+    keys.emplace_back(kv.first);
     if (B2.at(index)) {
-      keys.emplace_back(kv.first);
       count++;
     }
     index++;
@@ -232,7 +231,9 @@ bool Node::VerifyFinalBlockCoSignature(const TxBlock& txblock) {
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  // Generate the aggregated key
+  shared_ptr<PubKey> aggregatedKey =
+      MultiSig::GetInstance().AggregateCommitteeKeys(keys, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -249,8 +250,10 @@ bool Node::VerifyFinalBlockCoSignature(const TxBlock& txblock) {
   if (!MultiSig::GetInstance().MultiSigVerify(
           message, 0, message.size(), txblock.GetCS2(), *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    for (unsigned int i = 0; i < keys.size(); i++) {
+      if (B2.at(i)) {
+        LOG_GENERAL(WARNING, keys.at(i));
+      }
     }
     return false;
   }
@@ -268,12 +271,10 @@ void Node::InitiatePoW() {
 
   SetState(POW_SUBMISSION);
   POW::GetInstance().EthashConfigureClient(
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1,
-      FULL_DATASET_MINE);
+      m_mediator.m_dsBlockChain.GetLastBlockNum() + 1, FULL_DATASET_MINE);
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum, "Start pow ");
   auto func = [this]() mutable -> void {
-    auto epochNumber =
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+    auto epochNumber = m_mediator.m_dsBlockChain.GetLastBlockNum() + 1;
     auto dsBlockRand = m_mediator.m_dsBlockRand;
     auto txBlockRand = m_mediator.m_txBlockRand;
     StartPoW(
@@ -437,8 +438,7 @@ bool Node::ComposeMBnForwardTxnMessageForSender(bytes& mb_txns_message) {
     return false;
   }
 
-  const auto& blocknum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  const auto& blocknum = m_mediator.m_txBlockChain.GetLastBlockNum();
 
   {
     const vector<TxnHash>& tx_hashes = m_microblock->GetTranHashes();
@@ -470,8 +470,7 @@ bool Node::ComposeMBnForwardTxnMessageForSender(bytes& mb_txns_message) {
   LOG_STATE(
       "[TXBOD]["
       << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-      << "]["
-      << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1
+      << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
       << "] BEFORE SENDING MB & FORWARDING TXN BODIES #" << blocknum);
 
   LOG_GENERAL(INFO, "[SendMBnTxn]"
@@ -750,9 +749,7 @@ bool Node::ProcessFinalBlockCore(const bytes& message, unsigned int offset,
     auto writeStateToDisk = [this]() -> void {
       if (!AccountStore::GetInstance().MoveUpdatesToDisk(
               LOOKUP_NODE_MODE && ENABLE_REPOPULATE &&
-              (m_mediator.m_dsBlockChain.GetLastBlock()
-                       .GetHeader()
-                       .GetBlockNum() %
+              (m_mediator.m_dsBlockChain.GetLastBlockNum() %
                    REPOPULATE_STATE_PER_N_DS ==
                REPOPULATE_STATE_IN_DS))) {
         LOG_GENERAL(WARNING, "MoveUpdatesToDisk failed, what to do?");
@@ -782,9 +779,8 @@ bool Node::ProcessFinalBlockCore(const bytes& message, unsigned int offset,
           // change if all microblock received from shards
           lock_guard<mutex> g(m_mutexUnavailableMicroBlocks);
           if (m_unavailableMicroBlocks.find(
-                  m_mediator.m_txBlockChain.GetLastBlock()
-                      .GetHeader()
-                      .GetBlockNum()) == m_unavailableMicroBlocks.end()) {
+                  m_mediator.m_txBlockChain.GetLastBlockNum()) ==
+              m_unavailableMicroBlocks.end()) {
             if (!BlockStorage::GetBlockStorage().PutMetadata(
                     MetaType::DSINCOMPLETED, {'0'})) {
               LOG_GENERAL(WARNING,
@@ -801,13 +797,10 @@ bool Node::ProcessFinalBlockCore(const bytes& message, unsigned int offset,
         LOG_STATE("[FLBLK][" << setw(15) << left
                              << m_mediator.m_selfPeer.GetPrintableIPAddress()
                              << "]["
-                             << m_mediator.m_txBlockChain.GetLastBlock()
-                                        .GetHeader()
-                                        .GetBlockNum() +
-                                    1
+                             << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
                              << "] FINISH WRITE STATE TO DISK");
         if (ENABLE_ACCOUNTS_POPULATING &&
-            m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() <
+            m_mediator.m_dsBlockChain.GetLastBlockNum() <
                 PREGEN_ACCOUNT_TIMES) {
           PopulateAccounts();
         }
@@ -935,6 +928,20 @@ void Node::CommitForwardedTransactions(const MBnForwardedTxnEntry& entry) {
                                << twr.GetTransaction().GetTranID());
       return;
     }
+
+    // Index deployed contracts by creator for GetSmartContracts
+    const Transaction& tx = twr.GetTransaction();
+    if (LOOKUP_NODE_MODE &&
+        Transaction::GetTransactionType(tx) == Transaction::CONTRACT_CREATION &&
+        tx.GetNonce() > 0) {
+      const Address& sender = tx.GetSenderAddr();
+      if (!BlockStorage::GetBlockStorage().PutContractCreator(
+              sender, tx.GetNonce(),
+              Account::GetAddressForContract(sender, tx.GetNonce() - 1))) {
+        LOG_GENERAL(WARNING, "BlockStorage::PutContractCreator failed "
+                                 << tx.GetTranID());
+      }
+    }
   }
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
             "Proceessed " << entry.m_transactions.size() << " of txns.");
@@ -1041,13 +1048,12 @@ bool Node::ProcessMBnForwardTransaction(const bytes& message,
   LOG_STATE(
       "[TXBOD]["
       << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-      << "]["
-      << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1
+      << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
       << "] RECVD MB & TXN BODIES #"
       << entry.m_microBlock.GetHeader().GetEpochNum() << " shard "
       << entry.m_microBlock.GetHeader().GetShardId());
 
-  if ((m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() <
+  if ((m_mediator.m_txBlockChain.GetLastBlockNum() <
        entry.m_microBlock.GetHeader()
            .GetEpochNum()) || /* Buffer for syncing seed node */
       (LOOKUP_NODE_MODE && ARCHIVAL_LOOKUP &&
@@ -1167,8 +1173,7 @@ void Node::CommitMBnForwardedTransactionBuffer() {
 
   for (auto it = m_mbnForwardedTxnBuffer.begin();
        it != m_mbnForwardedTxnBuffer.end();) {
-    if (it->first <=
-        m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum()) {
+    if (it->first <= m_mediator.m_txBlockChain.GetLastBlockNum()) {
       for (const auto& entry : it->second) {
         ProcessMBnForwardTransactionCore(entry);
       }
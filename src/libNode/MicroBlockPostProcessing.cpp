@@ -285,9 +285,7 @@ bool Node::ProcessMicroBlockConsensusCore(const bytes& message,
     LOG_STATE(
         "[MIBLK]["
         << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-        << "]["
-        << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-               1
+        << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1
         << "] AFTER SENDING MIBLK");
 
     m_lastMicroBlockCoSig.first = m_mediator.m_currentEpochNum;
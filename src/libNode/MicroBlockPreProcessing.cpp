@@ -18,6 +18,7 @@
 #include <array>
 #include <chrono>
 #include <functional>
+#include <set>
 #include <thread>
 
 #include "Node.h"
@@ -140,8 +141,8 @@ bool Node::ComposeMicroBlock(const uint64_t& microblock_gas_limit) {
       MicroBlockHeader(
           shardId, gasLimit, gasUsed, rewards, m_mediator.m_currentEpochNum,
           {txRootHash, stateDeltaHash, txReceiptHash}, numTxs, minerPubKey,
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
-          version, committeeHash, prevHash),
+          m_mediator.m_dsBlockChain.GetLastBlockNum(), version, committeeHash,
+          prevHash),
       tranHashes, CoSignatures()));
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
@@ -265,6 +266,115 @@ void Node::NotifyTimeout(bool& txnProcTimeout) {
   }
 }
 
+bool Node::ProcessPaymentBatch(
+    const uint64_t& microblock_gas_limit,
+    const function<void(const Transaction&, const TransactionReceipt&)>&
+        appendOne,
+    vector<Transaction>& gasLimitExceededTxnBuffer, const bool& txnProcTimeout,
+    bool& stop) {
+  enum PickType { PAYMENT, GAS_EXCEEDED, OTHER };
+
+  // Pick txns as the sequential loop would if every payment succeeded, until
+  // a non-payment txn comes up
+  vector<pair<Transaction, PickType>> picked;
+  vector<Transaction> payments;
+  uint64_t gasUsed = m_gasUsedTotal;
+
+  while (!txnProcTimeout && gasUsed < microblock_gas_limit &&
+         payments.size() < PAYMENT_BATCH_SIZE) {
+    Transaction t;
+    if (!t_createdTxns.popReady(t)) {
+      break;
+    }
+
+    if (gasUsed + t.GetGasLimit() > microblock_gas_limit) {
+      picked.emplace_back(t, GAS_EXCEEDED);
+      continue;
+    }
+
+    if (Transaction::GetTransactionType(t) != Transaction::NON_CONTRACT) {
+      picked.emplace_back(t, OTHER);
+      break;
+    }
+
+    t_createdTxns.updateSender(t.GetSenderAddr(), t.GetNonce());
+    gasUsed += NORMAL_TRAN_GAS;
+    picked.emplace_back(t, PAYMENT);
+    payments.emplace_back(t);
+  }
+
+  PaymentBatch batch;
+  if (!payments.empty()) {
+    m_mediator.m_validator->CheckCreatedPayments(payments, batch);
+  }
+
+  // Account for the txns in order. Whatever was picked after the first failed
+  // payment is undone, since the sequential loop would have picked otherwise.
+  size_t numPicked = 0;
+  size_t numPayments = 0;
+  set<Address> sendersToUpdate;
+
+  for (; numPicked < picked.size(); numPicked++) {
+    const Transaction& t = picked[numPicked].first;
+    if (picked[numPicked].second == GAS_EXCEEDED) {
+      gasLimitExceededTxnBuffer.emplace_back(t);
+      sendersToUpdate.emplace(t.GetSenderAddr());
+      continue;
+    }
+    if (picked[numPicked].second == OTHER) {
+      break;
+    }
+
+    const TransactionReceipt& tr = batch.receipts.at(numPayments);
+    const bool applied = batch.applied.at(numPayments);
+    numPayments++;
+
+    if (!applied) {
+      sendersToUpdate.emplace(t.GetSenderAddr());
+      numPicked++;
+      break;
+    }
+
+    if (!SafeMath<uint64_t>::add(m_gasUsedTotal, tr.GetCumGas(),
+                                 m_gasUsedTotal)) {
+      LOG_GENERAL(WARNING, "m_gasUsedTotal addition overflow!");
+      stop = true;
+      numPicked++;
+      break;
+    }
+    uint128_t txnFee;
+    if (!SafeMath<uint128_t>::mul(tr.GetCumGas(), t.GetGasPrice(), txnFee)) {
+      LOG_GENERAL(WARNING, "txnFee multiplication overflow!");
+      continue;
+    }
+    if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
+      LOG_GENERAL(WARNING, "m_txnFees addition overflow!");
+      stop = true;
+      numPicked++;
+      break;
+    }
+    appendOne(t, tr);
+  }
+
+  AccountStore::GetInstance().CommitPaymentsTemp(batch, numPayments);
+
+  // The senders of these picks may still hold the nonce of a payment that
+  // was not committed
+  vector<Transaction> unused;
+  for (size_t i = numPicked; i < picked.size(); i++) {
+    unused.emplace_back(picked[i].first);
+  }
+  t_createdTxns.reinsert(unused, [](const Address& addr) {
+    return AccountStore::GetInstance().GetNonceTemp(addr);
+  });
+  for (const auto& sender : sendersToUpdate) {
+    t_createdTxns.updateSender(
+        sender, AccountStore::GetInstance().GetNonceTemp(sender));
+  }
+
+  return !payments.empty();
+}
+
 void Node::ProcessTransactionWhenShardLeader(
     const uint64_t& microblock_gas_limit) {
   LOG_MARKER();
@@ -276,7 +386,6 @@ void Node::ProcessTransactionWhenShardLeader(
   lock_guard<mutex> g(m_mutexCreatedTransactions);
 
   t_createdTxns = m_createdTxns;
-  map<Address, map<uint64_t, Transaction>> t_addrNonceTxnMap;
   t_processedTransactions.clear();
   m_TxnOrder.clear();
 
@@ -290,25 +399,6 @@ void Node::ProcessTransactionWhenShardLeader(
 
   this_thread::sleep_for(chrono::milliseconds(100));
 
-  auto findOneFromAddrNonceTxnMap =
-      [](Transaction& t,
-         map<Address, map<uint64_t, Transaction>>& t_addrNonceTxnMap) -> bool {
-    for (auto it = t_addrNonceTxnMap.begin(); it != t_addrNonceTxnMap.end();
-         it++) {
-      if (it->second.begin()->first ==
-          AccountStore::GetInstance().GetNonceTemp(it->first) + 1) {
-        t = move(it->second.begin()->second);
-        it->second.erase(it->second.begin());
-
-        if (it->second.empty()) {
-          t_addrNonceTxnMap.erase(it);
-        }
-        return true;
-      }
-    }
-    return false;
-  };
-
   auto appendOne = [this](const Transaction& t, const TransactionReceipt& tr) {
     t_processedTransactions.insert(
         make_pair(t.GetTranID(), TransactionWithReceipt(t, tr)));
@@ -320,116 +410,76 @@ void Node::ProcessTransactionWhenShardLeader(
 
   vector<Transaction> gasLimitExceededTxnBuffer;
 
+  // Look up the nonce of every pending sender once, after which each
+  // executable txn is picked from the pool's ready index
+  t_createdTxns.prepareReady([](const Address& addr) {
+    return AccountStore::GetInstance().GetNonceTemp(addr);
+  });
+
   while (m_gasUsedTotal < microblock_gas_limit) {
     if (txnProcTimeout) {
       break;
     }
 
+    if (ENABLE_PARALLEL_PAYMENTS) {
+      bool stop = false;
+      if (ProcessPaymentBatch(microblock_gas_limit, appendOne,
+                              gasLimitExceededTxnBuffer, txnProcTimeout,
+                              stop)) {
+        if (stop) {
+          break;
+        }
+        continue;
+      }
+    }
+
     Transaction t;
     TransactionReceipt tr;
 
-    // check m_addrNonceTxnMap contains any txn meets right nonce,
-    // if contains, process it
-    if (findOneFromAddrNonceTxnMap(t, t_addrNonceTxnMap)) {
-      // check whether m_createdTransaction have transaction with same Addr and
-      // nonce if has and with larger gasPrice then replace with that one.
-      // (*optional step)
-      t_createdTxns.findSameNonceButHigherGas(t);
+    // Pick the executable txn with the highest gas price
+    if (!t_createdTxns.popReady(t)) {
+      break;
+    }
 
-      if (m_gasUsedTotal + t.GetGasLimit() > microblock_gas_limit) {
-        gasLimitExceededTxnBuffer.emplace_back(t);
-        continue;
-      }
+    // With this txn out of the pool the sender's later txns cannot become
+    // ready, but they are still reported as waiting for a lower nonce
+    if (m_gasUsedTotal + t.GetGasLimit() > microblock_gas_limit) {
+      gasLimitExceededTxnBuffer.emplace_back(t);
+      t_createdTxns.updateSender(
+          t.GetSenderAddr(),
+          AccountStore::GetInstance().GetNonceTemp(t.GetSenderAddr()));
+      continue;
+    }
 
-      if (m_mediator.m_validator->CheckCreatedTransaction(t, tr)) {
-        if (!SafeMath<uint64_t>::add(m_gasUsedTotal, tr.GetCumGas(),
-                                     m_gasUsedTotal)) {
-          LOG_GENERAL(WARNING, "m_gasUsedTotal addition unsafe!");
-          break;
-        }
-        uint128_t txnFee;
-        if (!SafeMath<uint128_t>::mul(tr.GetCumGas(), t.GetGasPrice(),
-                                      txnFee)) {
-          LOG_GENERAL(WARNING, "txnFee multiplication unsafe!");
-          continue;
-        }
-        if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
-          LOG_GENERAL(WARNING, "m_txnFees addition unsafe!");
-          break;
-        }
-        appendOne(t, tr);
+    const Address senderAddr = t.GetSenderAddr();
+    const bool applied = m_mediator.m_validator->CheckCreatedTransaction(t, tr);
+    t_createdTxns.updateSender(
+        senderAddr, AccountStore::GetInstance().GetNonceTemp(senderAddr));
 
-        continue;
-      }
+    if (!applied) {
+      continue;
     }
-    // if no txn in u_map meet right nonce process new come-in transactions
-    else if (t_createdTxns.findOne(t)) {
-      // LOG_GENERAL(INFO, "findOneFromCreated");
-
-      Address senderAddr = t.GetSenderAddr();
-      // check nonce, if nonce larger than expected, put it into
-      // m_addrNonceTxnMap
-      if (t.GetNonce() >
-          AccountStore::GetInstance().GetNonceTemp(senderAddr) + 1) {
-        // LOG_GENERAL(INFO, "High nonce: "
-        //                     << t.GetNonce() << " cur sender " <<
-        //                     senderAddr.hex()
-        //                     << " nonce: "
-        //                     <<
-        //                     AccountStore::GetInstance().GetNonceTemp(senderAddr));
-        auto it1 = t_addrNonceTxnMap.find(senderAddr);
-        if (it1 != t_addrNonceTxnMap.end()) {
-          auto it2 = it1->second.find(t.GetNonce());
-          if (it2 != it1->second.end()) {
-            // found the txn with same addr and same nonce
-            // then compare the gasprice and remains the higher one
-            if (t.GetGasPrice() > it2->second.GetGasPrice()) {
-              it2->second = t;
-            }
-            continue;
-          }
-        }
-        t_addrNonceTxnMap[senderAddr].insert({t.GetNonce(), t});
-      }
-      // if nonce too small, ignore it
-      else if (t.GetNonce() <
-               AccountStore::GetInstance().GetNonceTemp(senderAddr) + 1) {
-        // LOG_GENERAL(INFO,
-        //             "Nonce too small"
-        //                 << " Expected "
-        //                 <<
-        //                 AccountStore::GetInstance().GetNonceTemp(senderAddr)
-        //                 << " Found " << t.GetNonce());
-      }
-      // if nonce correct, process it
-      else if (m_mediator.m_validator->CheckCreatedTransaction(t, tr)) {
-        if (!SafeMath<uint64_t>::add(m_gasUsedTotal, tr.GetCumGas(),
-                                     m_gasUsedTotal)) {
-          LOG_GENERAL(WARNING, "m_gasUsedTotal addition unsafe!");
-          break;
-        }
-        uint128_t txnFee;
-        if (!SafeMath<uint128_t>::mul(tr.GetCumGas(), t.GetGasPrice(),
-                                      txnFee)) {
-          LOG_GENERAL(WARNING, "txnFee multiplication unsafe!");
-          continue;
-        }
-        if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
-          LOG_GENERAL(WARNING, "m_txnFees addition unsafe!");
-          break;
-        }
-        appendOne(t, tr);
-      } else {
-        // LOG_GENERAL(WARNING, "CheckCreatedTransaction failed");
-      }
-    } else {
+
+    if (!SafeMath<uint64_t>::add(m_gasUsedTotal, tr.GetCumGas(),
+                                 m_gasUsedTotal)) {
+      LOG_GENERAL(WARNING, "m_gasUsedTotal addition unsafe!");
       break;
     }
+    uint128_t txnFee;
+    if (!SafeMath<uint128_t>::mul(tr.GetCumGas(), t.GetGasPrice(), txnFee)) {
+      LOG_GENERAL(WARNING, "txnFee multiplication unsafe!");
+      continue;
+    }
+    if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
+      LOG_GENERAL(WARNING, "m_txnFees addition unsafe!");
+      break;
+    }
+    appendOne(t, tr);
   }
 
   cv_TxnProcFinished.notify_all();
-  // Put txns in map back into pool
-  ReinstateMemPool(t_addrNonceTxnMap, gasLimitExceededTxnBuffer);
+  // Put txns exceeding the gas limit back into pool
+  ReinstateMemPool(gasLimitExceededTxnBuffer);
 }
 
 bool Node::VerifyTxnsOrdering(const vector<TxnHash>& tranHashes,
@@ -507,7 +557,6 @@ void Node::ProcessTransactionWhenShardBackup(
 
   t_createdTxns = m_createdTxns;
   m_expectedTranOrdering.clear();
-  map<Address, map<uint64_t, Transaction>> t_addrNonceTxnMap;
   t_processedTransactions.clear();
 
   bool txnProcTimeout = false;
@@ -520,26 +569,6 @@ void Node::ProcessTransactionWhenShardBackup(
 
   this_thread::sleep_for(chrono::milliseconds(100));
 
-  auto findOneFromAddrNonceTxnMap =
-      [](Transaction& t,
-         std::map<Address, map<uint64_t, Transaction>>& t_addrNonceTxnMap)
-      -> bool {
-    for (auto it = t_addrNonceTxnMap.begin(); it != t_addrNonceTxnMap.end();
-         it++) {
-      if (it->second.begin()->first ==
-          AccountStore::GetInstance().GetNonceTemp(it->first) + 1) {
-        t = move(it->second.begin()->second);
-        it->second.erase(it->second.begin());
-
-        if (it->second.empty()) {
-          t_addrNonceTxnMap.erase(it);
-        }
-        return true;
-      }
-    }
-    return false;
-  };
-
   auto appendOne = [this](const Transaction& t, const TransactionReceipt& tr) {
     m_expectedTranOrdering.emplace_back(t.GetTranID());
     t_processedTransactions.insert(
@@ -551,113 +580,85 @@ void Node::ProcessTransactionWhenShardBackup(
 
   vector<Transaction> gasLimitExceededTxnBuffer;
 
+  // Look up the nonce of every pending sender once, after which each
+  // executable txn is picked from the pool's ready index
+  t_createdTxns.prepareReady([](const Address& addr) {
+    return AccountStore::GetInstance().GetNonceTemp(addr);
+  });
+
   while (m_gasUsedTotal < microblock_gas_limit) {
     if (txnProcTimeout) {
       break;
     }
 
+    if (ENABLE_PARALLEL_PAYMENTS) {
+      bool stop = false;
+      if (ProcessPaymentBatch(microblock_gas_limit, appendOne,
+                              gasLimitExceededTxnBuffer, txnProcTimeout,
+                              stop)) {
+        if (stop) {
+          break;
+        }
+        continue;
+      }
+    }
+
     Transaction t;
     TransactionReceipt tr;
 
-    // check t_addrNonceTxnMap contains any txn meets right nonce,
-    // if contains, process it
-    if (findOneFromAddrNonceTxnMap(t, t_addrNonceTxnMap)) {
-      // check whether m_createdTransaction have transaction with same Addr and
-      // nonce if has and with larger gasPrice then replace with that one.
-      // (*optional step)
-      t_createdTxns.findSameNonceButHigherGas(t);
+    // Pick the executable txn with the highest gas price
+    if (!t_createdTxns.popReady(t)) {
+      break;
+    }
 
-      if (m_gasUsedTotal + t.GetGasLimit() > microblock_gas_limit) {
-        gasLimitExceededTxnBuffer.emplace_back(t);
-        continue;
-      }
+    // With this txn out of the pool the sender's later txns cannot become
+    // ready, but they are still reported as waiting for a lower nonce
+    if (m_gasUsedTotal + t.GetGasLimit() > microblock_gas_limit) {
+      gasLimitExceededTxnBuffer.emplace_back(t);
+      t_createdTxns.updateSender(
+          t.GetSenderAddr(),
+          AccountStore::GetInstance().GetNonceTemp(t.GetSenderAddr()));
+      continue;
+    }
 
-      if (m_mediator.m_validator->CheckCreatedTransaction(t, tr)) {
-        if (!SafeMath<uint64_t>::add(m_gasUsedTotal, tr.GetCumGas(),
-                                     m_gasUsedTotal)) {
-          LOG_GENERAL(WARNING, "m_gasUsedTotal addition unsafe!");
-          break;
-        }
-        uint128_t txnFee;
-        if (!SafeMath<uint128_t>::mul(tr.GetCumGas(), t.GetGasPrice(),
-                                      txnFee)) {
-          LOG_GENERAL(WARNING, "txnFee multiplication unsafe!");
-          continue;
-        }
-        if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
-          LOG_GENERAL(WARNING, "m_txnFees addition unsafe!");
-          break;
-        }
-        appendOne(t, tr);
-        continue;
-      }
+    const Address senderAddr = t.GetSenderAddr();
+    const bool applied = m_mediator.m_validator->CheckCreatedTransaction(t, tr);
+    t_createdTxns.updateSender(
+        senderAddr, AccountStore::GetInstance().GetNonceTemp(senderAddr));
+
+    if (!applied) {
+      continue;
     }
-    // if no txn in u_map meet right nonce process new come-in transactions
-    else if (t_createdTxns.findOne(t)) {
-      Address senderAddr = t.GetSenderAddr();
-      // check nonce, if nonce larger than expected, put it into
-      // t_addrNonceTxnMap
-      if (t.GetNonce() >
-          AccountStore::GetInstance().GetNonceTemp(senderAddr) + 1) {
-        auto it1 = t_addrNonceTxnMap.find(senderAddr);
-        if (it1 != t_addrNonceTxnMap.end()) {
-          auto it2 = it1->second.find(t.GetNonce());
-          if (it2 != it1->second.end()) {
-            // found the txn with same addr and same nonce
-            // then compare the gasprice and remains the higher one
-            if (t.GetGasPrice() > it2->second.GetGasPrice()) {
-              it2->second = t;
-            }
-            continue;
-          }
-        }
-        t_addrNonceTxnMap[senderAddr].insert({t.GetNonce(), t});
-      }
-      // if nonce too small, ignore it
-      else if (t.GetNonce() <
-               AccountStore::GetInstance().GetNonceTemp(senderAddr) + 1) {
-      }
-      // if nonce correct, process it
-      else if (m_mediator.m_validator->CheckCreatedTransaction(t, tr)) {
-        if (!SafeMath<uint64_t>::add(m_gasUsedTotal, tr.GetCumGas(),
-                                     m_gasUsedTotal)) {
-          LOG_GENERAL(WARNING, "m_gasUsedTotal addition overflow!");
-          break;
-        }
-        uint128_t txnFee;
-        if (!SafeMath<uint128_t>::mul(tr.GetCumGas(), t.GetGasPrice(),
-                                      txnFee)) {
-          LOG_GENERAL(WARNING, "txnFee multiplication overflow!");
-          continue;
-        }
-        if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
-          LOG_GENERAL(WARNING, "m_txnFees addition overflow!");
-          break;
-        }
-        appendOne(t, tr);
-      }
-    } else {
+
+    if (!SafeMath<uint64_t>::add(m_gasUsedTotal, tr.GetCumGas(),
+                                 m_gasUsedTotal)) {
+      LOG_GENERAL(WARNING, "m_gasUsedTotal addition overflow!");
       break;
     }
+    uint128_t txnFee;
+    if (!SafeMath<uint128_t>::mul(tr.GetCumGas(), t.GetGasPrice(), txnFee)) {
+      LOG_GENERAL(WARNING, "txnFee multiplication overflow!");
+      continue;
+    }
+    if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
+      LOG_GENERAL(WARNING, "m_txnFees addition overflow!");
+      break;
+    }
+    appendOne(t, tr);
   }
 
   cv_TxnProcFinished.notify_all();
 
-  ReinstateMemPool(t_addrNonceTxnMap, gasLimitExceededTxnBuffer);
+  ReinstateMemPool(gasLimitExceededTxnBuffer);
 }
 
 void Node::ReinstateMemPool(
-    const map<Address, map<uint64_t, Transaction>>& addrNonceTxnMap,
     const vector<Transaction>& gasLimitExceededTxnBuffer) {
   unique_lock<shared_timed_mutex> g(m_unconfirmedTxnsMutex);
 
-  // Put remaining txns back in pool
-  for (const auto& kv : addrNonceTxnMap) {
-    for (const auto& nonceTxn : kv.second) {
-      t_createdTxns.insert(nonceTxn.second);
-      m_unconfirmedTxns.emplace(nonceTxn.second.GetTranID(),
-                                PoolTxnStatus::PRESENT_NONCE_HIGH);
-    }
+  // Txns waiting for a lower nonce never left the pool
+  for (const auto& tranID : t_createdTxns.getNonceHighTxns()) {
+    m_unconfirmedTxns.emplace(tranID, PoolTxnStatus::PRESENT_NONCE_HIGH);
   }
 
   for (const auto& t : gasLimitExceededTxnBuffer) {
@@ -788,9 +789,8 @@ bool Node::RunConsensusOnMicroBlockWhenShardLeader() {
   LOG_STATE(
       "[MICON]["
       << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress()
-      << "]["
-      << m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1
-      << "][" << m_myshardId << "] BGIN");
+      << "][" << m_mediator.m_txBlockChain.GetLastBlockNum() + 1 << "]["
+      << m_myshardId << "] BGIN");
 
   cl->StartConsensus(announcementGeneratorFunc, BROADCAST_GOSSIP_MODE);
 
@@ -814,8 +814,7 @@ bool Node::RunConsensusOnMicroBlockWhenShardBackup() {
         m_mediator.m_dsBlockChain.GetLastBlock()
                 .GetHeader()
                 .GetDSDifficulty() >= TXN_DS_TARGET_DIFFICULTY) ||
-       m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() >=
-           TXN_DS_TARGET_NUM)) {
+       m_mediator.m_dsBlockChain.GetLastBlockNum() >= TXN_DS_TARGET_NUM)) {
     std::this_thread::sleep_for(chrono::milliseconds(TX_DISTRIBUTE_TIME_IN_MS));
     ProcessTransactionWhenShardBackup();
   }
@@ -1006,8 +1005,7 @@ unsigned char Node::CheckLegitimacyOfTxnHashes(bytes& errorMsg) {
         m_mediator.m_dsBlockChain.GetLastBlock()
                 .GetHeader()
                 .GetDSDifficulty() >= TXN_DS_TARGET_DIFFICULTY) ||
-       m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() >=
-           TXN_DS_TARGET_NUM)) {
+       m_mediator.m_dsBlockChain.GetLastBlockNum() >= TXN_DS_TARGET_NUM)) {
     vector<TxnHash> missingTxnHashes;
     if (!VerifyTxnsOrdering(m_microblock->GetTranHashes(), missingTxnHashes)) {
       LOG_GENERAL(WARNING, "The leader may have composed wrong order");
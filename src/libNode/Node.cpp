@@ -79,9 +79,7 @@ void Node::PopulateAccounts(bool temp) {
     m_accountPopulated = 0;
     while (getline(keys_file, line) &&
            m_accountPopulated < (NUM_ACCOUNTS_PREGENERATE *
-                                 (m_mediator.m_dsBlockChain.GetLastBlock()
-                                      .GetHeader()
-                                      .GetBlockNum() +
+                                 (m_mediator.m_dsBlockChain.GetLastBlockNum() +
                                   1))) {
       m_accountPopulated++;
       if (m_accountPopulated <= counter) {
@@ -193,8 +191,7 @@ bool Node::Install(const SyncType syncType, const bool toRetrieveHistory,
       return true;
     }
 
-    m_mediator.m_currentEpochNum =
-        m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+    m_mediator.m_currentEpochNum = m_mediator.m_txBlockChain.GetLastBlockNum();
     m_mediator.IncreaseEpochNum();
 
     if (RECOVERY_TRIM_INCOMPLETED_BLOCK) {
@@ -498,13 +495,12 @@ bool Node::ValidateDB() {
 void Node::Prepare(bool runInitializeGenesisBlocks) {
   LOG_MARKER();
   m_mediator.m_currentEpochNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+      m_mediator.m_txBlockChain.GetLastBlockNum() + 1;
   m_mediator.UpdateDSBlockRand(runInitializeGenesisBlocks);
   m_mediator.UpdateTxBlockRand(runInitializeGenesisBlocks);
   SetState(POW_SUBMISSION);
   POW::GetInstance().EthashConfigureClient(
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1,
-      FULL_DATASET_MINE);
+      m_mediator.m_dsBlockChain.GetLastBlockNum() + 1, FULL_DATASET_MINE);
 }
 
 bool Node::StartRetrieveHistory(const SyncType syncType,
@@ -655,7 +651,7 @@ bool Node::StartRetrieveHistory(const SyncType syncType,
 
       do {
         m_mediator.m_lookup->GetStateDeltaFromSeedNodes(
-            m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum());
+            m_mediator.m_txBlockChain.GetLastBlockNum());
         LOG_GENERAL(INFO,
                     "Retrieve final block state delta from lookup node, please "
                     "wait...");
@@ -676,11 +672,9 @@ bool Node::StartRetrieveHistory(const SyncType syncType,
   if (!LOOKUP_NODE_MODE &&
       SyncType::NO_SYNC == m_mediator.m_lookup->GetSyncType() &&
       SyncType::RECOVERY_ALL_SYNC != syncType &&
-      (m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() <
-           NUM_FINAL_BLOCK_PER_POW ||
+      (m_mediator.m_txBlockChain.GetLastBlockNum() < NUM_FINAL_BLOCK_PER_POW ||
        m_mediator.GetIsVacuousEpoch(
-           m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-           1))) {
+           m_mediator.m_txBlockChain.GetLastBlockNum() + 1))) {
     LOG_GENERAL(WARNING,
                 "Node recovery with vacuous epoch or in first DS epoch, apply "
                 "re-join process instead");
@@ -692,8 +686,7 @@ bool Node::StartRetrieveHistory(const SyncType syncType,
                SyncType::RECOVERY_ALL_SYNC == syncType)) {
     for (uint64_t blockNum =
              m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetEpochNum();
-         blockNum <=
-         m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+         blockNum <= m_mediator.m_txBlockChain.GetLastBlockNum();
          ++blockNum) {
       LOG_GENERAL(INFO, "Update coin base for finalblock with blockNum: "
                             << blockNum << ", reward: "
@@ -755,6 +748,9 @@ bool Node::StartRetrieveHistory(const SyncType syncType,
 
   if (LOOKUP_NODE_MODE) {
     m_mediator.m_lookup->ProcessEntireShardingStructure();
+    if (!BlockStorage::GetBlockStorage().BuildContractCreatorIndex()) {
+      LOG_GENERAL(WARNING, "BlockStorage::BuildContractCreatorIndex failed");
+    }
   } else {
     LoadShardingStructure(true);
     m_mediator.m_ds->ProcessShardingStructure(
@@ -773,15 +769,18 @@ bool Node::StartRetrieveHistory(const SyncType syncType,
   m_mediator.m_consensusID =
       (m_mediator.m_txBlockChain.GetBlockCount()) % NUM_FINAL_BLOCK_PER_POW;
 
+  if (!BlockStorage::GetBlockStorage().BuildMicroBlockIndex()) {
+    LOG_GENERAL(WARNING, "BlockStorage::BuildMicroBlockIndex failed");
+  }
+
   /// Save coin base for micro block, from last DS epoch to current TX epoch
   if (bDS && !(RECOVERY_TRIM_INCOMPLETED_BLOCK &&
                SyncType::RECOVERY_ALL_SYNC == syncType)) {
     std::list<MicroBlockSharedPtr> microBlocks;
     if (BlockStorage::GetBlockStorage().GetRangeMicroBlocks(
             m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetEpochNum(),
-            m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-                1,
-            0, m_mediator.m_ds->m_shards.size(), microBlocks)) {
+            m_mediator.m_txBlockChain.GetLastBlockNum() + 1, 0,
+            m_mediator.m_ds->m_shards.size(), microBlocks)) {
       for (const auto& microBlock : microBlocks) {
         LOG_GENERAL(INFO,
                     "Retrieve microblock with epochNum: "
@@ -863,9 +862,7 @@ void Node::WakeupAtDSEpoch() {
   if (DirectoryService::IDLE != m_mediator.m_ds->m_mode) {
     SetState(POW_SUBMISSION);
     LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
-              "START OF EPOCH " << m_mediator.m_dsBlockChain.GetLastBlock()
-                                           .GetHeader()
-                                           .GetBlockNum() +
+              "START OF EPOCH " << m_mediator.m_dsBlockChain.GetLastBlockNum() +
                                        1);
     if (BROADCAST_GOSSIP_MODE) {
       VectorOfNode peers;
@@ -918,8 +915,7 @@ void Node::WakeupAtDSEpoch() {
   LOG_GENERAL(INFO, "Set as shard node: "
                         << m_mediator.m_selfPeer.GetPrintableIPAddress() << ":"
                         << m_mediator.m_selfPeer.m_listenPortHost);
-  uint64_t block_num =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+  uint64_t block_num = m_mediator.m_dsBlockChain.GetLastBlockNum() + 1;
   uint8_t dsDifficulty =
       m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetDSDifficulty();
   uint8_t difficulty =
@@ -1039,8 +1035,7 @@ void Node::StartSynchronization() {
       m_synchronizer.FetchLatestTxBlockSeed(
           m_mediator.m_lookup,
           // m_mediator.m_txBlockChain.GetBlockCount());
-          m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() +
-              1);
+          m_mediator.m_txBlockChain.GetLastBlockNum() + 1);
       this_thread::sleep_for(chrono::seconds(m_mediator.m_lookup->m_startedPoW
                                                  ? POW_WINDOW_IN_SECONDS
                                                  : NEW_NODE_SYNC_INTERVAL));
@@ -1355,8 +1350,7 @@ bool Node::ProcessTxnPacketFromLookup([[gnu::unused]] const bytes& message,
           m_justDidFallback) &&
          (m_mediator.m_consensusID != 0)) ||
         ((m_mediator.m_currentEpochNum == 1) &&
-         ((m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() ==
-           0) ||
+         ((m_mediator.m_dsBlockChain.GetLastBlockNum() == 0) ||
           m_justDidFallback))) {
       lock_guard<mutex> g2(m_mutexTxnPacketBuffer);
       m_txnPacketBuffer.emplace_back(message2);
@@ -1429,13 +1423,10 @@ bool Node::ProcessTxnPacketFromLookupCore(const bytes& message,
     return false;
   }
 
-  if (dsBlockNum !=
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum()) {
+  if (dsBlockNum != m_mediator.m_dsBlockChain.GetLastBlockNum()) {
     LOG_GENERAL(WARNING, "Wrong DS block num ("
                              << dsBlockNum << "), expected ("
-                             << m_mediator.m_dsBlockChain.GetLastBlock()
-                                    .GetHeader()
-                                    .GetBlockNum()
+                             << m_mediator.m_dsBlockChain.GetLastBlockNum()
                              << ")");
     return false;
   }
@@ -1537,13 +1528,22 @@ bool Node::ProcessTxnPacketFromLookupCore(const bytes& message,
 
   LOG_GENERAL(INFO, "Start check txn packet from lookup");
 
+  // Check all the signatures of the packet in one batch first
+  vector<bool> sigVerified;
+  m_mediator.m_validator->VerifyTransactions(txns, sigVerified);
+
   std::vector<Transaction> checkedTxns;
-  for (const auto& txn : txns) {
+  for (unsigned int i = 0; i < txns.size(); i++) {
+    const auto& txn = txns.at(i);
     if (m_mediator.GetIsVacuousEpoch()) {
       LOG_GENERAL(WARNING, "Already in vacuous epoch, stop proc txn");
       return false;
     }
-    if (m_mediator.m_validator->CheckCreatedTransactionFromLookup(txn)) {
+    if (!sigVerified.at(i)) {
+      LOG_GENERAL(WARNING, "Txn " << txn.GetTranID().hex()
+                                  << " has an incorrect signature.");
+    } else if (m_mediator.m_validator->CheckCreatedTransactionFromLookup(
+                   txn, false)) {
       checkedTxns.push_back(txn);
     } else {
       LOG_GENERAL(WARNING, "Txn " << txn.GetTranID().hex() << " is not valid.");
@@ -1929,8 +1929,7 @@ void Node::QueryLookupForDSGuardNetworkInfoUpdate() {
   bytes queryLookupForDSGuardNetworkInfoUpdate = {
       MessageType::LOOKUP,
       LookupInstructionType::GETGUARDNODENETWORKINFOUPDATE};
-  uint64_t dsEpochNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t dsEpochNum = m_mediator.m_dsBlockChain.GetLastBlockNum();
 
   LOG_GENERAL(INFO,
               "Querying the lookup for any ds guard node network info change "
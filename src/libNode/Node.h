@@ -218,7 +218,6 @@ class Node : public Executable {
       const uint64_t& blocknum);
 
   void ReinstateMemPool(
-      const std::map<Address, std::map<uint64_t, Transaction>>& addrNonceTxnMap,
       const std::vector<Transaction>& gasLimitExceededTxnBuffer);
 
   // internal calls from ProcessVCDSBlocksMessage
@@ -301,6 +300,16 @@ class Node : public Executable {
   bool CheckMicroBlockTranReceiptHash();
 
   void NotifyTimeout(bool& txnProcTimeout);
+  /// Picks ready payment txns from t_createdTxns and applies them as a batch,
+  /// giving the same order and results as picking and applying them one by
+  /// one. Picking stops once txnProcTimeout is set. Returns false if no
+  /// payment was picked; stop is set if txn processing must end.
+  bool ProcessPaymentBatch(
+      const uint64_t& microblock_gas_limit,
+      const std::function<void(const Transaction&, const TransactionReceipt&)>&
+          appendOne,
+      std::vector<Transaction>& gasLimitExceededTxnBuffer,
+      const bool& txnProcTimeout, bool& stop);
   bool VerifyTxnsOrdering(const std::vector<TxnHash>& tranHashes,
                           std::vector<TxnHash>& missingtranHashes);
 
@@ -52,8 +52,7 @@ bool Node::GetLatestDSBlock() {
   while (!m_mediator.m_lookup->m_fetchedLatestDSBlock &&
          counter <= FETCH_LOOKUP_MSG_MAX_RETRY) {
     m_synchronizer.FetchLatestDSBlocksSeed(
-        m_mediator.m_lookup,
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1);
+        m_mediator.m_lookup, m_mediator.m_dsBlockChain.GetLastBlockNum() + 1);
 
     {
       unique_lock<mutex> lock(
@@ -443,9 +442,7 @@ bool Node::ProcessStartPoW(const bytes& message, unsigned int offset,
 
   LOG_MARKER();
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
-            "START OF EPOCH " << m_mediator.m_dsBlockChain.GetLastBlock()
-                                         .GetHeader()
-                                         .GetBlockNum() +
+            "START OF EPOCH " << m_mediator.m_dsBlockChain.GetLastBlockNum() +
                                      1);
 
   if (m_mediator.m_currentEpochNum > 1) {
@@ -470,8 +467,7 @@ bool Node::ProcessStartPoW(const bytes& message, unsigned int offset,
   }
 
   if (m_mediator.m_isRetrievedHistory) {
-    block_num =
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+    block_num = m_mediator.m_dsBlockChain.GetLastBlockNum() + 1;
     dsDifficulty =
         m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetDSDifficulty();
     difficulty =
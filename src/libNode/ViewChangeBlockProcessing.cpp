@@ -57,12 +57,11 @@ bool Node::VerifyVCBlockCoSignature(const VCBlock& vcblock) {
     return false;
   }
 
-  // Generate the aggregated key
   vector<PubKey> keys;
-
+  keys.reserve(B2.size());
   for (auto const& kv : *m_mediator.m_DSCommittee) {
+    keys.emplace_back(kv.first);
     if (B2.at(index)) {
-      keys.emplace_back(kv.first);
       count++;
     }
     index++;
@@ -73,7 +72,9 @@ bool Node::VerifyVCBlockCoSignature(const VCBlock& vcblock) {
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  // Generate the aggregated key
+  shared_ptr<PubKey> aggregatedKey =
+      MultiSig::GetInstance().AggregateCommitteeKeys(keys, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -90,8 +91,10 @@ bool Node::VerifyVCBlockCoSignature(const VCBlock& vcblock) {
   if (!MultiSig::GetInstance().MultiSigVerify(
           message, 0, message.size(), vcblock.GetCS2(), *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed. Pubkeys");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    for (unsigned int i = 0; i < keys.size(); i++) {
+      if (B2.at(i)) {
+        LOG_GENERAL(WARNING, keys.at(i));
+      }
     }
     return false;
   }
@@ -15,6 +15,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <boost/algorithm/string/predicate.hpp>
 #include <chrono>
 #include <ctime>
@@ -77,6 +78,12 @@ void POW::StopMining() {
   }
 }
 
+void POW::SetCPUMiningThreads(unsigned int numThreads) {
+  m_cpuMiningThreads = numThreads;
+}
+
+uint64_t POW::GetCPUHashRate() const { return m_cpuHashRate; }
+
 std::string POW::BytesToHexString(const uint8_t* str, const uint64_t s) {
   std::ostringstream ret;
 
@@ -275,72 +282,96 @@ ethash_mining_result_t POW::MineGetWork(uint64_t blockNum,
   return result;
 }
 
-ethash_mining_result_t POW::MineLight(ethash_hash256 const& headerHash,
-                                      ethash_hash256 const& boundary,
-                                      uint64_t startNonce, int timeWindow) {
-  uint64_t nonce = startNonce;
+template <class Context>
+ethash_mining_result_t POW::MineCPU(const Context& context,
+                                    ethash_hash256 const& headerHash,
+                                    ethash_hash256 const& boundary,
+                                    uint64_t startNonce, int timeWindow) {
+  const unsigned int numThreads =
+      (m_cpuMiningThreads > 0)
+          ? m_cpuMiningThreads.load()
+          : std::max(std::thread::hardware_concurrency(), 1u);
+
+  ethash_mining_result_t result = {"", "", 0, false};
+  std::mutex mutexResult;
+  // Set once a solution is found or the time window has passed
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> numHashes{0};
   auto startTime = std::chrono::high_resolution_clock::now();
 
-  while (m_shouldMine) {
-    auto mineResult = ethash::hash(*m_epochContextLight, headerHash, nonce);
-    if (ethash::is_less_or_equal(mineResult.final_hash, boundary)) {
-      ethash_mining_result_t winning_result = {
-          BlockhashToHexString(mineResult.final_hash),
-          BlockhashToHexString(mineResult.mix_hash), nonce, true};
-      return winning_result;
-    }
-    nonce++;
+  // Thread i tries the nonces startNonce + i + k * numThreads
+  auto mine = [&](unsigned int index) {
+    uint64_t count = 0;
+    for (uint64_t nonce = startNonce + index; m_shouldMine && !done;
+         nonce += numThreads) {
+      auto mineResult = ethash::hash(context, headerHash, nonce);
+      count++;
+      // The full dataset is filled in by whichever thread first needs an
+      // item, so a solution is confirmed against the light cache
+      if (ethash::is_less_or_equal(mineResult.final_hash, boundary) &&
+          ethash::verify(*m_epochContextLight, headerHash, mineResult.mix_hash,
+                         nonce, boundary)) {
+        std::lock_guard<std::mutex> g(mutexResult);
+        if (!done) {
+          result = {BlockhashToHexString(mineResult.final_hash),
+                    BlockhashToHexString(mineResult.mix_hash), nonce, true};
+          done = true;
+        }
+        break;
+      }
 
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto timePassedInSeconds = std::chrono::duration_cast<std::chrono::seconds>(
-                                   currentTime - startTime)
-                                   .count();
-    if (timePassedInSeconds > timeWindow) {
-      LOG_GENERAL(WARNING,
-                  "Time out while mining pow result, time "
-                  "passed in seconds "
-                      << timePassedInSeconds << ", time window " << timeWindow);
-      m_shouldMine = false;
-      break;
+      auto currentTime = std::chrono::high_resolution_clock::now();
+      auto timePassedInSeconds =
+          std::chrono::duration_cast<std::chrono::seconds>(currentTime -
+                                                           startTime)
+              .count();
+      if (timePassedInSeconds > timeWindow) {
+        if (!done.exchange(true)) {
+          LOG_GENERAL(WARNING, "Time out while mining pow result, time "
+                               "passed in seconds "
+                                   << timePassedInSeconds << ", time window "
+                                   << timeWindow);
+          m_shouldMine = false;
+        }
+        break;
+      }
     }
+    numHashes += count;
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(numThreads - 1);
+  for (unsigned int i = 1; i < numThreads; i++) {
+    workers.emplace_back(mine, i);
   }
+  mine(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::high_resolution_clock::now() - startTime)
+                       .count();
+  m_cpuHashRate = numHashes * 1000 / std::max<uint64_t>(elapsedMs, 1);
+  LOG_GENERAL(INFO, "CPU mining: " << numHashes << " hashes in " << elapsedMs
+                                   << " ms with " << numThreads
+                                   << " threads, " << m_cpuHashRate << " H/s");
 
-  ethash_mining_result_t failure_result = {"", "", 0, false};
-  return failure_result;
+  return result;
+}
+
+ethash_mining_result_t POW::MineLight(ethash_hash256 const& headerHash,
+                                      ethash_hash256 const& boundary,
+                                      uint64_t startNonce, int timeWindow) {
+  return MineCPU(*m_epochContextLight, headerHash, boundary, startNonce,
+                 timeWindow);
 }
 
 ethash_mining_result_t POW::MineFull(ethash_hash256 const& headerHash,
                                      ethash_hash256 const& boundary,
                                      uint64_t startNonce, int timeWindow) {
-  uint64_t nonce = startNonce;
-  auto startTime = std::chrono::high_resolution_clock::now();
-
-  while (m_shouldMine) {
-    auto mineResult = ethash::hash(*m_epochContextFull, headerHash, nonce);
-    if (ethash::is_less_or_equal(mineResult.final_hash, boundary)) {
-      ethash_mining_result_t winning_result = {
-          BlockhashToHexString(mineResult.final_hash),
-          BlockhashToHexString(mineResult.mix_hash), nonce, true};
-      return winning_result;
-    }
-    nonce++;
-
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto timePassedInSeconds = std::chrono::duration_cast<std::chrono::seconds>(
-                                   currentTime - startTime)
-                                   .count();
-    if (timePassedInSeconds > timeWindow) {
-      LOG_GENERAL(WARNING,
-                  "Time out while mining pow result, time "
-                  "passed in seconds "
-                      << timePassedInSeconds << ", time window " << timeWindow);
-      m_shouldMine = false;
-      break;
-    }
-  }
-
-  ethash_mining_result_t failure_result = {"", "", 0, false};
-  return failure_result;
+  return MineCPU(*m_epochContextFull, headerHash, boundary, startNonce,
+                 timeWindow);
 }
 
 ethash_mining_result_t POW::MineFullGPU(uint64_t blockNum,
@@ -20,6 +20,7 @@
 
 #include <stdint.h>
 #include <array>
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -88,6 +89,12 @@ class POW {
   /// Terminates proof-of-work mining.
   void StopMining();
 
+  /// Sets the number of threads for CPU mining, 0 for one per hardware thread.
+  void SetCPUMiningThreads(unsigned int numThreads);
+
+  /// Returns the hashes per second of the last CPU mining.
+  uint64_t GetCPUHashRate() const;
+
   /// Verifies a proof-of-work submission.
   bool PoWVerify(uint64_t blockNum, uint8_t difficulty,
                  const ethash_hash256& headerHash, uint64_t winning_nonce,
@@ -135,6 +142,8 @@ class POW {
   std::shared_ptr<ethash::epoch_context_full> m_epochContextFull = nullptr;
   uint64_t m_currentBlockNum;
   std::atomic<bool> m_shouldMine{};
+  std::atomic<unsigned int> m_cpuMiningThreads{CPU_MINING_THREADS};
+  std::atomic<uint64_t> m_cpuHashRate{};
   std::vector<dev::eth::MinerPtr> m_miners;
   std::vector<ethash_mining_result_t> m_vecMiningResult;
   std::atomic<int> m_minerIndex{};
@@ -142,6 +151,12 @@ class POW {
   std::mutex m_mutexMiningResult;
   std::unique_ptr<jsonrpc::HttpClient> m_httpClient;
 
+  /// Splits the nonces from startNonce between the CPU mining threads.
+  template <class Context>
+  ethash_mining_result_t MineCPU(const Context& context,
+                                 ethash_hash256 const& headerHash,
+                                 ethash_hash256 const& boundary,
+                                 uint64_t startNonce, int timeWindow);
   ethash_mining_result_t MineLight(ethash_hash256 const& headerHash,
                                    ethash_hash256 const& boundary,
                                    uint64_t startNonce, int timeWindow);
@@ -20,11 +20,14 @@
 #include <unistd.h>
 #include <algorithm>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string>
 
 #include <leveldb/db.h>
+#include <leveldb/write_batch.h>
 #include <boost/filesystem.hpp>
 
 #include "BlockStorage.h"
@@ -36,12 +39,115 @@
 
 using namespace std;
 
+namespace {
+
+// Contract creator index keys are the creator address followed by the nonce of
+// the creation txn in fixed width hex, so that the contracts of a creator are
+// contiguous and sorted by deployment order
+const unsigned int CONTRACT_CREATOR_NONCE_WIDTH = 16;
+const string CONTRACT_CREATOR_INDEX_BUILT = "indexBuilt";
+const unsigned int CONTRACT_CREATOR_BATCH_SIZE = 10000;
+
+string GetContractCreatorKey(const Address& creator, const uint64_t& nonce) {
+  ostringstream oss;
+  oss << creator.hex() << setw(CONTRACT_CREATOR_NONCE_WIDTH) << setfill('0')
+      << hex << nonce;
+  return oss.str();
+}
+
+// Micro block index keys are the epoch number and shard id in fixed width
+// big-endian followed by the micro block hash, so that the micro blocks of an
+// epoch are contiguous and sorted by shard id. They are kept in the micro
+// block DB, next to the micro blocks keyed by hash.
+const string MICROBLOCK_INDEX_PREFIX = "epochShard";
+const string MICROBLOCK_INDEX_BUILT = "indexBuilt";
+const unsigned int MICROBLOCK_INDEX_BATCH_SIZE = 10000;
+const size_t MICROBLOCK_INDEX_KEY_SIZE = MICROBLOCK_INDEX_PREFIX.size() +
+                                         BLOCKNUM_KEY_SIZE + sizeof(uint32_t) +
+                                         BLOCK_HASH_SIZE;
+
+string GetMicroBlockIndexKey(const uint64_t& epochNum, const uint32_t& shardId,
+                             const BlockHash& blockHash = BlockHash()) {
+  string key = MICROBLOCK_INDEX_PREFIX + toBlockNumKey(epochNum);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    key.push_back((char)((shardId >> shift) & 0xFF));
+  }
+  if (blockHash) {
+    key.append((const char*)blockHash.data(), blockHash.size);
+  }
+  return key;
+}
+
+bool ParseMicroBlockIndexKey(const leveldb::Slice& key, uint64_t& epochNum,
+                             uint32_t& shardId) {
+  if (key.size() != MICROBLOCK_INDEX_KEY_SIZE ||
+      !key.starts_with(MICROBLOCK_INDEX_PREFIX)) {
+    return false;
+  }
+
+  const char* data = key.data() + MICROBLOCK_INDEX_PREFIX.size();
+  if (!fromBlockNumKey(leveldb::Slice(data, BLOCKNUM_KEY_SIZE), epochNum)) {
+    return false;
+  }
+
+  shardId = 0;
+  for (size_t i = 0; i < sizeof(uint32_t); i++) {
+    shardId = (shardId << 8) | (unsigned char)data[BLOCKNUM_KEY_SIZE + i];
+  }
+  return true;
+}
+
+bool IsEmpty(const shared_ptr<LevelDB>& db) {
+  if (!db || !db->GetDB()) {
+    return true;
+  }
+  unique_ptr<leveldb::Iterator> it(
+      db->GetDB()->NewIterator(leveldb::ReadOptions()));
+  it->SeekToFirst();
+  return !it->Valid();
+}
+
+}  // namespace
+
 BlockStorage& BlockStorage::GetBlockStorage(const std::string& path,
                                             bool diagnostic) {
   static BlockStorage bs(path, diagnostic);
   return bs;
 }
 
+void BlockStorage::CheckStorageFormat() {
+  bytes data;
+  if (GetMetadata(MetaType::STORAGEFORMAT, data, true)) {
+    const string version = DataConversion::CharArrayToString(data);
+    if (version != to_string(STORAGE_FORMAT_VERSION)) {
+      LOG_GENERAL(FATAL, "Persistence is in storage format "
+                             << version << " instead of "
+                             << STORAGE_FORMAT_VERSION
+                             << ", run migrateDB on it first");
+    }
+    return;
+  }
+
+  // Stores from before the format was recorded have decimal block number keys
+  // and hex hash keys
+  for (const auto& db :
+       {m_dsBlockchainDB, m_txBlockchainDB, m_dsCommitteeDB, m_blockLinkDB,
+        m_shardStructureDB, m_stateDeltaDB, m_diagnosticDBNodes,
+        m_diagnosticDBCoinbase, m_microBlockDB, m_VCBlockDB,
+        m_fallbackBlockDB, m_txBodyDB}) {
+    if (!IsEmpty(db)) {
+      LOG_GENERAL(FATAL, db->GetDBName()
+                             << " has no storage format recorded, run "
+                                "migrateDB on the persistence first");
+      return;
+    }
+  }
+
+  PutMetadata(MetaType::STORAGEFORMAT,
+              DataConversion::StringToCharArray(
+                  to_string(STORAGE_FORMAT_VERSION)));
+}
+
 bool BlockStorage::PutBlock(const uint64_t& blockNum, const bytes& body,
                             const BlockType& blockType) {
   int ret = -1;  // according to LevelDB::Insert return value
@@ -113,23 +219,204 @@ bool BlockStorage::PutTxBody(const dev::h256& key, const bytes& body) {
   return (ret == 0);
 }
 
+bool BlockStorage::PutContractCreator(const Address& creator,
+                                      const uint64_t& nonce,
+                                      const Address& contract) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexContractCreator);
+  int ret = m_contractCreatorDB->Insert(GetContractCreatorKey(creator, nonce),
+                                        contract.asBytes());
+
+  return (ret == 0);
+}
+
+bool BlockStorage::GetContractsByCreator(const Address& creator,
+                                         vector<Address>& contracts,
+                                         uint64_t& total,
+                                         const uint64_t& offset,
+                                         const uint64_t& count) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  const string prefix = creator.hex();
+  total = 0;
+
+  shared_lock<shared_timed_mutex> g(m_mutexContractCreator);
+
+  unique_ptr<leveldb::Iterator> it(
+      m_contractCreatorDB->GetDB()->NewIterator(leveldb::ReadOptions()));
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix);
+       it->Next()) {
+    if (total >= offset && (count == 0 || contracts.size() < count)) {
+      const leveldb::Slice& value = it->value();
+      if (value.size() != ACC_ADDR_SIZE) {
+        LOG_GENERAL(WARNING, "Invalid contract address for key "
+                                 << it->key().ToString());
+        return false;
+      }
+      contracts.emplace_back(
+          bytes(value.data(), value.data() + value.size()));
+    }
+    total++;
+  }
+
+  return true;
+}
+
+bool BlockStorage::BuildContractCreatorIndex() {
+  if (!LOOKUP_NODE_MODE) {
+    return true;
+  }
+
+  {
+    shared_lock<shared_timed_mutex> g(m_mutexContractCreator);
+    if (m_contractCreatorDB->Exists(CONTRACT_CREATOR_INDEX_BUILT)) {
+      return true;
+    }
+  }
+
+  LOG_MARKER();
+
+  unique_lock<shared_timed_mutex> g(m_mutexContractCreator);
+  shared_lock<shared_timed_mutex> g2(m_mutexTxBody);
+
+  unordered_map<string, string> batch;
+  uint64_t numContracts = 0;
+
+  unique_ptr<leveldb::Iterator> it(
+      m_txBodyDB->GetDB()->NewIterator(LevelDB::ScanReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    const leveldb::Slice& value = it->value();
+    TransactionWithReceipt twr(bytes(value.data(), value.data() + value.size()),
+                               0);
+    const Transaction& tx = twr.GetTransaction();
+    if (Transaction::GetTransactionType(tx) != Transaction::CONTRACT_CREATION ||
+        tx.GetNonce() == 0) {
+      continue;
+    }
+
+    const Address& sender = tx.GetSenderAddr();
+    const bytes& contract =
+        Account::GetAddressForContract(sender, tx.GetNonce() - 1).asBytes();
+    batch.emplace(GetContractCreatorKey(sender, tx.GetNonce()),
+                  string(contract.begin(), contract.end()));
+    numContracts++;
+
+    if (batch.size() >= CONTRACT_CREATOR_BATCH_SIZE) {
+      if (!m_contractCreatorDB->BatchInsert(batch)) {
+        LOG_GENERAL(WARNING, "Failed to write contract creator index");
+        return false;
+      }
+      batch.clear();
+    }
+  }
+
+  batch.emplace(CONTRACT_CREATOR_INDEX_BUILT, "1");
+  if (!m_contractCreatorDB->BatchInsert(batch)) {
+    LOG_GENERAL(WARNING, "Failed to write contract creator index");
+    return false;
+  }
+
+  LOG_GENERAL(INFO, "Indexed " << numContracts << " contracts by creator");
+
+  return true;
+}
+
 bool BlockStorage::PutMicroBlock(const BlockHash& blockHash,
-                                 const bytes& body) {
+                                 const uint64_t& epochNum,
+                                 const uint32_t& shardId, const bytes& body) {
+  string buffer;
+  leveldb::WriteBatch batch;
+  batch.Put(m_microBlockDB->HashKey(blockHash, buffer),
+            leveldb::Slice((const char*)body.data(), body.size()));
+  batch.Put(GetMicroBlockIndexKey(epochNum, shardId, blockHash),
+            leveldb::Slice((const char*)blockHash.data(), blockHash.size));
+
   unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
-  int ret = m_microBlockDB->Insert(blockHash, body);
+  return m_microBlockDB->GetDB()->Write(leveldb::WriteOptions(), &batch).ok();
+}
 
-  return (ret == 0);
+bool BlockStorage::BuildMicroBlockIndex() {
+  {
+    shared_lock<shared_timed_mutex> g(m_mutexMicroBlock);
+    if (m_microBlockDB->Exists(MICROBLOCK_INDEX_BUILT)) {
+      return true;
+    }
+  }
+
+  LOG_MARKER();
+
+  unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
+
+  unordered_map<string, string> batch;
+  uint64_t numMicroBlocks = 0;
+
+  unique_ptr<leveldb::Iterator> it(
+      m_microBlockDB->GetDB()->NewIterator(LevelDB::ScanReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    if (it->key().compare(MICROBLOCK_INDEX_BUILT) == 0 ||
+        it->key().starts_with(MICROBLOCK_INDEX_PREFIX)) {
+      continue;
+    }
+
+    const leveldb::Slice& value = it->value();
+    MicroBlock microBlock;
+    if (!microBlock.Deserialize(
+            bytes(value.data(), value.data() + value.size()), 0)) {
+      LOG_GENERAL(WARNING, "Failed to deserialize micro block "
+                               << it->key().ToString());
+      continue;
+    }
+
+    const BlockHash& blockHash = microBlock.GetBlockHash();
+    batch.emplace(GetMicroBlockIndexKey(microBlock.GetHeader().GetEpochNum(),
+                                        microBlock.GetHeader().GetShardId(),
+                                        blockHash),
+                  string((const char*)blockHash.data(), blockHash.size));
+    numMicroBlocks++;
+
+    if (batch.size() >= MICROBLOCK_INDEX_BATCH_SIZE) {
+      if (!m_microBlockDB->BatchInsert(batch)) {
+        LOG_GENERAL(WARNING, "Failed to write micro block index");
+        return false;
+      }
+      batch.clear();
+    }
+  }
+
+  batch.emplace(MICROBLOCK_INDEX_BUILT, "1");
+  if (!m_microBlockDB->BatchInsert(batch)) {
+    LOG_GENERAL(WARNING, "Failed to write micro block index");
+    return false;
+  }
+
+  LOG_GENERAL(INFO, "Indexed " << numMicroBlocks
+                               << " micro blocks by epoch and shard");
+
+  return true;
 }
 
 bool BlockStorage::InitiateHistoricalDB(const string& path) {
-  // If not explicitly convert to string, calls the other constructor
+  // If not explicitly convert to string, calls the other constructor.
+  // Historical databases are prepared elsewhere and may still be keyed by
+  // hashes in hex.
   {
     unique_lock<shared_timed_mutex> g(m_mutexTxnHistorical);
-    m_txnHistoricalDB = make_shared<LevelDB>("txBodies", path, (string) "");
+    m_txnHistoricalDB = make_shared<LevelDB>("txBodies", path, (string) "",
+                                             LevelDBProfile::POINT_LOOKUP);
+    m_txnHistoricalDB->DetectHashKeyFormat();
   }
   {
     unique_lock<shared_timed_mutex> g(m_mutexMBHistorical);
-    m_MBHistoricalDB = make_shared<LevelDB>("microBlocks", path, (string) "");
+    m_MBHistoricalDB = make_shared<LevelDB>("microBlocks", path, (string) "",
+                                            LevelDBProfile::POINT_LOOKUP);
+    m_MBHistoricalDB->DetectHashKeyFormat();
   }
 
   return true;
@@ -196,34 +483,52 @@ bool BlockStorage::GetRangeMicroBlocks(const uint64_t lowEpochNum,
                                        list<MicroBlockSharedPtr>& blocks) {
   LOG_MARKER();
 
+  if (lowEpochNum > hiEpochNum || loShardId > hiShardId) {
+    return false;
+  }
+
   shared_lock<shared_timed_mutex> g(m_mutexMicroBlock);
 
-  leveldb::Iterator* it =
-      m_microBlockDB->GetDB()->NewIterator(leveldb::ReadOptions());
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string bns = it->key().ToString();
-    string blockString = it->value().ToString();
-    if (blockString.empty()) {
-      LOG_GENERAL(WARNING, "Lost one block in the chain");
-      delete it;
-      return false;
+  // Only the index entries within the shard range of each epoch are visited
+  unique_ptr<leveldb::Iterator> it(
+      m_microBlockDB->GetDB()->NewIterator(leveldb::ReadOptions()));
+  it->Seek(GetMicroBlockIndexKey(lowEpochNum, loShardId));
+  while (it->Valid() && it->key().starts_with(MICROBLOCK_INDEX_PREFIX)) {
+    uint64_t epochNum = 0;
+    uint32_t shardId = 0;
+    if (!ParseMicroBlockIndexKey(it->key(), epochNum, shardId)) {
+      it->Next();
+      continue;
     }
-    MicroBlockSharedPtr block = MicroBlockSharedPtr(
-        new MicroBlock(bytes(blockString.begin(), blockString.end()), 0));
 
-    if (block->GetHeader().GetEpochNum() < lowEpochNum ||
-        block->GetHeader().GetEpochNum() > hiEpochNum ||
-        block->GetHeader().GetShardId() < loShardId ||
-        block->GetHeader().GetShardId() > hiShardId) {
+    if (epochNum > hiEpochNum) {
+      break;
+    }
+    if (shardId < loShardId) {
+      it->Seek(GetMicroBlockIndexKey(epochNum, loShardId));
+      continue;
+    }
+    if (shardId > hiShardId) {
+      if (epochNum == hiEpochNum) {
+        break;
+      }
+      it->Seek(GetMicroBlockIndexKey(epochNum + 1, loShardId));
       continue;
     }
 
-    blocks.emplace_back(block);
-    LOG_GENERAL(INFO, "Retrievd MicroBlock Num:" << bns);
+    const leveldb::Slice& value = it->value();
+    const BlockHash blockHash(
+        dev::bytesConstRef((const unsigned char*)value.data(), value.size()));
+    const string blockString = m_microBlockDB->Lookup(blockHash);
+    if (blockString.empty()) {
+      LOG_GENERAL(WARNING, "Indexed micro block " << blockHash << " missing");
+    } else {
+      blocks.emplace_back(make_shared<MicroBlock>(
+          bytes(blockString.begin(), blockString.end()), 0));
+    }
+    it->Next();
   }
 
-  delete it;
-
   if (blocks.empty()) {
     LOG_GENERAL(INFO, "Disk has no MicroBlock matching the criteria");
     return false;
@@ -232,6 +537,13 @@ bool BlockStorage::GetRangeMicroBlocks(const uint64_t lowEpochNum,
   return true;
 }
 
+bool BlockStorage::GetMicroBlocksByEpochRange(
+    const uint64_t lowEpochNum, const uint64_t hiEpochNum,
+    list<MicroBlockSharedPtr>& blocks) {
+  return GetRangeMicroBlocks(lowEpochNum, hiEpochNum, 0,
+                             numeric_limits<uint32_t>::max(), blocks);
+}
+
 bool BlockStorage::PutTempState(const unordered_map<Address, Account>& states) {
   // LOG_MARKER();
 
@@ -256,7 +568,7 @@ bool BlockStorage::GetTempStateInBatch(leveldb::Iterator*& iter,
   shared_lock<shared_timed_mutex> g(m_mutexTempState);
 
   if (iter == nullptr) {
-    iter = m_tempStateDB->GetDB()->NewIterator(leveldb::ReadOptions());
+    iter = m_tempStateDB->GetDB()->NewIterator(LevelDB::ScanReadOptions());
     iter->SeekToFirst();
   }
 
@@ -425,6 +737,33 @@ bool BlockStorage::GetTxBlock(const uint64_t& blockNum,
   return true;
 }
 
+bool BlockStorage::GetTxBlockRange(const uint64_t& loBlockNum,
+                                   const uint64_t& hiBlockNum,
+                                   list<TxBlockSharedPtr>& blocks) {
+  if (loBlockNum > hiBlockNum) {
+    return false;
+  }
+
+  const string hiKey = toBlockNumKey(hiBlockNum);
+
+  shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
+
+  unique_ptr<leveldb::Iterator> it(
+      m_txBlockchainDB->GetDB()->NewIterator(leveldb::ReadOptions()));
+  for (it->Seek(toBlockNumKey(loBlockNum));
+       it->Valid() && it->key().compare(hiKey) <= 0; it->Next()) {
+    const leveldb::Slice value = it->value();
+    if (value.empty()) {
+      LOG_GENERAL(WARNING, "Lost one block in the chain");
+      return false;
+    }
+    blocks.emplace_back(make_shared<TxBlock>(
+        bytes(value.data(), value.data() + value.size()), 0));
+  }
+
+  return !blocks.empty();
+}
+
 bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
   std::string bodyString;
 
@@ -483,9 +822,24 @@ bool BlockStorage::DeleteTxBody(const dev::h256& key) {
 
 bool BlockStorage::DeleteMicroBlock(const BlockHash& blockHash) {
   unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
-  int ret = m_microBlockDB->DeleteKey(blockHash);
 
-  return (ret == 0);
+  string buffer;
+  leveldb::WriteBatch batch;
+  batch.Delete(m_microBlockDB->HashKey(blockHash, buffer));
+
+  // The index entry goes together with the block
+  const string blockString = m_microBlockDB->Lookup(blockHash);
+  if (!blockString.empty()) {
+    MicroBlock microBlock;
+    if (microBlock.Deserialize(bytes(blockString.begin(), blockString.end()),
+                               0)) {
+      batch.Delete(GetMicroBlockIndexKey(microBlock.GetHeader().GetEpochNum(),
+                                         microBlock.GetHeader().GetShardId(),
+                                         blockHash));
+    }
+  }
+
+  return m_microBlockDB->GetDB()->Write(leveldb::WriteOptions(), &batch).ok();
 }
 
 bool BlockStorage::DeleteStateDelta(const uint64_t& finalBlockNum) {
@@ -519,9 +873,8 @@ bool BlockStorage::GetAllDSBlocks(std::list<DSBlockSharedPtr>& blocks) {
   shared_lock<shared_timed_mutex> g(m_mutexDsBlockchain);
 
   leveldb::Iterator* it =
-      m_dsBlockchainDB->GetDB()->NewIterator(leveldb::ReadOptions());
+      m_dsBlockchainDB->GetDB()->NewIterator(LevelDB::ScanReadOptions());
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string bns = it->key().ToString();
     string blockString = it->value().ToString();
     if (blockString.empty()) {
       LOG_GENERAL(WARNING, "Lost one block in the chain");
@@ -532,7 +885,8 @@ bool BlockStorage::GetAllDSBlocks(std::list<DSBlockSharedPtr>& blocks) {
     DSBlockSharedPtr block = DSBlockSharedPtr(
         new DSBlock(bytes(blockString.begin(), blockString.end()), 0));
     blocks.emplace_back(block);
-    LOG_GENERAL(INFO, "Retrievd DsBlock Num:" << bns);
+    LOG_GENERAL(INFO,
+                "Retrievd DsBlock Num:" << block->GetHeader().GetBlockNum());
   }
 
   delete it;
@@ -551,10 +905,9 @@ bool BlockStorage::GetAllTxBlocks(std::list<TxBlockSharedPtr>& blocks) {
   shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
 
   leveldb::Iterator* it =
-      m_txBlockchainDB->GetDB()->NewIterator(leveldb::ReadOptions());
+      m_txBlockchainDB->GetDB()->NewIterator(LevelDB::ScanReadOptions());
   uint64_t count = 0;
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string bns = it->key().ToString();
     string blockString = it->value().ToString();
     if (blockString.empty()) {
       LOG_GENERAL(WARNING, "Lost one block in the chain");
@@ -591,15 +944,14 @@ bool BlockStorage::GetAllTxBodiesTmp(std::list<TxnHash>& txnHashes) {
   shared_lock<shared_timed_mutex> g(m_mutexTxBodyTmp);
 
   leveldb::Iterator* it =
-      m_txBodyTmpDB->GetDB()->NewIterator(leveldb::ReadOptions());
+      m_txBodyTmpDB->GetDB()->NewIterator(LevelDB::ScanReadOptions());
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string hashString = it->key().ToString();
-    if (hashString.empty()) {
+    TxnHash txnHash;
+    if (!m_txBodyTmpDB->FromHashKey(it->key(), txnHash)) {
       LOG_GENERAL(WARNING, "Lost one Tmp txBody Hash");
       delete it;
       return false;
     }
-    TxnHash txnHash(hashString);
     txnHashes.emplace_back(txnHash);
   }
 
@@ -613,9 +965,10 @@ bool BlockStorage::GetAllBlockLink(std::list<BlockLink>& blocklinks) {
   shared_lock<shared_timed_mutex> g(m_mutexBlockLink);
 
   leveldb::Iterator* it =
-      m_blockLinkDB->GetDB()->NewIterator(leveldb::ReadOptions());
+      m_blockLinkDB->GetDB()->NewIterator(LevelDB::ScanReadOptions());
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string bns = it->key().ToString();
+    uint64_t bns = 0;
+    fromBlockNumKey(it->key(), bns);
     string blockString = it->value().ToString();
     if (blockString.empty()) {
       LOG_GENERAL(WARNING, "Lost one blocklink in the chain");
@@ -1065,25 +1418,22 @@ void BlockStorage::GetDiagnosticDataNodes(
   lock_guard<mutex> g(m_mutexDiagnostic);
 
   leveldb::Iterator* it =
-      m_diagnosticDBNodes->GetDB()->NewIterator(leveldb::ReadOptions());
+      m_diagnosticDBNodes->GetDB()->NewIterator(LevelDB::ScanReadOptions());
 
   unsigned int index = 0;
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string dsBlockNumStr = it->key().ToString();
     string dataStr = it->value().ToString();
 
-    if (dsBlockNumStr.empty() || dataStr.empty()) {
+    if (dataStr.empty()) {
       LOG_GENERAL(WARNING,
                   "Failed to retrieve diagnostic data at index " << index);
       continue;
     }
 
     uint64_t dsBlockNum = 0;
-    try {
-      dsBlockNum = stoull(dsBlockNumStr);
-    } catch (...) {
-      LOG_GENERAL(WARNING,
-                  "Non-numeric key " << dsBlockNumStr << " at index " << index);
+    if (!fromBlockNumKey(it->key(), dsBlockNum)) {
+      LOG_GENERAL(WARNING, "Invalid key of size " << it->key().size()
+                                                  << " at index " << index);
       continue;
     }
 
@@ -1099,7 +1449,7 @@ void BlockStorage::GetDiagnosticDataNodes(
       LOG_GENERAL(
           WARNING,
           "Messenger::GetDiagnosticDataNodes failed for DS block number "
-              << dsBlockNumStr << " at index " << index);
+              << dsBlockNum << " at index " << index);
       continue;
     }
 
@@ -1128,25 +1478,22 @@ void BlockStorage::GetDiagnosticDataCoinbase(
   lock_guard<mutex> g(m_mutexDiagnostic);
 
   leveldb::Iterator* it =
-      m_diagnosticDBCoinbase->GetDB()->NewIterator(leveldb::ReadOptions());
+      m_diagnosticDBCoinbase->GetDB()->NewIterator(LevelDB::ScanReadOptions());
 
   unsigned int index = 0;
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string dsBlockNumStr = it->key().ToString();
     string dataStr = it->value().ToString();
 
-    if (dsBlockNumStr.empty() || dataStr.empty()) {
+    if (dataStr.empty()) {
       LOG_GENERAL(WARNING,
                   "Failed to retrieve diagnostic data at index " << index);
       continue;
     }
 
     uint64_t dsBlockNum = 0;
-    try {
-      dsBlockNum = stoull(dsBlockNumStr);
-    } catch (...) {
-      LOG_GENERAL(WARNING,
-                  "Non-numeric key " << dsBlockNumStr << " at index " << index);
+    if (!fromBlockNumKey(it->key(), dsBlockNum)) {
+      LOG_GENERAL(WARNING, "Invalid key of size " << it->key().size()
+                                                  << " at index " << index);
       continue;
     }
 
@@ -1158,7 +1505,7 @@ void BlockStorage::GetDiagnosticDataCoinbase(
       LOG_GENERAL(
           WARNING,
           "Messenger::GetDiagnosticDataCoinbase failed for DS block number "
-              << dsBlockNumStr << " at index " << index);
+              << dsBlockNum << " at index " << index);
       continue;
     }
 
@@ -1202,7 +1549,11 @@ bool BlockStorage::ResetDB(DBTYPE type) {
   switch (type) {
     case META: {
       unique_lock<shared_timed_mutex> g(m_mutexMetadata);
-      ret = m_metadataDB->ResetDB();
+      ret = m_metadataDB->ResetDB() &&
+            (0 == m_metadataDB->Insert(
+                      std::to_string((int)MetaType::STORAGEFORMAT),
+                      DataConversion::StringToCharArray(
+                          to_string(STORAGE_FORMAT_VERSION))));
       break;
     }
     case DS_BLOCK: {
@@ -1286,6 +1637,11 @@ bool BlockStorage::ResetDB(DBTYPE type) {
       ret = m_stateRootDB->ResetDB();
       break;
     }
+    case CONTRACT_CREATOR: {
+      unique_lock<shared_timed_mutex> g(m_mutexContractCreator);
+      ret = m_contractCreatorDB->ResetDB();
+      break;
+    }
   }
   if (!ret) {
     LOG_GENERAL(INFO, "FAIL: Reset DB " << type << " failed");
@@ -1383,6 +1739,11 @@ bool BlockStorage::RefreshDB(DBTYPE type) {
       ret = m_tempStateDB->RefreshDB();
       break;
     }
+    case CONTRACT_CREATOR: {
+      unique_lock<shared_timed_mutex> g(m_mutexContractCreator);
+      ret = m_contractCreatorDB->RefreshDB();
+      break;
+    }
   }
   if (!ret) {
     LOG_GENERAL(INFO, "FAIL: Refresh DB " << type << " failed");
@@ -1473,6 +1834,11 @@ std::vector<std::string> BlockStorage::GetDBName(DBTYPE type) {
       ret.push_back(m_stateRootDB->GetDBName());
       break;
     }
+    case CONTRACT_CREATOR: {
+      shared_lock<shared_timed_mutex> g(m_mutexContractCreator);
+      ret.push_back(m_contractCreatorDB->GetDBName());
+      break;
+    }
   }
 
   return ret;
@@ -1496,7 +1862,7 @@ bool BlockStorage::ResetAll() {
            ResetDB(BLOCKLINK) & ResetDB(SHARD_STRUCTURE) &
            ResetDB(STATE_DELTA) & ResetDB(TEMP_STATE) &
            ResetDB(DIAGNOSTIC_NODES) & ResetDB(DIAGNOSTIC_COINBASE) &
-           ResetDB(STATE_ROOT);
+           ResetDB(STATE_ROOT) & ResetDB(CONTRACT_CREATOR);
   }
 }
 
@@ -1519,7 +1885,7 @@ bool BlockStorage::RefreshAll() {
            RefreshDB(BLOCKLINK) & RefreshDB(SHARD_STRUCTURE) &
            RefreshDB(STATE_DELTA) & RefreshDB(TEMP_STATE) &
            RefreshDB(DIAGNOSTIC_NODES) & RefreshDB(DIAGNOSTIC_COINBASE) &
-           RefreshDB(STATE_ROOT) &
+           RefreshDB(STATE_ROOT) & RefreshDB(CONTRACT_CREATOR) &
            Contract::ContractStorage::GetContractStorage().RefreshAll();
   }
 }
\ No newline at end of file
@@ -77,6 +77,11 @@ struct DiagnosticDataCoinbase {
   }
 };
 
+/// Version of the on-disk key formats, recorded in the metadata DB.
+/// 1: records keyed by block number use toBlockNumKey keys.
+/// 2: records keyed by hash use the 32 bytes of the hash instead of its hex.
+const unsigned int STORAGE_FORMAT_VERSION = 2;
+
 /// Manages persistent storage of DS and Tx blocks.
 class BlockStorage : public Singleton<BlockStorage> {
   std::shared_ptr<LevelDB> m_metadataDB;
@@ -101,19 +106,25 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// used for historical data
   std::shared_ptr<LevelDB> m_txnHistoricalDB;
   std::shared_ptr<LevelDB> m_MBHistoricalDB;
+  /// creator address + nonce -> contract address, for lookup only
+  std::shared_ptr<LevelDB> m_contractCreatorDB;
 
   BlockStorage(const std::string& path = "", bool diagnostic = false)
       : m_metadataDB(std::make_shared<LevelDB>("metadata")),
         m_dsBlockchainDB(std::make_shared<LevelDB>("dsBlocks")),
         m_txBlockchainDB(std::make_shared<LevelDB>("txBlocks")),
-        m_microBlockDB(std::make_shared<LevelDB>("microBlocks")),
+        m_microBlockDB(std::make_shared<LevelDB>(
+            "microBlocks", "", false, LevelDBProfile::POINT_LOOKUP)),
         m_dsCommitteeDB(std::make_shared<LevelDB>("dsCommittee")),
-        m_VCBlockDB(std::make_shared<LevelDB>("VCBlocks")),
-        m_fallbackBlockDB(std::make_shared<LevelDB>("fallbackBlocks")),
+        m_VCBlockDB(std::make_shared<LevelDB>("VCBlocks", "", false,
+                                              LevelDBProfile::POINT_LOOKUP)),
+        m_fallbackBlockDB(std::make_shared<LevelDB>(
+            "fallbackBlocks", "", false, LevelDBProfile::POINT_LOOKUP)),
         m_blockLinkDB(std::make_shared<LevelDB>("blockLinks")),
         m_shardStructureDB(std::make_shared<LevelDB>("shardStructure")),
         m_stateDeltaDB(std::make_shared<LevelDB>("stateDelta")),
-        m_tempStateDB(std::make_shared<LevelDB>("tempState")),
+        m_tempStateDB(std::make_shared<LevelDB>(
+            "tempState", "", false, LevelDBProfile::BATCH_WRITE)),
         m_diagnosticDBNodes(
             std::make_shared<LevelDB>("diagnosticNodes", path, diagnostic)),
         m_diagnosticDBCoinbase(
@@ -122,14 +133,23 @@ class BlockStorage : public Singleton<BlockStorage> {
         m_diagnosticDBNodesCounter(0),
         m_diagnosticDBCoinbaseCounter(0) {
     if (LOOKUP_NODE_MODE) {
-      m_txBodyDB = std::make_shared<LevelDB>("txBodies");
-      m_txBodyTmpDB = std::make_shared<LevelDB>("txBodiesTmp");
+      m_txBodyDB = std::make_shared<LevelDB>("txBodies", "", false,
+                                             LevelDBProfile::POINT_LOOKUP);
+      m_txBodyTmpDB = std::make_shared<LevelDB>(
+          "txBodiesTmp", "", false, LevelDBProfile::POINT_LOOKUP);
+      m_contractCreatorDB = std::make_shared<LevelDB>("contractCreators");
     }
+    CheckStorageFormat();
   };
   ~BlockStorage() = default;
   bool PutBlock(const uint64_t& blockNum, const bytes& body,
                 const BlockType& blockType);
 
+  /// Records STORAGE_FORMAT_VERSION for a new store, and aborts if an
+  /// existing store was written in another format and has to be migrated
+  /// with migrateDB first.
+  void CheckStorageFormat();
+
  public:
   enum DBTYPE {
     META = 0x00,
@@ -147,7 +167,8 @@ class BlockStorage : public Singleton<BlockStorage> {
     TEMP_STATE,
     DIAGNOSTIC_NODES,
     DIAGNOSTIC_COINBASE,
-    STATE_ROOT
+    STATE_ROOT,
+    CONTRACT_CREATOR
   };
 
   /// Returns the singleton BlockStorage instance.
@@ -168,12 +189,36 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// Adds a Tx block to storage.
   bool PutTxBlock(const uint64_t& blockNum, const bytes& body);
 
-  // /// Adds a micro block to storage.
-  bool PutMicroBlock(const BlockHash& blockHash, const bytes& body);
+  /// Adds a micro block to storage, together with its entry in the index of
+  /// micro blocks by epoch and shard.
+  bool PutMicroBlock(const BlockHash& blockHash, const uint64_t& epochNum,
+                     const uint32_t& shardId, const bytes& body);
+
+  /// Populates the index of micro blocks by epoch and shard from the stored
+  /// micro blocks if it has never been built, e.g. on a node upgraded from an
+  /// older version.
+  bool BuildMicroBlockIndex();
 
   /// Adds a transaction body to storage.
   bool PutTxBody(const dev::h256& key, const bytes& body);
 
+  /// Records a contract deployed by the creator with the given txn nonce.
+  bool PutContractCreator(const Address& creator, const uint64_t& nonce,
+                          const Address& contract);
+
+  /// Retrieves the contracts deployed by the creator in deployment order,
+  /// skipping the first offset ones and returning at most count of them (all
+  /// of them if count is 0). total is set to the number of contracts recorded
+  /// for the creator.
+  bool GetContractsByCreator(const Address& creator,
+                             std::vector<Address>& contracts, uint64_t& total,
+                             const uint64_t& offset = 0,
+                             const uint64_t& count = 0);
+
+  /// Populates the contract creator index from the stored txn bodies if it
+  /// has never been built, e.g. on a lookup upgraded from an older version.
+  bool BuildContractCreatorIndex();
+
   /// Retrieves the requested DS block.
   bool GetDSBlock(const uint64_t& blockNum, DSBlockSharedPtr& block);
 
@@ -185,18 +230,32 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// Retrieves the requested Tx block.
   bool GetTxBlock(const uint64_t& blockNum, TxBlockSharedPtr& block);
 
+  /// Retrieves the stored Tx blocks numbered loBlockNum to hiBlockNum
+  /// inclusive, in ascending order.
+  bool GetTxBlockRange(const uint64_t& loBlockNum, const uint64_t& hiBlockNum,
+                       std::list<TxBlockSharedPtr>& blocks);
+
   bool ReleaseDB();
 
   // /// Retrieves the requested Micro block
   bool GetMicroBlock(const BlockHash& blockHash,
                      MicroBlockSharedPtr& microblock);
 
-  // /// Retrieves the range Micro blocks
+  /// Retrieves the micro blocks of epochs lowEpochNum to hiEpochNum and
+  /// shards loShardId to hiShardId inclusive, in ascending epoch and shard
+  /// order, using the index of micro blocks by epoch and shard.
   bool GetRangeMicroBlocks(const uint64_t lowEpochNum,
                            const uint64_t hiEpochNum, const uint32_t loShardId,
                            const uint32_t hiShardId,
                            std::list<MicroBlockSharedPtr>& blocks);
 
+  /// Retrieves the micro blocks of all shards, the DS committee included, of
+  /// epochs lowEpochNum to hiEpochNum inclusive, in ascending epoch and shard
+  /// order, using the index of micro blocks by epoch and shard.
+  bool GetMicroBlocksByEpochRange(const uint64_t lowEpochNum,
+                                  const uint64_t hiEpochNum,
+                                  std::list<MicroBlockSharedPtr>& blocks);
+
   /// Retrieves the requested transaction body.
   bool GetTxBody(const dev::h256& key, TxBodySharedPtr& body);
 
@@ -366,6 +425,7 @@ class BlockStorage : public Singleton<BlockStorage> {
   mutable std::shared_timed_mutex m_mutexStateRoot;
   mutable std::shared_timed_mutex m_mutexTxnHistorical;
   mutable std::shared_timed_mutex m_mutexMBHistorical;
+  mutable std::shared_timed_mutex m_mutexContractCreator;
 
   unsigned int m_diagnosticDBNodesCounter;
   unsigned int m_diagnosticDBCoinbaseCounter;
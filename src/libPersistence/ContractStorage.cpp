@@ -50,6 +50,84 @@ bool ContractStorage::DeleteContractCode(const dev::h160& address) {
   return m_codeDB.DeleteKey(address.hex()) == 0;
 }
 
+ContractStorage::CodeCacheEntry* ContractStorage::GetCodeCacheEntry(
+    const dev::h256& codeHash, bool create) {
+  auto it = m_codeCacheIndex.find(codeHash);
+  if (it != m_codeCacheIndex.end()) {
+    m_codeCache.splice(m_codeCache.begin(), m_codeCache, it->second);
+    return &it->second->second;
+  }
+  if (!create || CONTRACT_CODE_CACHE_SIZE == 0) {
+    return nullptr;
+  }
+
+  if (m_codeCache.size() >= CONTRACT_CODE_CACHE_SIZE) {
+    m_codeCacheIndex.erase(m_codeCache.back().first);
+    m_codeCache.pop_back();
+  }
+  m_codeCache.emplace_front(codeHash, CodeCacheEntry());
+  m_codeCacheIndex.emplace(codeHash, m_codeCache.begin());
+  return &m_codeCache.front().second;
+}
+
+bool ContractStorage::GetCachedCode(const dev::h256& codeHash, string& code) {
+  lock_guard<mutex> g(m_codeCacheMutex);
+  const CodeCacheEntry* entry = GetCodeCacheEntry(codeHash, false);
+  if (entry == nullptr || entry->code.empty()) {
+    return false;
+  }
+  code = entry->code;
+  return true;
+}
+
+void ContractStorage::CacheCode(const dev::h256& codeHash, const string& code) {
+  lock_guard<mutex> g(m_codeCacheMutex);
+  CodeCacheEntry* entry = GetCodeCacheEntry(codeHash, true);
+  if (entry != nullptr) {
+    entry->code = code;
+  }
+}
+
+bool ContractStorage::GetCachedCheckerOutput(const dev::h256& codeHash,
+                                             const string& root_w_version,
+                                             string& output) {
+  lock_guard<mutex> g(m_codeCacheMutex);
+  const CodeCacheEntry* entry = GetCodeCacheEntry(codeHash, false);
+  if (entry == nullptr) {
+    return false;
+  }
+  auto itOutput = entry->checkerOutputs.find(root_w_version);
+  if (itOutput == entry->checkerOutputs.end()) {
+    return false;
+  }
+  output = itOutput->second;
+  return true;
+}
+
+void ContractStorage::CacheCheckerOutput(const dev::h256& codeHash,
+                                         const string& root_w_version,
+                                         const string& output) {
+  lock_guard<mutex> g(m_codeCacheMutex);
+  CodeCacheEntry* entry = GetCodeCacheEntry(codeHash, true);
+  if (entry != nullptr) {
+    entry->checkerOutputs[root_w_version] = output;
+  }
+}
+
+void ContractStorage::GetExportedContract(dev::h160& address,
+                                          dev::h256& codeHash) {
+  lock_guard<mutex> g(m_codeCacheMutex);
+  address = m_exportedAddress;
+  codeHash = m_exportedCodeHash;
+}
+
+void ContractStorage::SetExportedContract(const dev::h160& address,
+                                          const dev::h256& codeHash) {
+  lock_guard<mutex> g(m_codeCacheMutex);
+  m_exportedAddress = address;
+  m_exportedCodeHash = codeHash;
+}
+
 // State
 // ========================================
 
@@ -20,7 +20,12 @@
 
 #include <json/json.h>
 #include <leveldb/db.h>
+#include <list>
+#include <map>
+#include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
+#include <utility>
 
 #include "common/Constants.h"
 #include "common/Singleton.h"
@@ -59,7 +64,25 @@ class ContractStorage : public Singleton<ContractStorage> {
   std::unordered_map<std::string, bytes> p_stateIndexMap;
   std::unordered_map<std::string, bytes> p_stateDataMap;
 
+  /// Interpreter inputs derived from a contract code, kept across calls and
+  /// epochs. They only depend on the code itself, hence are keyed by code hash.
+  struct CodeCacheEntry {
+    std::string code;
+    /// scilla-checker output per interpreter path
+    std::map<std::string, std::string> checkerOutputs;
+  };
+  using CodeCacheItem = std::pair<dev::h256, CodeCacheEntry>;
+  /// Most recently used first, bounded by CONTRACT_CODE_CACHE_SIZE
+  std::list<CodeCacheItem> m_codeCache;
+  std::unordered_map<dev::h256, std::list<CodeCacheItem>::iterator>
+      m_codeCacheIndex;
+
+  /// The contract whose code and init json are currently in SCILLA_FILES
+  dev::h160 m_exportedAddress;
+  dev::h256 m_exportedCodeHash;
+
   mutable std::shared_timed_mutex m_codeMutex;
+  std::mutex m_codeCacheMutex;
   mutable std::shared_timed_mutex m_stateMainMutex;
   mutable std::shared_timed_mutex m_stateIndexMutex;
   mutable std::shared_timed_mutex m_stateDataMutex;
@@ -72,10 +95,17 @@ class ContractStorage : public Singleton<ContractStorage> {
   /// Get the raw rlp string of the states of an account
   std::vector<bytes> GetContractStatesData(const dev::h160& address, bool temp);
 
+  /// Get the cache entry of a code hash and mark it as most recently used.
+  /// If create is set, a missing entry is added, evicting the least recently
+  /// used one when the cache is full. Caller holds m_codeCacheMutex.
+  CodeCacheEntry* GetCodeCacheEntry(const dev::h256& codeHash, bool create);
+
   ContractStorage()
-      : m_codeDB("contractCode"),
-        m_stateIndexDB("contractStateIndex"),
-        m_stateDataDB("contractStateData"){};
+      : m_codeDB("contractCode", "", false, LevelDBProfile::POINT_LOOKUP),
+        m_stateIndexDB("contractStateIndex", "", false,
+                       LevelDBProfile::POINT_LOOKUP),
+        m_stateDataDB("contractStateData", "", false,
+                      LevelDBProfile::BATCH_WRITE){};
 
   ~ContractStorage() = default;
 
@@ -104,6 +134,27 @@ class ContractStorage : public Singleton<ContractStorage> {
   /// Delete the contract code in persistence
   bool DeleteContractCode(const dev::h160& address);
 
+  /// Get the scilla source of a code hash from the cache
+  bool GetCachedCode(const dev::h256& codeHash, std::string& code);
+
+  /// Add the scilla source of a code hash to the cache
+  void CacheCode(const dev::h256& codeHash, const std::string& code);
+
+  /// Get the cached scilla-checker output of a code for an interpreter path
+  bool GetCachedCheckerOutput(const dev::h256& codeHash,
+                              const std::string& root_w_version,
+                              std::string& output);
+
+  /// Add the scilla-checker output of a code for an interpreter path
+  void CacheCheckerOutput(const dev::h256& codeHash,
+                          const std::string& root_w_version,
+                          const std::string& output);
+
+  /// Get / set the contract whose code and init json are in SCILLA_FILES
+  void GetExportedContract(dev::h160& address, dev::h256& codeHash);
+  void SetExportedContract(const dev::h160& address,
+                           const dev::h256& codeHash);
+
   /// Get the indexes of all the states of an contract account
   std::vector<Index> GetContractStateIndexes(const dev::h160& address,
                                              bool temp);
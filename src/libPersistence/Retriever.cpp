@@ -89,6 +89,18 @@ bool Retriever::RetrieveTxBlocks(bool trimIncompletedBlocks) {
     LOG_GENERAL(INFO, "Will try recreating state from txnblks: "
                           << lower_bound_txnblk << " - " << upper_bound_txnblk);
 
+    // Only the Tx blocks whose state roots are checked are read
+    std::list<TxBlockSharedPtr> rangeBlocks;
+    if (!BlockStorage::GetBlockStorage().GetTxBlockRange(
+            lower_bound_txnblk, upper_bound_txnblk, rangeBlocks) ||
+        rangeBlocks.size() != upper_bound_txnblk - lower_bound_txnblk + 1) {
+      LOG_GENERAL(WARNING, "Missing TxBlocks " << lower_bound_txnblk << " - "
+                                               << upper_bound_txnblk);
+      return false;
+    }
+    const std::vector<TxBlockSharedPtr> stateBlocks(rangeBlocks.begin(),
+                                                    rangeBlocks.end());
+
     // clear all the state deltas from disk.
     if (!BlockStorage::GetBlockStorage().ResetDB(BlockStorage::STATE_DELTA)) {
       LOG_GENERAL(WARNING, "BlockStorage::ResetDB failed");
@@ -134,7 +146,7 @@ bool Retriever::RetrieveTxBlocks(bool trimIncompletedBlocks) {
                 return false;
               }
               if (AccountStore::GetInstance().GetStateRootHash() !=
-                  (*std::next(blocks.begin(), j))
+                  stateBlocks.at(j - lower_bound_txnblk)
                       ->GetHeader()
                       .GetStateRootHash()) {
                 LOG_GENERAL(
@@ -431,11 +443,8 @@ bool Retriever::ValidateStates() {
   } else {
     LOG_GENERAL(WARNING, "ValidateStates failed.");
     LOG_GENERAL(INFO, "StateRoot in FinalBlock(BlockNum: "
-                          << m_mediator.m_txBlockChain.GetLastBlock()
-                                 .GetHeader()
-                                 .GetBlockNum()
-                          << "): "
-                          << m_mediator.m_txBlockChain.GetLastBlock()
+                          << m_mediator.m_txBlockChain.GetLastBlockNum()
+                          << "): " << m_mediator.m_txBlockChain.GetLastBlock()
                                  .GetHeader()
                                  .GetStateRootHash()
                           << '\n'
@@ -77,8 +77,7 @@ Server::~Server() {
 ////////////////////////////////////////////////////////////////////////
 
 uint256_t Server::GetNumTransactions(uint64_t blockNum) {
-  uint64_t currBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t currBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
 
   if (blockNum >= currBlockNum) {
     return 0;
@@ -741,8 +740,7 @@ StringResponse Server::GetNumDSBlocks() {
 StringResponse Server::GetNumTransactions() {
   LOG_MARKER();
 
-  uint64_t currBlock =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t currBlock = m_mediator.m_txBlockChain.GetLastBlockNum();
   if (m_BlockTxPair.first < currBlock) {
     for (uint64_t i = m_BlockTxPair.first + 1; i <= currBlock; i++) {
       m_BlockTxPair.second +=
@@ -761,8 +759,7 @@ DoubleResponse Server::GetTransactionRate() {
 
   DoubleResponse ret;
 
-  uint64_t refBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t refBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
 
   uint64_t refTimeTx = 0;
 
@@ -904,8 +901,7 @@ UInt64Response Server::GetCurrentDSEpoch() {
   LOG_MARKER();
 
   UInt64Response ret;
-  ret.set_result(
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum());
+  ret.set_result(m_mediator.m_dsBlockChain.GetLastBlockNum());
   return ret;
 }
 
@@ -918,8 +914,7 @@ ProtoBlockListing Server::DSBlockListing(ProtoPage& protoPage) {
     return ret;
   }
 
-  uint64_t currBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t currBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum();
   auto maxPages = (currBlockNum / PAGE_SIZE) + 1;
   ret.set_maxpages(int(maxPages));
 
@@ -1010,8 +1005,7 @@ ProtoBlockListing Server::TxBlockListing(ProtoPage& protoPage) {
     return ret;
   }
 
-  uint64_t currBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t currBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
   auto maxPages = (currBlockNum / PAGE_SIZE) + 1;
   ret.set_maxpages(int(maxPages));
 
@@ -42,6 +42,9 @@ std::mutex LookupServer::m_mutexRecentTxns;
 const unsigned int PAGE_SIZE = 10;
 const unsigned int NUM_PAGES_CACHE = 2;
 const unsigned int TXN_PAGE_SIZE = 100;
+const unsigned int CONTRACT_PAGE_SIZE = 100;
+const unsigned int RESPONSE_CACHE_SIZE = 10000;
+const unsigned int RESPONSE_CACHE_SHARDS = 16;
 
 //[warning] do not make this constant too big as it loops over blockchain
 const unsigned int REF_BLOCK_DIFF = 1;
@@ -50,7 +53,8 @@ LookupServer::LookupServer(Mediator& mediator,
                            jsonrpc::AbstractServerConnector& server)
     : Server(mediator),
       jsonrpc::AbstractServer<LookupServer>(server,
-                                            jsonrpc::JSONRPC_SERVER_V2) {
+                                            jsonrpc::JSONRPC_SERVER_V2),
+      m_responseCache(RESPONSE_CACHE_SIZE, RESPONSE_CACHE_SHARDS) {
   this->bindAndAddMethod(
       jsonrpc::Procedure("GetCurrentMiniEpoch", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_STRING, NULL),
@@ -119,6 +123,11 @@ LookupServer::LookupServer(Mediator& mediator,
                          jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_STRING,
                          NULL),
       &LookupServer::GetSmartContractsI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("SmartContractListing", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         "param02", jsonrpc::JSON_INTEGER, NULL),
+      &LookupServer::SmartContractListingI);
   this->bindAndAddMethod(
       jsonrpc::Procedure("GetContractAddressFromTransactionID",
                          jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_STRING,
@@ -316,13 +325,12 @@ bool LookupServer::ValidateTxn(const Transaction& tx, const Address& fromAddr,
     throw JsonRpcException(RPC_VERIFY_REJECTED, "Code size is too large");
   }
 
-  if (tx.GetGasPrice() <
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetGasPrice()) {
+  const auto lastDSBlock = m_mediator.m_dsBlockChain.GetLastBlockPtr();
+  if (tx.GetGasPrice() < lastDSBlock->GetHeader().GetGasPrice()) {
     throw JsonRpcException(RPC_VERIFY_REJECTED,
                            "GasPrice " + tx.GetGasPrice().convert_to<string>() +
                                " lower than minimum allowable " +
-                               m_mediator.m_dsBlockChain.GetLastBlock()
-                                   .GetHeader()
+                               lastDSBlock->GetHeader()
                                    .GetGasPrice()
                                    .convert_to<string>());
   }
@@ -522,8 +530,21 @@ Json::Value LookupServer::GetDsBlock(const string& blockNum) {
 
   try {
     uint64_t BlockNum = stoull(blockNum);
-    return JSONConversion::convertDSblocktoJson(
-        m_mediator.m_dsBlockChain.GetBlock(BlockNum));
+
+    const string cacheKey = "GetDsBlock:" + to_string(BlockNum);
+    Json::Value _json;
+    if (GetCachedResponse(cacheKey, _json)) {
+      return _json;
+    }
+
+    const auto dsBlock = m_mediator.m_dsBlockChain.GetBlockPtr(BlockNum);
+    _json = JSONConversion::convertDSblocktoJson(*dsBlock);
+
+    // A dummy block is returned for block numbers not reached yet
+    if (dsBlock->GetHeader().GetBlockNum() == BlockNum) {
+      CacheResponse(cacheKey, _json);
+    }
+    return _json;
   } catch (const JsonRpcException& je) {
     throw je;
   } catch (runtime_error& e) {
@@ -548,8 +569,21 @@ Json::Value LookupServer::GetTxBlock(const string& blockNum) {
 
   try {
     uint64_t BlockNum = stoull(blockNum);
-    return JSONConversion::convertTxBlocktoJson(
-        m_mediator.m_txBlockChain.GetBlock(BlockNum));
+
+    const string cacheKey = "GetTxBlock:" + to_string(BlockNum);
+    Json::Value _json;
+    if (GetCachedResponse(cacheKey, _json)) {
+      return _json;
+    }
+
+    const auto txBlock = m_mediator.m_txBlockChain.GetBlockPtr(BlockNum);
+    _json = JSONConversion::convertTxBlocktoJson(*txBlock);
+
+    // A dummy block is returned for block numbers not reached yet
+    if (txBlock->GetHeader().GetBlockNum() == BlockNum) {
+      CacheResponse(cacheKey, _json);
+    }
+    return _json;
   } catch (const JsonRpcException& je) {
     throw je;
   } catch (runtime_error& e) {
@@ -572,8 +606,8 @@ string LookupServer::GetMinimumGasPrice() {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
   }
 
-  return m_mediator.m_dsBlockChain.GetLastBlock()
-      .GetHeader()
+  return m_mediator.m_dsBlockChain.GetLastBlockPtr()
+      ->GetHeader()
       .GetGasPrice()
       .str();
 }
@@ -584,13 +618,13 @@ Json::Value LookupServer::GetLatestDsBlock() {
   }
 
   LOG_MARKER();
-  DSBlock Latest = m_mediator.m_dsBlockChain.GetLastBlock();
+  const auto Latest = m_mediator.m_dsBlockChain.GetLastBlockPtr();
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
-            "BlockNum " << Latest.GetHeader().GetBlockNum()
-                        << "  Timestamp:        " << Latest.GetTimestamp());
+            "BlockNum " << Latest->GetHeader().GetBlockNum()
+                        << "  Timestamp:        " << Latest->GetTimestamp());
 
-  return JSONConversion::convertDSblocktoJson(Latest);
+  return JSONConversion::convertDSblocktoJson(*Latest);
 }
 
 Json::Value LookupServer::GetLatestTxBlock() {
@@ -600,13 +634,13 @@ Json::Value LookupServer::GetLatestTxBlock() {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
   }
 
-  TxBlock Latest = m_mediator.m_txBlockChain.GetLastBlock();
+  const auto Latest = m_mediator.m_txBlockChain.GetLastBlockPtr();
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
-            "BlockNum " << Latest.GetHeader().GetBlockNum()
-                        << "  Timestamp:        " << Latest.GetTimestamp());
+            "BlockNum " << Latest->GetHeader().GetBlockNum()
+                        << "  Timestamp:        " << Latest->GetTimestamp());
 
-  return JSONConversion::convertTxBlocktoJson(Latest);
+  return JSONConversion::convertTxBlocktoJson(*Latest);
 }
 
 Json::Value LookupServer::GetBalance(const string& address) {
@@ -770,6 +804,32 @@ Json::Value LookupServer::GetSmartContractCode(const string& address) {
   }
 }
 
+Address LookupServer::GetCreatorAddress(const string& address) {
+  if (address.size() != ACC_ADDR_SIZE * 2) {
+    throw JsonRpcException(RPC_INVALID_PARAMETER,
+                           "Address size not appropriate");
+  }
+  bytes tmpaddr;
+  if (!DataConversion::HexStrToUint8Vec(address, tmpaddr)) {
+    throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                           "Address is not a hex string");
+  }
+
+  Address addr(tmpaddr);
+  const Account* account = AccountStore::GetInstance().GetAccount(addr);
+
+  if (account == nullptr) {
+    throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                           "Address does not exist");
+  }
+  if (account->isContract()) {
+    throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                           "A contract account queried");
+  }
+
+  return addr;
+}
+
 Json::Value LookupServer::GetSmartContracts(const string& address) {
   LOG_MARKER();
 
@@ -778,36 +838,20 @@ Json::Value LookupServer::GetSmartContracts(const string& address) {
   }
 
   try {
-    if (address.size() != ACC_ADDR_SIZE * 2) {
-      throw JsonRpcException(RPC_INVALID_PARAMETER,
-                             "Address size not appropriate");
-    }
-    bytes tmpaddr;
-    if (!DataConversion::HexStrToUint8Vec(address, tmpaddr)) {
-      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
-                             "Address is not a hex string");
-    }
+    const Address addr = GetCreatorAddress(address);
 
-    Address addr(tmpaddr);
-    const Account* account = AccountStore::GetInstance().GetAccount(addr);
-
-    if (account == nullptr) {
-      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
-                             "Address does not exist");
-    }
-    if (account->isContract()) {
-      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
-                             "A contract account queried");
+    vector<Address> contracts;
+    uint64_t total = 0;
+    if (!BlockStorage::GetBlockStorage().GetContractsByCreator(addr, contracts,
+                                                               total)) {
+      throw JsonRpcException(RPC_DATABASE_ERROR, "Failed to get contracts");
     }
-    uint64_t nonce = account->GetNonce();
-    //[TODO] find out a more efficient way (using storage)
+
     Json::Value _json;
 
-    for (uint64_t i = 0; i < nonce; i++) {
-      Address contractAddr = Account::GetAddressForContract(addr, i);
+    for (const auto& contractAddr : contracts) {
       const Account* contractAccount =
           AccountStore::GetInstance().GetAccount(contractAddr);
-
       if (contractAccount == nullptr || !contractAccount->isContract()) {
         continue;
       }
@@ -827,6 +871,61 @@ Json::Value LookupServer::GetSmartContracts(const string& address) {
   }
 }
 
+Json::Value LookupServer::SmartContractListing(const string& address,
+                                               const Json::Value& pageNum) {
+  LOG_MARKER();
+
+  if (!LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
+  }
+
+  try {
+    const Address addr = GetCreatorAddress(address);
+
+    if (!pageNum.isUInt() || pageNum.asUInt() < 1) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER, "Pages out of limit");
+    }
+    const unsigned int page = pageNum.asUInt();
+
+    vector<Address> contracts;
+    uint64_t total = 0;
+    if (!BlockStorage::GetBlockStorage().GetContractsByCreator(
+            addr, contracts, total, (uint64_t)CONTRACT_PAGE_SIZE * (page - 1),
+            CONTRACT_PAGE_SIZE)) {
+      throw JsonRpcException(RPC_DATABASE_ERROR, "Failed to get contracts");
+    }
+
+    uint64_t maxPages = (total + CONTRACT_PAGE_SIZE - 1) / CONTRACT_PAGE_SIZE;
+    if (maxPages == 0) {
+      maxPages = 1;
+    }
+    if (page > maxPages) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER, "Pages out of limit");
+    }
+
+    // Only addresses are returned, the state can be fetched per contract with
+    // GetSmartContractState
+    Json::Value _json;
+    _json["maxPages"] = Json::UInt64(maxPages);
+    _json["data"] = Json::arrayValue;
+
+    for (const auto& contractAddr : contracts) {
+      const Account* contractAccount =
+          AccountStore::GetInstance().GetAccount(contractAddr);
+      if (contractAccount == nullptr || !contractAccount->isContract()) {
+        continue;
+      }
+      _json["data"].append(contractAddr.hex());
+    }
+    return _json;
+  } catch (const JsonRpcException& je) {
+    throw je;
+  } catch (exception& e) {
+    LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << address);
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable To Process");
+  }
+}
+
 string LookupServer::GetContractAddressFromTransactionID(const string& tranID) {
   if (!LOOKUP_NODE_MODE) {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
@@ -901,15 +1000,14 @@ string LookupServer::GetNumTransactions() {
 
   lock_guard<mutex> g(m_mutexBlockTxPair);
 
-  uint64_t currBlock =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t currBlock = m_mediator.m_txBlockChain.GetLastBlockNum();
   if (currBlock == INIT_BLOCK_NUMBER) {
     throw JsonRpcException(RPC_IN_WARMUP, "No Tx blocks");
   }
   if (m_BlockTxPair.first < currBlock) {
     for (uint64_t i = m_BlockTxPair.first + 1; i <= currBlock; i++) {
       m_BlockTxPair.second +=
-          m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+          m_mediator.m_txBlockChain.GetBlockPtr(i)->GetHeader().GetNumTxs();
     }
   }
   m_BlockTxPair.first = currBlock;
@@ -922,8 +1020,7 @@ size_t LookupServer::GetNumTransactions(uint64_t blockNum) {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
   }
 
-  uint64_t currBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t currBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
 
   if (currBlockNum == INIT_BLOCK_NUMBER) {
     throw JsonRpcException(RPC_IN_WARMUP, "No Tx blocks");
@@ -936,7 +1033,7 @@ size_t LookupServer::GetNumTransactions(uint64_t blockNum) {
   size_t i, res = 0;
 
   for (i = blockNum + 1; i <= currBlockNum; i++) {
-    res += m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+    res += m_mediator.m_txBlockChain.GetBlockPtr(i)->GetHeader().GetNumTxs();
   }
 
   return res;
@@ -948,8 +1045,7 @@ double LookupServer::GetTransactionRate() {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
   }
 
-  uint64_t refBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t refBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
 
   uint64_t refTimeTx = 0;
 
@@ -971,8 +1067,8 @@ double LookupServer::GetTransactionRate() {
   LOG_GENERAL(INFO, "Num Txns: " << numTxns);
 
   try {
-    TxBlock tx = m_mediator.m_txBlockChain.GetBlock(refBlockNum);
-    refTimeTx = tx.GetTimestamp();
+    const auto tx = m_mediator.m_txBlockChain.GetBlockPtr(refBlockNum);
+    refTimeTx = tx->GetTimestamp();
   } catch (const JsonRpcException& je) {
     throw je;
   } catch (const char* msg) {
@@ -983,7 +1079,7 @@ double LookupServer::GetTransactionRate() {
   }
 
   uint64_t TimeDiff =
-      m_mediator.m_txBlockChain.GetLastBlock().GetTimestamp() - refTimeTx;
+      m_mediator.m_txBlockChain.GetLastBlockPtr()->GetTimestamp() - refTimeTx;
 
   if (TimeDiff == 0 || refTimeTx == 0) {
     // something went wrong
@@ -1013,8 +1109,8 @@ double LookupServer::GetDSBlockRate() {
   {
     try {
       // Refernce time chosen to be the first block's timestamp
-      DSBlock dsb = m_mediator.m_dsBlockChain.GetBlock(1);
-      m_StartTimeDs = dsb.GetTimestamp();
+      const auto dsb = m_mediator.m_dsBlockChain.GetBlockPtr(1);
+      m_StartTimeDs = dsb->GetTimestamp();
     } catch (const JsonRpcException& je) {
       throw je;
     } catch (const char* msg) {
@@ -1025,7 +1121,8 @@ double LookupServer::GetDSBlockRate() {
     }
   }
   uint64_t TimeDiff =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetTimestamp() - m_StartTimeDs;
+      m_mediator.m_dsBlockChain.GetLastBlockPtr()->GetTimestamp() -
+      m_StartTimeDs;
 
   if (TimeDiff == 0) {
     LOG_GENERAL(INFO, "Wait till the second block");
@@ -1052,8 +1149,8 @@ double LookupServer::GetTxBlockRate() {
   if (m_StartTimeTx == 0) {
     try {
       // Reference Time chosen to be first block's timestamp
-      TxBlock txb = m_mediator.m_txBlockChain.GetBlock(1);
-      m_StartTimeTx = txb.GetTimestamp();
+      const auto txb = m_mediator.m_txBlockChain.GetBlockPtr(1);
+      m_StartTimeTx = txb->GetTimestamp();
     } catch (const char* msg) {
       if (string(msg) == "Blocknumber Absent") {
         LOG_GENERAL(INFO, "No TxBlock has been mined yet");
@@ -1062,7 +1159,8 @@ double LookupServer::GetTxBlockRate() {
     }
   }
   uint64_t TimeDiff =
-      m_mediator.m_txBlockChain.GetLastBlock().GetTimestamp() - m_StartTimeTx;
+      m_mediator.m_txBlockChain.GetLastBlockPtr()->GetTimestamp() -
+      m_StartTimeTx;
 
   if (TimeDiff == 0) {
     LOG_GENERAL(INFO, "Wait till the second block");
@@ -1080,8 +1178,7 @@ Json::Value LookupServer::DSBlockListing(unsigned int page) {
   if (!LOOKUP_NODE_MODE) {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
   }
-  uint64_t currBlockNum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t currBlockNum = m_mediator.m_dsBlockChain.GetLastBlockNum();
   Json::Value _json;
 
   uint maxPages = (currBlockNum / PAGE_SIZE) + 1;
@@ -1097,7 +1194,8 @@ Json::Value LookupServer::DSBlockListing(unsigned int page) {
   if (m_DSBlockCache.second.size() == 0) {
     try {
       // add the hash of genesis block
-      DSBlockHeader dshead = m_mediator.m_dsBlockChain.GetBlock(0).GetHeader();
+      DSBlockHeader dshead =
+          m_mediator.m_dsBlockChain.GetBlockPtr(0)->GetHeader();
       SHA2<HashType::HASH_VARIANT_256> sha2;
       bytes vec;
       dshead.Serialize(vec, 0);
@@ -1117,15 +1215,16 @@ Json::Value LookupServer::DSBlockListing(unsigned int page) {
 
   if (currBlockNum > m_DSBlockCache.first) {
     for (uint64_t i = m_DSBlockCache.first + 1; i < currBlockNum; i++) {
-      m_DSBlockCache.second.insert_new(m_DSBlockCache.second.size(),
-                                       m_mediator.m_dsBlockChain.GetBlock(i + 1)
-                                           .GetHeader()
-                                           .GetPrevHash()
-                                           .hex());
+      m_DSBlockCache.second.insert_new(
+          m_DSBlockCache.second.size(),
+          m_mediator.m_dsBlockChain.GetBlockPtr(i + 1)
+              ->GetHeader()
+              .GetPrevHash()
+              .hex());
     }
     // for the latest block
     DSBlockHeader dshead =
-        m_mediator.m_dsBlockChain.GetBlock(currBlockNum).GetHeader();
+        m_mediator.m_dsBlockChain.GetBlockPtr(currBlockNum)->GetHeader();
     SHA2<HashType::HASH_VARIANT_256> sha2;
     bytes vec;
     dshead.Serialize(vec, 0);
@@ -1160,10 +1259,11 @@ Json::Value LookupServer::DSBlockListing(unsigned int page) {
     for (uint64_t i = offset; i < PAGE_SIZE + offset && i <= currBlockNum;
          i++) {
       tmpJson.clear();
-      tmpJson["Hash"] = m_mediator.m_dsBlockChain.GetBlock(currBlockNum - i + 1)
-                            .GetHeader()
-                            .GetPrevHash()
-                            .hex();
+      tmpJson["Hash"] =
+          m_mediator.m_dsBlockChain.GetBlockPtr(currBlockNum - i + 1)
+              ->GetHeader()
+              .GetPrevHash()
+              .hex();
       tmpJson["BlockNum"] = uint(currBlockNum - i);
       _json["data"].append(tmpJson);
     }
@@ -1177,8 +1277,7 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
   if (!LOOKUP_NODE_MODE) {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
   }
-  uint64_t currBlockNum =
-      m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t currBlockNum = m_mediator.m_txBlockChain.GetLastBlockNum();
   Json::Value _json;
 
   if (currBlockNum == INIT_BLOCK_NUMBER) {
@@ -1194,7 +1293,8 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
   if (m_TxBlockCache.second.size() == 0) {
     try {
       // add the hash of genesis block
-      TxBlockHeader txhead = m_mediator.m_txBlockChain.GetBlock(0).GetHeader();
+      TxBlockHeader txhead =
+          m_mediator.m_txBlockChain.GetBlockPtr(0)->GetHeader();
       SHA2<HashType::HASH_VARIANT_256> sha2;
       bytes vec;
       txhead.Serialize(vec, 0);
@@ -1214,15 +1314,16 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
 
   if (currBlockNum > m_TxBlockCache.first) {
     for (uint64_t i = m_TxBlockCache.first + 1; i < currBlockNum; i++) {
-      m_TxBlockCache.second.insert_new(m_TxBlockCache.second.size(),
-                                       m_mediator.m_txBlockChain.GetBlock(i + 1)
-                                           .GetHeader()
-                                           .GetPrevHash()
-                                           .hex());
+      m_TxBlockCache.second.insert_new(
+          m_TxBlockCache.second.size(),
+          m_mediator.m_txBlockChain.GetBlockPtr(i + 1)
+              ->GetHeader()
+              .GetPrevHash()
+              .hex());
     }
     // for the latest block
     TxBlockHeader txhead =
-        m_mediator.m_txBlockChain.GetBlock(currBlockNum).GetHeader();
+        m_mediator.m_txBlockChain.GetBlockPtr(currBlockNum)->GetHeader();
     SHA2<HashType::HASH_VARIANT_256> sha2;
     bytes vec;
     txhead.Serialize(vec, 0);
@@ -1258,10 +1359,11 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
     for (uint64_t i = offset; i < PAGE_SIZE + offset && i <= currBlockNum;
          i++) {
       tmpJson.clear();
-      tmpJson["Hash"] = m_mediator.m_txBlockChain.GetBlock(currBlockNum - i + 1)
-                            .GetHeader()
-                            .GetPrevHash()
-                            .hex();
+      tmpJson["Hash"] =
+          m_mediator.m_txBlockChain.GetBlockPtr(currBlockNum - i + 1)
+              ->GetHeader()
+              .GetPrevHash()
+              .hex();
       tmpJson["BlockNum"] = uint(currBlockNum - i);
       _json["data"].append(tmpJson);
     }
@@ -1352,7 +1454,7 @@ string LookupServer::GetNumTxnsTxEpoch() {
   }
   try {
     return to_string(
-        m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetNumTxs());
+        m_mediator.m_txBlockChain.GetLastBlockPtr()->GetHeader().GetNumTxs());
   } catch (const JsonRpcException& je) {
     throw je;
   } catch (exception& e) {
@@ -1367,7 +1469,8 @@ string LookupServer::GetNumTxnsDSEpoch() {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
   }
   try {
-    auto latestTxBlock = m_mediator.m_txBlockChain.GetLastBlock().GetHeader();
+    auto latestTxBlock =
+        m_mediator.m_txBlockChain.GetLastBlockPtr()->GetHeader();
     auto latestTxBlockNum = latestTxBlock.GetBlockNum();
     auto latestDSBlockNum = latestTxBlock.GetDSBlockNum();
 
@@ -1375,12 +1478,12 @@ string LookupServer::GetNumTxnsDSEpoch() {
 
     if (latestTxBlockNum > m_TxBlockCountSumPair.first) {
       // Case where the DS Epoch is same
-      if (m_mediator.m_txBlockChain.GetBlock(m_TxBlockCountSumPair.first)
-              .GetHeader()
+      if (m_mediator.m_txBlockChain.GetBlockPtr(m_TxBlockCountSumPair.first)
+              ->GetHeader()
               .GetDSBlockNum() == latestDSBlockNum) {
         for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
           m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+              m_mediator.m_txBlockChain.GetBlockPtr(i)->GetHeader().GetNumTxs();
         }
       }
       // Case if DS Epoch Changed
@@ -1388,13 +1491,13 @@ string LookupServer::GetNumTxnsDSEpoch() {
         m_TxBlockCountSumPair.second = 0;
 
         for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
-          if (m_mediator.m_txBlockChain.GetBlock(i)
-                  .GetHeader()
+          if (m_mediator.m_txBlockChain.GetBlockPtr(i)
+                  ->GetHeader()
                   .GetDSBlockNum() < latestDSBlockNum) {
             break;
           }
           m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+              m_mediator.m_txBlockChain.GetBlockPtr(i)->GetHeader().GetNumTxs();
         }
       }
 
@@ -1425,18 +1528,23 @@ Json::Value LookupServer::GetTransactionsForTxBlock(const string& txBlockNum) {
     throw JsonRpcException(RPC_INVALID_PARAMETER, e.what());
   }
 
-  auto const& txBlock = m_mediator.m_txBlockChain.GetBlock(txNum);
+  const string cacheKey = "GetTransactionsForTxBlock:" + to_string(txNum);
+  if (GetCachedResponse(cacheKey, _json)) {
+    return _json;
+  }
+
+  const auto txBlock = m_mediator.m_txBlockChain.GetBlockPtr(txNum);
 
   // TODO
   // Workaround to identify dummy block as == comparator does not work on
   // empty object for TxBlock and TxBlockheader().
   // if (txBlock == TxBlock()) {
-  if (txBlock.GetHeader().GetBlockNum() == INIT_BLOCK_NUMBER &&
-      txBlock.GetHeader().GetDSBlockNum() == INIT_BLOCK_NUMBER) {
+  if (txBlock->GetHeader().GetBlockNum() == INIT_BLOCK_NUMBER &&
+      txBlock->GetHeader().GetDSBlockNum() == INIT_BLOCK_NUMBER) {
     throw JsonRpcException(RPC_INVALID_PARAMS, "Tx Block does not exist");
   }
 
-  auto microBlockInfos = txBlock.GetMicroBlockInfos();
+  const auto& microBlockInfos = txBlock->GetMicroBlockInfos();
 
   bool hasTransactions = false;
   for (auto const& mbInfo : microBlockInfos) {
@@ -1470,9 +1578,24 @@ Json::Value LookupServer::GetTransactionsForTxBlock(const string& txBlockNum) {
     throw JsonRpcException(RPC_MISC_ERROR, "TxBlock has no transactions");
   }
 
+  CacheResponse(cacheKey, _json);
   return _json;
 }
 
+bool LookupServer::GetCachedResponse(const string& key, Json::Value& response) {
+  shared_ptr<const Json::Value> cached;
+  if (!m_responseCache.Get(key, cached)) {
+    return false;
+  }
+  response = *cached;
+  return true;
+}
+
+void LookupServer::CacheResponse(const string& key,
+                                 const Json::Value& response) {
+  m_responseCache.Put(key, make_shared<const Json::Value>(response));
+}
+
 vector<uint> GenUniqueIndices(uint32_t size, uint32_t num, mt19937& eng) {
   // case when the number required is greater than total numbers being shuffled
   if (size < num) {
@@ -18,7 +18,10 @@
 #ifndef ZILLIQA_SRC_LIBSERVER_LOOKUPSERVER_H_
 #define ZILLIQA_SRC_LIBSERVER_LOOKUPSERVER_H_
 
+#include <memory>
+
 #include "Server.h"
+#include "libData/DataStructures/ShardedLRUCache.h"
 
 class Mediator;
 
@@ -38,6 +41,14 @@ class LookupServer : public Server,
   static std::mutex m_mutexRecentTxns;
   std::mt19937 m_eng;
 
+  /// Responses that can no longer change, i.e. those about blocks that are
+  /// already in the chain, keyed by method name and block number
+  ShardedLRUCache<std::string, std::shared_ptr<const Json::Value>>
+      m_responseCache;
+
+  bool GetCachedResponse(const std::string& key, Json::Value& response);
+  void CacheResponse(const std::string& key, const Json::Value& response);
+
  public:
   LookupServer(Mediator& mediator, jsonrpc::AbstractServerConnector& server);
   ~LookupServer() = default;
@@ -86,6 +97,10 @@ class LookupServer : public Server,
                                          Json::Value& response) {
     response = this->GetSmartContracts(request[0u].asString());
   }
+  inline virtual void SmartContractListingI(const Json::Value& request,
+                                            Json::Value& response) {
+    response = this->SmartContractListing(request[0u].asString(), request[1u]);
+  }
   inline virtual void GetContractAddressFromTransactionIDI(
       const Json::Value& request, Json::Value& response) {
     response =
@@ -192,6 +207,8 @@ class LookupServer : public Server,
   Json::Value GetBalance(const std::string& address);
   std::string GetMinimumGasPrice();
   Json::Value GetSmartContracts(const std::string& address);
+  Json::Value SmartContractListing(const std::string& address,
+                                   const Json::Value& pageNum);
   std::string GetContractAddressFromTransactionID(const std::string& tranID);
   unsigned int GetNumPeers();
   std::string GetNumTxBlocks();
@@ -210,6 +227,7 @@ class LookupServer : public Server,
   std::string GetNumTxnsTxEpoch();
 
   size_t GetNumTransactions(uint64_t blockNum);
+  Address GetCreatorAddress(const std::string& address);
   bool ValidateTxn(const Transaction& tx, const Address& fromAddr,
                    const Account* sender) const;
   bool StartCollectorThread();
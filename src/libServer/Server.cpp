@@ -56,8 +56,7 @@ string Server::GetCurrentMiniEpoch() {
 string Server::GetCurrentDSEpoch() {
   LOG_MARKER();
 
-  return to_string(
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum());
+  return to_string(m_mediator.m_dsBlockChain.GetLastBlockNum());
 }
 
 string Server::GetNodeType() {
@@ -77,9 +76,13 @@ string Server::GetNodeType() {
 }
 
 uint8_t Server::GetPrevDSDifficulty() {
-  return m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetDSDifficulty();
+  return m_mediator.m_dsBlockChain.GetLastBlockPtr()
+      ->GetHeader()
+      .GetDSDifficulty();
 }
 
 uint8_t Server::GetPrevDifficulty() {
-  return m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetDifficulty();
+  return m_mediator.m_dsBlockChain.GetLastBlockPtr()
+      ->GetHeader()
+      .GetDifficulty();
 }
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_LOCKFREERINGBUFFER_H_
+#define ZILLIQA_SRC_LIBUTILS_LOCKFREERINGBUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/// Utility class - bounded multi-producer multi-consumer queue that never
+/// takes a lock. Each slot carries a sequence number telling whether it is
+/// free for the producer or filled for the consumer of the current lap, so
+/// producers and consumers only contend on their own position counter.
+/// Capacity is rounded up to a power of two.
+template <class T>
+class LockFreeRingBuffer {
+  struct Slot {
+    std::atomic<size_t> m_sequence;
+    T m_value;
+  };
+
+  std::unique_ptr<Slot[]> m_slots;
+  size_t m_mask;
+  alignas(64) std::atomic<size_t> m_pushPos{0};
+  alignas(64) std::atomic<size_t> m_popPos{0};
+
+ public:
+  /// Constructor.
+  explicit LockFreeRingBuffer(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    m_slots.reset(new Slot[size]);
+    m_mask = size - 1;
+    for (size_t i = 0; i < size; i++) {
+      m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  LockFreeRingBuffer(const LockFreeRingBuffer&) = delete;
+  LockFreeRingBuffer& operator=(const LockFreeRingBuffer&) = delete;
+
+  /// Adds value to the back. Returns false, leaving value as it is, if the
+  /// buffer is full.
+  bool TryPush(T&& value) {
+    size_t pos = m_pushPos.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = m_slots[pos & m_mask];
+      const size_t seq = slot.m_sequence.load(std::memory_order_acquire);
+      const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (m_pushPos.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          slot.m_value = std::move(value);
+          slot.m_sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_pushPos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Moves the front into value. Returns false if the buffer is empty.
+  bool TryPop(T& value) {
+    size_t pos = m_popPos.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = m_slots[pos & m_mask];
+      const size_t seq = slot.m_sequence.load(std::memory_order_acquire);
+      const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (m_popPos.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+          value = std::move(slot.m_value);
+          slot.m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_popPos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  size_t Capacity() const { return m_mask + 1; }
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_LOCKFREERINGBUFFER_H_
@@ -44,8 +44,26 @@ inline pid_t getCurrentPid() {
   return 0;
 #endif
 }
+
+/// Returns the "[tid][time][file:line][function] " start of a line.
+string LinePrefix(pid_t tid, const unsigned int linenum, const char* filename,
+                  const char* function) {
+  auto cur = chrono::system_clock::now();
+  auto cur_time_t = chrono::system_clock::to_time_t(cur);
+  auto file_and_line =
+      std::string(std::string(filename) + ":" + std::to_string(linenum));
+  ostringstream oss;
+  oss << "[" << PAD(tid, Logger::TID_LEN, ' ') << "]["
+      << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
+      << PAD(get_ms(cur), 3, '0') << "]["
+      << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
+      << LIMIT(function, Logger::MAX_FUNCNAME_LEN) << "] ";
+  return oss.str();
+}
 }  // namespace
 
+atomic<int> Logger::s_lowestLevel{INT_MIN};
+
 const streampos Logger::MAX_FILE_SIZE =
     1024 * 1024 * 100;  // 100MB per log file
 
@@ -79,19 +97,20 @@ Logger::Logger(const char* prefix, bool log_to_file, const char* logpath,
     m_fileNamePrefix = prefix ? prefix : "common";
     m_seqNum = 0;
     newLog();
+
+    if (!m_bRefactor) {
+      m_buffer = make_unique<LockFreeRingBuffer<string>>(WRITE_BUFFER_SIZE);
+      m_writer = thread(&Logger::WriterLoop, this);
+    }
   }
 }
 
-Logger::~Logger() { m_logFile.close(); }
-
-void Logger::checkLog() {
-  std::ifstream in(m_fileName.c_str(),
-                   std::ifstream::ate | std::ifstream::binary);
-
-  if (in.tellg() >= m_maxFileSize) {
-    m_logFile.close();
-    newLog();
+Logger::~Logger() {
+  if (m_writer.joinable()) {
+    m_stopWriter = true;
+    m_writer.join();
   }
+  m_logFile.close();
 }
 
 void Logger::newLog() {
@@ -114,7 +133,56 @@ void Logger::newLog() {
     sinkHandle->call(&g3::FileSink::overrideLogHeader, "").wait();
     initializeLogging(logworker.get());
   } else {
-    m_logFile.open(m_logPath + m_fileName, ios_base::app);
+    const string path = m_logPath + m_fileName;
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(path, ec);
+    m_fileSize = ec ? 0 : (streamoff)size;
+    m_logFile.open(path, ios_base::app);
+  }
+}
+
+void Logger::Write(string&& line) {
+  if (!m_buffer) {
+    lock_guard<mutex> guard(m);
+    cout << line << endl << flush;
+    return;
+  }
+
+  // Only waits if the writer falls WRITE_BUFFER_SIZE lines behind
+  while (!m_buffer->TryPush(move(line))) {
+    this_thread::yield();
+  }
+  m_queued++;
+}
+
+void Logger::WriterLoop() {
+  string line;
+  while (true) {
+    if (m_buffer->TryPop(line)) {
+      m_logFile << line << '\n';
+      m_fileSize += line.size() + 1;
+      if (m_fileSize >= m_maxFileSize) {
+        m_logFile.close();
+        newLog();
+      }
+      m_written++;
+      continue;
+    }
+
+    m_logFile << flush;
+    if (m_stopWriter && m_written == m_queued) {
+      return;
+    }
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+}
+
+void Logger::Flush() {
+  if (!m_buffer) {
+    return;
+  }
+  while (m_written < m_queued) {
+    this_thread::sleep_for(chrono::milliseconds(1));
   }
 }
 
@@ -137,17 +205,26 @@ Logger& Logger::GetEpochInfoLogger(const char* fname_prefix, bool log_to_file,
   return logger;
 }
 
-void Logger::LogState(const char* msg) {
-  lock_guard<mutex> guard(m);
+Logger& Logger::GetLogger() {
+  static Logger& logger = GetLogger(
+      NULL, true, boost::filesystem::absolute("./").string().c_str());
+  return logger;
+}
 
-  if (m_logToFile) {
-    checkLog();
-    m_logFile << msg << endl << flush;
-  } else {
-    cout << msg << endl << flush;
-  }
+Logger& Logger::GetStateLogger() {
+  static Logger& logger = GetStateLogger(
+      NULL, true, boost::filesystem::absolute("./").string().c_str());
+  return logger;
 }
 
+Logger& Logger::GetEpochInfoLogger() {
+  static Logger& logger = GetEpochInfoLogger(
+      NULL, true, boost::filesystem::absolute("./").string().c_str());
+  return logger;
+}
+
+void Logger::LogState(const char* msg) { Write(msg); }
+
 void Logger::LogGeneral(const LEVELS& level, const char* msg,
                         const unsigned int linenum, const char* filename,
                         const char* function) {
@@ -164,166 +241,50 @@ void Logger::LogGeneral(const LEVELS& level, const char* msg,
     return;
   }
 
-  lock_guard<mutex> guard(m);
-
-  if (m_logToFile) {
-    checkLog();
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    m_logFile << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-              << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-              << PAD(get_ms(cur), 3, '0') << "]["
-              << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-              << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg << endl
-              << flush;
-  } else {
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    cout << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-         << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-         << PAD(get_ms(cur), 3, '0') << "]["
-         << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-         << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg << endl
-         << flush;
+  Write(LinePrefix(GetPid(), linenum, filename, function) + msg);
+  if (level.value >= FATAL.value) {
+    Flush();
   }
 }
 
-void Logger::LogEpoch([[gnu::unused]] const LEVELS& level, const char* msg,
-                      const char* epoch, const unsigned int linenum,
-                      const char* filename, const char* function) {
-  lock_guard<mutex> guard(m);
-
-  if (m_logToFile) {
-    checkLog();
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    m_logFile << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-              << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-              << PAD(get_ms(cur), 3, '0') << "]["
-              << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-              << LIMIT(function, MAX_FUNCNAME_LEN) << "] [Epoch " << epoch
-              << "] " << msg << endl
-              << flush;
-  } else {
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    cout << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-         << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-         << PAD(get_ms(cur), 3, '0') << "]["
-         << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-         << LIMIT(function, MAX_FUNCNAME_LEN) << "] [Epoch " << epoch << "] "
-         << msg << endl
-         << flush;
+void Logger::LogEpoch(const LEVELS& level, const char* msg, const char* epoch,
+                      const unsigned int linenum, const char* filename,
+                      const char* function) {
+  Write(LinePrefix(GetPid(), linenum, filename, function) + "[Epoch " +
+        epoch + "] " + msg);
+  if (level.value >= FATAL.value) {
+    Flush();
   }
 }
 
-void Logger::LogPayload([[gnu::unused]] const LEVELS& level, const char* msg,
+void Logger::LogPayload(const LEVELS& level, const char* msg,
                         const bytes& payload, size_t max_bytes_to_display,
                         const unsigned int linenum, const char* filename,
                         const char* function) {
   std::unique_ptr<char[]> payload_string;
   GetPayloadS(payload, max_bytes_to_display, payload_string);
-  lock_guard<mutex> guard(m);
 
-  if (m_logToFile) {
-    checkLog();
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-
-    if (payload.size() > max_bytes_to_display) {
-      m_logFile << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-                << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-                << PAD(get_ms(cur), 3, '0') << "]["
-                << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)
-                << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg
-                << " (Len=" << payload.size() << "): " << payload_string.get()
-                << "..." << endl
-                << flush;
-    } else {
-      m_logFile << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-                << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-                << PAD(get_ms(cur), 3, '0') << "]["
-                << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)
-                << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg
-                << " (Len=" << payload.size() << "): " << payload_string.get()
-                << endl
-                << flush;
-    }
-  } else {
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-
-    if (payload.size() > max_bytes_to_display) {
-      cout << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-           << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-           << PAD(get_ms(cur), 3, '0') << "]["
-           << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-           << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg
-           << " (Len=" << payload.size() << "): " << payload_string.get()
-           << "..." << endl
-           << flush;
-    } else {
-      cout << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-           << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-           << PAD(get_ms(cur), 3, '0') << "]["
-           << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-           << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg
-           << " (Len=" << payload.size() << "): " << payload_string.get()
-           << endl
-           << flush;
-    }
+  ostringstream oss;
+  oss << LinePrefix(GetPid(), linenum, filename, function) << msg
+      << " (Len=" << payload.size() << "): " << payload_string.get()
+      << (payload.size() > max_bytes_to_display ? "..." : "");
+  Write(oss.str());
+  if (level.value >= FATAL.value) {
+    Flush();
   }
 }
 
 void Logger::LogEpochInfo(const char* msg, const unsigned int linenum,
                           const char* filename, const char* function,
                           const char* epoch) {
-  pid_t tid = getCurrentPid();
-  lock_guard<mutex> guard(m);
-
-  if (m_logToFile) {
-    checkLog();
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    m_logFile << "[" << PAD(tid, TID_LEN, ' ') << "]["
-              << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-              << PAD(get_ms(cur), 3, '0') << "]["
-              << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-              << LIMIT(function, MAX_FUNCNAME_LEN) << "] [Epoch " << epoch
-              << "] " << msg << endl
-              << flush;
-  } else {
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    cout << "[" << PAD(tid, TID_LEN, ' ') << "]["
-         << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-         << PAD(get_ms(cur), 3, '0') << "]["
-         << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-         << LIMIT(function, MAX_FUNCNAME_LEN) << "] [Epoch " << epoch << "] "
-         << msg << endl
-         << flush;
-  }
+  Write(LinePrefix(getCurrentPid(), linenum, filename, function) + "[Epoch " +
+        epoch + "] " + msg);
 }
 
 void Logger::DisplayLevelAbove(const LEVELS& level) {
   if (level != INFO && level != WARNING && level != FATAL) return;
 
+  s_lowestLevel = level.value;
   g3::log_levels::setHighest(level);
 }
 
@@ -361,14 +322,14 @@ void Logger::GetPayloadS(const bytes& payload, size_t max_bytes_to_display,
 ScopeMarker::ScopeMarker(const unsigned int linenum, const char* filename,
                          const char* function)
     : m_linenum(linenum), m_filename(filename), m_function(function) {
-  Logger& logger = Logger::GetLogger(
-      NULL, true, boost::filesystem::absolute("./").string().c_str());
-  logger.LogGeneral(INFO, "BEG", linenum, filename, function);
+  if (Logger::IsEnabled(INFO)) {
+    Logger::GetLogger().LogGeneral(INFO, "BEG", linenum, filename, function);
+  }
 }
 
 ScopeMarker::~ScopeMarker() {
-  Logger& logger = Logger::GetLogger(
-      NULL, true, boost::filesystem::absolute("./").string().c_str());
-  logger.LogGeneral(INFO, "END", m_linenum, m_filename.c_str(),
-                    m_function.c_str());
+  if (Logger::IsEnabled(INFO)) {
+    Logger::GetLogger().LogGeneral(INFO, "END", m_linenum, m_filename.c_str(),
+                                   m_function.c_str());
+  }
 }
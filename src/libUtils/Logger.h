@@ -19,19 +19,30 @@
 #define ZILLIQA_SRC_LIBUTILS_LOGGER_H_
 
 #include <boost/filesystem.hpp>
+#include <atomic>
 #include <chrono>
+#include <climits>
 #include <fstream>
 #include <iomanip>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include "common/BaseType.h"
 #include "g3log/g3log.hpp"
 #include "g3log/loglevels.hpp"
 #include "g3log/logworker.hpp"
+#include "libUtils/LockFreeRingBuffer.h"
 #include "libUtils/TimeUtils.h"
 
+/// Lowest level value (see g3log LEVELS) still logged by this build. Set with
+/// e.g. -DLOG_MIN_LEVEL=500 to leave only WARNING and above; by default the
+/// check folds away.
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL INT_MIN
+#endif
+
 #define LIMIT(s, len)                              \
   std::setw(len) << std::setfill(' ') << std::left \
                  << std::string(s).substr(0, len)
@@ -50,20 +61,36 @@ class Logger {
   std::streampos m_maxFileSize;
   std::unique_ptr<g3::LogWorker> logworker;
 
+  /// Lowest level value displayed, set by DisplayLevelAbove
+  static std::atomic<int> s_lowestLevel;
+
   Logger(const char* prefix, bool log_to_file, const char* logpath,
          std::streampos max_file_size);
   ~Logger();
 
-  void checkLog();
   void newLog();
 
+  /// Outputs a complete line. Lines for a log file are queued for m_writer,
+  /// others are printed right away.
+  void Write(std::string&& line);
+  void WriterLoop();
+
   std::string m_fileNamePrefix;
   std::string m_fileName;
   std::ofstream m_logFile;
+  std::streamoff m_fileSize{0};
   unsigned int m_seqNum;
   bool m_bRefactor{};
   std::string m_logPath;
 
+  /// Lines waiting to be written to m_logFile by m_writer, which alone
+  /// touches the file once it is started
+  std::unique_ptr<LockFreeRingBuffer<std::string>> m_buffer;
+  std::thread m_writer;
+  std::atomic<bool> m_stopWriter{false};
+  std::atomic<uint64_t> m_queued{0};
+  std::atomic<uint64_t> m_written{0};
+
  public:
   /// Limits the number of bytes of a payload to display.
   static const size_t MAX_BYTES_TO_DISPLAY = 30;
@@ -84,6 +111,9 @@ class Logger {
   /// Limits the output file size before rolling over to new output file.
   static const std::streampos MAX_FILE_SIZE;
 
+  /// Limits the number of lines waiting to be written to the log file.
+  static const size_t WRITE_BUFFER_SIZE = 8192;
+
   /// Returns the singleton instance for the main Logger.
   static Logger& GetLogger(const char* fname_prefix, bool log_to_file,
                            const char* logpath,
@@ -99,6 +129,23 @@ class Logger {
       const char* fname_prefix, bool log_to_file, const char* logpath,
       std::streampos max_file_size = MAX_FILE_SIZE);
 
+  /// Return the same singletons, creating them with a log file in the current
+  /// folder if they were not initialised. The handles are cached, so these are
+  /// cheap enough to call for every message.
+  static Logger& GetLogger();
+  static Logger& GetStateLogger();
+  static Logger& GetEpochInfoLogger();
+
+  /// Returns true if messages of level are displayed. Checked before the
+  /// message is formatted.
+  static bool IsEnabled(const LEVELS& level) {
+    return level.value >= LOG_MIN_LEVEL &&
+           level.value >= s_lowestLevel.load(std::memory_order_relaxed);
+  }
+
+  /// Waits until the queued lines are written to the log file.
+  void Flush();
+
   /// Outputs the specified message and function name to the state/reporting
   /// log.
   void LogState(const char* msg);
@@ -176,87 +223,76 @@ class ScopeMarker {
 #define INIT_EPOCHINFO_LOGGER(fname_prefix, logpath) \
   Logger::GetEpochInfoLogger(fname_prefix, true, logpath)
 #define LOG_MARKER() ScopeMarker marker(__LINE__, __FILE__, __FUNCTION__)
-#define LOG_STATE(msg)                                                         \
-  {                                                                            \
-    std::ostringstream oss;                                                    \
-    auto cur = std::chrono::system_clock::now();                               \
-    auto cur_time_t = std::chrono::system_clock::to_time_t(cur);               \
-    oss << "[ " << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")          \
-        << PAD(get_ms(cur), 3, '0') << " ]" << msg;                            \
-    Logger::GetStateLogger(NULL, true,                                         \
-                           boost::filesystem::absolute("./").string().c_str()) \
-        .LogState(oss.str().c_str());                                          \
+#define LOG_STATE(msg)                                                \
+  {                                                                   \
+    std::ostringstream oss;                                           \
+    auto cur = std::chrono::system_clock::now();                      \
+    auto cur_time_t = std::chrono::system_clock::to_time_t(cur);      \
+    oss << "[ " << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.") \
+        << PAD(get_ms(cur), 3, '0') << " ]" << msg;                   \
+    Logger::GetStateLogger().LogState(oss.str().c_str());             \
   }
 #define LOG_GENERAL(level, msg)                                                \
   {                                                                            \
-    if (Logger::GetLogger(NULL, true,                                          \
-                          boost::filesystem::absolute("./").string().c_str())  \
-            .IsG3Log()) {                                                      \
-      auto cur = std::chrono::system_clock::now();                             \
-      auto cur_time_t = std::chrono::system_clock::to_time_t(cur);             \
-      auto file_and_line =                                                     \
-          std::string(std::string(__FILE__) + ":" + std::to_string(__LINE__)); \
-      LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ') << "][" \
-                 << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")         \
-                 << PAD(get_ms(cur), 3, '0') << "]["                           \
-                 << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)    \
-                 << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)      \
-                 << "] " << msg;                                               \
-    } else {                                                                   \
-      std::ostringstream oss;                                                  \
-      oss << msg;                                                              \
-      Logger::GetLogger(NULL, true,                                            \
-                        boost::filesystem::absolute("./").string().c_str())    \
-          .LogGeneral(level, oss.str().c_str(), __LINE__, __FILE__,            \
-                      __FUNCTION__);                                           \
+    if (Logger::IsEnabled(level)) {                                            \
+      Logger& log_handle = Logger::GetLogger();                                \
+      if (log_handle.IsG3Log()) {                                              \
+        auto cur = std::chrono::system_clock::now();                           \
+        auto cur_time_t = std::chrono::system_clock::to_time_t(cur);           \
+        auto file_and_line = std::string(std::string(__FILE__) + ":" +         \
+                                         std::to_string(__LINE__));            \
+        LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ')       \
+                   << "]["                                                     \
+                   << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")       \
+                   << PAD(get_ms(cur), 3, '0') << "]["                         \
+                   << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)  \
+                   << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)    \
+                   << "] " << msg;                                             \
+      } else {                                                                 \
+        std::ostringstream oss;                                                \
+        oss << msg;                                                            \
+        log_handle.LogGeneral(level, oss.str().c_str(), __LINE__, __FILE__,    \
+                              __FUNCTION__);                                   \
+      }                                                                        \
     }                                                                          \
   }
 #define LOG_EPOCH(level, epoch, msg)                                           \
   {                                                                            \
-    if (Logger::GetLogger(NULL, true,                                          \
-                          boost::filesystem::absolute("./").string().c_str())  \
-            .IsG3Log()) {                                                      \
-      auto cur = std::chrono::system_clock::now();                             \
-      auto cur_time_t = std::chrono::system_clock::to_time_t(cur);             \
-      auto file_and_line =                                                     \
-          std::string(std::string(__FILE__) + ":" + std::to_string(__LINE__)); \
-      LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ') << "][" \
-                 << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")         \
-                 << PAD(get_ms(cur), 3, '0') << "]["                           \
-                 << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)    \
-                 << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)      \
-                 << "] [Epoch " << std::to_string(epoch).c_str() << "] "       \
-                 << msg;                                                       \
-    } else {                                                                   \
-      std::ostringstream oss;                                                  \
-      oss << msg;                                                              \
-      Logger::GetLogger(NULL, true,                                            \
-                        boost::filesystem::absolute("./").string().c_str())    \
-          .LogEpoch(level, std::to_string(epoch).c_str(), oss.str().c_str(),   \
-                    __LINE__, __FILE__, __FUNCTION__);                         \
-    }                                                                          \
-  }
-#define LOG_PAYLOAD(level, msg, payload, max_bytes_to_display)                 \
-  {                                                                            \
-    if (Logger::GetLogger(NULL, true,                                          \
-                          boost::filesystem::absolute("./").string().c_str())  \
-            .IsG3Log()) {                                                      \
-      std::unique_ptr<char[]> payload_string;                                  \
-      Logger::GetPayloadS(payload, max_bytes_to_display, payload_string);      \
-      auto cur = std::chrono::system_clock::now();                             \
-      auto cur_time_t = std::chrono::system_clock::to_time_t(cur);             \
-      auto file_and_line =                                                     \
-          std::string(std::string(__FILE__) + ":" + std::to_string(__LINE__)); \
-      if ((payload).size() > max_bytes_to_display) {                           \
+    if (Logger::IsEnabled(level)) {                                            \
+      Logger& log_handle = Logger::GetLogger();                                \
+      if (log_handle.IsG3Log()) {                                              \
+        auto cur = std::chrono::system_clock::now();                           \
+        auto cur_time_t = std::chrono::system_clock::to_time_t(cur);           \
+        auto file_and_line = std::string(std::string(__FILE__) + ":" +         \
+                                         std::to_string(__LINE__));            \
         LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ')       \
                    << "]["                                                     \
                    << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")       \
                    << PAD(get_ms(cur), 3, '0') << "]["                         \
                    << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)  \
                    << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)    \
-                   << "] " << msg << " (Len=" << (payload).size()              \
-                   << "): " << payload_string.get() << "...";                  \
+                   << "] [Epoch " << std::to_string(epoch).c_str() << "] "     \
+                   << msg;                                                     \
       } else {                                                                 \
+        std::ostringstream oss;                                                \
+        oss << msg;                                                            \
+        log_handle.LogEpoch(level, std::to_string(epoch).c_str(),              \
+                            oss.str().c_str(), __LINE__, __FILE__,             \
+                            __FUNCTION__);                                     \
+      }                                                                        \
+    }                                                                          \
+  }
+#define LOG_PAYLOAD(level, msg, payload, max_bytes_to_display)                 \
+  {                                                                            \
+    if (Logger::IsEnabled(level)) {                                            \
+      Logger& log_handle = Logger::GetLogger();                                \
+      if (log_handle.IsG3Log()) {                                              \
+        std::unique_ptr<char[]> payload_string;                                \
+        Logger::GetPayloadS(payload, max_bytes_to_display, payload_string);    \
+        auto cur = std::chrono::system_clock::now();                           \
+        auto cur_time_t = std::chrono::system_clock::to_time_t(cur);           \
+        auto file_and_line = std::string(std::string(__FILE__) + ":" +         \
+                                         std::to_string(__LINE__));            \
         LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ')       \
                    << "]["                                                     \
                    << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")       \
@@ -264,43 +300,30 @@ class ScopeMarker {
                    << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)  \
                    << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)    \
                    << "] " << msg << " (Len=" << (payload).size()              \
-                   << "): " << payload_string.get();                           \
+                   << "): " << payload_string.get()                            \
+                   << ((payload).size() > max_bytes_to_display ? "..." : "");  \
+      } else {                                                                 \
+        std::ostringstream oss;                                                \
+        oss << msg;                                                            \
+        log_handle.LogPayload(level, oss.str().c_str(), payload,               \
+                              max_bytes_to_display, __LINE__, __FILE__,        \
+                              __FUNCTION__);                                   \
       }                                                                        \
-    } else {                                                                   \
-      std::ostringstream oss;                                                  \
-      oss << msg;                                                              \
-      Logger::GetLogger(NULL, true,                                            \
-                        boost::filesystem::absolute("./").string().c_str())    \
-          .LogPayload(level, oss.str().c_str(), payload, max_bytes_to_display, \
-                      __LINE__, __FILE__, __FUNCTION__);                       \
     }                                                                          \
   }
-#define LOG_DISPLAY_LEVEL_ABOVE(level)                                    \
-  {                                                                       \
-    Logger::GetLogger(NULL, true,                                         \
-                      boost::filesystem::absolute("./").string().c_str()) \
-        .DisplayLevelAbove(level);                                        \
-  }
-#define LOG_ENABLE_LEVEL(level)                                           \
-  {                                                                       \
-    Logger::GetLogger(NULL, true,                                         \
-                      boost::filesystem::absolute("./").string().c_str()) \
-        .EnableLevel(level);                                              \
-  }
-#define LOG_DISABLE_LEVEL(level)                                          \
-  {                                                                       \
-    Logger::GetLogger(NULL, true,                                         \
-                      boost::filesystem::absolute("./").string().c_str()) \
-        .DisableLevel(level);                                             \
-  }
-#define LOG_EPOCHINFO(blockNum, msg)                                       \
-  {                                                                        \
-    std::ostringstream oss;                                                \
-    oss << msg;                                                            \
-    Logger::GetEpochInfoLogger(                                            \
-        NULL, true, boost::filesystem::absolute("./").string().c_str())    \
-        .LogEpochInfo(oss.str().c_str(), __LINE__, __FILE__, __FUNCTION__, \
-                      std::to_string(blockNum).c_str());                   \
+#define LOG_DISPLAY_LEVEL_ABOVE(level)              \
+  { Logger::GetLogger().DisplayLevelAbove(level); }
+#define LOG_ENABLE_LEVEL(level)               \
+  { Logger::GetLogger().EnableLevel(level); }
+#define LOG_DISABLE_LEVEL(level)               \
+  { Logger::GetLogger().DisableLevel(level); }
+#define LOG_EPOCHINFO(blockNum, msg)                          \
+  {                                                           \
+    std::ostringstream oss;                                   \
+    oss << msg;                                               \
+    Logger::GetEpochInfoLogger().LogEpochInfo(                \
+        oss.str().c_str(), __LINE__, __FILE__, __FUNCTION__,  \
+        std::to_string(blockNum).c_str());                    \
   }
 
 #define LOG_CHECK_FAIL(checktype, received, expected) \
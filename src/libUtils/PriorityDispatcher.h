@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_PRIORITYDISPATCHER_H_
+#define ZILLIQA_SRC_LIBUTILS_PRIORITYDISPATCHER_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libUtils/Logger.h"
+
+/// Utility class - hands jobs of several priority classes to a pool of worker
+/// threads. Each class has its own bounded queue. Idle workers sleep until a
+/// job is pushed, and take jobs in weighted round-robin order: in each round,
+/// class i is served up to weight i times before lower classes wait for the
+/// next round, so lower classes are slowed down but never starved.
+template <class T>
+class PriorityDispatcher {
+ public:
+  using Handler = std::function<void(T&)>;
+
+  /// Scheduling parameters of a class. Classes are listed from the highest
+  /// priority down.
+  struct Class {
+    std::string m_name;
+    unsigned int m_weight;
+    size_t m_maxDepth;
+  };
+
+  /// Constructor. Starts numWorkers threads that call handler on each job.
+  PriorityDispatcher(const std::string& name, const std::vector<Class>& classes,
+                     unsigned int numWorkers, Handler handler)
+      : m_name(name), m_handler(std::move(handler)) {
+    for (const auto& c : classes) {
+      m_queues.push_back({c, {}, std::max(c.m_weight, 1u), 0});
+    }
+    m_workers.reserve(numWorkers);
+    for (unsigned int i = 0; i < numWorkers; i++) {
+      m_workers.emplace_back([this]() { Work(); });
+    }
+  }
+
+  PriorityDispatcher(const PriorityDispatcher&) = delete;
+  PriorityDispatcher& operator=(const PriorityDispatcher&) = delete;
+
+  /// Destructor. Stops the workers; jobs still queued are not handled.
+  ~PriorityDispatcher() { Stop(); }
+
+  /// Queues job in class index. Returns false, leaving job as it is, if the
+  /// queue of the class is full.
+  bool Push(unsigned int index, T&& job) {
+    {
+      std::lock_guard<std::mutex> g(m_mutex);
+      Queue& queue = m_queues.at(index);
+      if (m_stopped || queue.m_jobs.size() >= queue.m_class.m_maxDepth) {
+        if (!m_stopped && (queue.m_dropped++ % DROP_LOG_INTERVAL == 0)) {
+          LOG_GENERAL(WARNING, m_name << " " << queue.m_class.m_name
+                                      << " queue is full, dropped "
+                                      << queue.m_dropped << " jobs");
+        }
+        return false;
+      }
+      queue.m_jobs.push_back(std::move(job));
+    }
+    m_cvJob.notify_one();
+    return true;
+  }
+
+  /// Takes the jobs still queued, highest class first, and stops the
+  /// workers after the jobs they are handling.
+  std::vector<T> Stop() {
+    std::vector<T> jobs;
+    {
+      std::lock_guard<std::mutex> g(m_mutex);
+      if (m_stopped) {
+        return jobs;
+      }
+      m_stopped = true;
+      for (auto& queue : m_queues) {
+        for (auto& job : queue.m_jobs) {
+          jobs.push_back(std::move(job));
+        }
+        queue.m_jobs.clear();
+      }
+    }
+    m_cvJob.notify_all();
+    for (auto& worker : m_workers) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+    }
+    return jobs;
+  }
+
+  /// Returns the number of jobs waiting in class index.
+  size_t Size(unsigned int index) const {
+    std::lock_guard<std::mutex> g(m_mutex);
+    return m_queues.at(index).m_jobs.size();
+  }
+
+  /// Returns the number of jobs of class index dropped for a full queue.
+  uint64_t Dropped(unsigned int index) const {
+    std::lock_guard<std::mutex> g(m_mutex);
+    return m_queues.at(index).m_dropped;
+  }
+
+ private:
+  static const uint64_t DROP_LOG_INTERVAL = 100;
+
+  struct Queue {
+    Class m_class;
+    std::deque<T> m_jobs;
+    /// Jobs the class may still take in the current round
+    unsigned int m_credits;
+    uint64_t m_dropped;
+  };
+
+  std::string m_name;
+  Handler m_handler;
+  std::vector<Queue> m_queues;
+  std::vector<std::thread> m_workers;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cvJob;
+  bool m_stopped{false};
+
+  /// Moves the next job into job. Requires m_mutex and a non-empty queue.
+  void PopLocked(T& job) {
+    while (true) {
+      for (auto& queue : m_queues) {
+        if (!queue.m_jobs.empty() && queue.m_credits > 0) {
+          queue.m_credits--;
+          job = std::move(queue.m_jobs.front());
+          queue.m_jobs.pop_front();
+          return;
+        }
+      }
+      // Every class with jobs has had its share of this round
+      for (auto& queue : m_queues) {
+        queue.m_credits = std::max(queue.m_class.m_weight, 1u);
+      }
+    }
+  }
+
+  bool HasJobsLocked() const {
+    for (const auto& queue : m_queues) {
+      if (!queue.m_jobs.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Work() {
+    while (true) {
+      T job;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cvJob.wait(lock, [this] { return m_stopped || HasJobsLocked(); });
+        if (m_stopped) {
+          return;
+        }
+        PopLocked(job);
+      }
+      m_handler(job);
+    }
+  }
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_PRIORITYDISPATCHER_H_
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ScillaWorker.h"
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+
+#include "common/Constants.h"
+#include "libUtils/JsonUtils.h"
+#include "libUtils/Logger.h"
+#include "libUtils/ScillaWorkerClient.h"
+#include "libUtils/SysCommand.h"
+
+using namespace std;
+
+namespace {
+
+bool WriteFile(const string& path, const string& content) {
+  ofstream os(path, ios::binary | ios::trunc);
+  os << content;
+  return os.good();
+}
+
+/// Runs cmd and collects its printout, killing it if peerFd hangs up.
+bool RunInterpreter(const string& cmd, int peerFd, string& print) {
+  LOG_GENERAL(INFO, cmd);
+
+  int pid = -1;
+  FILE* fp = SysCommand::popen_with_pid(cmd + " 2>&1", "r", pid);
+  if (fp == nullptr) {
+    LOG_GENERAL(WARNING, "popen() failed for command: " << cmd);
+    return true;
+  }
+
+  bool aborted = false;
+  array<char, 4096> buffer{};
+  struct pollfd fds[2] = {{fileno(fp), POLLIN, 0}, {peerFd, POLLIN, 0}};
+  while (true) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+
+    // The client sends nothing while it waits, so any event on its side
+    // means it has gone away
+    if (fds[1].revents != 0) {
+      LOG_GENERAL(INFO, "Client went away, killing interpreter " << pid);
+      kill(-pid, SIGKILL);
+      aborted = true;
+      break;
+    }
+
+    if (fds[0].revents != 0) {
+      const ssize_t n = read(fds[0].fd, buffer.data(), buffer.size());
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        break;
+      }
+      print.append(buffer.data(), n);
+    }
+  }
+
+  SysCommand::popen_with_pid(fp, pid);
+  return !aborted;
+}
+
+}  // namespace
+
+ScillaWorker::ScillaWorker(const string& socketPath, const string& workDir)
+    : m_socketPath(socketPath), m_workDir(workDir) {}
+
+ScillaWorker::~ScillaWorker() {
+  Stop();
+  for (auto& t : m_threads) {
+    if (t.joinable()) {
+      t.join();
+    }
+  }
+}
+
+bool ScillaWorker::Listen() {
+  struct sockaddr_un addr {};
+  if (m_socketPath.size() >= sizeof(addr.sun_path)) {
+    LOG_GENERAL(WARNING, "Socket path too long: " << m_socketPath);
+    return false;
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(m_workDir, ec);
+  if (ec) {
+    LOG_GENERAL(WARNING, "Cannot create " << m_workDir << ": " << ec.message());
+    return false;
+  }
+
+  unlink(m_socketPath.c_str());
+  m_listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (m_listenFd < 0) {
+    LOG_GENERAL(WARNING, "socket() failed: " << strerror(errno));
+    return false;
+  }
+
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, m_socketPath.c_str(), sizeof(addr.sun_path) - 1);
+  if (bind(m_listenFd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+      listen(m_listenFd, SOMAXCONN) != 0) {
+    LOG_GENERAL(WARNING, "Cannot listen on " << m_socketPath << ": "
+                                             << strerror(errno));
+    close(m_listenFd);
+    m_listenFd = -1;
+    return false;
+  }
+
+  LOG_GENERAL(INFO, "Scilla worker listening on " << m_socketPath);
+  return true;
+}
+
+void ScillaWorker::Run() {
+  unsigned int connId = 0;
+  while (!m_stopped) {
+    const int fd = accept(m_listenFd, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+
+    lock_guard<mutex> g(m_mutexConnections);
+    if (m_stopped) {
+      close(fd);
+      break;
+    }
+    m_connections.emplace(fd);
+    const string dir = m_workDir + "/conn_" + to_string(connId++);
+    m_threads.emplace_back([this, fd, dir]() { Serve(fd, dir); });
+  }
+
+  for (auto& t : m_threads) {
+    t.join();
+  }
+  m_threads.clear();
+}
+
+void ScillaWorker::Stop() {
+  lock_guard<mutex> g(m_mutexConnections);
+  if (m_stopped.exchange(true)) {
+    return;
+  }
+
+  if (m_listenFd >= 0) {
+    shutdown(m_listenFd, SHUT_RDWR);
+    close(m_listenFd);
+    m_listenFd = -1;
+    unlink(m_socketPath.c_str());
+  }
+  for (const auto& fd : m_connections) {
+    shutdown(fd, SHUT_RDWR);
+  }
+}
+
+void ScillaWorker::Serve(int fd, const string& dir) {
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(dir, ec);
+
+  string lastCodeHash;
+  string request;
+  while (!ec && ScillaWorkerClient::ReadFrame(fd, request)) {
+    string response;
+    if (!HandleRequest(request, dir, fd, lastCodeHash, response) ||
+        !ScillaWorkerClient::WriteFrame(fd, response)) {
+      break;
+    }
+  }
+
+  {
+    lock_guard<mutex> g(m_mutexConnections);
+    m_connections.erase(fd);
+  }
+  close(fd);
+  boost::filesystem::remove_all(dir, ec);
+}
+
+bool ScillaWorker::HandleRequest(const string& request, const string& dir,
+                                 int peerFd, string& lastCodeHash,
+                                 string& response) {
+  Json::Value req;
+  if (!JSONUtils::GetInstance().convertStrtoJson(request, req) ||
+      !req.isObject()) {
+    response = "Invalid scilla worker request";
+    return true;
+  }
+
+  const string command = req["command"].asString();
+  const string root = req["root"].asString();
+
+  string args;
+  for (const auto& arg : req["args"]) {
+    args += " " + arg.asString();
+  }
+
+  // The code is written again only for another contract
+  const string codePath = dir + "/input.scilla";
+  const string codeHash = req["code_hash"].asString();
+  if (codeHash.empty() || codeHash != lastCodeHash ||
+      !boost::filesystem::exists(codePath)) {
+    lastCodeHash.clear();
+    if (!WriteFile(codePath, req["code"].asString())) {
+      response = "Failed to write code";
+      return true;
+    }
+    lastCodeHash = codeHash;
+  }
+
+  string cmd;
+  const string outputPath = dir + "/output.json";
+  if (command == "check") {
+    cmd = root + '/' + SCILLA_CHECKER + args + " " + codePath;
+  } else if (command == "run") {
+    boost::system::error_code ec;
+    boost::filesystem::remove(outputPath, ec);
+
+    auto& json = JSONUtils::GetInstance();
+    cmd = root + '/' + SCILLA_BINARY + " -init " + dir + "/init.json";
+    if (!WriteFile(dir + "/init.json", json.convertJsontoStr(req["init"])) ||
+        !WriteFile(dir + "/blockchain.json",
+                   json.convertJsontoStr(req["blockchain"]))) {
+      response = "Failed to write inputs";
+      return true;
+    }
+    if (req.isMember("state")) {
+      if (!WriteFile(dir + "/state.json",
+                     json.convertJsontoStr(req["state"]))) {
+        response = "Failed to write inputs";
+        return true;
+      }
+      cmd += " -istate " + dir + "/state.json";
+    }
+    cmd += " -iblockchain " + dir + "/blockchain.json";
+    if (req.isMember("message")) {
+      if (!WriteFile(dir + "/message.json",
+                     json.convertJsontoStr(req["message"]))) {
+        response = "Failed to write inputs";
+        return true;
+      }
+      cmd += " -imessage " + dir + "/message.json";
+    }
+    cmd += " -o " + outputPath + " -i " + codePath + args;
+  } else {
+    response = "Unknown scilla worker command: " + command;
+    return true;
+  }
+
+  string print;
+  if (!RunInterpreter(cmd, peerFd, print)) {
+    return false;
+  }
+
+  // As with OUTPUT_JSON, the printout stands in for a missing output
+  ifstream in(outputPath, ios::binary);
+  if (command == "run" && in.is_open()) {
+    response.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+  } else {
+    response = move(print);
+  }
+  return true;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_SCILLAWORKER_H_
+#define ZILLIQA_SRC_LIBUTILS_SCILLAWORKER_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/// Worker side of the protocol of ScillaWorkerClient, serving requests with
+/// the scilla-checker and scilla-runner binaries.
+///
+/// Each connection gets its own directory under the work directory, where the
+/// inputs of a request are written for the interpreter. The code is only
+/// written again when its code_hash changes. The interpreter is killed if the
+/// client disconnects while it runs.
+class ScillaWorker {
+  const std::string m_socketPath;
+  const std::string m_workDir;
+
+  int m_listenFd{-1};
+  std::atomic<bool> m_stopped{false};
+
+  std::mutex m_mutexConnections;
+  std::unordered_set<int> m_connections;
+  std::vector<std::thread> m_threads;
+
+  void Serve(int fd, const std::string& dir);
+
+  ScillaWorker(ScillaWorker const&) = delete;
+  void operator=(ScillaWorker const&) = delete;
+
+ public:
+  ScillaWorker(const std::string& socketPath, const std::string& workDir);
+  ~ScillaWorker();
+
+  /// Binds the socket, replacing one left behind by an earlier run.
+  bool Listen();
+
+  /// Serves connections, each on its own thread, until Stop is called.
+  void Run();
+
+  /// Makes Run return after closing all connections.
+  void Stop();
+
+  /// Runs one request with its inputs written to dir, and sets response to
+  /// the interpreter's output json, or to its printout if there is none.
+  /// Returns false if peerFd hung up and the interpreter was killed.
+  static bool HandleRequest(const std::string& request, const std::string& dir,
+                            int peerFd, std::string& lastCodeHash,
+                            std::string& response);
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_SCILLAWORKER_H_
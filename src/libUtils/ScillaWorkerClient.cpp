@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ScillaWorkerClient.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+
+bool WriteAll(int fd, const char* data, size_t len) {
+  while (len > 0) {
+    ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+bool ReadAll(int fd, char* data, size_t len) {
+  while (len > 0) {
+    ssize_t n = recv(fd, data, len, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (n == 0) {
+      return false;
+    }
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+}  // namespace
+
+ScillaWorkerClient::ScillaWorkerClient(const string& socketPath)
+    : m_socketPath(socketPath) {}
+
+ScillaWorkerClient::~ScillaWorkerClient() {
+  lock_guard<mutex> g(m_mutexIdle);
+  for (const auto& fd : m_idle) {
+    close(fd);
+  }
+  m_idle.clear();
+}
+
+ScillaWorkerClient& ScillaWorkerClient::GetInstance() {
+  static ScillaWorkerClient client(SCILLA_WORKER_SOCKET);
+  return client;
+}
+
+int ScillaWorkerClient::Connect() const {
+  struct sockaddr_un addr {};
+  if (m_socketPath.size() >= sizeof(addr.sun_path)) {
+    LOG_GENERAL(WARNING, "Socket path too long: " << m_socketPath);
+    return -1;
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    LOG_GENERAL(WARNING, "socket() failed: " << strerror(errno));
+    return -1;
+  }
+
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, m_socketPath.c_str(), sizeof(addr.sun_path) - 1);
+  if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    LOG_GENERAL(WARNING, "Cannot connect to scilla worker at "
+                             << m_socketPath << ": " << strerror(errno));
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+int ScillaWorkerClient::AcquireConnection(bool& reused) {
+  {
+    lock_guard<mutex> g(m_mutexIdle);
+    if (!m_idle.empty()) {
+      int fd = m_idle.back();
+      m_idle.pop_back();
+      reused = true;
+      return fd;
+    }
+  }
+
+  reused = false;
+  return Connect();
+}
+
+void ScillaWorkerClient::ReleaseConnection(int fd) {
+  lock_guard<mutex> g(m_mutexIdle);
+  if (m_idle.size() < MAX_IDLE_CONNECTIONS) {
+    m_idle.emplace_back(fd);
+  } else {
+    close(fd);
+  }
+}
+
+bool ScillaWorkerClient::Call(const string& request, string& response,
+                              int& fd) {
+  bool reused = false;
+  fd = AcquireConnection(reused);
+  if (fd < 0) {
+    return false;
+  }
+
+  // An idle connection may have been closed by a restarted worker, in which
+  // case the request is sent again over a new one
+  if (!WriteFrame(fd, request)) {
+    close(fd);
+    fd = -1;
+    if (!reused) {
+      LOG_GENERAL(WARNING, "Failed to send request to scilla worker");
+      return false;
+    }
+    fd = Connect();
+    if (fd < 0) {
+      return false;
+    }
+    if (!WriteFrame(fd, request)) {
+      LOG_GENERAL(WARNING, "Failed to send request to scilla worker");
+      close(fd);
+      fd = -1;
+      return false;
+    }
+  }
+
+  if (!ReadFrame(fd, response)) {
+    LOG_GENERAL(WARNING, "Failed to read response from scilla worker");
+    close(fd);
+    fd = -1;
+    return false;
+  }
+
+  ReleaseConnection(fd);
+  fd = -1;
+  return true;
+}
+
+void ScillaWorkerClient::Abort(int fd) {
+  if (fd >= 0) {
+    shutdown(fd, SHUT_RDWR);
+  }
+}
+
+bool ScillaWorkerClient::WriteFrame(int fd, const string& payload) {
+  if (payload.size() > MAX_FRAME_SIZE) {
+    LOG_GENERAL(WARNING, "Frame too large: " << payload.size());
+    return false;
+  }
+
+  const uint32_t len = payload.size();
+  const char header[4] = {(char)(len >> 24), (char)(len >> 16),
+                          (char)(len >> 8), (char)len};
+
+  return WriteAll(fd, header, sizeof(header)) &&
+         WriteAll(fd, payload.data(), payload.size());
+}
+
+bool ScillaWorkerClient::ReadFrame(int fd, string& payload) {
+  unsigned char header[4];
+  if (!ReadAll(fd, (char*)header, sizeof(header))) {
+    return false;
+  }
+
+  const uint32_t len = ((uint32_t)header[0] << 24) |
+                       ((uint32_t)header[1] << 16) |
+                       ((uint32_t)header[2] << 8) | (uint32_t)header[3];
+  if (len > MAX_FRAME_SIZE) {
+    LOG_GENERAL(WARNING, "Frame too large: " << len);
+    return false;
+  }
+
+  payload.resize(len);
+  return len == 0 || ReadAll(fd, &payload[0], len);
+}
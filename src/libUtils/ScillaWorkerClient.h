@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_SCILLAWORKERCLIENT_H_
+#define ZILLIQA_SRC_LIBUTILS_SCILLAWORKERCLIENT_H_
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Client for a long-lived scilla interpreter worker, such as the scillaworker
+/// tool (see ScillaWorker).
+///
+/// The worker listens on a Unix domain socket and serves one request at a time
+/// per connection. Requests and responses are frames made of a 4-byte
+/// big-endian payload length followed by the payload. Connections are kept
+/// open and reused across calls, and a client disconnecting during a request
+/// aborts it.
+///
+/// A request is a JSON object with:
+///  - "command": "check" for scilla-checker, "run" for scilla-runner
+///  - "root": the scilla root directory of the contract's scilla version
+///  - "args": the interpreter arguments other than the input files, e.g.
+///    -libdir, -gaslimit and -jsonerrors
+///  - "code" and "code_hash": the contract source and its hash, which lets the
+///    worker skip reloading code it already has
+///  - "init", "blockchain", and for a call "state" and "message": the JSON
+///    otherwise exported to INIT_JSON, INPUT_BLOCKCHAIN_JSON,
+///    INPUT_STATE_JSON and INPUT_MESSAGE_JSON
+///
+/// The response is what the runner would have written to OUTPUT_JSON, or the
+/// interpreter's printout when there is no such output, as for the checker.
+class ScillaWorkerClient {
+  const std::string m_socketPath;
+
+  std::mutex m_mutexIdle;
+  std::vector<int> m_idle;
+
+  static const unsigned int MAX_IDLE_CONNECTIONS = 4;
+  static const uint32_t MAX_FRAME_SIZE = 64 * 1024 * 1024;
+
+  int Connect() const;
+  int AcquireConnection(bool& reused);
+  void ReleaseConnection(int fd);
+
+  // Singleton should not implement these
+  ScillaWorkerClient(ScillaWorkerClient const&) = delete;
+  void operator=(ScillaWorkerClient const&) = delete;
+
+ public:
+  explicit ScillaWorkerClient(const std::string& socketPath);
+  ~ScillaWorkerClient();
+
+  /// Returns the client connected to SCILLA_WORKER_SOCKET.
+  static ScillaWorkerClient& GetInstance();
+
+  /// Sends the request and waits for the response. fd is set to the
+  /// connection in use as soon as it is known, so that another thread can
+  /// interrupt the call with Abort.
+  bool Call(const std::string& request, std::string& response, int& fd);
+
+  /// Interrupts an ongoing Call on the connection. The worker is expected to
+  /// drop the job once its peer disconnects.
+  static void Abort(int fd);
+
+  /// Frame helpers, shared with the worker side.
+  static bool WriteFrame(int fd, const std::string& payload);
+  static bool ReadFrame(int fd, std::string& payload);
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_SCILLAWORKERCLIENT_H_
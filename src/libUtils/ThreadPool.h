@@ -18,80 +18,170 @@
 #ifndef ZILLIQA_SRC_LIBUTILS_THREADPOOL_H_
 #define ZILLIQA_SRC_LIBUTILS_THREADPOOL_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
-
-/**
- *  Set to 1 to use vector instead of queue for jobs container to improve
- *  memory locality however changes job order from FIFO to LIFO.
- */
-#define CONTIGUOUS_JOBS_MEMORY 0
-#if CONTIGUOUS_JOBS_MEMORY
+#include <type_traits>
+#include <utility>
 #include <vector>
-#else
-#include <queue>
-#endif
+
+#include "libUtils/Logger.h"
 
 /**
- * Simple thread pool that creates `threadCount` threads upon its creation, and
- * pulls from a queue to get new jobs. This class requires a number of C++11
- * features be present in your compiler.
+ * Work-stealing thread pool that creates `threadCount` threads upon its
+ * creation. Jobs added by a worker go to the worker's own deque, which it
+ * takes from newest first; jobs added by other threads go to a shared queue.
+ * Idle workers steal the oldest job of another worker's deque without
+ * taking a lock, and sleep only when there is no job anywhere.
  */
 class ThreadPool {
  public:
   typedef std::function<void()> Job;
 
+  /// Counters of the pool since it was created.
+  struct Stats {
+    /// Jobs added but not yet taken by a worker
+    size_t m_queued;
+    uint64_t m_completed;
+    /// Jobs taken from the deque of another worker
+    uint64_t m_stolen;
+    /// Mean time from adding a job to a worker taking it
+    uint64_t m_averageWaitMicros;
+  };
+
   /// Constructor.
-#if CONTIGUOUS_JOBS_MEMORY
-  explicit ThreadPool(const unsigned int threadCount,
-                      const std::string& poolName,
-                      const unsigned int jobsReserveCount = 0)
-#else
   explicit ThreadPool(const unsigned int threadCount,
                       const std::string& poolName)
-#endif
-      : _jobsLeft(0),
-        _bailout(false),
-        _poolName(poolName),
-        _jobAvailableVar(),
-        _jobsLeftMutex(),
-        _queueMutex() {
-    _threads.reserve(threadCount);
+      : m_poolName(poolName) {
+    m_deques.reserve(threadCount);
     for (unsigned int index = 0; index < threadCount; ++index) {
-      _threads.push_back(std::thread([this] { this->Task(); }));
+      m_deques.emplace_back(new WorkStealingDeque());
     }
-
-#if CONTIGUOUS_JOBS_MEMORY
-    if (jobsReserveCount > 0) {
-      _queue.reserve(jobsReserveCount);
+    m_threads.reserve(threadCount);
+    for (unsigned int index = 0; index < threadCount; ++index) {
+      m_threads.push_back(std::thread([this, index] { this->Work(index); }));
     }
-#endif
   }
 
-  /// Destructor (JoinAll on deconstruction).
-  ~ThreadPool() { JoinAll(); }
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
 
-  /// Adds a new job to the pool. If there are no jobs in the queue, a thread is
-  /// woken up to take the job. If all threads are busy, the job is added to the
-  /// end of the queue.
+  /// Destructor (JoinAll on deconstruction). Jobs not yet taken are dropped.
+  ~ThreadPool() {
+    JoinAll();
+    for (auto& deque : m_deques) {
+      while (Task* task = deque->Pop()) {
+        delete task;
+      }
+    }
+    for (Task* task : m_shared) {
+      delete task;
+    }
+  }
+
+  /// Adds a new job to the pool, waking up a sleeping thread if there is one.
   void AddJob(const Job& job) {
-    std::lock(_queueMutex, _jobsLeftMutex);
-    std::lock_guard<std::mutex> lg1(_queueMutex, std::adopt_lock);
-    std::lock_guard<std::mutex> lg2(_jobsLeftMutex, std::adopt_lock);
+    Push(new Task{job, std::chrono::steady_clock::now()});
+    Wake(1);
+  }
+
+  /// Adds a new job to the pool and returns the future of its result.
+  template <class F>
+  std::future<typename std::result_of<F()>::type> Submit(F&& f) {
+    using Result = typename std::result_of<F()>::type;
+    auto task =
+        std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+    std::future<Result> result = task->get_future();
+    AddJob([task]() { (*task)(); });
+    return result;
+  }
 
-#if CONTIGUOUS_JOBS_MEMORY
-    _queue.push_back(job);
-#else
-    _queue.push(job);
-#endif
-    ++_jobsLeft;
-    _jobAvailableVar.notify_one();
+  /// Adds many jobs at once, waking up as many threads as needed.
+  void BulkSubmit(const std::vector<Job>& jobs) {
+    const auto now = std::chrono::steady_clock::now();
+    const Worker& self = CurrentWorker();
+    if (self.m_pool == this) {
+      for (const auto& job : jobs) {
+        Push(new Task{job, now});
+      }
+    } else {
+      std::lock_guard<std::mutex> g(m_sharedMutex);
+      for (const auto& job : jobs) {
+        m_shared.push_back(new Task{job, now});
+      }
+      m_pending += jobs.size();
+    }
+    Wake(jobs.size());
+  }
 
-    if (0 == _jobsLeft % 100) {
-      LOG_GENERAL(INFO, "PoolName: " << _poolName << " JobLeft: " << _jobsLeft);
+  /// Calls body on consecutive ranges of at most grain items that together
+  /// cover [begin, end), and returns when all of them are done. The calling
+  /// thread takes ranges too, so it may be a worker of this pool.
+  void ParallelFor(size_t begin, size_t end, size_t grain,
+                   const std::function<void(size_t, size_t)>& body) {
+    if (begin >= end) {
+      return;
     }
+    grain = std::max<size_t>(grain, 1);
+    const size_t numRanges = (end - begin + grain - 1) / grain;
+    if (numRanges == 1 || m_threads.empty()) {
+      body(begin, end);
+      return;
+    }
+
+    // Helpers may start after the caller has returned, so the state they
+    // share with it is reference counted
+    struct Range {
+      std::function<void(size_t, size_t)> m_body;
+      std::atomic<size_t> m_next{0};
+      size_t m_done{0};
+      std::mutex m_mutex;
+      std::condition_variable m_cvDone;
+    };
+    auto state = std::make_shared<Range>();
+    state->m_body = body;
+
+    auto run = [state, begin, end, grain, numRanges]() {
+      size_t index;
+      size_t done = 0;
+      while ((index = state->m_next++) < numRanges) {
+        const size_t from = begin + index * grain;
+        state->m_body(from, std::min(from + grain, end));
+        done++;
+      }
+      if (done > 0) {
+        std::lock_guard<std::mutex> g(state->m_mutex);
+        state->m_done += done;
+        if (state->m_done == numRanges) {
+          state->m_cvDone.notify_all();
+        }
+      }
+    };
+
+    const size_t numHelpers = std::min(m_threads.size(), numRanges - 1);
+    BulkSubmit(std::vector<Job>(numHelpers, run));
+    run();
+
+    std::unique_lock<std::mutex> lock(state->m_mutex);
+    state->m_cvDone.wait(
+        lock, [&state, numRanges] { return state->m_done == numRanges; });
+  }
+
+  /// Returns the counters of the pool.
+  Stats GetStats() const {
+    const uint64_t completed = m_completed;
+    const uint64_t taken = m_taken;
+    return {static_cast<size_t>(std::max<int64_t>(m_pending, 0)), completed,
+            m_stolen, taken == 0 ? 0 : m_totalWaitMicros / taken};
   }
 
   /// Joins with all threads. Blocks until all threads have completed. The queue
@@ -100,18 +190,18 @@ class ThreadPool {
   void JoinAll() {
     // scoped lock
     {
-      std::lock_guard<std::mutex> lock(_queueMutex);
-      if (_bailout) {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+      if (m_bailout) {
         return;
       }
-      _bailout = true;
+      m_bailout = true;
     }
 
     // note that we're done, and wake up any thread that's
     // waiting for a new job
-    _jobAvailableVar.notify_all();
+    m_jobAvailableVar.notify_all();
 
-    for (std::thread& thread : _threads) {
+    for (std::thread& thread : m_threads) {
       try {
         if (thread.joinable()) {
           thread.join();
@@ -126,67 +216,183 @@ class ThreadPool {
 
   /// Gets the vector of threads themselves, in order to set the affinity, or
   /// anything else you might want to do
-  std::vector<std::thread>& GetThreads() { return _threads; }
+  std::vector<std::thread>& GetThreads() { return m_threads; }
 
  private:
-  /**
-   *  Take the next job in the queue and run it.
-   *  Notify the main thread that a job has completed.
-   */
-  void Task() {
-    while (true) {
-      Job job;
+  struct Task {
+    Job m_job;
+    std::chrono::steady_clock::time_point m_queuedAt;
+  };
 
-      // scoped lock
-      {
-        std::unique_lock<std::mutex> lock(_queueMutex);
+  /// Fixed-size Chase-Lev deque. Only the owning worker pushes and pops, at
+  /// the bottom; any thread may steal from the top.
+  class WorkStealingDeque {
+    static const int64_t CAPACITY = 4096;
+    std::atomic<int64_t> m_top{0};
+    std::atomic<int64_t> m_bottom{0};
+    std::atomic<Task*> m_tasks[CAPACITY];
 
-        if (_bailout) {
-          return;
-        }
+   public:
+    WorkStealingDeque() {
+      for (auto& task : m_tasks) {
+        task.store(nullptr, std::memory_order_relaxed);
+      }
+    }
 
-        // Wait for a job if we don't have any.
-        _jobAvailableVar.wait(lock,
-                              [this] { return !_queue.empty() || _bailout; });
+    /// Returns false if the deque is full.
+    bool Push(Task* task) {
+      const int64_t b = m_bottom.load(std::memory_order_relaxed);
+      const int64_t t = m_top.load(std::memory_order_acquire);
+      if (b - t >= CAPACITY) {
+        return false;
+      }
+      m_tasks[b % CAPACITY].store(task, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      m_bottom.store(b + 1, std::memory_order_relaxed);
+      return true;
+    }
 
-        if (_bailout) {
-          return;
+    Task* Pop() {
+      const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+      m_bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t t = m_top.load(std::memory_order_relaxed);
+      Task* task = nullptr;
+      if (t <= b) {
+        task = m_tasks[b % CAPACITY].load(std::memory_order_relaxed);
+        if (t == b) {
+          // Last task: race the thieves for it
+          if (!m_top.compare_exchange_strong(t, t + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+            task = nullptr;
+          }
+          m_bottom.store(b + 1, std::memory_order_relaxed);
         }
+      } else {
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+      }
+      return task;
+    }
 
-        // Get job from the queue
-#if CONTIGUOUS_JOBS_MEMORY
-        job = _queue.back();
-        _queue.pop_back();
-#else
-        job = _queue.front();
-        _queue.pop();
-#endif
+    Task* Steal() {
+      int64_t t = m_top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const int64_t b = m_bottom.load(std::memory_order_acquire);
+      if (t >= b) {
+        return nullptr;
+      }
+      Task* task = m_tasks[t % CAPACITY].load(std::memory_order_relaxed);
+      if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+        return nullptr;
       }
+      return task;
+    }
+  };
+
+  struct Worker {
+    const ThreadPool* m_pool;
+    size_t m_index;
+  };
+
+  static Worker& CurrentWorker() {
+    static thread_local Worker worker{nullptr, 0};
+    return worker;
+  }
+
+  std::string m_poolName;
+  std::vector<std::unique_ptr<WorkStealingDeque>> m_deques;
+  std::vector<std::thread> m_threads;
+
+  /// Jobs added by threads outside the pool, or that did not fit a deque
+  std::deque<Task*> m_shared;
+  std::mutex m_sharedMutex;
+
+  std::atomic<int64_t> m_pending{0};
+  std::atomic<unsigned int> m_idle{0};
+  std::atomic<bool> m_bailout{false};
+  std::mutex m_sleepMutex;
+  std::condition_variable m_jobAvailableVar;
+
+  std::atomic<uint64_t> m_completed{0};
+  std::atomic<uint64_t> m_taken{0};
+  std::atomic<uint64_t> m_stolen{0};
+  std::atomic<uint64_t> m_totalWaitMicros{0};
 
-      job();
+  void Push(Task* task) {
+    const Worker& self = CurrentWorker();
+    if (self.m_pool != this || !m_deques[self.m_index]->Push(task)) {
+      std::lock_guard<std::mutex> g(m_sharedMutex);
+      m_shared.push_back(task);
+    }
+    ++m_pending;
+  }
+
+  /// Wakes up to count sleeping threads. A thread about to sleep counts
+  /// itself idle before its last look at m_pending, so either it sees the
+  /// new jobs or it is woken here.
+  void Wake(size_t count) {
+    if (m_idle == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+    if (count == 1) {
+      m_jobAvailableVar.notify_one();
+    } else {
+      m_jobAvailableVar.notify_all();
+    }
+  }
 
-      // scoped lock
-      {
-        std::lock_guard<std::mutex> lock(_jobsLeftMutex);
-        --_jobsLeft;
+  Task* Take(size_t index) {
+    Task* task = m_deques[index]->Pop();
+    if (task == nullptr) {
+      std::lock_guard<std::mutex> g(m_sharedMutex);
+      if (!m_shared.empty()) {
+        task = m_shared.front();
+        m_shared.pop_front();
+      }
+    }
+    for (size_t i = 1; task == nullptr && i < m_deques.size(); i++) {
+      task = m_deques[(index + i) % m_deques.size()]->Steal();
+      if (task != nullptr) {
+        ++m_stolen;
       }
     }
+    if (task != nullptr) {
+      --m_pending;
+    }
+    return task;
   }
 
-  std::vector<std::thread> _threads;
-#if CONTIGUOUS_JOBS_MEMORY
-  std::vector<Job> _queue;
-#else
-  std::queue<Job> _queue;
-#endif
-
-  int _jobsLeft;
-  bool _bailout;
-  std::string _poolName;
-  std::condition_variable _jobAvailableVar;
-  std::mutex _jobsLeftMutex;
-  std::mutex _queueMutex;
+  /**
+   *  Take the next job from the deques or the shared queue and run it, or
+   *  sleep until there is one.
+   */
+  void Work(size_t index) {
+    CurrentWorker() = {this, index};
+
+    while (!m_bailout) {
+      Task* task = Take(index);
+      if (task == nullptr) {
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        ++m_idle;
+        m_jobAvailableVar.wait(lock,
+                               [this] { return m_bailout || m_pending > 0; });
+        --m_idle;
+        continue;
+      }
+
+      m_totalWaitMicros +=
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - task->m_queuedAt)
+              .count();
+      ++m_taken;
+      task->m_job();
+      delete task;
+      ++m_completed;
+    }
+  }
 };
 
-#undef CONTIGUOUS_JOBS_MEMORY
 #endif  // ZILLIQA_SRC_LIBUTILS_THREADPOOL_H_
@@ -40,18 +40,23 @@ bool Validator::VerifyTransaction(const Transaction& tran) const {
                                        tran.GetSenderPubKey());
 }
 
-bool Validator::CheckCreatedTransaction(const Transaction& tx,
-                                        TransactionReceipt& receipt) const {
-  if (LOOKUP_NODE_MODE) {
-    LOG_GENERAL(WARNING,
-                "Validator::CheckCreatedTransaction not expected to be "
-                "called from LookUp node.");
-    return true;
+bool Validator::VerifyTransactions(const vector<Transaction>& txns,
+                                   vector<bool>& results) const {
+  vector<bytes> txnsData(txns.size());
+  vector<Schnorr::VerifyItem> items;
+  items.reserve(txns.size());
+
+  for (unsigned int i = 0; i < txns.size(); i++) {
+    txns.at(i).SerializeCoreFields(txnsData.at(i), 0);
+    items.push_back({&txnsData.at(i), 0, (unsigned int)txnsData.at(i).size(),
+                     &txns.at(i).GetSignature(),
+                     &txns.at(i).GetSenderPubKey()});
   }
-  // LOG_MARKER();
 
-  // LOG_GENERAL(INFO, "Tran: " << tx.GetTranID());
+  return Schnorr::GetInstance().VerifyBatch(items, results);
+}
 
+bool Validator::PreCheckCreatedTransaction(const Transaction& tx) const {
   if (DataConversion::UnpackA(tx.GetVersion()) != CHAIN_ID) {
     LOG_GENERAL(WARNING, "CHAIN_ID incorrect");
     return false;
@@ -84,6 +89,25 @@ bool Validator::CheckCreatedTransaction(const Transaction& tx,
     return false;
   }
 
+  return true;
+}
+
+bool Validator::CheckCreatedTransaction(const Transaction& tx,
+                                        TransactionReceipt& receipt) const {
+  if (LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING,
+                "Validator::CheckCreatedTransaction not expected to be "
+                "called from LookUp node.");
+    return true;
+  }
+  // LOG_MARKER();
+
+  // LOG_GENERAL(INFO, "Tran: " << tx.GetTranID());
+
+  if (!PreCheckCreatedTransaction(tx)) {
+    return false;
+  }
+
   receipt.SetEpochNum(m_mediator.m_currentEpochNum);
 
   return AccountStore::GetInstance().UpdateAccountsTemp(
@@ -91,7 +115,30 @@ bool Validator::CheckCreatedTransaction(const Transaction& tx,
       m_mediator.m_ds->m_mode != DirectoryService::Mode::IDLE, tx, receipt);
 }
 
-bool Validator::CheckCreatedTransactionFromLookup(const Transaction& tx) {
+void Validator::CheckCreatedPayments(const vector<Transaction>& txns,
+                                     PaymentBatch& batch) const {
+  if (LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING,
+                "Validator::CheckCreatedPayments not expected to be "
+                "called from LookUp node.");
+    return;
+  }
+
+  vector<unsigned char> eligible(txns.size(), 0);
+  batch.receipts.assign(txns.size(), TransactionReceipt());
+
+  for (unsigned int i = 0; i < txns.size(); i++) {
+    if (PreCheckCreatedTransaction(txns.at(i))) {
+      eligible.at(i) = 1;
+      batch.receipts.at(i).SetEpochNum(m_mediator.m_currentEpochNum);
+    }
+  }
+
+  AccountStore::GetInstance().ExecutePaymentsTemp(txns, eligible, batch);
+}
+
+bool Validator::CheckCreatedTransactionFromLookup(const Transaction& tx,
+                                                  bool verifySignature) {
   if (LOOKUP_NODE_MODE) {
     LOG_GENERAL(WARNING,
                 "Validator::CheckCreatedTransactionFromLookup not expected "
@@ -164,7 +211,7 @@ bool Validator::CheckCreatedTransactionFromLookup(const Transaction& tx) {
     return false;
   }
 
-  if (!VerifyTransaction(tx)) {
+  if (verifySignature && !VerifyTransaction(tx)) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
               "Signature incorrect: " << fromAddr << ". Transaction rejected: "
                                       << tx.GetTranID());
@@ -208,11 +255,11 @@ bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
     return false;
   }
 
-  // Generate the aggregated key
   vector<PubKey> keys;
+  keys.reserve(B2.size());
   for (auto const& kv : commKeys) {
+    keys.emplace_back(get<PubKey>(kv));
     if (B2.at(index)) {
-      keys.emplace_back(get<PubKey>(kv));
       count++;
     }
     index++;
@@ -223,7 +270,9 @@ bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
     return false;
   }
 
-  shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
+  // Generate the aggregated key
+  shared_ptr<PubKey> aggregatedKey =
+      MultiSig::GetInstance().AggregateCommitteeKeys(keys, B2);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
     return false;
@@ -239,8 +288,10 @@ bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
                                               serializedHeader.size(),
                                               block.GetCS2(), *aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed");
-    for (auto& kv : keys) {
-      LOG_GENERAL(WARNING, kv);
+    for (unsigned int i = 0; i < keys.size(); i++) {
+      if (B2.at(i)) {
+        LOG_GENERAL(WARNING, keys.at(i));
+      }
     }
     return false;
   }
@@ -257,8 +308,7 @@ bool Validator::CheckDirBlocks(
 
   bool ret = true;
 
-  uint64_t prevdsblocknum =
-      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  uint64_t prevdsblocknum = m_mediator.m_dsBlockChain.GetLastBlockNum();
   uint64_t totalIndex = index_num;
   ShardingHash prevShardingHash =
       m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetShardingHash();
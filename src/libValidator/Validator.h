@@ -20,6 +20,7 @@
 
 #include <boost/variant.hpp>
 #include <string>
+#include "libData/AccountData/AccountStore.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountData/TransactionReceipt.h"
 #include "libData/BlockChainData/BlockLinkChain.h"
@@ -38,10 +39,21 @@ class ValidatorBase {
   /// Verifies the transaction w.r.t given pubKey and signature
   virtual bool VerifyTransaction(const Transaction& tran) const = 0;
 
+  /// Verifies the signatures of a batch of transactions in parallel
+  virtual bool VerifyTransactions(const std::vector<Transaction>& txns,
+                                  std::vector<bool>& results) const = 0;
+
   virtual bool CheckCreatedTransaction(const Transaction& tx,
                                        TransactionReceipt& receipt) const = 0;
 
-  virtual bool CheckCreatedTransactionFromLookup(const Transaction& tx) = 0;
+  /// Checks and runs a batch of payment txns without applying them
+  virtual void CheckCreatedPayments(const std::vector<Transaction>& txns,
+                                    PaymentBatch& batch) const = 0;
+
+  /// Set verifySignature to false only if the signature was already checked,
+  /// e.g. through VerifyTransactions
+  virtual bool CheckCreatedTransactionFromLookup(const Transaction& tx,
+                                                 bool verifySignature) = 0;
 
   virtual bool CheckDirBlocks(
       const std::vector<boost::variant<
@@ -60,10 +72,19 @@ class Validator : public ValidatorBase {
   std::string name() const override { return "Validator"; }
   bool VerifyTransaction(const Transaction& tran) const override;
 
+  bool VerifyTransactions(const std::vector<Transaction>& txns,
+                          std::vector<bool>& results) const override;
+
   bool CheckCreatedTransaction(const Transaction& tx,
                                TransactionReceipt& receipt) const override;
 
-  bool CheckCreatedTransactionFromLookup(const Transaction& tx) override;
+  /// Gives the same results as CheckCreatedTransaction applied to each txn in
+  /// turn. The effects are applied with AccountStore::CommitPaymentsTemp.
+  void CheckCreatedPayments(const std::vector<Transaction>& txns,
+                            PaymentBatch& batch) const override;
+
+  bool CheckCreatedTransactionFromLookup(const Transaction& tx,
+                                         bool verifySignature) override;
 
   template <class Container, class DirectoryBlock>
   bool CheckBlockCosignature(const DirectoryBlock& block,
@@ -79,6 +100,10 @@ class Validator : public ValidatorBase {
                                      const DequeOfNode& dsComm,
                                      const BlockLink& latestBlockLink) override;
   Mediator& m_mediator;
+
+ private:
+  /// Checks of CheckCreatedTransaction that do not depend on the temp states
+  bool PreCheckCreatedTransaction(const Transaction& tx) const;
 };
 
 #endif  // ZILLIQA_SRC_LIBVALIDATOR_VALIDATOR_H_
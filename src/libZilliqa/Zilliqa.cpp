@@ -20,6 +20,7 @@
 #include "Zilliqa.h"
 #include "common/Constants.h"
 #include "common/MessageNames.h"
+#include "common/Messages.h"
 #include "common/Serializable.h"
 #include "depends/safeserver/safehttpserver.h"
 #include "depends/safeserver/safetcpsocketserver.h"
@@ -36,6 +37,19 @@
 using namespace std;
 using namespace jsonrpc;
 
+namespace {
+
+vector<PriorityDispatcher<pair<bytes, Peer>*>::Class> MessageClasses() {
+  vector<PriorityDispatcher<pair<bytes, Peer>*>::Class> classes;
+  for (unsigned int i = 0; i < NUM_MESSAGE_PRIORITIES; i++) {
+    classes.push_back({MESSAGE_PRIORITY_NAMES[i], MESSAGE_PRIORITY_WEIGHTS[i],
+                       MSGQUEUE_SIZE});
+  }
+  return classes;
+}
+
+}  // namespace
+
 void Zilliqa::LogSelfNodeInfo(const PairOfKey& key, const Peer& peer) {
   bytes tmp1;
   bytes tmp2;
@@ -135,26 +149,11 @@ Zilliqa::Zilliqa(const PairOfKey& key, const Peer& peer, SyncType syncType,
       m_ds(m_mediator),
       m_lookup(m_mediator, syncType),
       m_n(m_mediator, syncType, toRetrieveHistory),
-      m_msgQueue(MSGQUEUE_SIZE)
-
-{
+      m_msgDispatcher(
+          "MsgDispatcher", MessageClasses(), MAXMESSAGE,
+          [this](pair<bytes, Peer>*& message) { ProcessMessage(message); }) {
   LOG_MARKER();
 
-  // Launch the thread that reads messages from the queue
-  auto funcCheckMsgQueue = [this]() mutable -> void {
-    pair<bytes, Peer>* message = NULL;
-    while (true) {
-      while (m_msgQueue.pop(message)) {
-        // For now, we use a thread pool to handle this message
-        // Eventually processing will be single-threaded
-        m_queuePool.AddJob(
-            [this, message]() mutable -> void { ProcessMessage(message); });
-      }
-      std::this_thread::sleep_for(std::chrono::microseconds(1));
-    }
-  };
-  DetachedFunction(1, funcCheckMsgQueue);
-
   m_validator = make_shared<Validator>(m_mediator);
 
   m_mediator.RegisterColleagues(&m_ds, &m_n, &m_lookup, m_validator.get());
@@ -363,8 +362,7 @@ Zilliqa::Zilliqa(const PairOfKey& key, const Peer& peer, SyncType syncType,
 }
 
 Zilliqa::~Zilliqa() {
-  pair<bytes, Peer>* message = NULL;
-  while (m_msgQueue.pop(message)) {
+  for (auto message : m_msgDispatcher.Stop()) {
     delete message;
   }
 }
@@ -372,8 +370,14 @@ Zilliqa::~Zilliqa() {
 void Zilliqa::Dispatch(pair<bytes, Peer>* message) {
   // LOG_MARKER();
 
+  MessagePriority priority = PRIORITY_SYNC;
+  if (message->first.size() >= MessageOffset::BODY) {
+    priority = GetMessagePriority(message->first.at(MessageOffset::TYPE),
+                                  message->first.at(MessageOffset::INST));
+  }
+
   // Queue message
-  if (!m_msgQueue.bounded_push(message)) {
-    LOG_GENERAL(WARNING, "Input MsgQueue is full");
+  if (!m_msgDispatcher.Push(priority, move(message))) {
+    delete message;
   }
 }
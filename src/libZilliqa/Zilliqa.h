@@ -27,7 +27,7 @@
 #include "libNode/Node.h"
 #include "libServer/LookupServer.h"
 #include "libServer/StatusServer.h"
-#include "libUtils/ThreadPool.h"
+#include "libUtils/PriorityDispatcher.h"
 
 /// Main Zilliqa class.
 class Zilliqa {
@@ -38,14 +38,14 @@ class Zilliqa {
   Node m_n;
   // ConsensusUser m_cu; // Note: This is just a test class to demo Consensus
   // usage
-  boost::lockfree::queue<std::pair<bytes, Peer>*> m_msgQueue;
 
   std::unique_ptr<StatusServer> m_statusServer;
   std::shared_ptr<LookupServer> m_lookupServer;
   std::unique_ptr<jsonrpc::AbstractServerConnector> m_statusServerConnector;
   std::unique_ptr<jsonrpc::AbstractServerConnector> m_lookupServerConnector;
 
-  ThreadPool m_queuePool{MAXMESSAGE, "QueuePool"};
+  /// Hands incoming messages to the workers, by message class
+  PriorityDispatcher<std::pair<bytes, Peer>*> m_msgDispatcher;
 
   void ProcessMessage(std::pair<bytes, Peer>* message);
 
@@ -168,7 +168,7 @@ BOOST_AUTO_TEST_CASE(test_serialization) {
   }
 
   /// Check PrintPoint function
-  schnorr.PrintPoint(aggregatedPubkey->m_P.get());
+  schnorr.PrintPoint(aggregatedPubkey->GetPoint().get());
 
   /// Check CommitSecret operator =
   CommitSecret dummy_secret;
@@ -236,4 +236,66 @@ BOOST_AUTO_TEST_CASE(test_serialization) {
                       "Signature verification (wrong message) failed");
 }
 
+/**
+ * \brief test_committee_keys
+ *
+ * \details Test aggregation of committee keys selected by a bitmap
+ */
+BOOST_AUTO_TEST_CASE(test_committee_keys) {
+  INIT_STDOUT_LOGGER();
+
+  Schnorr& schnorr = Schnorr::GetInstance();
+  MultiSig& multisig = MultiSig::GetInstance();
+
+  const unsigned int committeeSize = 60;
+  vector<PubKey> committee;
+  for (unsigned int i = 0; i < committeeSize; i++) {
+    committee.emplace_back(schnorr.GenKeyPair().second);
+  }
+
+  auto checkBitmap = [&committee, &multisig](const vector<bool>& bitmap) {
+    vector<PubKey> signers;
+    for (unsigned int i = 0; i < committee.size(); i++) {
+      if (bitmap.at(i)) {
+        signers.emplace_back(committee.at(i));
+      }
+    }
+    shared_ptr<PubKey> expected = MultiSig::AggregatePubKeys(signers);
+    shared_ptr<PubKey> aggregated =
+        multisig.AggregateCommitteeKeys(committee, bitmap);
+    BOOST_REQUIRE(expected != nullptr);
+    BOOST_REQUIRE(aggregated != nullptr);
+    BOOST_CHECK_EQUAL(*aggregated, *expected);
+  };
+
+  /// Most members signed, derived from the full-committee aggregate
+  vector<bool> bitmap(committeeSize, true);
+  for (unsigned int i = 0; i < committeeSize; i += 3) {
+    bitmap.at(i) = false;
+  }
+  checkBitmap(bitmap);
+  /// Second call is served from the cache
+  checkBitmap(bitmap);
+
+  /// Everyone signed
+  checkBitmap(vector<bool>(committeeSize, true));
+
+  /// Few members signed, summed directly
+  vector<bool> fewSigners(committeeSize, false);
+  fewSigners.at(1) = fewSigners.at(7) = fewSigners.at(42) = true;
+  checkBitmap(fewSigners);
+
+  /// A different committee must not reuse the cached aggregate
+  committee.at(0) = schnorr.GenKeyPair().second;
+  checkBitmap(bitmap);
+  bitmap.at(0) = true;
+  checkBitmap(bitmap);
+
+  BOOST_CHECK(multisig.AggregateCommitteeKeys(
+                  committee, vector<bool>(committeeSize, false)) == nullptr);
+  BOOST_CHECK(multisig.AggregateCommitteeKeys(
+                  committee, vector<bool>(committeeSize - 1, true)) ==
+              nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -16,6 +16,7 @@
  */
 
 #include <cstring>
+#include <thread>
 #include "libCrypto/Schnorr.h"
 #include "libUtils/Logger.h"
 #include "libUtils/TimeUtils.h"
@@ -117,8 +118,8 @@ BOOST_AUTO_TEST_CASE(test_keys) {
                    keypair.first.m_d.get(), NULL, NULL, NULL) != 0,
       "Key generation check #3 failed");
   BOOST_CHECK_MESSAGE(
-      EC_POINT_cmp(schnorr.GetCurve().m_group.get(), keypair.second.m_P.get(),
-                   P.get(), NULL) == 0,
+      EC_POINT_cmp(schnorr.GetCurve().m_group.get(),
+                   keypair.second.GetPoint().get(), P.get(), NULL) == 0,
       "Key generation check #4 failed");
 }
 
@@ -303,6 +304,73 @@ BOOST_AUTO_TEST_CASE(test_serialization) {
   BOOST_CHECK(!SignatureOutput.is_empty(false));
 }
 
+/**
+ * \brief test_verify_batch
+ *
+ * \details Test batch verification and concurrent single verification
+ */
+BOOST_AUTO_TEST_CASE(test_verify_batch) {
+  Schnorr& schnorr = Schnorr::GetInstance();
+
+  const unsigned int num_signatures = 200;
+  const unsigned int bad_index = 137;
+
+  vector<PairOfKey> keypairs;
+  vector<bytes> messages;
+  vector<Signature> signatures(num_signatures);
+  for (unsigned int i = 0; i < num_signatures; i++) {
+    keypairs.emplace_back(schnorr.GenKeyPair());
+    messages.emplace_back(bytes(256));
+    generate(messages.back().begin(), messages.back().end(), std::rand);
+    BOOST_CHECK_MESSAGE(schnorr.Sign(messages.back(), keypairs.back().first,
+                                     keypairs.back().second, signatures.at(i)),
+                        "Signing failed");
+  }
+
+  vector<Schnorr::VerifyItem> items;
+  for (unsigned int i = 0; i < num_signatures; i++) {
+    items.push_back({&messages.at(i), 0, (unsigned int)messages.at(i).size(),
+                     &signatures.at(i), &keypairs.at(i).second});
+  }
+
+  vector<bool> results;
+  auto t = r_timer_start();
+  BOOST_CHECK_MESSAGE(schnorr.VerifyBatch(items, results),
+                      "Batch verification of valid signatures failed");
+  LOG_GENERAL(INFO, "VerifyBatch " << num_signatures
+                                   << " sigs (usec) = " << r_timer_end(t));
+  BOOST_CHECK_EQUAL(results.size(), num_signatures);
+
+  /// Tamper with one message and check that only it is reported
+  messages.at(bad_index).at(0) ^= 0xFF;
+  BOOST_CHECK_MESSAGE(!schnorr.VerifyBatch(items, results),
+                      "Batch verification accepted a bad signature");
+  for (unsigned int i = 0; i < num_signatures; i++) {
+    BOOST_CHECK_MESSAGE(results.at(i) == (i != bad_index),
+                        "Wrong batch result at index " << i);
+  }
+
+  /// Verify from several threads at once without any external locking
+  vector<thread> threads;
+  vector<unsigned char> verified(num_signatures, 0);
+  const unsigned int num_threads = 4;
+  for (unsigned int n = 0; n < num_threads; n++) {
+    threads.emplace_back([&, n]() {
+      for (unsigned int i = n; i < num_signatures; i += num_threads) {
+        verified.at(i) = schnorr.Verify(messages.at(i), signatures.at(i),
+                                        keypairs.at(i).second);
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  for (unsigned int i = 0; i < num_signatures; i++) {
+    BOOST_CHECK_MESSAGE((verified.at(i) != 0) == (i != bad_index),
+                        "Wrong concurrent result at index " << i);
+  }
+}
+
 /**
  * \brief test_error_deserialization_pubkey
  *
@@ -316,6 +384,63 @@ BOOST_AUTO_TEST_CASE(test_error_deserialization_pubkey) {
                       "Expected: -1 Obtained: " << returnValue);
 }
 
+/**
+ * \brief test_pubkey_compact
+ *
+ * \details Test that keys compare by their encoding and decode lazily
+ */
+BOOST_AUTO_TEST_CASE(test_pubkey_compact) {
+  Schnorr& schnorr = Schnorr::GetInstance();
+
+  /// Keys order by their serialized form
+  vector<PubKey> pubkeys;
+  for (unsigned int i = 0; i < 100; i++) {
+    pubkeys.emplace_back(schnorr.GenKeyPair().second);
+  }
+  sort(pubkeys.begin(), pubkeys.end());
+  for (unsigned int i = 1; i < pubkeys.size(); i++) {
+    bytes lhs, rhs;
+    pubkeys.at(i - 1).Serialize(lhs, 0);
+    pubkeys.at(i).Serialize(rhs, 0);
+    BOOST_CHECK_MESSAGE(lhs <= rhs, "PubKey order differs from encoding");
+  }
+
+  /// A deserialized copy decodes to the same point and verifies
+  PairOfKey keypair = schnorr.GenKeyPair();
+  bytes message(256), pubkey_bytes;
+  generate(message.begin(), message.end(), std::rand);
+  Signature signature;
+  BOOST_CHECK(schnorr.Sign(message, keypair.first, keypair.second, signature));
+  keypair.second.Serialize(pubkey_bytes, 0);
+  PubKey pubkey(pubkey_bytes, 0);
+  PubKey pubkeyCopy(pubkey);
+  BOOST_CHECK(pubkeyCopy == keypair.second);
+  BOOST_CHECK(hash<PubKey>()(pubkeyCopy) == hash<PubKey>()(keypair.second));
+  BOOST_CHECK_MESSAGE(
+      EC_POINT_cmp(schnorr.GetCurve().m_group.get(), pubkey.GetPoint().get(),
+                   keypair.second.GetPoint().get(), NULL) == 0,
+      "Decoded point differs");
+  BOOST_CHECK(schnorr.Verify(message, signature, pubkeyCopy));
+
+  /// The default key is the point at infinity, and cannot verify
+  PubKey infinity;
+  BOOST_CHECK(EC_POINT_is_at_infinity(schnorr.GetCurve().m_group.get(),
+                                      infinity.GetPoint().get()));
+  BOOST_CHECK(!schnorr.Verify(message, signature, infinity));
+
+  /// Only the compressed form is accepted
+  bytes bad_bytes(pubkey_bytes);
+  bad_bytes.at(0) = 0x04;
+  BOOST_CHECK(pubkey.Deserialize(bad_bytes, 0) == -1);
+
+  /// An x with no point on the curve deserializes but does not verify
+  bytes off_curve(PUB_KEY_SIZE, 0xFF);
+  off_curve.at(0) = 0x02;
+  BOOST_CHECK(pubkey.Deserialize(off_curve, 0) == 0);
+  BOOST_CHECK(pubkey.GetPoint() == nullptr);
+  BOOST_CHECK(!schnorr.Verify(message, signature, pubkey));
+}
+
 /**
  * \brief test_error_deserialization_privkey
  *
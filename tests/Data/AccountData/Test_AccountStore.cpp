@@ -15,8 +15,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <array>
+#include <map>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #define BOOST_TEST_MODULE accountstoretest
 #define BOOST_TEST_DYN_LINK
@@ -633,6 +637,116 @@ BOOST_AUTO_TEST_CASE(serializeAndDeserialize) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(serializeAndAddStateChunks) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  AccountStore::GetInstance().Init();
+
+  const unsigned int numAccounts = 30;
+  std::map<Address, Account> accounts;
+  for (unsigned int i = 0; i < numAccounts; i++) {
+    PubKey pubKey = Schnorr::GetInstance().GenKeyPair().second;
+    Address address = Account::GetAddressFromPublicKey(pubKey);
+    Account account(i + 1, i);
+    accounts.emplace(address, account);
+    AccountStore::GetInstance().AddAccount(address, account);
+  }
+  AccountStore::GetInstance().UpdateStateTrieAll();
+  BOOST_CHECK(AccountStore::GetInstance().MoveUpdatesToDisk());
+  const StateHash root = AccountStore::GetInstance().GetStateRootHash();
+
+  // Two ranges split at 0x80..., the second one open ended
+  Address middle;
+  middle.asArray()[0] = 0x80;
+  const std::vector<std::pair<Address, Address>> ranges = {{Address(), middle},
+                                                 {middle, Address()}};
+
+  const unsigned int chunkSize = 7;
+  std::vector<std::tuple<Address, Address, bytes>> chunks;
+  for (const auto& range : ranges) {
+    Address start = range.first;
+    Address next;
+    do {
+      bytes chunk;
+      bool stale = true;
+      BOOST_REQUIRE(AccountStore::GetInstance().SerializeStateChunk(
+          root, start, range.second, chunkSize, chunk, next, stale));
+      BOOST_CHECK(!stale);
+      chunks.emplace_back(start, next, chunk);
+      start = next;
+    } while (next != range.second);
+  }
+  BOOST_CHECK_GE(chunks.size(), numAccounts / chunkSize);
+
+  dev::h256 digest;
+  BOOST_REQUIRE(AccountStore::GetInstance().GetStateRangeDigest(
+      root, ranges[0].first, ranges[0].second, digest));
+
+  // Roots that were never committed cannot be served and are reported stale
+  bytes chunk;
+  Address next;
+  bool stale = false;
+  BOOST_CHECK(!AccountStore::GetInstance().SerializeStateChunk(
+      dev::h256(), Address(), Address(), chunkSize, chunk, next, stale));
+  BOOST_CHECK(stale);
+  dev::h256 unknownDigest;
+  BOOST_CHECK(!AccountStore::GetInstance().GetStateRangeDigest(
+      dev::h256(), Address(), Address(), unknownDigest));
+
+  AccountStore::GetInstance().Init();
+
+  // A chunk has to stay within its range
+  const auto& last = chunks.back();
+  BOOST_CHECK(!AccountStore::GetInstance().AddStateChunk(
+      std::get<2>(last), 0, Address(), std::get<0>(last)));
+
+  // Chunks can be added in any order
+  for (auto it = chunks.rbegin(); it != chunks.rend(); ++it) {
+    BOOST_REQUIRE(AccountStore::GetInstance().AddStateChunk(
+        std::get<2>(*it), 0, std::get<0>(*it), std::get<1>(*it)));
+  }
+
+  BOOST_CHECK_MESSAGE(AccountStore::GetInstance().GetStateRootHash() == root,
+                      "State root didn't match after adding state chunks");
+  for (const auto& entry : accounts) {
+    BOOST_CHECK_EQUAL(AccountStore::GetInstance().GetBalance(entry.first),
+                      entry.second.GetBalance());
+    BOOST_CHECK_EQUAL(AccountStore::GetInstance().GetNonce(entry.first),
+                      entry.second.GetNonce());
+  }
+
+  // A synced range has the same digest as the one it was served from
+  dev::h256 syncedDigest;
+  BOOST_REQUIRE(AccountStore::GetInstance().GetStateRangeDigest(
+      root, ranges[0].first, ranges[0].second, syncedDigest));
+  BOOST_CHECK(syncedDigest == digest);
+
+  // A removed range changes the digest and can be fetched again
+  BOOST_REQUIRE(AccountStore::GetInstance().RemoveStateRange(ranges[0].first,
+                                                             ranges[0].second));
+  const StateHash removedRoot = AccountStore::GetInstance().GetStateRootHash();
+  BOOST_CHECK(removedRoot != root);
+  BOOST_REQUIRE(AccountStore::GetInstance().GetStateRangeDigest(
+      removedRoot, ranges[0].first, ranges[0].second, syncedDigest));
+  BOOST_CHECK(syncedDigest != digest);
+  for (const auto& entry : accounts) {
+    if (entry.first < middle) {
+      BOOST_CHECK(!AccountStore::GetInstance().IsAccountExist(entry.first));
+    }
+  }
+
+  for (const auto& c : chunks) {
+    if (std::get<0>(c) < middle) {
+      BOOST_REQUIRE(AccountStore::GetInstance().AddStateChunk(
+          std::get<2>(c), 0, std::get<0>(c), std::get<1>(c)));
+    }
+  }
+  BOOST_CHECK_MESSAGE(AccountStore::GetInstance().GetStateRootHash() == root,
+                      "State root didn't match after fetching range again");
+}
+
 BOOST_AUTO_TEST_CASE(stateDelta) {
   INIT_STDOUT_LOGGER();
 
@@ -754,6 +868,71 @@ BOOST_AUTO_TEST_CASE(commitRevertible) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(parallelPayments) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  AccountStore::GetInstance().Init();
+
+  const unsigned int numSenders = 50;
+  std::vector<PairOfKey> senders;
+  for (unsigned int i = 0; i < numSenders; i++) {
+    senders.emplace_back(Schnorr::GetInstance().GenKeyPair());
+    AccountStore::GetInstance().AddAccount(
+        Account::GetAddressFromPublicKey(senders.back().second),
+        {1000000, 0});
+  }
+
+  // Payments within pairs of senders, to a new account per pair, and some
+  // that run out of balance
+  std::vector<Transaction> txns;
+  std::vector<uint64_t> nonces(numSenders, 0);
+  for (unsigned int i = 0; i < 300; i++) {
+    const unsigned int from = (i * 7) % numSenders;
+    const Address toAddr =
+        (i % 11 == 0) ? Address(from / 2 + 1)
+                      : Account::GetAddressFromPublicKey(
+                            senders.at(from ^ 1).second);
+    const uint128_t amount = (i % 17 == 0) ? 900000 : i;
+    txns.emplace_back(DataConversion::Pack(CHAIN_ID, 1), ++nonces.at(from),
+                      toAddr, senders.at(from), amount, 1, NORMAL_TRAN_GAS,
+                      bytes(), bytes());
+  }
+
+  AccountStore::GetInstance().InitTemp();
+  std::vector<bool> results;
+  std::vector<TransactionReceipt> receipts(txns.size());
+  for (unsigned int i = 0; i < txns.size(); i++) {
+    results.emplace_back(AccountStore::GetInstance().UpdateAccountsTemp(
+        1, 1, false, txns.at(i), receipts.at(i)));
+  }
+  BOOST_REQUIRE(AccountStore::GetInstance().SerializeDelta());
+  const StateHash sequentialHash =
+      AccountStore::GetInstance().GetStateDeltaHash();
+  BOOST_CHECK(std::find(results.begin(), results.end(), false) !=
+              results.end());
+
+  AccountStore::GetInstance().InitTemp();
+  PaymentBatch batch;
+  batch.receipts.assign(txns.size(), TransactionReceipt());
+  AccountStore::GetInstance().ExecutePaymentsTemp(
+      txns, std::vector<unsigned char>(txns.size(), 1), batch);
+  AccountStore::GetInstance().CommitPaymentsTemp(batch, txns.size());
+  BOOST_REQUIRE(AccountStore::GetInstance().SerializeDelta());
+
+  for (unsigned int i = 0; i < txns.size(); i++) {
+    BOOST_CHECK_EQUAL(results.at(i), (bool)batch.applied.at(i));
+    BOOST_CHECK_EQUAL(receipts.at(i).GetString(),
+                      batch.receipts.at(i).GetString());
+  }
+  BOOST_CHECK_MESSAGE(
+      AccountStore::GetInstance().GetStateDeltaHash() == sequentialHash,
+      "StateDeltaHash of the batch doesn't match sequential execution");
+
+  AccountStore::GetInstance().InitTemp();
+}
+
 BOOST_AUTO_TEST_CASE(commitRevertible2) {
   INIT_STDOUT_LOGGER();
 
@@ -789,6 +968,43 @@ BOOST_AUTO_TEST_CASE(commitRevertible2) {
                       "StateRootHash didn't revert");
 }
 
+BOOST_AUTO_TEST_CASE(accountCacheAcrossCommits) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  AccountStore::GetInstance().Init();
+
+  PubKey pubKey1 = Schnorr::GetInstance().GenKeyPair().second;
+  Address address1 = Account::GetAddressFromPublicKey(pubKey1);
+  AccountStore::GetInstance().AddAccount(address1, {100, 1});
+  AccountStore::GetInstance().UpdateStateTrieAll();
+  AccountStore::GetInstance().MoveUpdatesToDisk();
+
+  // Every epoch reads the account back after the commit and updates it
+  for (unsigned int i = 1; i <= 3; i++) {
+    BOOST_CHECK_EQUAL(AccountStore::GetInstance().GetBalance(address1),
+                      100 + i - 1);
+    AccountStore::GetInstance().IncreaseBalance(address1, 1);
+    AccountStore::GetInstance().UpdateStateTrieAll();
+    AccountStore::GetInstance().MoveUpdatesToDisk();
+    BOOST_CHECK_EQUAL(AccountStore::GetInstance().GetBalance(address1),
+                      100 + i);
+  }
+
+  // An update that is discarded must not be served afterwards
+  AccountStore::GetInstance().IncreaseBalance(address1, 50);
+  AccountStore::GetInstance().UpdateStateTrieAll();
+  AccountStore::GetInstance().DiscardUnsavedUpdates();
+  BOOST_CHECK_EQUAL(AccountStore::GetInstance().GetBalance(address1), 103);
+
+  // Nor an account of a state that has been reset
+  AccountStore::GetInstance().InitSoft();
+  BOOST_CHECK_EQUAL(AccountStore::GetInstance().GetBalance(address1), 0);
+  BOOST_CHECK(AccountStore::GetInstance().RetrieveFromDisk());
+  BOOST_CHECK_EQUAL(AccountStore::GetInstance().GetBalance(address1), 103);
+}
+
 BOOST_AUTO_TEST_CASE(DiskOperation) {
   INIT_STDOUT_LOGGER();
 
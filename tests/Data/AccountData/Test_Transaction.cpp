@@ -15,6 +15,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <array>
 #include <string>
 #include <vector>
@@ -175,6 +176,53 @@ BOOST_AUTO_TEST_CASE(test1) {
                       "Signature not converted properly");
 }
 
+BOOST_AUTO_TEST_CASE(test_verify_transactions_mixed) {
+  INIT_STDOUT_LOGGER();
+  LOG_MARKER();
+
+  Mediator* m = nullptr;
+  unique_ptr<ValidatorBase> validator = make_unique<Validator>(*m);
+
+  // Enough txns for the batch to be split across the verification workers
+  const unsigned int numTxns = 8 * Schnorr::VERIFY_BATCH_MIN_PER_JOB;
+  Address toAddr;
+  vector<Transaction> txns;
+  vector<bool> expected;
+  for (unsigned int i = 0; i < numTxns; i++) {
+    PairOfKey sender = TestUtils::GenerateRandomKeyPair();
+    Transaction tx(DataConversion::Pack(CHAIN_ID, 1), i + 1, toAddr, sender, 55,
+                   PRECISION_MIN_VALUE, 22, {}, {});
+    const bool valid = i % 3 != 0;
+    if (!valid) {
+      // Signed by the right key, but over other data
+      tx.SetSignature(TestUtils::GetSignature(
+          TestUtils::GenerateRandomCharVector(TestUtils::Dist1to99()),
+          sender));
+    }
+    txns.emplace_back(tx);
+    expected.emplace_back(valid);
+  }
+
+  vector<bool> results;
+  BOOST_CHECK(!validator->VerifyTransactions(txns, results));
+  BOOST_REQUIRE_EQUAL(results.size(), numTxns);
+  for (unsigned int i = 0; i < numTxns; i++) {
+    BOOST_CHECK_MESSAGE(results.at(i) == expected.at(i),
+                        "Wrong result for txn " << i);
+    BOOST_CHECK_EQUAL(results.at(i), validator->VerifyTransaction(txns.at(i)));
+  }
+
+  vector<Transaction> validTxns;
+  for (unsigned int i = 0; i < numTxns; i++) {
+    if (expected.at(i)) {
+      validTxns.emplace_back(txns.at(i));
+    }
+  }
+  BOOST_CHECK(validator->VerifyTransactions(validTxns, results));
+  BOOST_CHECK_EQUAL(results.size(), validTxns.size());
+  BOOST_CHECK(all_of(results.begin(), results.end(), [](bool r) { return r; }));
+}
+
 BOOST_AUTO_TEST_CASE(testOperators) {
   INIT_STDOUT_LOGGER();
   LOG_MARKER();
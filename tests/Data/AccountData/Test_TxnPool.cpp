@@ -15,6 +15,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <array>
 #include <map>
 #include <string>
@@ -146,8 +147,8 @@ BOOST_AUTO_TEST_CASE(txnpool) {
     uint128_t gasprice = transaction_v[i].GetGasPrice();
     if (gasprice < gasprice + 1) {
       transactionHigherGas = createTransaction(
-          gasprice + 1, transaction_v[i].GetTranID(),
-          transaction_v[i].GetSenderPubKey(), transaction_v[i].GetNonce());
+          gasprice + 1, TxnHash().random(), transaction_v[i].GetSenderPubKey(),
+          transaction_v[i].GetNonce());
       break;
     }
     ++i;
@@ -155,22 +156,162 @@ BOOST_AUTO_TEST_CASE(txnpool) {
   BOOST_CHECK_EQUAL(true, tp.insert(transactionHigherGas));
 
   // ============================================================
-  // Test if findSameNonceButHigherGas returns same Transaction but with higher
-  // gas
+  // Check that the higher gas Transaction replaced the one with the same nonce
   // ============================================================
-  Transaction transactionLoverGas_test = transaction_v[i];
-  tp.findSameNonceButHigherGas(transactionLoverGas_test);
-  BOOST_CHECK_EQUAL(true, transactionHigherGas == transactionLoverGas_test);
+  BOOST_CHECK_EQUAL(transaction_v.size(), tp.size());
+  BOOST_CHECK_EQUAL(false, tp.exist(transaction_v[i].GetTranID()));
+  Transaction transactionHigherGas_test;
+  BOOST_CHECK_EQUAL(true, tp.get(transactionHigherGas.GetTranID(),
+                                 transactionHigherGas_test));
+  BOOST_CHECK_EQUAL(true, transactionHigherGas == transactionHigherGas_test);
 
   // ============================================================
-  // Try to find all the transactions
+  // Check that a lower gas Transaction with the same nonce is ignored
   // ============================================================
-  Transaction transactionTest;
-  uint size = tp.size();
-  for (uint i = 0; i < size; i++) {
-    BOOST_CHECK_EQUAL(true, tp.findOne(transactionTest));
+  const Transaction transactionLowerGas = createTransaction(
+      0, TxnHash().random(), transaction_v[i].GetSenderPubKey(),
+      transaction_v[i].GetNonce());
+  BOOST_CHECK_EQUAL(true, tp.insert(transactionLowerGas));
+  BOOST_CHECK_EQUAL(false, tp.exist(transactionLowerGas.GetTranID()));
+  BOOST_CHECK_EQUAL(transaction_v.size(), tp.size());
+}
+
+BOOST_AUTO_TEST_CASE(txnpool_nonce_order) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  TestUtils::Initialize();
+
+  TxnPool tp;
+
+  const PubKey senderA = TestUtils::GenerateRandomPubKey();
+  const PubKey senderB = TestUtils::GenerateRandomPubKey();
+
+  // Sender A: nonces 1..3 with increasing gas, plus a gap at nonce 5
+  // Sender B: nonce 1 with a gas price between A's first and second
+  const Transaction a1 = createTransaction(10, TxnHash().random(), senderA, 1);
+  const Transaction a2 = createTransaction(30, TxnHash().random(), senderA, 2);
+  const Transaction a3 = createTransaction(40, TxnHash().random(), senderA, 3);
+  const Transaction a5 = createTransaction(50, TxnHash().random(), senderA, 5);
+  const Transaction b1 = createTransaction(20, TxnHash().random(), senderB, 1);
+  const Transaction stale =
+      createTransaction(100, TxnHash().random(), senderB, 0);
+
+  for (const auto& t : {a3, a5, a1, b1, a2, stale}) {
+    BOOST_CHECK_EQUAL(true, tp.insert(t));
   }
-  BOOST_CHECK_EQUAL(false, tp.findOne(transactionTest));
+  BOOST_CHECK_EQUAL(6, tp.size());
+
+  std::map<Address, uint128_t> nonces;
+  tp.prepareReady(
+      [&nonces](const Address& addr) -> uint128_t { return nonces[addr]; });
+
+  // Stale nonce is dropped, nonce gap stays in the pool
+  BOOST_CHECK_EQUAL(false, tp.exist(stale.GetTranID()));
+
+  std::vector<TxnHash> order;
+  Transaction t;
+  while (tp.popReady(t)) {
+    order.emplace_back(t.GetTranID());
+    const Address sender = t.GetSenderAddr();
+    nonces[sender] = t.GetNonce();
+    tp.updateSender(sender, nonces[sender]);
+  }
+
+  const std::vector<TxnHash> expected = {b1.GetTranID(), a1.GetTranID(),
+                                         a2.GetTranID(), a3.GetTranID()};
+  BOOST_CHECK_EQUAL(true, order == expected);
+
+  BOOST_CHECK_EQUAL(1, tp.size());
+  const std::vector<TxnHash> nonceHigh = tp.getNonceHighTxns();
+  BOOST_CHECK_EQUAL(1, nonceHigh.size());
+  BOOST_CHECK_EQUAL(true, nonceHigh.front() == a5.GetTranID());
+}
+
+BOOST_AUTO_TEST_CASE(txnpool_held_back_sender) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  TestUtils::Initialize();
+
+  TxnPool tp;
+
+  const PubKey sender = TestUtils::GenerateRandomPubKey();
+  const Transaction t1 = createTransaction(10, TxnHash().random(), sender, 1);
+  const Transaction t2 = createTransaction(10, TxnHash().random(), sender, 2);
+  const Transaction t3 = createTransaction(10, TxnHash().random(), sender, 3);
+  for (const auto& t : {t1, t2, t3}) {
+    BOOST_CHECK_EQUAL(true, tp.insert(t));
+  }
+
+  tp.prepareReady([](const Address&) -> uint128_t { return 0; });
+
+  // The head is taken out but not applied, e.g. for exceeding the gas limit
+  Transaction t;
+  BOOST_CHECK_EQUAL(true, tp.popReady(t));
+  BOOST_CHECK_EQUAL(true, t == t1);
+  tp.updateSender(t.GetSenderAddr(), 0);
+
+  BOOST_CHECK_EQUAL(false, tp.popReady(t));
+  std::vector<TxnHash> nonceHigh = tp.getNonceHighTxns();
+  std::sort(nonceHigh.begin(), nonceHigh.end());
+  std::vector<TxnHash> expected = {t2.GetTranID(), t3.GetTranID()};
+  std::sort(expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(true, nonceHigh == expected);
+}
+
+BOOST_AUTO_TEST_CASE(txnpool_reinsert_after_partial_commit) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  TestUtils::Initialize();
+
+  TxnPool tp;
+
+  // The nonce gap at 5 keeps the sender's queue alive while 1..3 are out
+  const PubKey sender = TestUtils::GenerateRandomPubKey();
+  const Transaction t1 = createTransaction(10, TxnHash().random(), sender, 1);
+  const Transaction t2 = createTransaction(10, TxnHash().random(), sender, 2);
+  const Transaction t3 = createTransaction(10, TxnHash().random(), sender, 3);
+  const Transaction t5 = createTransaction(10, TxnHash().random(), sender, 5);
+  for (const auto& t : {t1, t2, t3, t5}) {
+    BOOST_CHECK_EQUAL(true, tp.insert(t));
+  }
+
+  tp.prepareReady([](const Address&) -> uint128_t { return 0; });
+
+  // Pick 1..3 ahead of applying them, as a payment batch does
+  std::vector<Transaction> picked;
+  Transaction t;
+  while (tp.popReady(t)) {
+    picked.emplace_back(t);
+    tp.updateSender(t.GetSenderAddr(), t.GetNonce());
+  }
+  BOOST_CHECK_EQUAL(3, picked.size());
+  BOOST_CHECK_EQUAL(1, tp.size());
+
+  // Only the first one is committed, the others go back
+  const std::vector<Transaction> unused(picked.begin() + 1, picked.end());
+  tp.reinsert(unused, [](const Address&) -> uint128_t { return 1; });
+  BOOST_CHECK_EQUAL(3, tp.size());
+  BOOST_CHECK_EQUAL(true, tp.exist(t2.GetTranID()));
+  BOOST_CHECK_EQUAL(true, tp.exist(t3.GetTranID()));
+
+  BOOST_CHECK_EQUAL(true, tp.popReady(t));
+  BOOST_CHECK_EQUAL(true, t == t2);
+
+  // A sender whose queue was released comes back as well
+  TxnPool single;
+  BOOST_CHECK_EQUAL(true, single.insert(t1));
+  single.prepareReady([](const Address&) -> uint128_t { return 0; });
+  BOOST_CHECK_EQUAL(true, single.popReady(t));
+  single.updateSender(t.GetSenderAddr(), t.GetNonce());
+  single.reinsert({t1}, [](const Address&) -> uint128_t { return 0; });
+  BOOST_CHECK_EQUAL(true, single.popReady(t));
+  BOOST_CHECK_EQUAL(true, t == t1);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -174,6 +174,13 @@ void test_BlockChain(T1& blockChain, T2& block_0, T2& block_1, T2& block_last,
   BOOST_CHECK_MESSAGE(
       blockChain.GetLastBlock() == block_last,
       "GetLastBlock returned block different from block added last.\n");
+  BOOST_CHECK_MESSAGE(
+      blockChain.GetLastBlockNum() == block_last.GetHeader().GetBlockNum(),
+      "GetLastBlockNum returned number different from block added last.\n");
+  BOOST_CHECK_MESSAGE(
+      blockChain.GetLastBlockPtr() ==
+          blockChain.GetBlockPtr(block_last.GetHeader().GetBlockNum()),
+      "GetLastBlockPtr returned handle different from the stored one.\n");
 }
 
 BOOST_AUTO_TEST_CASE(DSBlockChain_test) {
@@ -203,6 +210,31 @@ BOOST_AUTO_TEST_CASE(DSBlockChain_test) {
   test_BlockChain(dsbc, dsb_0, dsb_1, lastBlock, dsb_empty);
 }
 
+BOOST_AUTO_TEST_CASE(BlockChain_SharedHandles_test) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  DSBlockChain dsbc;
+  BOOST_CHECK_MESSAGE(dsbc.GetLastBlockNum() == INIT_BLOCK_NUMBER,
+                      "Empty DSBlockChain has a last block number.\n");
+
+  auto block = make_shared<const DSBlock>(TestUtils::createDSBlockHeader(0),
+                                          CoSignatures());
+  BOOST_CHECK_MESSAGE(dsbc.AddBlock(block) == 1, "Unable to add block.\n");
+  BOOST_CHECK_MESSAGE(dsbc.GetBlockPtr(0) == block,
+                      "Added block handle was copied instead of shared.\n");
+  BOOST_CHECK_MESSAGE(dsbc.GetLastBlockPtr() == block,
+                      "Last block handle was copied instead of shared.\n");
+  BOOST_CHECK_MESSAGE(dsbc.GetLastBlockNum() == 0,
+                      "Incorrect last block number after adding block 0.\n");
+
+  dsbc.Reset();
+  BOOST_CHECK_MESSAGE(dsbc.GetLastBlockNum() == INIT_BLOCK_NUMBER &&
+                          *dsbc.GetLastBlockPtr() == DSBlock(),
+                      "Reset DSBlockChain still has a last block.\n");
+}
+
 BOOST_AUTO_TEST_CASE(TxBlockChain_test) {
   INIT_STDOUT_LOGGER();
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libData/DataStructures/ShardedLRUCache.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE shardedlrucachetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(shardedlrucachetest)
+
+BOOST_AUTO_TEST_CASE(test_eviction) {
+  INIT_STDOUT_LOGGER();
+
+  // Single shard, so that eviction order is fully determined
+  ShardedLRUCache<int, string> cache(3, 1);
+  string value;
+
+  cache.Put(1, "one");
+  cache.Put(2, "two");
+  cache.Put(3, "three");
+  BOOST_CHECK_EQUAL(cache.Size(), 3);
+
+  // 1 becomes the most recently used, so 2 goes first
+  BOOST_REQUIRE(cache.Get(1, value));
+  BOOST_CHECK_EQUAL(value, "one");
+  cache.Put(4, "four");
+  BOOST_CHECK(!cache.Get(2, value));
+  BOOST_CHECK(cache.Get(1, value));
+  BOOST_CHECK(cache.Get(3, value));
+  BOOST_CHECK(cache.Get(4, value));
+  BOOST_CHECK_EQUAL(cache.Size(), 3);
+
+  // Replacing a value does not grow the cache
+  cache.Put(3, "THREE");
+  BOOST_REQUIRE(cache.Get(3, value));
+  BOOST_CHECK_EQUAL(value, "THREE");
+  BOOST_CHECK_EQUAL(cache.Size(), 3);
+
+  cache.Erase(3);
+  cache.Erase(5);
+  BOOST_CHECK(!cache.Get(3, value));
+  BOOST_CHECK_EQUAL(cache.Size(), 2);
+
+  cache.Clear();
+  BOOST_CHECK_EQUAL(cache.Size(), 0);
+  BOOST_CHECK(!cache.Get(1, value));
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_access) {
+  INIT_STDOUT_LOGGER();
+
+  const unsigned int capacity = 1000;
+  ShardedLRUCache<string, unsigned int> cache(capacity, 16);
+
+  vector<thread> threads;
+  atomic<unsigned int> mismatches{0};
+  for (unsigned int t = 0; t < 8; t++) {
+    threads.emplace_back([&cache, &mismatches, t]() {
+      for (unsigned int i = 0; i < 5000; i++) {
+        const unsigned int key = (i * 31 + t) % 2000;
+        unsigned int value = 0;
+        if (!cache.Get(to_string(key), value)) {
+          cache.Put(to_string(key), key);
+        } else if (value != key) {
+          mismatches++;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  BOOST_CHECK_EQUAL(mismatches.load(), 0);
+
+  // Each shard is bounded by its share of the capacity
+  BOOST_CHECK_LE(cache.Size(), capacity + 16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -246,6 +246,32 @@ BOOST_AUTO_TEST_CASE(test_SetAndGetFallbackBlock) {
   BOOST_CHECK(fallbackBlock == fallbackBlockDeserialized);
 }
 
+BOOST_AUTO_TEST_CASE(test_RejectOffCurvePubKey) {
+  // A compressed key in the right form whose x has no point on the curve
+  bytes offCurve(PUB_KEY_SIZE, 0xFF);
+  offCurve.at(0) = 0x02;
+  const PubKey badKey(offCurve, 0);
+  BOOST_REQUIRE(badKey.GetPoint() == nullptr);
+
+  const Transaction badTxn(DataConversion::Pack(CHAIN_ID, 1), 1, Address(),
+                           badKey, 1, 1, 1, {}, {},
+                           TestUtils::GenerateRandomSignature());
+  bytes dst;
+  BOOST_REQUIRE(Messenger::SetTransaction(dst, 0, badTxn));
+
+  Transaction txnDeserialized;
+  BOOST_CHECK(!Messenger::GetTransaction(dst, 0, txnDeserialized));
+
+  // The same transaction from a valid key goes through
+  const Transaction goodTxn(DataConversion::Pack(CHAIN_ID, 1), 1, Address(),
+                            TestUtils::GenerateRandomPubKey(), 1, 1, 1, {}, {},
+                            TestUtils::GenerateRandomSignature());
+  dst.clear();
+  BOOST_REQUIRE(Messenger::SetTransaction(dst, 0, goodTxn));
+  BOOST_CHECK(Messenger::GetTransaction(dst, 0, txnDeserialized));
+  BOOST_CHECK(txnDeserialized == goodTxn);
+}
+
 BOOST_AUTO_TEST_CASE(test_CopyWithSizeCheck) {
   bytes arr;
   dev::h256 result;
@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "libNetwork/PeerConnectionPool.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE peerconnectionpool
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+const uint32_t LISTEN_PORT = 35123;
+const uint32_t CLOSED_PORT = 35124;
+const unsigned int HDR_LEN = 6;
+
+bool ReadAll(int fd, unsigned char* data, size_t len) {
+  while (len > 0) {
+    ssize_t n = read(fd, data, len);
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+/// Stand-in for a peer: reads frames of a 6-byte header (the second byte
+/// being the value every payload byte is filled with) followed by the payload.
+/// With resetFirst, the first connection is reset after reading one header.
+class MockPeer {
+  int m_listenFd{-1};
+  thread m_acceptThread;
+  vector<thread> m_connThreads;
+  mutex m_mutexConnFds;
+  vector<int> m_connFds;
+
+  void Reset(unsigned int index) {
+    lock_guard<mutex> g(m_mutexConnFds);
+    struct linger lin {
+      1, 0
+    };
+    setsockopt(m_connFds.at(index), SOL_SOCKET, SO_LINGER, &lin, sizeof(lin));
+    close(m_connFds.at(index));
+    m_connFds.at(index) = -1;
+  }
+
+ public:
+  atomic<unsigned int> m_accepted{0};
+  atomic<unsigned int> m_frames{0};
+  atomic<unsigned int> m_badFrames{0};
+
+  explicit MockPeer(bool resetFirst = false) {
+    m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(LISTEN_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    BOOST_REQUIRE(bind(m_listenFd, (struct sockaddr*)&addr, sizeof(addr)) ==
+                  0);
+    BOOST_REQUIRE(listen(m_listenFd, 8) == 0);
+
+    m_acceptThread = thread([this, resetFirst]() {
+      while (true) {
+        int fd = accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+          return;
+        }
+        const unsigned int index = m_accepted++;
+        {
+          lock_guard<mutex> g(m_mutexConnFds);
+          m_connFds.emplace_back(fd);
+        }
+        m_connThreads.emplace_back([this, fd, index, resetFirst]() {
+          unsigned char header[HDR_LEN];
+          while (ReadAll(fd, header, HDR_LEN)) {
+            if (resetFirst && index == 0) {
+              // Let the sender fill up the socket before resetting it
+              this_thread::sleep_for(chrono::milliseconds(200));
+              Reset(index);
+              return;
+            }
+            const uint32_t len = (header[2] << 24) + (header[3] << 16) +
+                                 (header[4] << 8) + header[5];
+            vector<unsigned char> payload(len);
+            if (!ReadAll(fd, payload.data(), len)) {
+              return;
+            }
+            for (const auto& c : payload) {
+              if (c != header[1]) {
+                m_badFrames++;
+                break;
+              }
+            }
+            m_frames++;
+          }
+        });
+      }
+    });
+  }
+
+  ~MockPeer() {
+    shutdown(m_listenFd, SHUT_RDWR);
+    close(m_listenFd);
+    m_acceptThread.join();
+    {
+      lock_guard<mutex> g(m_mutexConnFds);
+      for (const auto& fd : m_connFds) {
+        if (fd >= 0) {
+          shutdown(fd, SHUT_RDWR);
+        }
+      }
+    }
+    for (auto& t : m_connThreads) {
+      t.join();
+    }
+    for (const auto& fd : m_connFds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(peerconnectionpool)
+
+BOOST_AUTO_TEST_CASE(test_concurrent_frames_share_connection) {
+  INIT_STDOUT_LOGGER();
+
+  MockPeer mockPeer;
+  PeerConnectionPool pool;
+  BOOST_REQUIRE(pool.Start());
+
+  const Peer peer(inet_addr("127.0.0.1"), LISTEN_PORT);
+  const unsigned int numThreads = 8;
+  const unsigned int numFrames = 100;
+
+  vector<thread> senders;
+  atomic<unsigned int> sent{0};
+  for (unsigned int t = 0; t < numThreads; t++) {
+    senders.emplace_back([&, t]() {
+      for (unsigned int i = 0; i < numFrames; i++) {
+        // Sizes large enough for frames to be flushed in several writes
+        const uint32_t len = 1000 + (i * 7919 + t) % 200000;
+        auto payload = make_shared<const bytes>(len, (unsigned char)t);
+        const bytes header = {1,
+                              (unsigned char)t,
+                              (unsigned char)(len >> 24),
+                              (unsigned char)(len >> 16),
+                              (unsigned char)(len >> 8),
+                              (unsigned char)len};
+        if (pool.Send(peer, header, payload, true)) {
+          sent++;
+        }
+      }
+    });
+  }
+  for (auto& t : senders) {
+    t.join();
+  }
+
+  for (unsigned int i = 0;
+       i < 200 && mockPeer.m_frames.load() < numThreads * numFrames; i++) {
+    this_thread::sleep_for(chrono::milliseconds(50));
+  }
+
+  BOOST_CHECK_EQUAL(sent.load(), numThreads * numFrames);
+  BOOST_CHECK_EQUAL(mockPeer.m_frames.load(), numThreads * numFrames);
+  BOOST_CHECK_EQUAL(mockPeer.m_badFrames.load(), 0);
+  BOOST_CHECK_EQUAL(mockPeer.m_accepted.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_payload) {
+  INIT_STDOUT_LOGGER();
+
+  MockPeer mockPeer;
+  PeerConnectionPool pool;
+  BOOST_REQUIRE(pool.Start());
+
+  const Peer peer(inet_addr("127.0.0.1"), LISTEN_PORT);
+  const uint32_t len = 4 * 1024 * 1024;
+  const auto payload = make_shared<const bytes>(len, 7);
+  const bytes header = {1,
+                        7,
+                        (unsigned char)(len >> 24),
+                        (unsigned char)(len >> 16),
+                        (unsigned char)(len >> 8),
+                        (unsigned char)len};
+
+  // Shared payloads are broadcasts, which are not requeued
+  for (unsigned int i = 0; i < 10; i++) {
+    BOOST_REQUIRE(pool.Send(peer, header, payload, false));
+  }
+
+  for (unsigned int i = 0; i < 200 && mockPeer.m_frames.load() < 10; i++) {
+    this_thread::sleep_for(chrono::milliseconds(50));
+  }
+
+  BOOST_CHECK_EQUAL(mockPeer.m_frames.load(), 10);
+  BOOST_CHECK_EQUAL(mockPeer.m_badFrames.load(), 0);
+
+  // Written out frames no longer hold on to the payload
+  BOOST_CHECK_EQUAL(payload.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_connect_failure) {
+  INIT_STDOUT_LOGGER();
+
+  PeerConnectionPool pool;
+
+  const bytes header(HDR_LEN, 0);
+  const auto payload = make_shared<const bytes>();
+  const Peer peer(inet_addr("127.0.0.1"), CLOSED_PORT);
+
+  // Not started yet
+  BOOST_CHECK(!pool.Send(peer, header, payload, true));
+
+  BOOST_REQUIRE(pool.Start());
+  BOOST_CHECK(!pool.Send(peer, header, payload, true));
+  BOOST_CHECK_EQUAL(errno, ECONNREFUSED);
+}
+
+BOOST_AUTO_TEST_CASE(test_requeue_after_reset) {
+  INIT_STDOUT_LOGGER();
+
+  MockPeer mockPeer(true);
+  PeerConnectionPool pool;
+  BOOST_REQUIRE(pool.Start());
+
+  // More than the socket buffers hold, so that frames are still queued in
+  // the pool when the peer resets the connection
+  const Peer peer(inet_addr("127.0.0.1"), LISTEN_PORT);
+  const unsigned int numFrames = 12;
+  const uint32_t len = 1024 * 1024;
+  for (unsigned int i = 0; i < numFrames; i++) {
+    auto payload = make_shared<const bytes>(len, (unsigned char)i);
+    const bytes header = {1,
+                          (unsigned char)i,
+                          (unsigned char)(len >> 24),
+                          (unsigned char)(len >> 16),
+                          (unsigned char)(len >> 8),
+                          (unsigned char)len};
+    BOOST_REQUIRE(pool.Send(peer, header, payload, true));
+  }
+
+  // The first connection never completes a frame, so every frame received
+  // was requeued on the second one
+  for (unsigned int i = 0; i < 200 && (mockPeer.m_accepted.load() < 2 ||
+                                       mockPeer.m_frames.load() == 0);
+       i++) {
+    this_thread::sleep_for(chrono::milliseconds(50));
+  }
+  this_thread::sleep_for(chrono::milliseconds(500));
+
+  BOOST_CHECK_EQUAL(mockPeer.m_accepted.load(), 2);
+  BOOST_CHECK_GT(mockPeer.m_frames.load(), 0);
+  BOOST_CHECK_LE(mockPeer.m_frames.load(), numFrames);
+  BOOST_CHECK_EQUAL(mockPeer.m_badFrames.load(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
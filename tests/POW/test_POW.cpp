@@ -417,6 +417,48 @@ BOOST_AUTO_TEST_CASE(mining_high_diffculty_time_out) {
   BOOST_REQUIRE(!verifyLight);
 }
 
+BOOST_AUTO_TEST_CASE(cpu_mining_hash_rate) {
+  if (REMOTE_MINE || GETWORK_SERVER_MINE || OPENCL_GPU_MINE || CUDA_GPU_MINE) {
+    std::cout << "CPU mining is not enabled, skip test case "
+                 "cpu_mining_hash_rate"
+              << std::endl;
+    return;
+  }
+
+  POW& POWClient = POW::GetInstance();
+  std::array<unsigned char, 32> rand1 = {{'0', '1'}};
+  std::array<unsigned char, 32> rand2 = {{'0', '2'}};
+  auto peer = TestUtils::GenerateRandomPeer();
+  auto keyPair = Schnorr::GetInstance().GenKeyPair();
+  auto pubKey = keyPair.second;
+
+  // Mine light at a difficulty that cannot be met, until the time window
+  uint8_t difficultyToUse = 50;
+  uint64_t blockToUse = 0;
+  int timeWindow = 3;
+  auto headerHash = POW::GenHeaderHash(rand1, rand2, peer, pubKey, 0, 0);
+  auto hashRate = [&](unsigned int numThreads) {
+    POWClient.SetCPUMiningThreads(numThreads);
+    ethash_mining_result_t winning_result =
+        POWClient.PoWMine(blockToUse, difficultyToUse, keyPair, headerHash,
+                          false, std::time(0), timeWindow);
+    BOOST_REQUIRE(!winning_result.success);
+    return POWClient.GetCPUHashRate();
+  };
+
+  const unsigned int numThreads =
+      std::max(std::thread::hardware_concurrency(), 1u);
+  const uint64_t singleThreadRate = hashRate(1);
+  const uint64_t multiThreadRate = hashRate(numThreads);
+  POWClient.SetCPUMiningThreads(CPU_MINING_THREADS);
+
+  std::cout << "Light mining hash rate with 1 thread: " << singleThreadRate
+            << " H/s, with " << numThreads << " threads: " << multiThreadRate
+            << " H/s" << std::endl;
+  BOOST_REQUIRE(singleThreadRate > 0);
+  BOOST_REQUIRE(multiThreadRate > 0);
+}
+
 // Please enable the OPENCL_GPU_MINE option in constants.xml to run this test
 // case
 BOOST_AUTO_TEST_CASE(gpu_mining_and_verification_1) {
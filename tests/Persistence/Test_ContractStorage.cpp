@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <vector>
+
+#include "common/Constants.h"
+#include "libPersistence/ContractStorage.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE contractstoragetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace Contract;
+
+BOOST_AUTO_TEST_SUITE(contractstoragetest)
+
+BOOST_AUTO_TEST_CASE(testCodeCache) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ContractStorage& cs = ContractStorage::GetContractStorage();
+
+  const dev::h256 codeHash = dev::h256::random();
+  const std::string code = "scilla_version 0\ncontract HelloWorld ()";
+  std::string out;
+
+  BOOST_CHECK(!cs.GetCachedCode(codeHash, out));
+  BOOST_CHECK(!cs.GetCachedCheckerOutput(codeHash, "/scilla/0", out));
+
+  cs.CacheCode(codeHash, code);
+  BOOST_CHECK(cs.GetCachedCode(codeHash, out));
+  BOOST_CHECK_EQUAL(out, code);
+
+  // Checker output is kept per interpreter version
+  cs.CacheCheckerOutput(codeHash, "/scilla/0", "{ \"v0\": true }");
+  BOOST_CHECK(cs.GetCachedCheckerOutput(codeHash, "/scilla/0", out));
+  BOOST_CHECK_EQUAL(out, "{ \"v0\": true }");
+  BOOST_CHECK(!cs.GetCachedCheckerOutput(codeHash, "/scilla/1", out));
+
+  // Caching the checker output keeps the code
+  BOOST_CHECK(cs.GetCachedCode(codeHash, out));
+  BOOST_CHECK_EQUAL(out, code);
+
+  // Other code hashes are not affected
+  BOOST_CHECK(!cs.GetCachedCode(dev::h256::random(), out));
+}
+
+BOOST_AUTO_TEST_CASE(testCodeCacheBounded) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ContractStorage& cs = ContractStorage::GetContractStorage();
+
+  std::vector<dev::h256> hashes;
+  for (unsigned int i = 0; i < CONTRACT_CODE_CACHE_SIZE + 10; i++) {
+    hashes.emplace_back(dev::h256::random());
+    cs.CacheCode(hashes.back(), std::to_string(i));
+  }
+
+  unsigned int cached = 0;
+  std::string out;
+  for (const auto& hash : hashes) {
+    if (cs.GetCachedCode(hash, out)) {
+      cached++;
+    }
+  }
+  BOOST_CHECK_EQUAL(cached, CONTRACT_CODE_CACHE_SIZE);
+
+  // The latest entry is always kept
+  BOOST_CHECK(cs.GetCachedCode(hashes.back(), out));
+  BOOST_CHECK_EQUAL(out, std::to_string(hashes.size() - 1));
+}
+
+BOOST_AUTO_TEST_CASE(testCodeCacheRecency) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ContractStorage& cs = ContractStorage::GetContractStorage();
+
+  std::vector<dev::h256> hashes;
+  for (unsigned int i = 0; i < CONTRACT_CODE_CACHE_SIZE; i++) {
+    hashes.emplace_back(dev::h256::random());
+    cs.CacheCode(hashes.back(), std::to_string(i));
+  }
+
+  // A hit makes the oldest entry the most recently used, so the next insert
+  // evicts the second oldest instead
+  std::string out;
+  BOOST_CHECK(cs.GetCachedCode(hashes.front(), out));
+  cs.CacheCheckerOutput(dev::h256::random(), "/scilla/0", "{}");
+
+  BOOST_CHECK(cs.GetCachedCode(hashes.front(), out));
+  BOOST_CHECK_EQUAL(out, "0");
+  if (CONTRACT_CODE_CACHE_SIZE > 1) {
+    BOOST_CHECK(!cs.GetCachedCode(hashes.at(1), out));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testExportedContract) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  ContractStorage& cs = ContractStorage::GetContractStorage();
+
+  const dev::h160 address = dev::h160::random();
+  const dev::h256 codeHash = dev::h256::random();
+  cs.SetExportedContract(address, codeHash);
+
+  dev::h160 outAddress;
+  dev::h256 outCodeHash;
+  cs.GetExportedContract(outAddress, outCodeHash);
+  BOOST_CHECK(outAddress == address);
+  BOOST_CHECK(outCodeHash == codeHash);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
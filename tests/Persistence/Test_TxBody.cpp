@@ -20,6 +20,7 @@
 #include <vector>
 #include "common/Constants.h"
 #include "libCrypto/Schnorr.h"
+#include "libData/AccountData/Account.h"
 #include "libData/AccountData/Address.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountData/TransactionReceipt.h"
@@ -169,4 +170,49 @@ BOOST_AUTO_TEST_CASE(testRandomBlockAccesses) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(testContractCreatorIndex) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+  if (LOOKUP_NODE_MODE) {
+    BlockStorage& bs = BlockStorage::GetBlockStorage();
+    BOOST_REQUIRE(bs.ResetDB(BlockStorage::CONTRACT_CREATOR));
+
+    Address creator1(1), creator2(2);
+    vector<Address> deployed;
+    // Nonces are stored in fixed width, so 300 sorts after 2
+    for (const auto& nonce : {300, 1, 2}) {
+      Address contract = Account::GetAddressForContract(creator1, nonce - 1);
+      BOOST_REQUIRE(bs.PutContractCreator(creator1, nonce, contract));
+    }
+    for (const auto& nonce : {1, 2, 300}) {
+      deployed.emplace_back(
+          Account::GetAddressForContract(creator1, nonce - 1));
+    }
+    BOOST_REQUIRE(bs.PutContractCreator(
+        creator2, 1, Account::GetAddressForContract(creator2, 0)));
+
+    vector<Address> contracts;
+    uint64_t total = 0;
+    BOOST_REQUIRE(bs.GetContractsByCreator(creator1, contracts, total));
+    BOOST_CHECK_EQUAL(total, 3);
+    BOOST_CHECK(contracts == deployed);
+
+    contracts.clear();
+    BOOST_REQUIRE(bs.GetContractsByCreator(creator1, contracts, total, 1, 1));
+    BOOST_CHECK_EQUAL(total, 3);
+    BOOST_REQUIRE_EQUAL(contracts.size(), 1);
+    BOOST_CHECK(contracts[0] == deployed[1]);
+
+    contracts.clear();
+    BOOST_REQUIRE(bs.GetContractsByCreator(creator2, contracts, total));
+    BOOST_CHECK_EQUAL(total, 1);
+
+    contracts.clear();
+    BOOST_REQUIRE(bs.GetContractsByCreator(Address(3), contracts, total));
+    BOOST_CHECK_EQUAL(total, 0);
+    BOOST_CHECK(contracts.empty());
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -16,6 +16,7 @@
  */
 
 #include <array>
+#include <list>
 #include <string>
 #include <thread>
 #include <vector>
@@ -183,6 +184,143 @@ BOOST_AUTO_TEST_CASE(testCachedAndEvictedBlocks) {
       "block number shouldn't change after writing to/ reading from disk");
 }
 
+BOOST_AUTO_TEST_CASE(testTxBlockRange) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  // Keys sort numerically, unlike the decimal strings they replaced
+  BOOST_CHECK(toBlockNumKey(9) < toBlockNumKey(10));
+  BOOST_CHECK(toBlockNumKey(255) < toBlockNumKey(256));
+  uint64_t blockNum = 0;
+  BOOST_CHECK(fromBlockNumKey(toBlockNumKey(123456789), blockNum));
+  BOOST_CHECK_EQUAL(blockNum, 123456789);
+
+  for (int i = 0; i < 21; i++) {
+    bytes serializedTxBlock;
+    constructDummyTxBlock(i).Serialize(serializedTxBlock, 0);
+    BlockStorage::GetBlockStorage().PutTxBlock(i, serializedTxBlock);
+  }
+
+  list<TxBlockSharedPtr> blocks;
+  BOOST_CHECK(BlockStorage::GetBlockStorage().GetTxBlockRange(8, 12, blocks));
+  BOOST_CHECK_EQUAL(blocks.size(), 5);
+  uint64_t expected = 8;
+  for (const auto& block : blocks) {
+    BOOST_CHECK_EQUAL(block->GetHeader().GetBlockNum(), expected++);
+  }
+
+  blocks.clear();
+  BOOST_CHECK(BlockStorage::GetBlockStorage().GetTxBlockRange(18, 100, blocks));
+  BOOST_CHECK_EQUAL(blocks.size(), 3);
+
+  blocks.clear();
+  BOOST_CHECK(
+      !BlockStorage::GetBlockStorage().GetTxBlockRange(100, 200, blocks));
+  BOOST_CHECK(!BlockStorage::GetBlockStorage().GetTxBlockRange(12, 8, blocks));
+  BOOST_CHECK(blocks.empty());
+}
+
+BOOST_AUTO_TEST_CASE(testMicroBlockRange) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  PairOfKey pubKey = Schnorr::GetInstance().GenKeyPair();
+
+  vector<BlockHash> hashes;
+  for (uint64_t epochNum = 0; epochNum < 12; epochNum++) {
+    for (uint32_t shardId = 0; shardId < 4; shardId++) {
+      MicroBlock microBlock(
+          MicroBlockHeader(shardId, 1, 1, 0, epochNum, MicroBlockHashSet(), 0,
+                           pubKey.second, 0, MICROBLOCK_VERSION),
+          vector<TxnHash>(), CoSignatures());
+      bytes body;
+      microBlock.Serialize(body, 0);
+      BOOST_CHECK(BlockStorage::GetBlockStorage().PutMicroBlock(
+          microBlock.GetBlockHash(), epochNum, shardId, body));
+      hashes.emplace_back(microBlock.GetBlockHash());
+    }
+  }
+
+  list<MicroBlockSharedPtr> blocks;
+  BOOST_CHECK(
+      BlockStorage::GetBlockStorage().GetRangeMicroBlocks(9, 10, 1, 2, blocks));
+  BOOST_CHECK_EQUAL(blocks.size(), 4);
+  const vector<pair<uint64_t, uint32_t>> expected = {
+      {9, 1}, {9, 2}, {10, 1}, {10, 2}};
+  auto it = expected.begin();
+  for (const auto& block : blocks) {
+    BOOST_CHECK_EQUAL(block->GetHeader().GetEpochNum(), it->first);
+    BOOST_CHECK_EQUAL(block->GetHeader().GetShardId(), it->second);
+    it++;
+  }
+
+  // Deleted micro blocks drop out of the index as well
+  BOOST_CHECK(BlockStorage::GetBlockStorage().DeleteMicroBlock(hashes[9 * 4]));
+  blocks.clear();
+  BOOST_CHECK(
+      !BlockStorage::GetBlockStorage().GetRangeMicroBlocks(9, 9, 0, 0, blocks));
+  BOOST_CHECK(blocks.empty());
+
+  BOOST_CHECK(BlockStorage::GetBlockStorage().BuildMicroBlockIndex());
+  BOOST_CHECK(BlockStorage::GetBlockStorage().GetRangeMicroBlocks(0, 100, 3,
+                                                                  100, blocks));
+  BOOST_CHECK_EQUAL(blocks.size(), 12);
+}
+
+BOOST_AUTO_TEST_CASE(testMicroBlocksByEpochRange) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  PairOfKey pubKey = Schnorr::GetInstance().GenKeyPair();
+
+  // Epochs 100 to 109, each with shards 0 to 2 and a DS micro block whose
+  // shard id is the number of shards
+  const uint32_t numShards = 3;
+  for (uint64_t epochNum = 100; epochNum < 110; epochNum++) {
+    for (uint32_t shardId = 0; shardId <= numShards; shardId++) {
+      MicroBlock microBlock(
+          MicroBlockHeader(shardId, 1, 1, 0, epochNum, MicroBlockHashSet(), 0,
+                           pubKey.second, 0, MICROBLOCK_VERSION),
+          vector<TxnHash>(), CoSignatures());
+      bytes body;
+      microBlock.Serialize(body, 0);
+      BOOST_CHECK(BlockStorage::GetBlockStorage().PutMicroBlock(
+          microBlock.GetBlockHash(), epochNum, shardId, body));
+    }
+  }
+
+  list<MicroBlockSharedPtr> blocks;
+  BOOST_CHECK(BlockStorage::GetBlockStorage().GetMicroBlocksByEpochRange(
+      104, 106, blocks));
+  BOOST_CHECK_EQUAL(blocks.size(), 3 * (numShards + 1));
+  uint64_t epochNum = 104;
+  uint32_t shardId = 0;
+  for (const auto& block : blocks) {
+    BOOST_CHECK_EQUAL(block->GetHeader().GetEpochNum(), epochNum);
+    BOOST_CHECK_EQUAL(block->GetHeader().GetShardId(), shardId);
+    if (++shardId > numShards) {
+      shardId = 0;
+      epochNum++;
+    }
+  }
+
+  // The range is inclusive at both ends
+  blocks.clear();
+  BOOST_CHECK(BlockStorage::GetBlockStorage().GetMicroBlocksByEpochRange(
+      109, 109, blocks));
+  BOOST_CHECK_EQUAL(blocks.size(), numShards + 1);
+
+  blocks.clear();
+  BOOST_CHECK(!BlockStorage::GetBlockStorage().GetMicroBlocksByEpochRange(
+      110, 200, blocks));
+  BOOST_CHECK(!BlockStorage::GetBlockStorage().GetMicroBlocksByEpochRange(
+      106, 104, blocks));
+  BOOST_CHECK(blocks.empty());
+}
+
 void writeBlock(int id) {
   TxBlock block = constructDummyTxBlock(id);
 
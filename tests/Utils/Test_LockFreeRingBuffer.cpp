@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "libUtils/LockFreeRingBuffer.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE utils
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(utils)
+
+BOOST_AUTO_TEST_CASE(testRingBufferOrderAndCapacity) {
+  INIT_STDOUT_LOGGER();
+
+  LockFreeRingBuffer<string> buffer(3);
+  BOOST_CHECK_EQUAL(buffer.Capacity(), 4);
+
+  for (unsigned int i = 0; i < 4; i++) {
+    BOOST_CHECK(buffer.TryPush(to_string(i)));
+  }
+  string full = "full";
+  BOOST_CHECK(!buffer.TryPush(move(full)));
+  BOOST_CHECK_EQUAL(full, "full");
+
+  string value;
+  for (unsigned int i = 0; i < 4; i++) {
+    BOOST_CHECK(buffer.TryPop(value));
+    BOOST_CHECK_EQUAL(value, to_string(i));
+  }
+  BOOST_CHECK(!buffer.TryPop(value));
+
+  // Wraps around
+  BOOST_CHECK(buffer.TryPush("again"));
+  BOOST_CHECK(buffer.TryPop(value));
+  BOOST_CHECK_EQUAL(value, "again");
+}
+
+BOOST_AUTO_TEST_CASE(testRingBufferConcurrentProducers) {
+  INIT_STDOUT_LOGGER();
+
+  const unsigned int numProducers = 4;
+  const unsigned int numItems = 100000;
+  LockFreeRingBuffer<unsigned int> buffer(64);
+
+  vector<thread> producers;
+  for (unsigned int p = 0; p < numProducers; p++) {
+    producers.emplace_back([&buffer, p]() {
+      for (unsigned int i = 0; i < numItems; i++) {
+        unsigned int value = p * numItems + i;
+        while (!buffer.TryPush(move(value))) {
+          this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Every item arrives once, and each producer's items arrive in order
+  vector<bool> seen(numProducers * numItems, false);
+  vector<int> last(numProducers, -1);
+  bool inOrder = true;
+  for (unsigned int received = 0; received < numProducers * numItems;) {
+    unsigned int value;
+    if (!buffer.TryPop(value)) {
+      this_thread::yield();
+      continue;
+    }
+    BOOST_REQUIRE(!seen[value]);
+    seen[value] = true;
+    const int index = value % numItems;
+    inOrder &= index > last[value / numItems];
+    last[value / numItems] = index;
+    received++;
+  }
+
+  for (auto& t : producers) {
+    t.join();
+  }
+  BOOST_CHECK(inOrder);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include "libUtils/Logger.h"
+#include "libUtils/PriorityDispatcher.h"
+
+#define BOOST_TEST_MODULE utils
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(utils)
+
+BOOST_AUTO_TEST_CASE(testDispatcherWeightedOrder) {
+  INIT_STDOUT_LOGGER();
+
+  // A single worker, held by the first job until every job is queued
+  promise<void> gate;
+  shared_future<void> opened(gate.get_future());
+  vector<string> handled;
+  PriorityDispatcher<string> dispatcher(
+      "Test", {{"High", 3, 100}, {"Low", 1, 100}}, 1,
+      [&](string& job) {
+        if (job == "gate") {
+          opened.wait();
+        } else {
+          handled.push_back(job);
+        }
+      });
+
+  BOOST_CHECK(dispatcher.Push(0, "gate"));
+  while (dispatcher.Size(0) > 0) {
+    this_thread::yield();
+  }
+  for (unsigned int i = 0; i < 2; i++) {
+    BOOST_CHECK(dispatcher.Push(1, "L"));
+  }
+  for (unsigned int i = 0; i < 6; i++) {
+    BOOST_CHECK(dispatcher.Push(0, "H"));
+  }
+  gate.set_value();
+
+  while (dispatcher.Size(0) + dispatcher.Size(1) > 0) {
+    this_thread::yield();
+  }
+  dispatcher.Stop();
+
+  // The gate took one of the three jobs of the first round
+  const vector<string> expected = {"H", "H", "L", "H", "H", "H", "L", "H"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(handled.begin(), handled.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(testDispatcherDepthAndStop) {
+  INIT_STDOUT_LOGGER();
+
+  promise<void> gate;
+  shared_future<void> opened(gate.get_future());
+  PriorityDispatcher<string> dispatcher("Test", {{"Only", 1, 2}}, 1,
+                                        [&](string&) { opened.wait(); });
+
+  BOOST_CHECK(dispatcher.Push(0, "busy"));
+  while (dispatcher.Size(0) > 0) {
+    this_thread::yield();
+  }
+  BOOST_CHECK(dispatcher.Push(0, "a"));
+  BOOST_CHECK(dispatcher.Push(0, "b"));
+  string full = "c";
+  BOOST_CHECK(!dispatcher.Push(0, move(full)));
+  BOOST_CHECK_EQUAL(full, "c");
+  BOOST_CHECK_EQUAL(dispatcher.Dropped(0), 1);
+
+  // Queued jobs are handed back rather than handled
+  auto stopped = async(launch::async, [&]() { return dispatcher.Stop(); });
+  while (dispatcher.Size(0) > 0) {
+    this_thread::yield();
+  }
+  gate.set_value();
+  const vector<string> left = stopped.get();
+  BOOST_CHECK_EQUAL(left.size(), 2);
+  string late = "d";
+  BOOST_CHECK(!dispatcher.Push(0, move(late)));
+}
+
+BOOST_AUTO_TEST_CASE(testDispatcherConcurrentProducers) {
+  INIT_STDOUT_LOGGER();
+
+  const unsigned int numProducers = 4;
+  const unsigned int numJobs = 10000;
+  atomic<unsigned int> handled{0};
+  PriorityDispatcher<unsigned int> dispatcher(
+      "Test", {{"High", 4, numJobs}, {"Mid", 2, numJobs}, {"Low", 1, numJobs}},
+      4, [&](unsigned int&) { handled++; });
+
+  vector<thread> producers;
+  for (unsigned int p = 0; p < numProducers; p++) {
+    producers.emplace_back([&dispatcher, p]() {
+      for (unsigned int i = 0; i < numJobs; i++) {
+        unsigned int job = i;
+        while (!dispatcher.Push((p + i) % 3, move(job))) {
+          this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+
+  while (handled < numProducers * numJobs) {
+    this_thread::yield();
+  }
+  dispatcher.Stop();
+  BOOST_CHECK_EQUAL(handled, numProducers * numJobs);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
+#include "common/Constants.h"
+#include "libUtils/JsonUtils.h"
+#include "libUtils/Logger.h"
+#include "libUtils/ScillaWorker.h"
+#include "libUtils/ScillaWorkerClient.h"
+
+#define BOOST_TEST_MODULE scillaworker
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+const string TEST_DIR = "/tmp/test_scilla_worker_dir_" + to_string(getpid());
+const string SOCKET_PATH = TEST_DIR + "/worker.sock";
+const string ROOT = TEST_DIR + "/root";
+
+// Stand-in for scilla-runner: writes the message, or the init for a deploy,
+// as its output. A gas limit of 0 prints an error instead, and "hang" never
+// returns.
+const string FAKE_RUNNER = R"(#!/bin/sh
+while [ $# -gt 0 ]; do
+  case "$1" in
+    -o) out="$2"; shift ;;
+    -init) init="$2"; shift ;;
+    -imessage) msg="$2"; shift ;;
+    -gaslimit) gas="$2"; shift ;;
+  esac
+  shift
+done
+if [ "$gas" = "hang" ]; then sleep 60; fi
+if [ "$gas" = "0" ]; then echo "out of gas"; exit 1; fi
+if [ -n "$msg" ]; then cat "$msg" > "$out"; else cat "$init" > "$out"; fi
+)";
+
+// Stand-in for scilla-checker: prints its arguments and the code
+const string FAKE_CHECKER = R"(#!/bin/sh
+for a; do last="$a"; done
+echo "checked $*"
+cat "$last"
+)";
+
+void WriteScript(const string& path, const string& content) {
+  boost::filesystem::create_directories(
+      boost::filesystem::path(path).parent_path());
+  ofstream os(path);
+  os << content;
+  os.close();
+  boost::filesystem::permissions(path, boost::filesystem::owner_all);
+}
+
+/// Runs a worker on SOCKET_PATH for the lifetime of the object
+struct WorkerFixture {
+  ScillaWorker worker{SOCKET_PATH, TEST_DIR + "/work"};
+  thread runner;
+
+  WorkerFixture() {
+    WriteScript(ROOT + '/' + SCILLA_BINARY, FAKE_RUNNER);
+    WriteScript(ROOT + '/' + SCILLA_CHECKER, FAKE_CHECKER);
+    BOOST_REQUIRE(worker.Listen());
+    runner = thread([this]() { worker.Run(); });
+  }
+
+  ~WorkerFixture() {
+    worker.Stop();
+    runner.join();
+    boost::filesystem::remove_all(TEST_DIR);
+  }
+};
+
+Json::Value MakeRequest(const string& command, const string& gasLimit) {
+  Json::Value request;
+  request["command"] = command;
+  request["root"] = ROOT;
+  request["code"] = "scilla_version 0";
+  request["code_hash"] = "0x01";
+  request["init"][0]["vname"] = "_scilla_version";
+  request["blockchain"][0]["vname"] = "BLOCKNUMBER";
+  request["args"].append("-gaslimit");
+  request["args"].append(gasLimit);
+  return request;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(scillaworker)
+
+BOOST_AUTO_TEST_CASE(test_run_and_check) {
+  INIT_STDOUT_LOGGER();
+
+  WorkerFixture fixture;
+  ScillaWorkerClient client(SOCKET_PATH);
+  auto& json = JSONUtils::GetInstance();
+  string response;
+  int fd = -1;
+
+  // A deploy has no message, so the fake runner outputs the init
+  Json::Value request = MakeRequest("run", "100");
+  BOOST_REQUIRE(client.Call(json.convertJsontoStr(request), response, fd));
+  Json::Value output;
+  BOOST_REQUIRE(json.convertStrtoJson(response, output));
+  BOOST_CHECK(output == request["init"]);
+
+  // A call passes the state and message as well
+  request["state"][0]["vname"] = "_balance";
+  request["message"]["_tag"] = "Transfer";
+  BOOST_REQUIRE(client.Call(json.convertJsontoStr(request), response, fd));
+  BOOST_REQUIRE(json.convertStrtoJson(response, output));
+  BOOST_CHECK(output == request["message"]);
+
+  // Without an output json the printout is returned
+  request = MakeRequest("run", "0");
+  BOOST_REQUIRE(client.Call(json.convertJsontoStr(request), response, fd));
+  BOOST_CHECK_EQUAL(response, "out of gas\n");
+
+  // Another contract on the same connection gets its own code
+  request = MakeRequest("check", "100");
+  request["code"] = "scilla_version 1";
+  request["code_hash"] = "0x02";
+  BOOST_REQUIRE(client.Call(json.convertJsontoStr(request), response, fd));
+  BOOST_CHECK(response.find("checked -gaslimit 100") == 0);
+  BOOST_CHECK(response.find("scilla_version 1") != string::npos);
+
+  BOOST_REQUIRE(client.Call("not json", response, fd));
+  BOOST_CHECK_EQUAL(response, "Invalid scilla worker request");
+}
+
+BOOST_AUTO_TEST_CASE(test_abort_kills_interpreter) {
+  INIT_STDOUT_LOGGER();
+
+  WorkerFixture fixture;
+  ScillaWorkerClient client(SOCKET_PATH);
+  auto& json = JSONUtils::GetInstance();
+
+  int fd = -1;
+  string response;
+  const auto start = chrono::steady_clock::now();
+  thread caller([&]() {
+    BOOST_CHECK(!client.Call(
+        json.convertJsontoStr(MakeRequest("run", "hang")), response, fd));
+  });
+  this_thread::sleep_for(chrono::milliseconds(500));
+  ScillaWorkerClient::Abort(fd);
+  caller.join();
+
+  // The worker kills the interpreter and drops the connection's directory
+  const string connDir = TEST_DIR + "/work/conn_0";
+  while (boost::filesystem::exists(connDir) &&
+         chrono::steady_clock::now() - start < chrono::seconds(30)) {
+    this_thread::sleep_for(chrono::milliseconds(50));
+  }
+  BOOST_CHECK(!boost::filesystem::exists(connDir));
+  BOOST_CHECK(chrono::steady_clock::now() - start < chrono::seconds(30));
+
+  // The worker carries on with a new connection
+  int fd2 = -1;
+  BOOST_REQUIRE(client.Call(json.convertJsontoStr(MakeRequest("run", "100")),
+                            response, fd2));
+  Json::Value output;
+  BOOST_CHECK(json.convertStrtoJson(response, output));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
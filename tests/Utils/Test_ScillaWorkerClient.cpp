@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libUtils/Logger.h"
+#include "libUtils/ScillaWorkerClient.h"
+
+#define BOOST_TEST_MODULE scillaworkerclient
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+/// Stand-in for the scilla worker: answers each request with "out:" followed
+/// by the request, and never answers a request equal to "hang".
+class MockScillaWorker {
+  const string m_path;
+  int m_listenFd{-1};
+  thread m_acceptThread;
+  vector<thread> m_connThreads;
+  vector<int> m_connFds;
+
+ public:
+  atomic<unsigned int> m_accepted{0};
+  atomic<unsigned int> m_served{0};
+  atomic<unsigned int> m_hung{0};
+
+  explicit MockScillaWorker(const string& path) : m_path(path) {
+    unlink(m_path.c_str());
+    m_listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr {};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, m_path.c_str(), sizeof(addr.sun_path) - 1);
+    BOOST_REQUIRE(bind(m_listenFd, (struct sockaddr*)&addr, sizeof(addr)) ==
+                  0);
+    BOOST_REQUIRE(listen(m_listenFd, 8) == 0);
+
+    m_acceptThread = thread([this]() {
+      while (true) {
+        int fd = accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+          return;
+        }
+        m_accepted++;
+        m_connFds.emplace_back(fd);
+        m_connThreads.emplace_back([this, fd]() {
+          string request;
+          while (ScillaWorkerClient::ReadFrame(fd, request)) {
+            if (request == "hang") {
+              m_hung++;
+              continue;
+            }
+            m_served++;
+            if (!ScillaWorkerClient::WriteFrame(fd, "out:" + request)) {
+              break;
+            }
+          }
+        });
+      }
+    });
+  }
+
+  ~MockScillaWorker() {
+    shutdown(m_listenFd, SHUT_RDWR);
+    close(m_listenFd);
+    m_acceptThread.join();
+    for (const auto& fd : m_connFds) {
+      shutdown(fd, SHUT_RDWR);
+    }
+    for (auto& t : m_connThreads) {
+      t.join();
+    }
+    for (const auto& fd : m_connFds) {
+      close(fd);
+    }
+    unlink(m_path.c_str());
+  }
+};
+
+const string SOCKET_PATH = "/tmp/test_scilla_worker_" + to_string(getpid());
+
+BOOST_AUTO_TEST_SUITE(scillaworkerclient)
+
+BOOST_AUTO_TEST_CASE(test_call_reuses_connection) {
+  INIT_STDOUT_LOGGER();
+
+  MockScillaWorker worker(SOCKET_PATH);
+  ScillaWorkerClient client(SOCKET_PATH);
+
+  for (unsigned int i = 0; i < 10; i++) {
+    string response;
+    int fd = -1;
+    BOOST_REQUIRE(client.Call("req" + to_string(i), response, fd));
+    BOOST_CHECK_EQUAL(response, "out:req" + to_string(i));
+  }
+
+  // Large payloads and empty payloads go through the same framing
+  string large(3 * 1024 * 1024, 'x');
+  string response;
+  int fd = -1;
+  BOOST_REQUIRE(client.Call(large, response, fd));
+  BOOST_CHECK(response == "out:" + large);
+  BOOST_REQUIRE(client.Call("", response, fd));
+  BOOST_CHECK_EQUAL(response, "out:");
+
+  BOOST_CHECK_EQUAL(worker.m_accepted.load(), 1);
+  BOOST_CHECK_EQUAL(worker.m_served.load(), 12);
+}
+
+BOOST_AUTO_TEST_CASE(test_abort) {
+  INIT_STDOUT_LOGGER();
+
+  MockScillaWorker worker(SOCKET_PATH);
+  ScillaWorkerClient client(SOCKET_PATH);
+
+  int fd = -1;
+  string response;
+
+  // Call blocks until the connection is shut down
+  thread caller([&]() { BOOST_CHECK(!client.Call("hang", response, fd)); });
+
+  // fd is set before the request is sent
+  while (worker.m_hung.load() == 0) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  ScillaWorkerClient::Abort(fd);
+  caller.join();
+
+  // The aborted connection is not reused
+  int fd2 = -1;
+  BOOST_REQUIRE(client.Call("next", response, fd2));
+  BOOST_CHECK_EQUAL(response, "out:next");
+  BOOST_CHECK_EQUAL(worker.m_accepted.load(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_worker_restart) {
+  INIT_STDOUT_LOGGER();
+
+  ScillaWorkerClient client(SOCKET_PATH);
+  string response;
+  int fd = -1;
+
+  BOOST_CHECK(!client.Call("no worker", response, fd));
+
+  {
+    MockScillaWorker worker(SOCKET_PATH);
+    BOOST_REQUIRE(client.Call("first", response, fd));
+    BOOST_CHECK_EQUAL(response, "out:first");
+  }
+
+  // The idle connection to the previous worker is dropped and replaced
+  MockScillaWorker worker(SOCKET_PATH);
+  BOOST_REQUIRE(client.Call("second", response, fd));
+  BOOST_CHECK_EQUAL(response, "out:second");
+  BOOST_CHECK_EQUAL(worker.m_accepted.load(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+#include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
+
+#define BOOST_TEST_MODULE utils
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(utils)
+
+BOOST_AUTO_TEST_CASE(testThreadPoolSubmit) {
+  INIT_STDOUT_LOGGER();
+
+  ThreadPool pool(4, "Test");
+  vector<future<unsigned int>> results;
+  for (unsigned int i = 0; i < 100; i++) {
+    results.emplace_back(pool.Submit([i]() { return i * i; }));
+  }
+  for (unsigned int i = 0; i < results.size(); i++) {
+    BOOST_CHECK_EQUAL(results[i].get(), i * i);
+  }
+
+  promise<void> done;
+  atomic<unsigned int> count{0};
+  vector<ThreadPool::Job> jobs(1000, [&count, &done]() {
+    if (++count == 1000) {
+      done.set_value();
+    }
+  });
+  pool.BulkSubmit(jobs);
+  done.get_future().wait();
+  BOOST_CHECK_EQUAL(count, 1000);
+
+  // Workers count a job after running it, so let them finish first
+  pool.JoinAll();
+  const ThreadPool::Stats stats = pool.GetStats();
+  BOOST_CHECK_EQUAL(stats.m_queued, 0);
+  BOOST_CHECK_EQUAL(stats.m_completed, 1100);
+}
+
+BOOST_AUTO_TEST_CASE(testThreadPoolParallelFor) {
+  INIT_STDOUT_LOGGER();
+
+  ThreadPool pool(4, "Test");
+  vector<unsigned int> hits(10007, 0);
+  atomic<unsigned int> oversized{0};
+  pool.ParallelFor(0, hits.size(), 64, [&](size_t begin, size_t end) {
+    if (end - begin > 64) {
+      oversized++;
+    }
+    for (size_t i = begin; i < end; i++) {
+      hits[i]++;
+    }
+  });
+  BOOST_CHECK_EQUAL(oversized, 0);
+  BOOST_CHECK(all_of(hits.begin(), hits.end(),
+                     [](unsigned int hit) { return hit == 1; }));
+
+  // Nested from inside the workers, whose helper jobs go to their own deques
+  vector<atomic<unsigned int>> sums(8);
+  pool.ParallelFor(0, sums.size(), 1, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      pool.ParallelFor(0, 1000, 10, [&sums, i](size_t from, size_t to) {
+        sums[i] += to - from;
+      });
+    }
+  });
+  for (const auto& sum : sums) {
+    BOOST_CHECK_EQUAL(sum, 1000);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testThreadPoolConcurrentSubmitters) {
+  INIT_STDOUT_LOGGER();
+
+  ThreadPool pool(3, "Test");
+  atomic<unsigned int> count{0};
+  vector<thread> submitters;
+  for (unsigned int t = 0; t < 4; t++) {
+    submitters.emplace_back([&pool, &count]() {
+      vector<future<void>> results;
+      for (unsigned int i = 0; i < 500; i++) {
+        results.emplace_back(pool.Submit([&count]() { count++; }));
+      }
+      for (auto& result : results) {
+        result.wait();
+      }
+    });
+  }
+  for (auto& submitter : submitters) {
+    submitter.join();
+  }
+  BOOST_CHECK_EQUAL(count, 2000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,7 @@
 
 #include <arpa/inet.h>
 #include <array>
+#include <map>
 #include <string>
 #include <thread>
 #include <vector>
@@ -666,6 +667,48 @@ void perfTestTrie(char const* _name) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(batchUpdate) {
+  LOG_GENERAL(INFO, "Comparing batched updates with single inserts...");
+
+  MemoryDB singleDB;
+  MemoryDB batchDB;
+  EnforceRefs e1(singleDB, true);
+  EnforceRefs e2(batchDB, true);
+  SpecificTrieDB<GenericTrieDB<MemoryDB>, h160> single(&singleDB);
+  SpecificTrieDB<GenericTrieDB<MemoryDB>, h160> batch(&batchDB);
+  single.init();
+  batch.init();
+
+  vector<h160> keys;
+  for (unsigned round = 0; round < 10; ++round) {
+    map<h160, bytes> updates;
+    for (unsigned i = 0; i < 100; ++i) {
+      if (!keys.empty() && i % 3 == 0) {
+        // Remove, or overwrite with a value short enough to be inlined
+        const h160& key = keys[rand() % keys.size()];
+        updates[key] = i % 2 ? bytes() : bytes{(byte)i};
+      } else {
+        keys.emplace_back(h160::random());
+        updates[keys.back()] = h256::random().asBytes();
+      }
+    }
+    // Removing a missing key changes nothing
+    updates[h160::random()] = bytes();
+
+    for (const auto& u : updates) {
+      if (u.second.empty()) {
+        single.remove(u.first);
+      } else {
+        single.insert(u.first, u.second);
+      }
+    }
+    batch.update(updates, round % 2 ? 4 : 1);
+
+    BOOST_CHECK_EQUAL(single.root(), batch.root());
+    BOOST_CHECK(singleDB.get() == batchDB.get());
+  }
+}
+
 BOOST_AUTO_TEST_CASE(triePerf) {
   //    if (test::Options::get().all)
   //    {
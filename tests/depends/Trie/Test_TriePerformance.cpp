@@ -15,9 +15,13 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <map>
 #include <string>
+#include <thread>
+#include <vector>
 
 #define BOOST_TEST_MODULE TriePerformance
 #define BOOST_TEST_DYN_LINK
@@ -154,4 +158,70 @@ BOOST_AUTO_TEST_CASE(TestMemoryDB) {
                   << " ms");
 }
 
+/// Checks that the parallel state root matches the sequential one. Run as
+/// "Test_TriePerformance -- benchmark" to time it at mainnet-like sizes.
+BOOST_AUTO_TEST_CASE(TestParallelStateRoot) {
+  INIT_STDOUT_LOGGER();
+
+  const auto& suite = boost::unit_test::framework::master_test_suite();
+  const bool benchmark =
+      suite.argc > 1 && std::string(suite.argv[1]) == "benchmark";
+  const unsigned int numAccounts = benchmark ? 1000000 : 10000;
+  const unsigned int numUpdates = benchmark ? 100000 : 1000;
+  // At least two threads, so that the parallel path is taken on any host
+  const unsigned int numThreads =
+      std::max(std::thread::hardware_concurrency(), 2u);
+
+  dev::MemoryDB tm;
+  dev::SpecificTrieDB<dev::GenericTrieDB<dev::MemoryDB>, Address> state(&tm);
+  state.init();
+
+  std::vector<Address> addresses;
+  addresses.reserve(numAccounts);
+  std::map<Address, bytes> accounts;
+  for (auto i = 0u; i < numAccounts; i++) {
+    addresses.emplace_back(Address::random());
+    dev::RLPStream rlpStream(2);
+    rlpStream << uint128_t{i + 9999998945} << uint128_t{i};
+    accounts.emplace(addresses.back(), rlpStream.out());
+  }
+  state.update(accounts, numThreads);
+  const dev::h256 baseRoot = state.root();
+  accounts.clear();
+
+  // The state delta of a busy epoch: updated, new and removed accounts
+  std::map<Address, bytes> delta;
+  for (auto i = 0u; i < numUpdates; i++) {
+    dev::RLPStream rlpStream(2);
+    rlpStream << uint128_t{i} << uint128_t{i + 1};
+    if (i % 10 == 0) {
+      delta.emplace(addresses[rand() % numAccounts], bytes());
+    } else if (i % 10 == 1) {
+      delta.emplace(Address::random(), rlpStream.out());
+    } else {
+      delta.emplace(addresses[rand() % numAccounts], rlpStream.out());
+    }
+  }
+
+  auto timeUpdate = [&](unsigned int threads) {
+    state.setRoot(baseRoot);
+    auto t_start = std::chrono::high_resolution_clock::now();
+    state.update(delta, threads);
+    auto t_end = std::chrono::high_resolution_clock::now();
+    LOG_GENERAL(INFO,
+                "State root of " << numUpdates / 1000 << "k updates to "
+                                 << numAccounts / 1000 << "k accounts with "
+                                 << threads << " threads: "
+                                 << (std::chrono::duration<double, std::milli>(
+                                         t_end - t_start)
+                                         .count())
+                                 << " ms");
+    return state.root();
+  };
+
+  const dev::h256 sequentialRoot = timeUpdate(1);
+  const dev::h256 parallelRoot = timeUpdate(numThreads);
+  BOOST_CHECK_EQUAL(sequentialRoot, parallelRoot);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -61,4 +61,38 @@ BOOST_AUTO_TEST_CASE(fat_trie) {
   LOG_GENERAL(INFO, m_testDB.Lookup((uint256_t)3));
 }
 
+BOOST_AUTO_TEST_CASE(hash_keys) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  LevelDB m_testDB("testHashKeys");
+  const h256 hash = h256::random();
+  string buffer;
+
+  m_testDB.Insert(hash, bytes{'k', 'i', 'w', 'i'});
+  BOOST_CHECK_EQUAL(m_testDB.Lookup(hash), "kiwi");
+
+  // Binary keys are the hash bytes themselves
+  leveldb::Slice key = m_testDB.HashKey(hash, buffer);
+  BOOST_CHECK_EQUAL(key.size(), h256::size);
+  BOOST_CHECK(!isHexHashKey(key));
+  BOOST_CHECK_EQUAL(m_testDB.Lookup(hash.ref()), "kiwi");
+
+  h256 recovered;
+  BOOST_CHECK(m_testDB.FromHashKey(key, recovered));
+  BOOST_CHECK_EQUAL(recovered, hash);
+
+  m_testDB.SetHashKeyFormat(HashKeyFormat::HEX);
+  key = m_testDB.HashKey(hash, buffer);
+  BOOST_CHECK(isHexHashKey(key));
+  BOOST_CHECK(m_testDB.FromHashKey(key, recovered));
+  BOOST_CHECK_EQUAL(recovered, hash);
+  BOOST_CHECK(m_testDB.Lookup(hash).empty());
+
+  m_testDB.SetHashKeyFormat(HashKeyFormat::BINARY);
+  BOOST_CHECK_EQUAL(m_testDB.DeleteKey(hash), 0);
+  BOOST_CHECK(!m_testDB.Exists(hash));
+}
+
 BOOST_AUTO_TEST_SUITE_END()